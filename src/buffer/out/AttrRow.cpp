@@ -120,6 +120,40 @@ size_t ATTR_ROW::GetNumberOfRuns() const noexcept
     return _list.size();
 }
 
+// Routine Description:
+// - Gets the attribute runs that cover a range of this ATTR_ROW, with the
+//   first and last runs cut down to fit inside it.
+// - For example, if the row was [{3, BLUE}, {4, RED}] and the range was
+//   (start, count) = (1, 3), the result would be [{2, BLUE}, {1, RED}].
+// Arguments:
+// - start - the first column of the range
+// - count - the number of columns in the range
+// Return Value:
+// - the runs, which add up to count in length.
+std::vector<TextAttributeRun> ATTR_ROW::GetRuns(const size_t start, const size_t count) const
+{
+    THROW_HR_IF(E_INVALIDARG, start > _cchRowWidth || count > _cchRowWidth - start);
+
+    std::vector<TextAttributeRun> runs;
+    const auto end = start + count;
+    size_t runStart = 0;
+    for (const auto& run : _list)
+    {
+        if (runStart >= end)
+        {
+            break;
+        }
+
+        const auto runEnd = runStart + run.GetLength();
+        if (runEnd > start)
+        {
+            runs.emplace_back(std::min(runEnd, end) - std::max(runStart, start), run.GetAttributes());
+        }
+        runStart = runEnd;
+    }
+    return runs;
+}
+
 // Routine Description:
 // - This routine finds the nth attribute in this ATTR_ROW.
 // Arguments:
@@ -41,6 +41,8 @@ public:
     size_t FindAttrIndex(const size_t index,
                          size_t* const pApplies) const;
 
+    std::vector<TextAttributeRun> GetRuns(const size_t start, const size_t count) const;
+
     bool SetAttrToEnd(const UINT iStart, const TextAttribute attr);
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith) noexcept;
 
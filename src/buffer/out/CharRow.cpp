@@ -19,10 +19,56 @@ CharRow::CharRow(size_t rowWidth, ROW* const pParent) :
     _wrapForced{ false },
     _doubleBytePadded{ false },
     _data(rowWidth, value_type()),
-    _pParent{ FAIL_FAST_IF_NULL(pParent) }
+    _pParent{ FAIL_FAST_IF_NULL(pParent) },
+    _generation{ 0 }
 {
 }
 
+// Routine Description:
+// - Copies the contents of another row into this one.
+// - The generation moves past both rows' generations, rather than being copied,
+//   so that this row never reports a generation it reported before.
+CharRow& CharRow::operator=(const CharRow& other)
+{
+    _wrapForced = other._wrapForced;
+    _doubleBytePadded = other._doubleBytePadded;
+    _data = other._data;
+    _pParent = other._pParent;
+    _generation = std::max(_generation, other._generation) + 1;
+    return *this;
+}
+
+// Routine Description:
+// - Moves the contents of another row into this one.
+// - See the copy assignment operator regarding the generation.
+CharRow& CharRow::operator=(CharRow&& other) noexcept
+{
+    _wrapForced = other._wrapForced;
+    _doubleBytePadded = other._doubleBytePadded;
+    _data = std::move(other._data);
+    _pParent = other._pParent;
+    _generation = std::max(_generation, other._generation) + 1;
+    return *this;
+}
+
+// Routine Description:
+// - Gets a counter that changes every time the text of this row may have changed.
+// - Anything that provides mutable access to the cells counts as a change,
+//   so this may change without the text actually being different.
+// Arguments:
+// - <none>
+// Return Value:
+// - the current generation of the row
+size_t CharRow::GetGeneration() const noexcept
+{
+    return _generation;
+}
+
+void CharRow::_Touch() noexcept
+{
+    ++_generation;
+}
+
 // Routine Description:
 // - Sets the wrap status for the current row
 // Arguments:
@@ -86,6 +132,8 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset() noexcept
 {
+    _Touch();
+
     for (auto& cell : _data)
     {
         cell.Reset();
@@ -103,6 +151,8 @@ void CharRow::Reset() noexcept
 // - S_OK on success, otherwise relevant error code
 [[nodiscard]] HRESULT CharRow::Resize(const size_t newSize) noexcept
 {
+    _Touch();
+
     try
     {
         const value_type insertVals;
@@ -115,6 +165,7 @@ void CharRow::Reset() noexcept
 
 typename CharRow::iterator CharRow::begin() noexcept
 {
+    _Touch();
     return _data.begin();
 }
 
@@ -125,6 +176,7 @@ typename CharRow::const_iterator CharRow::cbegin() const noexcept
 
 typename CharRow::iterator CharRow::end() noexcept
 {
+    _Touch();
     return _data.end();
 }
 
@@ -167,6 +219,7 @@ size_t CharRow::MeasureRight() const noexcept
 
 void CharRow::ClearCell(const size_t column)
 {
+    _Touch();
     _data.at(column).Reset();
 }
 
@@ -209,6 +262,7 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
+    _Touch();
     return _data.at(column).DbcsAttr();
 }
 
@@ -221,9 +275,91 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
+    _Touch();
     _data.at(column).EraseChars();
 }
 
+// Routine Description:
+// - overwrites a range of cells with the same single-width glyph, in one pass
+// Arguments:
+// - column - the first column to fill
+// - count - the number of columns to fill
+// - wch - the glyph to fill them with. It must not be a full-width glyph.
+// Return Value:
+// - <none>
+// Note: will throw exception if the range is out of bounds
+void CharRow::FillGlyphs(const size_t column, const size_t count, const wchar_t wch)
+{
+    THROW_HR_IF(E_INVALIDARG, column > _data.size() || count > _data.size() - column);
+    _Touch();
+    std::fill_n(_data.begin() + column, count, value_type{ wch, DbcsAttribute{} });
+}
+
+// Routine Description:
+// - overwrites a range of cells with text, one character per cell, in one pass
+// Arguments:
+// - column - the first column to write
+// - chars - the text to write. Every character must be a single-width glyph on
+//   its own, like printable ASCII is.
+// Return Value:
+// - <none>
+// Note: will throw exception if the range is out of bounds
+void CharRow::WriteGlyphs(const size_t column, const std::wstring_view chars)
+{
+    THROW_HR_IF(E_INVALIDARG, column > _data.size() || chars.size() > _data.size() - column);
+    _Touch();
+    std::transform(chars.cbegin(), chars.cend(), _data.begin() + column, [](const wchar_t wch) {
+        return value_type{ wch, DbcsAttribute{} };
+    });
+}
+
+// Routine Description:
+// - copies a range of cells to another place in the row, like memmove would.
+//   The ranges are allowed to overlap.
+// Arguments:
+// - sourceColumn - the first column to copy from
+// - count - the number of columns to copy
+// - targetColumn - the first column to copy to
+// Return Value:
+// - <none>
+// Note: will throw exception if either range is out of bounds
+void CharRow::CopyCells(const size_t sourceColumn, const size_t count, const size_t targetColumn)
+{
+    THROW_HR_IF(E_INVALIDARG, sourceColumn > _data.size() || count > _data.size() - sourceColumn);
+    THROW_HR_IF(E_INVALIDARG, targetColumn > _data.size() || count > _data.size() - targetColumn);
+    if (count == 0 || sourceColumn == targetColumn)
+    {
+        return;
+    }
+
+    _Touch();
+
+    const auto source = _data.begin() + sourceColumn;
+    const auto target = _data.begin() + targetColumn;
+    if (targetColumn < sourceColumn)
+    {
+        std::copy(source, source + count, target);
+    }
+    else
+    {
+        std::copy_backward(source, source + count, target + count);
+    }
+
+    // Glyphs that don't fit in a single wchar_t are kept in the unicode storage, keyed by
+    // their position, so they have to be copied along. That's walked in the same
+    // direction as the copy, so that no key is overwritten before it's been read.
+    auto& storage = GetUnicodeStorage();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto offset = targetColumn < sourceColumn ? i : count - 1 - i;
+        if (_data.at(targetColumn + offset).DbcsAttr().IsGlyphStored())
+        {
+            const auto glyph = storage.GetText(GetStorageKey(sourceColumn + offset));
+            storage.StoreGlyph(GetStorageKey(targetColumn + offset), glyph);
+        }
+    }
+}
+
 // Routine Description:
 // - returns text data at column as a const reference.
 // Arguments:
@@ -247,6 +383,7 @@ const CharRow::reference CharRow::GlyphAt(const size_t column) const
 CharRow::reference CharRow::GlyphAt(const size_t column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    _Touch();
     return { *this, column };
 }
 
@@ -296,6 +433,30 @@ const DelimiterClass CharRow::DelimiterClassAt(const size_t column, const std::w
     }
 }
 
+// Method Description:
+// - get the delimiter class for every cell in the char row at once
+// - used for double click selection and uia word navigation, which would otherwise
+//   classify the same cells over and over again while walking across words
+// Arguments:
+// - table: the precompiled word delimiters
+// - classes: receives one delimiter class per cell. Resized to the width of the row.
+// Return Value:
+// - <none>
+void CharRow::GetDelimiterClasses(const DelimiterTable& table, std::vector<DelimiterClass>& classes) const
+{
+    classes.resize(_data.size());
+
+    for (size_t i = 0; i < _data.size(); ++i)
+    {
+        const auto& cell = til::at(_data, i);
+
+        // Extended glyphs live in the UnicodeStorage and have to be looked up.
+        // Everything else can be classified straight out of the cell.
+        const auto glyph = cell.DbcsAttr().IsGlyphStored() ? *GlyphAt(i).begin() : cell.Char();
+        til::at(classes, i) = table.Classify(glyph);
+    }
+}
+
 UnicodeStorage& CharRow::GetUnicodeStorage() noexcept
 {
     return _pParent->GetUnicodeStorage();
@@ -325,3 +486,58 @@ void CharRow::UpdateParent(ROW* const pParent)
 {
     _pParent = FAIL_FAST_IF_NULL(pParent);
 }
+
+// Routine Description:
+// - constructor
+// Arguments:
+// - wordDelimiters - the characters that will be classified as DelimiterClass::DelimiterChar
+// Return Value:
+// - instantiated object
+DelimiterTable::DelimiterTable(const std::wstring_view wordDelimiters)
+{
+    for (size_t i = 0; i < _lowTable.size(); ++i)
+    {
+        til::at(_lowTable, i) = i <= UNICODE_SPACE ? DelimiterClass::ControlChar : DelimiterClass::RegularChar;
+    }
+
+    for (const auto wch : wordDelimiters)
+    {
+        if (wch <= UNICODE_SPACE)
+        {
+            // control characters always win over delimiters, see CharRow::DelimiterClassAt
+            continue;
+        }
+        else if (wch < _lowTable.size())
+        {
+            til::at(_lowTable, wch) = DelimiterClass::DelimiterChar;
+        }
+        else
+        {
+            _highDelimiters.push_back(wch);
+        }
+    }
+
+    std::sort(_highDelimiters.begin(), _highDelimiters.end());
+}
+
+// Routine Description:
+// - get the delimiter class of a character
+// Arguments:
+// - wch - the character to classify
+// Return Value:
+// - the delimiter class for the given char
+DelimiterClass DelimiterTable::Classify(const wchar_t wch) const noexcept
+{
+    if (wch < _lowTable.size())
+    {
+        return til::at(_lowTable, wch);
+    }
+    else if (std::binary_search(_highDelimiters.cbegin(), _highDelimiters.cend(), wch))
+    {
+        return DelimiterClass::DelimiterChar;
+    }
+    else
+    {
+        return DelimiterClass::RegularChar;
+    }
+}
@@ -34,6 +34,23 @@ enum class DelimiterClass
     RegularChar
 };
 
+// A precompiled form of a set of word delimiters.
+// Classifying a character is a table lookup for the first 256 code points,
+// rather than a search through the delimiter string for every cell.
+class DelimiterTable final
+{
+public:
+    explicit DelimiterTable(const std::wstring_view wordDelimiters);
+
+    DelimiterClass Classify(const wchar_t wch) const noexcept;
+
+private:
+    std::array<DelimiterClass, 256> _lowTable;
+
+    // delimiters outside the lookup table, kept sorted for binary search
+    std::wstring _highDelimiters;
+};
+
 // the characters of one row of screen buffer
 // we keep the following values so that we don't write
 // more pixels to the screen than we have to:
@@ -54,6 +71,12 @@ public:
     using reference = typename CharRowCellReference;
 
     CharRow(size_t rowWidth, ROW* const pParent);
+    CharRow(const CharRow&) = default;
+    CharRow(CharRow&&) = default;
+    CharRow& operator=(const CharRow& other);
+    CharRow& operator=(CharRow&& other) noexcept;
+
+    size_t GetGeneration() const noexcept;
 
     void SetWrapForced(const bool wrap) noexcept;
     bool WasWrapForced() const noexcept;
@@ -69,9 +92,13 @@ public:
     const DbcsAttribute& DbcsAttrAt(const size_t column) const;
     DbcsAttribute& DbcsAttrAt(const size_t column);
     void ClearGlyph(const size_t column);
+    void FillGlyphs(const size_t column, const size_t count, const wchar_t wch);
+    void WriteGlyphs(const size_t column, const std::wstring_view chars);
+    void CopyCells(const size_t sourceColumn, const size_t count, const size_t targetColumn);
     std::wstring GetText() const;
 
     const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+    void GetDelimiterClasses(const DelimiterTable& table, std::vector<DelimiterClass>& classes) const;
 
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
@@ -105,6 +132,12 @@ protected:
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
+
+    // Bumped whenever the text of this row might have changed, so that anyone
+    // caching something derived from the text can tell whether it's stale.
+    size_t _generation;
+
+    void _Touch() noexcept;
 };
 
 constexpr bool operator==(const CharRow& a, const CharRow& b) noexcept
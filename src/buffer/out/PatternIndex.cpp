@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "PatternIndex.hpp"
+
+using namespace Microsoft::Console::Types;
+
+static constexpr std::array<std::wstring_view, 4> UrlSchemes{ L"https", L"http", L"file", L"ftp" };
+
+static constexpr bool _IsAsciiAlpha(const wchar_t wch) noexcept
+{
+    return (wch >= L'a' && wch <= L'z') || (wch >= L'A' && wch <= L'Z');
+}
+
+static constexpr bool _IsAsciiDigit(const wchar_t wch) noexcept
+{
+    return wch >= L'0' && wch <= L'9';
+}
+
+static constexpr bool _IsPathChar(const wchar_t wch) noexcept
+{
+    return _IsAsciiAlpha(wch) || _IsAsciiDigit(wch) || wch > 0x7f ||
+           wch == L'_' || wch == L'-' || wch == L'.' || wch == L'/' || wch == L'\\' ||
+           wch == L'~' || wch == L'+' || wch == L'@' || wch == L'$';
+}
+
+static constexpr bool _IsUrlChar(const wchar_t wch) noexcept
+{
+    return wch > UNICODE_SPACE && wch != L'"' && wch != L'<' && wch != L'>' && wch != L'`' &&
+           wch != L'{' && wch != L'}' && wch != L'|' && wch != L'\\' && wch != L'^';
+}
+
+static constexpr bool _IsOpeningPunctuation(const wchar_t wch) noexcept
+{
+    return wch == L'(' || wch == L'[' || wch == L'<' || wch == L'"' || wch == L'\'';
+}
+
+static constexpr bool _IsTrailingPunctuation(const wchar_t wch) noexcept
+{
+    return wch == L'.' || wch == L',' || wch == L';' || wch == L':' || wch == L'!' || wch == L'?' ||
+           wch == L')' || wch == L']' || wch == L'\'';
+}
+
+static bool _IsUrlScheme(const std::wstring_view scheme) noexcept
+{
+    return std::any_of(UrlSchemes.begin(), UrlSchemes.end(), [&](const auto candidate) {
+        return candidate.size() == scheme.size() &&
+               std::equal(candidate.begin(), candidate.end(), scheme.begin(), [](const wchar_t a, const wchar_t b) {
+                   return a == (b | 0x20);
+               });
+    });
+}
+
+// Routine Description:
+// - Looks for a URL such as "https://example.com/path" within a token.
+// Arguments:
+// - token - a run of text that contains no whitespace
+// Return Value:
+// - the offsets of the first and last characters of the URL within the token, if there is one.
+static std::optional<std::pair<size_t, size_t>> _MatchUrl(const std::wstring_view token) noexcept
+{
+    const auto separator = token.find(L"://");
+    if (separator == std::wstring_view::npos)
+    {
+        return std::nullopt;
+    }
+
+    auto begin = separator;
+    while (begin > 0 && _IsAsciiAlpha(til::at(token, begin - 1)))
+    {
+        --begin;
+    }
+
+    if (!_IsUrlScheme(token.substr(begin, separator - begin)))
+    {
+        return std::nullopt;
+    }
+
+    const auto authority = separator + 3;
+    auto end = authority;
+    while (end < token.size() && _IsUrlChar(til::at(token, end)))
+    {
+        ++end;
+    }
+
+    // Prose likes to put URLs in parentheses or end sentences with them.
+    // Only keep a closing parenthesis when the URL itself opened one.
+    const auto url = token.substr(begin, end - begin);
+    const auto hasOpenParen = url.find(L'(') != std::wstring_view::npos;
+    while (end > authority && _IsTrailingPunctuation(til::at(token, end - 1)))
+    {
+        if (til::at(token, end - 1) == L')' && hasOpenParen)
+        {
+            break;
+        }
+        --end;
+    }
+
+    if (end == authority)
+    {
+        return std::nullopt;
+    }
+
+    return std::pair{ begin, end - 1 };
+}
+
+// Routine Description:
+// - Looks for a file path followed by a line number within a token, in any of
+//   the forms compilers print them:
+//      path/to/file.cpp:12   path/to/file.cpp:12:5
+//      C:\path\file.cpp(12)  C:\path\file.cpp(12,5)
+// Arguments:
+// - token - a run of text that contains no whitespace
+// Return Value:
+// - the offsets of the first and last characters of the match within the token, if there is one.
+static std::optional<std::pair<size_t, size_t>> _MatchFilePath(const std::wstring_view token) noexcept
+{
+    size_t begin = 0;
+    while (begin < token.size() && _IsOpeningPunctuation(til::at(token, begin)))
+    {
+        ++begin;
+    }
+
+    auto pos = begin;
+
+    // A drive letter is the only place a colon may appear within the path.
+    if (pos + 2 < token.size() &&
+        _IsAsciiAlpha(til::at(token, pos)) &&
+        til::at(token, pos + 1) == L':' &&
+        (til::at(token, pos + 2) == L'\\' || til::at(token, pos + 2) == L'/'))
+    {
+        pos += 2;
+    }
+
+    // Require a dot or a separator somewhere, so that "error:12" isn't a path.
+    bool looksLikeFile = false;
+    while (pos < token.size() && _IsPathChar(til::at(token, pos)))
+    {
+        const auto wch = til::at(token, pos);
+        looksLikeFile |= wch == L'.' || wch == L'/' || wch == L'\\';
+        ++pos;
+    }
+
+    if (pos == begin || !looksLikeFile || pos + 1 >= token.size() || !_IsAsciiDigit(til::at(token, pos + 1)))
+    {
+        return std::nullopt;
+    }
+
+    const auto skipDigits = [&](size_t i) noexcept {
+        while (i < token.size() && _IsAsciiDigit(til::at(token, i)))
+        {
+            ++i;
+        }
+        return i;
+    };
+
+    auto end = skipDigits(pos + 1);
+
+    if (til::at(token, pos) == L':')
+    {
+        if (end + 1 < token.size() && til::at(token, end) == L':' && _IsAsciiDigit(til::at(token, end + 1)))
+        {
+            end = skipDigits(end + 1);
+        }
+    }
+    else if (til::at(token, pos) == L'(')
+    {
+        if (end + 1 < token.size() && til::at(token, end) == L',' && _IsAsciiDigit(til::at(token, end + 1)))
+        {
+            end = skipDigits(end + 1);
+        }
+        if (end >= token.size() || til::at(token, end) != L')')
+        {
+            return std::nullopt;
+        }
+        ++end;
+    }
+    else
+    {
+        return std::nullopt;
+    }
+
+    return std::pair{ begin, end - 1 };
+}
+
+// Routine Description:
+// - Scans the given rows for patterns, skipping any row whose text hasn't
+//   changed since the last time it was scanned.
+// Arguments:
+// - buffer - the buffer the rows belong to
+// - rows - the rows to scan. Only the vertical extent is used.
+// Return Value:
+// - the number of rows that actually had to be scanned
+size_t PatternIndex::Update(const TextBuffer& buffer, const Viewport& rows)
+{
+    if (_rows.size() != buffer.TotalRowCount())
+    {
+        _rows.clear();
+        _rows.resize(buffer.TotalRowCount());
+    }
+
+    size_t scanned = 0;
+    for (auto y = rows.Top(); y < rows.BottomExclusive(); ++y)
+    {
+        const auto& row = buffer.GetRowByOffset(y);
+        const auto& charRow = row.GetCharRow();
+        auto& entry = _rows.at(gsl::narrow_cast<size_t>(row.GetId()));
+
+        if (entry.generation == charRow.GetGeneration())
+        {
+            continue;
+        }
+
+        _GetColumnText(charRow, _text);
+        s_FindPatterns(_text, entry.spans);
+        entry.generation = charRow.GetGeneration();
+        ++scanned;
+    }
+
+    return scanned;
+}
+
+// Routine Description:
+// - Forgets everything that was found so far. This must be called when the
+//   buffer is replaced (for instance when it's reflowed on resize), since the
+//   new buffer's rows start counting their generations over.
+void PatternIndex::Invalidate() noexcept
+{
+    _rows.clear();
+}
+
+// Routine Description:
+// - Finds the pattern under the given position, if it's known.
+// - Rows that changed since they were last scanned are treated as having no patterns.
+// Arguments:
+// - buffer - the buffer the position refers to
+// - position - a position in the buffer
+// Return Value:
+// - the (inclusive) region of the buffer covered by the pattern, if there is one.
+std::optional<SMALL_RECT> PatternIndex::FindAt(const TextBuffer& buffer, const COORD position) const
+{
+    if (!buffer.GetSize().IsInBounds(position))
+    {
+        return std::nullopt;
+    }
+
+    const auto& row = buffer.GetRowByOffset(position.Y);
+    const auto id = gsl::narrow_cast<size_t>(row.GetId());
+    if (id >= _rows.size())
+    {
+        return std::nullopt;
+    }
+
+    const auto& entry = til::at(_rows, id);
+    if (entry.generation != row.GetCharRow().GetGeneration())
+    {
+        return std::nullopt;
+    }
+
+    const auto x = gsl::narrow_cast<size_t>(position.X);
+    for (const auto& span : entry.spans)
+    {
+        if (span.left <= x && x <= span.right)
+        {
+            return SMALL_RECT{ gsl::narrow<SHORT>(span.left), position.Y, gsl::narrow<SHORT>(span.right), position.Y };
+        }
+    }
+
+    return std::nullopt;
+}
+
+// Routine Description:
+// - Finds every pattern in a single row of text.
+// Arguments:
+// - text - the text of the row, with exactly one character per column
+// - spans - receives the patterns found, in order
+// Return Value:
+// - <none>
+void PatternIndex::s_FindPatterns(const std::wstring_view text, std::vector<PatternSpan>& spans)
+{
+    spans.clear();
+
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        if (til::at(text, pos) <= UNICODE_SPACE)
+        {
+            ++pos;
+            continue;
+        }
+
+        const auto begin = pos;
+        while (pos < text.size() && til::at(text, pos) > UNICODE_SPACE)
+        {
+            ++pos;
+        }
+
+        const auto token = text.substr(begin, pos - begin);
+        if (const auto url = _MatchUrl(token))
+        {
+            spans.push_back({ begin + url->first, begin + url->second, PatternKind::Url });
+        }
+        else if (const auto path = _MatchFilePath(token))
+        {
+            spans.push_back({ begin + path->first, begin + path->second, PatternKind::FilePath });
+        }
+    }
+}
+
+// Routine Description:
+// - Gets the text of a row with exactly one character per column, so that
+//   offsets into the text are also columns. The right half of a wide glyph
+//   repeats its left half, and only the first code unit of a stored glyph is used.
+// Arguments:
+// - charRow - the row to read
+// - text - receives the text
+// Return Value:
+// - <none>
+void PatternIndex::_GetColumnText(const CharRow& charRow, std::wstring& text)
+{
+    text.clear();
+    text.reserve(charRow.size());
+
+    size_t column = 0;
+    for (auto it = charRow.cbegin(); it != charRow.cend(); ++it, ++column)
+    {
+        if (it->DbcsAttr().IsTrailing() && !text.empty())
+        {
+            text.push_back(text.back());
+        }
+        else if (it->DbcsAttr().IsGlyphStored())
+        {
+            text.push_back(*charRow.GlyphAt(column).begin());
+        }
+        else
+        {
+            text.push_back(it->Char());
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- PatternIndex.hpp
+
+Abstract:
+- Detects clickable patterns (URLs, and file paths followed by a line number as
+  printed by compilers) in the text buffer, and remembers where they are.
+- Rows are only scanned when their text changed since the last scan. Every ROW's
+  CharRow carries a generation counter, and the index records the generation it
+  saw when it scanned that row. Entries are keyed by ROW id, which is the row's
+  position in the buffer's storage rather than on screen, so circling the
+  buffer doesn't cause anything to be rescanned.
+- The index doesn't own any locks. The owner must hold the buffer's lock while
+  calling into it, and must call Invalidate if it replaces the buffer.
+--*/
+
+#pragma once
+
+#include "textBuffer.hpp"
+
+enum class PatternKind
+{
+    Url,
+    FilePath
+};
+
+struct PatternSpan
+{
+    // first and last (inclusive) column of the pattern
+    size_t left;
+    size_t right;
+    PatternKind kind;
+};
+
+class PatternIndex final
+{
+public:
+    PatternIndex() = default;
+
+    size_t Update(const TextBuffer& buffer, const Microsoft::Console::Types::Viewport& rows);
+    void Invalidate() noexcept;
+
+    std::optional<SMALL_RECT> FindAt(const TextBuffer& buffer, const COORD position) const;
+
+    static void s_FindPatterns(const std::wstring_view text, std::vector<PatternSpan>& spans);
+
+private:
+    struct Entry
+    {
+        std::optional<size_t> generation;
+        std::vector<PatternSpan> spans;
+    };
+
+    // indexed by ROW id
+    std::vector<Entry> _rows;
+
+    // scratch space for the text of the row being scanned
+    std::wstring _text;
+
+    static void _GetColumnText(const CharRow& charRow, std::wstring& text);
+};
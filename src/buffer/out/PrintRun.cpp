@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "PrintRun.hpp"
+
+#include "../../types/inc/GlyphWidth.hpp"
+
+static constexpr bool s_IsPrintableAscii(const wchar_t wch) noexcept
+{
+    return wch >= L' ' && wch < 0x7F;
+}
+
+static constexpr bool s_IsControlChar(const wchar_t wch) noexcept
+{
+    return wch < L' ' || wch == 0x7F;
+}
+
+static constexpr bool s_IsLeadingSurrogate(const wchar_t wch) noexcept
+{
+    return wch >= 0xD800 && wch <= 0xDBFF;
+}
+
+static constexpr bool s_IsTrailingSurrogate(const wchar_t wch) noexcept
+{
+    return wch >= 0xDC00 && wch <= 0xDFFF;
+}
+
+// Routine Description:
+// - Splits as much of the given text as fits in the given number of columns
+//   into glyphs, and measures them. Surrogate pairs are kept together, and a
+//   surrogate that isn't part of a pair becomes a replacement character.
+// Arguments:
+// - text - the text to print
+// - columns - the number of columns available to print it in
+// - stopAtControlChars - if true, the run ends at the first C0 control
+//   character or DEL, for callers that have to act on those themselves.
+// Return Value:
+// - <none>
+void PrintRun::Compile(const std::wstring_view text, const size_t columns, const bool stopAtControlChars)
+{
+    _glyphs.clear();
+
+    // The ASCII fast path: every character in it takes up exactly one column.
+    const auto asciiLimit = std::min(text.size(), columns);
+    size_t pos = 0;
+    while (pos < asciiLimit && s_IsPrintableAscii(til::at(text, pos)))
+    {
+        ++pos;
+    }
+    _asciiPrefix = pos;
+    _columns = pos;
+
+    while (pos < text.size() && _columns < columns)
+    {
+        const auto wch = til::at(text, pos);
+        if (stopAtControlChars && s_IsControlChar(wch))
+        {
+            break;
+        }
+
+        Glyph glyph{ text.substr(pos, 1), 1, {} };
+        if (s_IsLeadingSurrogate(wch) && pos + 1 < text.size() && s_IsTrailingSurrogate(til::at(text, pos + 1)))
+        {
+            glyph.chars = text.substr(pos, 2);
+        }
+        else if (s_IsLeadingSurrogate(wch) || s_IsTrailingSurrogate(wch))
+        {
+            glyph.chars = { &UNICODE_REPLACEMENT, 1 };
+        }
+
+        if (!s_IsPrintableAscii(wch) && IsGlyphFullWidth(glyph.chars))
+        {
+            if (_columns + 2 > columns)
+            {
+                break;
+            }
+            glyph.columns = 2;
+            glyph.dbcsAttr.SetLeading();
+        }
+
+        // A replacement character still only consumes the one code unit it replaced.
+        pos += glyph.chars.size() == 2 ? 2 : 1;
+        _columns += glyph.columns;
+        _glyphs.push_back(glyph);
+    }
+
+    _text = text.substr(0, pos);
+}
+
+// Return Value:
+// - the code units of the text that made it into the run
+std::wstring_view PrintRun::Text() const noexcept
+{
+    return _text;
+}
+
+// Return Value:
+// - the number of columns the run takes up
+size_t PrintRun::Columns() const noexcept
+{
+    return _columns;
+}
+
+bool PrintRun::empty() const noexcept
+{
+    return _text.empty();
+}
+
+// Return Value:
+// - the printable ASCII characters the run starts with, one column each
+std::wstring_view PrintRun::AsciiPrefix() const noexcept
+{
+    return _text.substr(0, _asciiPrefix);
+}
+
+// Return Value:
+// - the glyphs of the run that follow its ASCII prefix
+const std::vector<PrintRun::Glyph>& PrintRun::Glyphs() const noexcept
+{
+    return _glyphs;
+}
@@ -0,0 +1,53 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- PrintRun.hpp
+
+Abstract:
+- A run of printable text, measured and split into glyphs in a single pass so
+  that it can be written into a row of the buffer without being walked again.
+- Compiling a run stops when the next glyph wouldn't fit in the columns left
+  on the row, so the writer never has to check for space itself.
+- Printable ASCII is always a single code unit and a single column, so the
+  leading ASCII part of a run isn't split into glyphs at all, and never has
+  its width looked up. Only what follows it is.
+--*/
+
+#pragma once
+
+#include "DbcsAttribute.hpp"
+
+class PrintRun final
+{
+public:
+    struct Glyph
+    {
+        // the code units of the glyph, which is either one of them or a surrogate pair
+        std::wstring_view chars;
+        // the number of columns the glyph takes up, 1 or 2
+        size_t columns;
+        // Single, or Leading for a glyph that takes up two columns. The trailing
+        // half is implied, and is written by the writer.
+        DbcsAttribute dbcsAttr;
+    };
+
+    void Compile(const std::wstring_view text, const size_t columns, const bool stopAtControlChars = false);
+
+    std::wstring_view Text() const noexcept;
+    size_t Columns() const noexcept;
+    bool empty() const noexcept;
+
+    std::wstring_view AsciiPrefix() const noexcept;
+    const std::vector<Glyph>& Glyphs() const noexcept;
+
+private:
+    std::wstring_view _text;
+    size_t _columns{ 0 };
+    size_t _asciiPrefix{ 0 };
+
+    // The glyphs that follow the ASCII prefix. Kept between compiles to save
+    // on allocations, since the same run is usually compiled over and over.
+    std::vector<Glyph> _glyphs;
+};
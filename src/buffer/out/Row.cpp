@@ -256,3 +256,174 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
 
     return it;
 }
+
+// Routine Description:
+// - fills a range of the row with the same character and/or color. Unlike WriteCells,
+//   the text is filled in a single pass and the colors with a single attribute run,
+//   so that erasing doesn't pay for walking an iterator cell by cell.
+// Arguments:
+// - index - column in row to start filling at
+// - count - the number of columns to fill. It's clamped to the end of the row.
+// - wch - the character to fill with (must not be full-width), or nullopt to keep the text
+// - attr - the color to fill with, or nullopt to keep the colors
+// - wrap - change the wrap flag if we fill the last column with text.
+// Return Value:
+// - <none>
+void ROW::FillCells(const size_t index,
+                    const size_t count,
+                    const std::optional<wchar_t> wch,
+                    const std::optional<TextAttribute> attr,
+                    const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    const auto fillCount = std::min(count, _charRow.size() - index);
+    if (fillCount == 0)
+    {
+        return;
+    }
+
+    if (wch.has_value())
+    {
+        _charRow.FillGlyphs(index, fillCount, wch.value());
+
+        // See WriteCells for the meaning of the wrap values.
+        if (wrap.has_value() && index + fillCount == _charRow.size())
+        {
+            _charRow.SetWrapForced(wrap.value());
+        }
+    }
+
+    if (attr.has_value())
+    {
+        // Filling the whole row replaces all of its runs with one.
+        if (fillCount == _charRow.size())
+        {
+            _attrRow.Reset(attr.value());
+        }
+        else
+        {
+            const TextAttributeRun run{ fillCount, attr.value() };
+            LOG_IF_FAILED(_attrRow.InsertAttrRuns({ &run, 1 },
+                                                  index,
+                                                  index + fillCount - 1,
+                                                  _charRow.size()));
+        }
+    }
+}
+
+// Routine Description:
+// - writes a compiled run of printable text into the row, all in one color.
+//   The run has already been measured and split into glyphs, so its ASCII
+//   prefix is copied in one go, and the colors are set with a single run.
+// Arguments:
+// - run - the text to write. It must fit in the row from the given column on.
+// - index - column in row to start writing at
+// - attr - the color to write the text in
+// - wrap - change the wrap flag if the text reaches the last column.
+// Return Value:
+// - <none>
+void ROW::WriteRun(const PrintRun& run, const size_t index, const TextAttribute attr, const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size() || run.Columns() > _charRow.size() - index);
+    if (run.empty())
+    {
+        return;
+    }
+
+    const auto ascii = run.AsciiPrefix();
+    _charRow.WriteGlyphs(index, ascii);
+
+    auto column = index + ascii.size();
+    for (const auto& glyph : run.Glyphs())
+    {
+        _charRow.DbcsAttrAt(column) = glyph.dbcsAttr;
+        _charRow.GlyphAt(column) = glyph.chars;
+        ++column;
+
+        // Full-width glyphs are stored in both of their cells.
+        if (glyph.columns == 2)
+        {
+            _charRow.DbcsAttrAt(column) = DbcsAttribute{ DbcsAttribute::Attribute::Trailing };
+            _charRow.GlyphAt(column) = glyph.chars;
+            ++column;
+        }
+    }
+
+    // See WriteCells for the meaning of the wrap values.
+    if (wrap.has_value() && column == _charRow.size())
+    {
+        _charRow.SetWrapForced(wrap.value());
+    }
+
+    FillCells(index, run.Columns(), std::nullopt, attr);
+}
+
+// Routine Description:
+// - copies a range of cells, text and colors, to another place in the row. The ranges
+//   may overlap. The text is moved in one go and the colors are spliced in as runs,
+//   rather than being written back a cell at a time.
+// Arguments:
+// - sourceIndex - column in row to copy from
+// - count - the number of columns to copy
+// - targetIndex - column in row to copy to
+// Return Value:
+// - <none>
+void ROW::CopyCells(const size_t sourceIndex, const size_t count, const size_t targetIndex)
+{
+    if (count == 0 || sourceIndex == targetIndex)
+    {
+        return;
+    }
+
+    _charRow.CopyCells(sourceIndex, count, targetIndex);
+
+    const auto runs = _attrRow.GetRuns(sourceIndex, count);
+    LOG_IF_FAILED(_attrRow.InsertAttrRuns(runs,
+                                          targetIndex,
+                                          targetIndex + count - 1,
+                                          _charRow.size()));
+}
+
+// Routine Description:
+// - inserts blank cells at the given column, pushing the rest of the row to the
+//   right. Whatever's pushed past the end of the row is lost.
+// Arguments:
+// - index - column in row to insert at
+// - count - the number of cells to insert
+// - fillAttr - the color of the inserted cells
+// Return Value:
+// - <none>
+void ROW::InsertCells(const size_t index, const size_t count, const TextAttribute fillAttr)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    const auto shift = std::min(count, _charRow.size() - index);
+    if (shift == 0)
+    {
+        return;
+    }
+
+    CopyCells(index, _charRow.size() - index - shift, index + shift);
+    FillCells(index, shift, UNICODE_SPACE, fillAttr);
+}
+
+// Routine Description:
+// - deletes cells at the given column, pulling the rest of the row to the left.
+//   The cells this uncovers at the end of the row are blanked.
+// Arguments:
+// - index - column in row to delete at
+// - count - the number of cells to delete
+// - fillAttr - the color of the uncovered cells
+// Return Value:
+// - <none>
+void ROW::DeleteCells(const size_t index, const size_t count, const TextAttribute fillAttr)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+    const auto shift = std::min(count, _charRow.size() - index);
+    if (shift == 0)
+    {
+        return;
+    }
+
+    CopyCells(index + shift, _charRow.size() - index - shift, index);
+    FillCells(_charRow.size() - shift, shift, UNICODE_SPACE, fillAttr);
+}
@@ -24,6 +24,7 @@ Revision History:
 #include "OutputCell.hpp"
 #include "OutputCellIterator.hpp"
 #include "CharRow.hpp"
+#include "PrintRun.hpp"
 #include "RowCellIterator.hpp"
 #include "UnicodeStorage.hpp"
 
@@ -58,6 +59,15 @@ public:
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    void FillCells(const size_t index,
+                   const size_t count,
+                   const std::optional<wchar_t> wch,
+                   const std::optional<TextAttribute> attr,
+                   const std::optional<bool> wrap = std::nullopt);
+    void WriteRun(const PrintRun& run, const size_t index, const TextAttribute attr, const std::optional<bool> wrap = std::nullopt);
+    void CopyCells(const size_t sourceIndex, const size_t count, const size_t targetIndex);
+    void InsertCells(const size_t index, const size_t count, const TextAttribute fillAttr);
+    void DeleteCells(const size_t index, const size_t count, const TextAttribute fillAttr);
 
     friend bool operator==(const ROW& a, const ROW& b) noexcept;
 
@@ -351,3 +351,23 @@ void TextAttribute::SetStandardErase() noexcept
     _extendedAttrs = ExtendedAttributes::Normal;
     _wAttrLegacy = 0;
 }
+
+// Method Description:
+// - Applies a change, like the one made by a rendition sequence, in one go.
+// Arguments:
+// - delta - the flags to clear and set, and the colors to replace.
+// Return Value:
+// - <none>
+void TextAttribute::ApplyDelta(const TextAttributeDelta& delta) noexcept
+{
+    _wAttrLegacy = gsl::narrow_cast<WORD>((_wAttrLegacy & ~delta.legacyClear) | delta.legacySet);
+    _extendedAttrs = (_extendedAttrs & ~delta.extendedClear) | delta.extendedSet;
+    if (delta.foreground.has_value())
+    {
+        _foreground = delta.foreground.value();
+    }
+    if (delta.background.has_value())
+    {
+        _background = delta.background.value();
+    }
+}
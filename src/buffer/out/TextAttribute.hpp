@@ -27,6 +27,8 @@ Revision History:
 #include "WexTestClass.h"
 #endif
 
+struct TextAttributeDelta;
+
 #pragma pack(push, 1)
 
 class TextAttribute final
@@ -129,6 +131,8 @@ public:
 
     void SetStandardErase() noexcept;
 
+    void ApplyDelta(const TextAttributeDelta& delta) noexcept;
+
     // This returns whether this attribute, if printed directly next to another attribute, for the space
     // character, would look identical to the other one.
     bool HasIdenticalVisualRepresentationForBlankSpace(const TextAttribute& other, const bool inverted = false) const noexcept
@@ -182,6 +186,54 @@ private:
 // 1 for _extendedAttrs
 static_assert(sizeof(TextAttribute) <= 11 * sizeof(BYTE), "We should only need 11B for an entire TextColor. Any more than that is just waste");
 
+// A change to a TextAttribute, like the one a rendition (SGR) sequence makes:
+// flags to clear and then set, and the colors to replace, if any. Changes can
+// be added one after the other, and later ones win, just as if they had been
+// made to the attribute directly. See TextAttribute::ApplyDelta.
+struct TextAttributeDelta
+{
+    WORD legacySet{ 0 };
+    WORD legacyClear{ 0 };
+    ExtendedAttributes extendedSet{ ExtendedAttributes::Normal };
+    ExtendedAttributes extendedClear{ ExtendedAttributes::Normal };
+    std::optional<TextColor> foreground;
+    std::optional<TextColor> background;
+
+    void UpdateLegacyFlags(const WORD flags, const bool set) noexcept
+    {
+        if (set)
+        {
+            WI_SetAllFlags(legacySet, flags);
+        }
+        else
+        {
+            WI_ClearAllFlags(legacySet, flags);
+        }
+        WI_SetAllFlags(legacyClear, flags);
+    }
+
+    void UpdateExtendedFlags(const ExtendedAttributes flags, const bool set) noexcept
+    {
+        if (set)
+        {
+            WI_SetAllFlags(extendedSet, flags);
+        }
+        else
+        {
+            WI_ClearAllFlags(extendedSet, flags);
+        }
+        WI_SetAllFlags(extendedClear, flags);
+    }
+
+    void SetStandardErase() noexcept
+    {
+        legacySet = 0;
+        legacyClear = gsl::narrow_cast<WORD>(~0);
+        extendedSet = ExtendedAttributes::Normal;
+        extendedClear = ~ExtendedAttributes::Normal;
+    }
+};
+
 enum class TextAttributeBehavior
 {
     Stored, // use contained text attribute
@@ -96,3 +96,31 @@ void UnicodeStorage::Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const
     // Swap into the stored map, free the temporary when we exit.
     _map.swap(newMap);
 }
+
+// Routine Description:
+// - Moves the stored items of some rows to their new row IDs, after those rows
+//   were rearranged amongst themselves. Items of every other row stay where they are.
+// Arguments:
+// - rowMap - A map of the old row IDs to the new row IDs, for the rows that moved.
+void UnicodeStorage::RemapRows(const std::unordered_map<SHORT, SHORT>& rowMap)
+{
+    // Take out everything that moves first, since the rows may have traded places.
+    std::vector<std::pair<key_type, mapped_type>> moved;
+    for (auto it = _map.begin(); it != _map.end();)
+    {
+        const auto mapIter = rowMap.find(it->first.Y);
+        if (mapIter == rowMap.end())
+        {
+            ++it;
+            continue;
+        }
+
+        moved.emplace_back(COORD{ it->first.X, mapIter->second }, std::move(it->second));
+        it = _map.erase(it);
+    }
+
+    for (auto& item : moved)
+    {
+        _map.insert_or_assign(item.first, std::move(item.second));
+    }
+}
@@ -56,6 +56,7 @@ public:
     void Erase(const key_type key);
 
     void Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
+    void RemapRows(const std::unordered_map<SHORT, SHORT>& rowMap);
 
 private:
     std::unordered_map<key_type, mapped_type> _map;
@@ -384,6 +384,70 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes a compiled run of printable text into one row of the buffer. The
+//   run was measured to fit in the row when it was compiled, so unlike Write
+//   there's no need to walk the text again, or to continue onto the next row.
+// Arguments:
+// - run - the text to write
+// - target - the row/column to start writing the text to
+// - attr - the color to write the text in
+// - wrap - change the wrap flag if the text reaches the end of the row
+// Return Value:
+// - <none>
+void TextBuffer::WriteRun(const PrintRun& run,
+                          const COORD target,
+                          const TextAttribute attr,
+                          const std::optional<bool> wrap)
+{
+    if (run.empty() || !GetSize().IsInBounds(target))
+    {
+        return;
+    }
+
+    GetRowByOffset(target.Y).WriteRun(run, target.X, attr, wrap);
+    _NotifyPaint(Viewport::FromDimensions(target, { gsl::narrow<SHORT>(run.Columns()), 1 }));
+}
+
+// Routine Description:
+// - Fills a stream of cells with the same character and/or color, starting at the
+//   target and continuing down lines, like Write would with a repeating iterator.
+//   Each row is filled in one go, rather than a cell at a time.
+// Arguments:
+// - target - the row/column to start filling at
+// - length - the number of cells to fill
+// - wch - the character to fill with, or nullopt to keep the text. It must not be full-width.
+// - attr - the color to fill with, or nullopt to keep the colors
+// - wrap - change the wrap flag if we fill the end of a row with text
+// Return Value:
+// - The number of cells filled, which is less than length if we ran out of buffer.
+size_t TextBuffer::FillCells(const COORD target,
+                             const size_t length,
+                             const std::optional<wchar_t> wch,
+                             const std::optional<TextAttribute> attr,
+                             const std::optional<bool> wrap)
+{
+    // Make mutable target so we can walk down lines.
+    auto lineTarget = target;
+    auto remaining = length;
+
+    // Get size of the text buffer so we can stay in bounds.
+    const auto size = GetSize();
+
+    while (remaining > 0 && size.IsInBounds(lineTarget))
+    {
+        const auto count = std::min(remaining, gsl::narrow_cast<size_t>(size.RightExclusive() - lineTarget.X));
+        GetRowByOffset(lineTarget.Y).FillCells(lineTarget.X, count, wch, attr, wrap);
+        _NotifyPaint(Viewport::FromDimensions(lineTarget, { gsl::narrow<SHORT>(count), 1 }));
+
+        remaining -= count;
+        lineTarget.X = 0;
+        ++lineTarget.Y;
+    }
+
+    return length - remaining;
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -679,6 +743,34 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
+    // If all of the rows we're about to rearrange sit in one piece within the storage,
+    // we can rotate them right where they are and only renumber those. This is the
+    // common case for IL and DL, which only shuffle a few rows within the viewport,
+    // and saves us from straightening out the whole circular buffer to do it.
+    {
+        const auto totalRows = gsl::narrow_cast<int>(TotalRowCount());
+        const auto top = std::min<int>(firstRow, firstRow + delta);
+        const auto bottom = std::max<int>(firstRow + size, firstRow + size + delta);
+        const auto storageTop = (_firstRow + top) % totalRows;
+        if (top >= 0 && bottom <= totalRows && storageTop + (bottom - top) <= totalRows)
+        {
+            const auto begin = _storage.begin() + storageTop;
+            if (delta < 0)
+            {
+                // Same as the negative delta case below, with begin as A.
+                std::rotate(begin, begin - delta, begin - delta + size);
+            }
+            else
+            {
+                // Same as the positive delta case below, with begin as A.
+                std::rotate(begin, begin + size, begin + size + delta);
+            }
+
+            _RefreshRowIDs(gsl::narrow_cast<size_t>(storageTop), gsl::narrow_cast<size_t>(bottom - top));
+            return;
+        }
+    }
+
     // OK. We're about to play games by moving rows around within the deque to
     // scroll a massive region in a faster way than copying things.
     // To make this easier, first correct the circular buffer to have the first row be 0 again.
@@ -772,6 +864,36 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
     _RefreshRowIDs(std::nullopt);
 }
 
+// Routine Description:
+// - Inserts blank cells at the target, pushing the rest of its row to the right.
+// Arguments:
+// - target - the row/column to insert at
+// - count - the number of cells to insert
+// - fillAttr - the color of the inserted cells
+void TextBuffer::InsertCells(const COORD target, const size_t count, const TextAttribute fillAttr)
+{
+    if (GetSize().IsInBounds(target))
+    {
+        GetRowByOffset(target.Y).InsertCells(target.X, count, fillAttr);
+        _NotifyPaint(Viewport::FromDimensions(target, gsl::narrow<SHORT>(GetSize().RightExclusive() - target.X), 1));
+    }
+}
+
+// Routine Description:
+// - Deletes cells at the target, pulling the rest of its row to the left.
+// Arguments:
+// - target - the row/column to delete at
+// - count - the number of cells to delete
+// - fillAttr - the color of the cells uncovered at the end of the row
+void TextBuffer::DeleteCells(const COORD target, const size_t count, const TextAttribute fillAttr)
+{
+    if (GetSize().IsInBounds(target))
+    {
+        GetRowByOffset(target.Y).DeleteCells(target.X, count, fillAttr);
+        _NotifyPaint(Viewport::FromDimensions(target, gsl::narrow<SHORT>(GetSize().RightExclusive() - target.X), 1));
+    }
+}
+
 Cursor& TextBuffer::GetCursor() noexcept
 {
     return _cursor;
@@ -909,6 +1031,31 @@ void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
     _unicodeStorage.Remap(rowMap, newRowWidth);
 }
 
+// Routine Description:
+// - Renumbers the IDs of a range of rows that were rearranged amongst themselves,
+//   leaving the rest of the buffer alone.
+// Arguments:
+// - first - the index of the first row of the range within the storage
+// - count - the number of rows in the range
+void TextBuffer::_RefreshRowIDs(const size_t first, const size_t count)
+{
+    std::unordered_map<SHORT, SHORT> rowMap;
+    for (auto i = first; i < first + count; ++i)
+    {
+        auto& row = _storage.at(i);
+        const auto id = gsl::narrow<SHORT>(i);
+
+        // Build a map so we can update Unicode Storage
+        rowMap.emplace(row.GetId(), id);
+
+        row.SetId(id);
+        row.GetCharRow().UpdateParent(&row);
+    }
+
+    // Give the new mapping to Unicode Storage
+    _unicodeStorage.RemapRows(rowMap);
+}
+
 void TextBuffer::_NotifyPaint(const Viewport& viewport) const
 {
     _renderTarget.TriggerRedraw(viewport);
@@ -957,17 +1104,73 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
     return _renderTarget;
 }
 
+// Routine Description:
+// - constructor
+// Arguments:
+// - buffer - the text buffer that will be walked
+// - wordDelimiters - the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// Return Value:
+// - instantiated object
+TextBuffer::DelimiterClassCache::DelimiterClassCache(const TextBuffer& buffer, const std::wstring_view wordDelimiters) :
+    _buffer{ buffer },
+    _table{ wordDelimiters }
+{
+}
+
 // Method Description:
 // - get delimiter class for buffer cell position
 // - used for double click selection and uia word navigation
 // Arguments:
 // - pos: the buffer cell under observation
-// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
 // Return Value:
 // - the delimiter class for the given char
-const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
+DelimiterClass TextBuffer::DelimiterClassCache::At(const COORD pos)
+{
+    _Load(pos.Y);
+    return _classes.at(pos.X);
+}
+
+// Method Description:
+// - get the first column of the run of cells in pos's row that share pos's delimiter class
+// Arguments:
+// - pos: the buffer cell under observation
+// Return Value:
+// - the column where the run containing pos begins (inclusive)
+SHORT TextBuffer::DelimiterClassCache::RunFirst(const COORD pos)
+{
+    const auto delimiterClass = At(pos);
+    const auto rbegin = _classes.crbegin() + (_classes.size() - pos.X - 1);
+    const auto it = std::find_if(rbegin, _classes.crend(), [=](const auto cls) { return cls != delimiterClass; });
+    return gsl::narrow_cast<SHORT>(std::distance(it, _classes.crend()));
+}
+
+// Method Description:
+// - get the last column of the run of cells in pos's row that share pos's delimiter class
+// Arguments:
+// - pos: the buffer cell under observation
+// Return Value:
+// - the column where the run containing pos ends (inclusive)
+SHORT TextBuffer::DelimiterClassCache::RunLast(const COORD pos)
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    const auto delimiterClass = At(pos);
+    const auto begin = _classes.cbegin() + pos.X;
+    const auto it = std::find_if(begin, _classes.cend(), [=](const auto cls) { return cls != delimiterClass; });
+    return gsl::narrow_cast<SHORT>(std::distance(_classes.cbegin(), it) - 1);
+}
+
+// Method Description:
+// - classify the given row, unless it's the one we classified last
+// Arguments:
+// - row: the row (offset from the top of the buffer) we're about to look at
+// Return Value:
+// - <none>
+void TextBuffer::DelimiterClassCache::_Load(const SHORT row)
+{
+    if (_row != row)
+    {
+        _buffer.GetRowByOffset(row).GetCharRow().GetDelimiterClasses(_table, _classes);
+        _row = row;
+    }
 }
 
 // Method Description:
@@ -998,13 +1201,14 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
         return target;
     }
 
+    DelimiterClassCache delimiters{ *this, wordDelimiters };
     if (accessibilityMode)
     {
-        return _GetWordStartForAccessibility(target, wordDelimiters);
+        return _GetWordStartForAccessibility(target, delimiters);
     }
     else
     {
-        return _GetWordStartForSelection(target, wordDelimiters);
+        return _GetWordStartForSelection(target, delimiters);
     }
 }
 
@@ -1012,18 +1216,20 @@ const COORD TextBuffer::GetWordStart(const COORD target, const std::wstring_view
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (accessibility definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the delimiter classes of the buffer's cells
 // Return Value:
 // - The COORD for the first character on the current/previous READABLE "word" (inclusive)
-const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, DelimiterClassCache& delimiters) const
 {
     COORD result = target;
     const auto bufferSize = GetSize();
     bool stayAtOrigin = false;
 
     // ignore left boundary. Continue until readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (delimiters.At(result) != DelimiterClass::RegularChar)
     {
+        // skip the rest of this run in one go
+        result.X = delimiters.RunFirst(result);
         if (!bufferSize.DecrementInBounds(result))
         {
             // first char in buffer is a DelimiterChar or ControlChar
@@ -1034,8 +1240,9 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // make sure we expand to the left boundary or the beginning of the word
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (delimiters.At(result) == DelimiterClass::RegularChar)
     {
+        result.X = delimiters.RunFirst(result);
         if (!bufferSize.DecrementInBounds(result))
         {
             // first char in buffer is a RegularChar
@@ -1045,7 +1252,7 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
     }
 
     // move off of delimiter and onto word start
-    if (!stayAtOrigin && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    if (!stayAtOrigin && delimiters.At(result) != DelimiterClass::RegularChar)
     {
         bufferSize.IncrementInBounds(result);
     }
@@ -1057,28 +1264,14 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
 // - Helper method for GetWordStart(). Get the COORD for the beginning of the word (selection definition) you are on
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the delimiter classes of the buffer's cells
 // Return Value:
 // - The COORD for the first character on the current word or delimiter run (stopped by the left margin)
-const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordStartForSelection(const COORD target, DelimiterClassCache& delimiters) const
 {
-    COORD result = target;
-    const auto bufferSize = GetSize();
-
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
-
     // expand left until we hit the left boundary or a different delimiter class
-    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
-    {
-        bufferSize.DecrementInBounds(result);
-    }
-
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
-    {
-        // move off of delimiter
-        bufferSize.IncrementInBounds(result);
-    }
-
+    COORD result = target;
+    result.X = delimiters.RunFirst(target);
     return result;
 }
 
@@ -1104,13 +1297,14 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
     //  so the words in the example include ["word   ", "other  "]
     // NOTE: the end anchor (this one) is exclusive, whereas the start anchor (GetWordStart) is inclusive
 
+    DelimiterClassCache delimiters{ *this, wordDelimiters };
     if (accessibilityMode)
     {
-        return _GetWordEndForAccessibility(target, wordDelimiters);
+        return _GetWordEndForAccessibility(target, delimiters);
     }
     else
     {
-        return _GetWordEndForSelection(target, wordDelimiters);
+        return _GetWordEndForSelection(target, delimiters);
     }
 }
 
@@ -1118,17 +1312,19 @@ const COORD TextBuffer::GetWordEnd(const COORD target, const std::wstring_view w
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the next READABLE word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the delimiter classes of the buffer's cells
 // Return Value:
 // - The COORD for the first character of the next readable "word". If no next word, return one past the end of the buffer
-const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, DelimiterClassCache& delimiters) const
 {
     const auto bufferSize = GetSize();
     COORD result = target;
 
     // ignore right boundary. Continue through readable text found
-    while (_GetDelimiterClassAt(result, wordDelimiters) == DelimiterClass::RegularChar)
+    while (delimiters.At(result) == DelimiterClass::RegularChar)
     {
+        // skip the rest of this run in one go
+        result.X = delimiters.RunLast(result);
         if (!bufferSize.IncrementInBounds(result, true))
         {
             break;
@@ -1136,8 +1332,9 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
     }
 
     // make sure we expand to the beginning of the NEXT word
-    while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
+    while (delimiters.At(result) != DelimiterClass::RegularChar)
     {
+        result.X = delimiters.RunLast(result);
         if (!bufferSize.IncrementInBounds(result, true))
         {
             // we are at the EndInclusive COORD
@@ -1154,34 +1351,20 @@ const COORD TextBuffer::_GetWordEndForAccessibility(const COORD target, const st
 // - Helper method for GetWordEnd(). Get the COORD for the beginning of the NEXT word
 // Arguments:
 // - target - a COORD on the word you are currently on
-// - wordDelimiters - what characters are we considering for the separation of words
+// - delimiters - the delimiter classes of the buffer's cells
 // Return Value:
 // - The COORD for the last character of the current word or delimiter run (stopped by right margin)
-const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const
+const COORD TextBuffer::_GetWordEndForSelection(const COORD target, DelimiterClassCache& delimiters) const
 {
-    const auto bufferSize = GetSize();
-
     // can't expand right
-    if (target.X == bufferSize.RightInclusive())
+    if (target.X == GetSize().RightInclusive())
     {
         return target;
     }
 
-    COORD result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
-
     // expand right until we hit the right boundary or a different delimiter class
-    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
-    {
-        bufferSize.IncrementInBounds(result);
-    }
-
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
-    {
-        // move off of delimiter
-        bufferSize.DecrementInBounds(result);
-    }
-
+    COORD result = target;
+    result.X = delimiters.RunLast(target);
     return result;
 }
 
@@ -1195,13 +1378,29 @@ const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::w
 // - true, if successfully updated pos. False, if we are unable to move (usually due to a buffer boundary)
 // - pos - The COORD for the first character on the "word" (inclusive)
 bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimiters, COORD lastCharPos) const
+{
+    DelimiterClassCache delimiters{ *this, wordDelimiters };
+    return _MoveToNextWord(pos, delimiters, lastCharPos);
+}
+
+// Method Description:
+// - Helper method for MoveToNextWord() and MoveByWords().
+// Arguments:
+// - pos - a COORD on the word you are currently on
+// - delimiters - the delimiter classes of the buffer's cells
+// - lastCharPos - the position of the last nonspace character in the text buffer (to improve performance)
+// Return Value:
+// - true, if successfully updated pos. False, if we are unable to move (usually due to a buffer boundary)
+// - pos - The COORD for the first character on the "word" (inclusive)
+bool TextBuffer::_MoveToNextWord(COORD& pos, DelimiterClassCache& delimiters, const COORD lastCharPos) const
 {
     auto copy = pos;
     const auto bufferSize = GetSize();
 
     // started on a word, continue until the end of the word
-    while (_GetDelimiterClassAt(copy, wordDelimiters) == DelimiterClass::RegularChar)
+    while (delimiters.At(copy) == DelimiterClass::RegularChar)
     {
+        copy.X = delimiters.RunLast(copy);
         if (!bufferSize.IncrementInBounds(copy))
         {
             // last char in buffer is a RegularChar
@@ -1217,8 +1416,9 @@ bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimite
     }
 
     // on whitespace, continue until the beginning of the next word
-    while (_GetDelimiterClassAt(copy, wordDelimiters) != DelimiterClass::RegularChar)
+    while (delimiters.At(copy) != DelimiterClass::RegularChar)
     {
+        copy.X = delimiters.RunLast(copy);
         if (!bufferSize.IncrementInBounds(copy))
         {
             // last char in buffer is a DelimiterChar or ControlChar
@@ -1241,13 +1441,28 @@ bool TextBuffer::MoveToNextWord(COORD& pos, const std::wstring_view wordDelimite
 // - true, if successfully updated pos. False, if we are unable to move (usually due to a buffer boundary)
 // - pos - The COORD for the first character on the "word" (inclusive)
 bool TextBuffer::MoveToPreviousWord(COORD& pos, std::wstring_view wordDelimiters) const
+{
+    DelimiterClassCache delimiters{ *this, wordDelimiters };
+    return _MoveToPreviousWord(pos, delimiters);
+}
+
+// Method Description:
+// - Helper method for MoveToPreviousWord() and MoveByWords().
+// Arguments:
+// - pos - a COORD on the word you are currently on
+// - delimiters - the delimiter classes of the buffer's cells
+// Return Value:
+// - true, if successfully updated pos. False, if we are unable to move (usually due to a buffer boundary)
+// - pos - The COORD for the first character on the "word" (inclusive)
+bool TextBuffer::_MoveToPreviousWord(COORD& pos, DelimiterClassCache& delimiters) const
 {
     auto copy = pos;
     auto bufferSize = GetSize();
 
     // started on whitespace/delimiter, continue until the end of the previous word
-    while (_GetDelimiterClassAt(copy, wordDelimiters) != DelimiterClass::RegularChar)
+    while (delimiters.At(copy) != DelimiterClass::RegularChar)
     {
+        copy.X = delimiters.RunFirst(copy);
         if (!bufferSize.DecrementInBounds(copy))
         {
             // first char in buffer is a DelimiterChar or ControlChar
@@ -1257,8 +1472,9 @@ bool TextBuffer::MoveToPreviousWord(COORD& pos, std::wstring_view wordDelimiters
     }
 
     // on a word, continue until the beginning of the word
-    while (_GetDelimiterClassAt(copy, wordDelimiters) == DelimiterClass::RegularChar)
+    while (delimiters.At(copy) == DelimiterClass::RegularChar)
     {
+        copy.X = delimiters.RunFirst(copy);
         if (!bufferSize.DecrementInBounds(copy))
         {
             // first char in buffer is a RegularChar
@@ -1272,6 +1488,76 @@ bool TextBuffer::MoveToPreviousWord(COORD& pos, std::wstring_view wordDelimiters
     return true;
 }
 
+// Method Description:
+// - Move pos by count words in one go. This is used for accessibility.
+// - This is equivalent to calling MoveToNextWord()/MoveToPreviousWord() count times,
+//   except that the delimiter classes of the rows that were visited are reused between words.
+// - Moving forward past the last word lands on the end of the document if allowBottomExclusive is set.
+//   Moving backward past the first word lands on the document origin without counting as a move.
+// Arguments:
+// - pos - a COORD on the word you are currently on
+// - count - the number of words to move. Negative values move backwards.
+// - wordDelimiters - what characters are we considering for the separation of words
+// - documentOrigin - the first position of the document that is being navigated
+// - documentEnd - the exclusive end of that document, which may end before the buffer does
+// - lastCharPos - the position of the last nonspace character in the text buffer (to improve performance)
+// - allowBottomExclusive - allow the nonexistent end-of-buffer cell to be encountered
+// Return Value:
+// - the number of words actually moved. Negative when moving backwards.
+// - pos - The COORD for the first character on the "word" (inclusive)
+int TextBuffer::MoveByWords(COORD& pos, const int count, const std::wstring_view wordDelimiters, const COORD documentOrigin, const COORD documentEnd, const COORD lastCharPos, const bool allowBottomExclusive) const
+{
+    DelimiterClassCache delimiters{ *this, wordDelimiters };
+
+    auto resultPos = pos;
+    int moved = 0;
+    bool success = true;
+    while (success && std::abs(moved) < std::abs(count))
+    {
+        auto nextPos = resultPos;
+        if (count > 0)
+        {
+            if (nextPos == documentEnd)
+            {
+                success = false;
+            }
+            else if (_MoveToNextWord(nextPos, delimiters, lastCharPos))
+            {
+                resultPos = nextPos;
+                moved++;
+            }
+            else if (allowBottomExclusive)
+            {
+                resultPos = documentEnd;
+                moved++;
+            }
+            else
+            {
+                success = false;
+            }
+        }
+        else
+        {
+            if (nextPos == documentOrigin)
+            {
+                success = false;
+            }
+            else if (_MoveToPreviousWord(nextPos, delimiters))
+            {
+                resultPos = nextPos;
+                moved--;
+            }
+            else
+            {
+                resultPos = documentOrigin;
+            }
+        }
+    }
+
+    pos = resultPos;
+    return moved;
+}
+
 // Method Description:
 // - Update pos to be the beginning of the current glyph/character. This is used for accessibility
 // Arguments:
@@ -1360,6 +1646,66 @@ bool TextBuffer::MoveToPreviousGlyph(til::point& pos, bool allowBottomExclusive)
     return success;
 }
 
+// Method Description:
+// - Move pos by count glyphs in one go. This is used for accessibility.
+// - This is equivalent to calling MoveToNextGlyph()/MoveToPreviousGlyph() count times,
+//   but it reads the double byte attributes straight out of the rows instead of
+//   constructing a cell iterator for every step.
+// Arguments:
+// - pos - a COORD on the glyph you are currently on
+// - count - the number of glyphs to move. Negative values move backwards.
+// - allowBottomExclusive - allow the nonexistent end-of-buffer cell to be encountered
+// Return Value:
+// - the number of glyphs actually moved. Negative when moving backwards.
+// - pos - The COORD for the first cell of the glyph we landed on (inclusive)
+int TextBuffer::MoveByGlyphs(til::point& pos, const int count, const bool allowBottomExclusive) const
+{
+    const auto bufferSize = GetSize();
+    const auto bufferEnd = bufferSize.EndExclusive();
+    const auto dbcsAttrAt = [this](const COORD at) -> const DbcsAttribute& {
+        return GetRowByOffset(at.Y).GetCharRow().DbcsAttrAt(at.X);
+    };
+
+    COORD resultPos = pos;
+    int moved = 0;
+    bool success = true;
+    if (count > 0)
+    {
+        while (success && moved < count)
+        {
+            success = bufferSize.IncrementInBounds(resultPos, allowBottomExclusive);
+            if (resultPos != bufferEnd && dbcsAttrAt(resultPos).IsTrailing())
+            {
+                bufferSize.IncrementInBounds(resultPos, allowBottomExclusive);
+            }
+
+            if (success)
+            {
+                moved++;
+            }
+        }
+    }
+    else
+    {
+        while (success && moved > count)
+        {
+            success = bufferSize.DecrementInBounds(resultPos, allowBottomExclusive);
+            if (resultPos != bufferEnd && dbcsAttrAt(resultPos).IsLeading())
+            {
+                bufferSize.DecrementInBounds(resultPos, allowBottomExclusive);
+            }
+
+            if (success)
+            {
+                moved--;
+            }
+        }
+    }
+
+    pos = resultPos;
+    return moved;
+}
+
 // Method Description:
 // - Determines the line-by-line rectangles based on two COORDs
 // - expands the rectangles to support wide glyphs
@@ -1583,6 +1929,52 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     return data;
 }
 
+// Routine Description:
+// - Appends the text of the given regions to a caller provided string.
+// - This produces the same text as GetText() without colors, but reads the glyphs
+//   straight out of the rows and doesn't allocate a string for every row.
+// Arguments:
+// - textRects - the rectangular regions from which the data will be extracted from the buffer
+// - includeCRLF - inject CRLF pairs to the end of each line
+// - text - receives the text. Existing contents are preserved.
+// - maxLength - stop once text has grown to this length
+// Return Value:
+// - <none>
+void TextBuffer::GetPlainText(const std::vector<SMALL_RECT>& textRects,
+                              const bool includeCRLF,
+                              std::wstring& text,
+                              const size_t maxLength) const
+{
+    for (size_t i = 0; i < textRects.size() && text.size() < maxLength; ++i)
+    {
+        const auto& rect = til::at(textRects, i);
+        const auto& charRow = GetRowByOffset(rect.Top).GetCharRow();
+
+        // copy char data into the string buffer, skipping trailing bytes
+        for (auto col = rect.Left; col <= rect.Right && text.size() < maxLength; ++col)
+        {
+            if (!charRow.DbcsAttrAt(col).IsTrailing())
+            {
+                const std::wstring_view glyph = charRow.GlyphAt(col);
+                text.append(glyph);
+            }
+        }
+
+        // apply CR/LF to the end of the final string, unless we're the last line
+        // or the row was wrapped.
+        if (includeCRLF && i < textRects.size() - 1 && !charRow.WasWrapForced())
+        {
+            text.push_back(UNICODE_CARRIAGERETURN);
+            text.push_back(UNICODE_LINEFEED);
+        }
+    }
+
+    if (text.size() > maxLength)
+    {
+        text.resize(maxLength);
+    }
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure based on the passed in text and color data
 // Arguments:
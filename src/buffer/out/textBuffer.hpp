@@ -95,6 +95,17 @@ public:
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    void WriteRun(const PrintRun& run,
+                  const COORD target,
+                  const TextAttribute attr,
+                  const std::optional<bool> wrap = true);
+
+    size_t FillCells(const COORD target,
+                     const size_t length,
+                     const std::optional<wchar_t> wch,
+                     const std::optional<TextAttribute> attr,
+                     const std::optional<bool> wrap = true);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -114,6 +125,9 @@ public:
 
     void ScrollRows(const SHORT firstRow, const SHORT size, const SHORT delta);
 
+    void InsertCells(const COORD target, const size_t count, const TextAttribute fillAttr);
+    void DeleteCells(const COORD target, const size_t count, const TextAttribute fillAttr);
+
     UINT TotalRowCount() const noexcept;
 
     [[nodiscard]] TextAttribute GetCurrentAttributes() const noexcept;
@@ -133,11 +147,13 @@ public:
     const COORD GetWordEnd(const COORD target, const std::wstring_view wordDelimiters, bool accessibilityMode = false) const;
     bool MoveToNextWord(COORD& pos, const std::wstring_view wordDelimiters, COORD lastCharPos) const;
     bool MoveToPreviousWord(COORD& pos, const std::wstring_view wordDelimiters) const;
+    int MoveByWords(COORD& pos, const int count, const std::wstring_view wordDelimiters, const COORD documentOrigin, const COORD documentEnd, const COORD lastCharPos, const bool allowBottomExclusive) const;
 
     const til::point GetGlyphStart(const til::point pos) const;
     const til::point GetGlyphEnd(const til::point pos) const;
     bool MoveToNextGlyph(til::point& pos, bool allowBottomExclusive = false) const;
     bool MoveToPreviousGlyph(til::point& pos, bool allowBottomExclusive = false) const;
+    int MoveByGlyphs(til::point& pos, const int count, const bool allowBottomExclusive = false) const;
 
     const std::vector<SMALL_RECT> GetTextRects(COORD start, COORD end, bool blockSelection = false) const;
 
@@ -154,6 +170,11 @@ public:
                                const std::vector<SMALL_RECT>& textRects,
                                std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors = nullptr) const;
 
+    void GetPlainText(const std::vector<SMALL_RECT>& textRects,
+                      const bool includeCRLF,
+                      std::wstring& text,
+                      const size_t maxLength = std::wstring::npos) const;
+
     static std::string GenHTML(const TextAndColor& rows,
                                const int fontHeightPoints,
                                const std::wstring_view fontFaceName,
@@ -189,6 +210,7 @@ private:
     UnicodeStorage _unicodeStorage;
 
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
+    void _RefreshRowIDs(const size_t first, const size_t count);
 
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
 
@@ -210,11 +232,36 @@ private:
 
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
-    const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
-    const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
+    // Word navigation walks cell by cell across potentially many rows.
+    // Instead of classifying each cell against the delimiter string as it goes,
+    // a walk classifies the row it's on once and then moves through it a whole
+    // run of same-class cells at a time.
+    // This lives on the stack of a single walk: the buffer's const methods are
+    // called under a shared lock by the Terminal, so it can't be stored in the rows.
+    class DelimiterClassCache final
+    {
+    public:
+        DelimiterClassCache(const TextBuffer& buffer, const std::wstring_view wordDelimiters);
+
+        DelimiterClass At(const COORD pos);
+        SHORT RunFirst(const COORD pos);
+        SHORT RunLast(const COORD pos);
+
+    private:
+        void _Load(const SHORT row);
+
+        const TextBuffer& _buffer;
+        const DelimiterTable _table;
+        std::optional<SHORT> _row;
+        std::vector<DelimiterClass> _classes;
+    };
+
+    const COORD _GetWordStartForAccessibility(const COORD target, DelimiterClassCache& delimiters) const;
+    const COORD _GetWordStartForSelection(const COORD target, DelimiterClassCache& delimiters) const;
+    const COORD _GetWordEndForAccessibility(const COORD target, DelimiterClassCache& delimiters) const;
+    const COORD _GetWordEndForSelection(const COORD target, DelimiterClassCache& delimiters) const;
+    bool _MoveToNextWord(COORD& pos, DelimiterClassCache& delimiters, const COORD lastCharPos) const;
+    bool _MoveToPreviousWord(COORD& pos, DelimiterClassCache& delimiters) const;
 
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../PatternIndex.hpp"
+#include "../../../renderer/inc/DummyRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace std::string_view_literals;
+using Microsoft::Console::Types::Viewport;
+
+class PatternIndexTests
+{
+    TEST_CLASS(PatternIndexTests);
+
+    DummyRenderTarget _renderTarget;
+    std::unique_ptr<TextBuffer> _buffer;
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        _buffer = std::make_unique<TextBuffer>(COORD{ 40, 5 }, TextAttribute{}, 12, _renderTarget);
+        _buffer->WriteLine(OutputCellIterator{ L"see https://example.com" }, { 0, 0 });
+        _buffer->WriteLine(OutputCellIterator{ L"nothing to see here" }, { 0, 1 });
+        _buffer->WriteLine(OutputCellIterator{ L"src/a.cpp:3: error" }, { 0, 2 });
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        _buffer.reset();
+        return true;
+    }
+
+    Viewport _AllRows() const
+    {
+        return Viewport::FromDimensions({ 0, 0 }, _buffer->GetSize().Dimensions());
+    }
+
+    static std::vector<std::wstring_view> _FindPatterns(const std::wstring_view text, const PatternKind kind)
+    {
+        std::vector<PatternSpan> spans;
+        PatternIndex::s_FindPatterns(text, spans);
+
+        std::vector<std::wstring_view> found;
+        for (const auto& span : spans)
+        {
+            if (span.kind == kind)
+            {
+                found.push_back(text.substr(span.left, span.right - span.left + 1));
+            }
+        }
+        return found;
+    }
+
+    TEST_METHOD(FindsUrls)
+    {
+        const auto found = _FindPatterns(L"see https://example.com/a?b=c, or (http://example.org/x). ftp://host/ and HTTPS://CAPS.EXAMPLE",
+                                         PatternKind::Url);
+
+        VERIFY_ARE_EQUAL(4u, found.size());
+        VERIFY_ARE_EQUAL(L"https://example.com/a?b=c"sv, found.at(0));
+        VERIFY_ARE_EQUAL(L"http://example.org/x"sv, found.at(1));
+        VERIFY_ARE_EQUAL(L"ftp://host/"sv, found.at(2));
+        VERIFY_ARE_EQUAL(L"HTTPS://CAPS.EXAMPLE"sv, found.at(3));
+    }
+
+    TEST_METHOD(KeepsBalancedParenthesesInUrls)
+    {
+        const auto found = _FindPatterns(L"https://en.wikipedia.org/wiki/Foo_(bar)", PatternKind::Url);
+
+        VERIFY_ARE_EQUAL(1u, found.size());
+        VERIFY_ARE_EQUAL(L"https://en.wikipedia.org/wiki/Foo_(bar)"sv, found.at(0));
+    }
+
+    TEST_METHOD(IgnoresThingsThatAreNotUrls)
+    {
+        VERIFY_ARE_EQUAL(0u, _FindPatterns(L"gopher://old mailto:someone https:// ://nothing", PatternKind::Url).size());
+    }
+
+    TEST_METHOD(FindsCompilerFileReferences)
+    {
+        const auto found = _FindPatterns(L"src/foo.cpp:12:5: error  C:\\src\\bar.h(34,2): warning  'baz.c(7)'  qux.rs:8",
+                                         PatternKind::FilePath);
+
+        VERIFY_ARE_EQUAL(4u, found.size());
+        VERIFY_ARE_EQUAL(L"src/foo.cpp:12:5"sv, found.at(0));
+        VERIFY_ARE_EQUAL(L"C:\\src\\bar.h(34,2)"sv, found.at(1));
+        VERIFY_ARE_EQUAL(L"baz.c(7)"sv, found.at(2));
+        VERIFY_ARE_EQUAL(L"qux.rs:8"sv, found.at(3));
+    }
+
+    TEST_METHOD(IgnoresThingsThatAreNotFileReferences)
+    {
+        VERIFY_ARE_EQUAL(0u, _FindPatterns(L"error:12 12:30 foo.cpp: foo.cpp(bar) foo.cpp(12", PatternKind::FilePath).size());
+    }
+
+    TEST_METHOD(ReportsColumns)
+    {
+        std::vector<PatternSpan> spans;
+        PatternIndex::s_FindPatterns(L"  a.c:1 http://x", spans);
+
+        VERIFY_ARE_EQUAL(2u, spans.size());
+        VERIFY_ARE_EQUAL(2u, spans.at(0).left);
+        VERIFY_ARE_EQUAL(6u, spans.at(0).right);
+        VERIFY_ARE_EQUAL(8u, spans.at(1).left);
+        VERIFY_ARE_EQUAL(15u, spans.at(1).right);
+    }
+
+    TEST_METHOD(UpdateOnlyRescansChangedRows)
+    {
+        PatternIndex index;
+
+        Log::Comment(L"The first update has to scan every row it's given.");
+        VERIFY_ARE_EQUAL(2u, index.Update(*_buffer, Viewport::FromDimensions({ 0, 0 }, { 40, 2 })));
+        VERIFY_ARE_EQUAL(3u, index.Update(*_buffer, _AllRows()));
+
+        Log::Comment(L"Nothing changed, so nothing is scanned again.");
+        VERIFY_ARE_EQUAL(0u, index.Update(*_buffer, _AllRows()));
+
+        Log::Comment(L"Writing to a row rescans just that row.");
+        _buffer->WriteLine(OutputCellIterator{ L"now http://example.org" }, { 0, 1 });
+        VERIFY_ARE_EQUAL(1u, index.Update(*_buffer, _AllRows()));
+        VERIFY_ARE_EQUAL(0u, index.Update(*_buffer, _AllRows()));
+
+        const auto found = index.FindAt(*_buffer, { 10, 1 });
+        VERIFY_IS_TRUE(found.has_value());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 4, 1, 21, 1 }), *found);
+    }
+
+    TEST_METHOD(WritesScrollsAndCirclingChangeTheGeneration)
+    {
+        Log::Comment(L"Writing text bumps the generation of the row written to.");
+        const auto before = _buffer->GetRowByOffset(3).GetCharRow().GetGeneration();
+        _buffer->WriteLine(OutputCellIterator{ L"x" }, { 0, 3 });
+        VERIFY_ARE_NOT_EQUAL(before, _buffer->GetRowByOffset(3).GetCharRow().GetGeneration());
+
+        PatternIndex index;
+        VERIFY_ARE_EQUAL(5u, index.Update(*_buffer, _AllRows()));
+
+        Log::Comment(L"Scrolling a region rescans the rows that moved, and only those.");
+        _buffer->ScrollRows(2, 1, -1);
+        VERIFY_ARE_EQUAL(2u, index.Update(*_buffer, _AllRows()));
+        const auto moved = index.FindAt(*_buffer, { 0, 1 });
+        VERIFY_IS_TRUE(moved.has_value());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 1, 10, 1 }), *moved);
+        VERIFY_IS_FALSE(index.FindAt(*_buffer, { 0, 2 }).has_value());
+
+        Log::Comment(L"Circling the buffer only rescans the row that was recycled.");
+        VERIFY_IS_TRUE(_buffer->IncrementCircularBuffer());
+        VERIFY_ARE_EQUAL(1u, index.Update(*_buffer, _AllRows()));
+        VERIFY_IS_FALSE(index.FindAt(*_buffer, { 5, 4 }).has_value());
+        const auto circled = index.FindAt(*_buffer, { 0, 0 });
+        VERIFY_IS_TRUE(circled.has_value());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 0, 10, 0 }), *circled);
+    }
+
+    TEST_METHOD(StaleRowsHaveNoPatterns)
+    {
+        PatternIndex index;
+        index.Update(*_buffer, _AllRows());
+
+        const auto found = index.FindAt(*_buffer, { 5, 0 });
+        VERIFY_IS_TRUE(found.has_value());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 4, 0, 22, 0 }), *found);
+        VERIFY_IS_FALSE(index.FindAt(*_buffer, { 2, 0 }).has_value());
+
+        Log::Comment(L"Once the row changed, its old patterns aren't reported until it's scanned again.");
+        _buffer->WriteLine(OutputCellIterator{ L"see https://example.org" }, { 0, 0 });
+        VERIFY_IS_FALSE(index.FindAt(*_buffer, { 5, 0 }).has_value());
+        VERIFY_IS_TRUE(index.FindAt(*_buffer, { 0, 2 }).has_value());
+
+        VERIFY_ARE_EQUAL(1u, index.Update(*_buffer, _AllRows()));
+        VERIFY_IS_TRUE(index.FindAt(*_buffer, { 5, 0 }).has_value());
+    }
+
+    TEST_METHOD(InvalidateRescansEverything)
+    {
+        PatternIndex index;
+        VERIFY_ARE_EQUAL(5u, index.Update(*_buffer, _AllRows()));
+
+        index.Invalidate();
+        VERIFY_IS_FALSE(index.FindAt(*_buffer, { 5, 0 }).has_value());
+        VERIFY_ARE_EQUAL(5u, index.Update(*_buffer, _AllRows()));
+        VERIFY_IS_TRUE(index.FindAt(*_buffer, { 5, 0 }).has_value());
+    }
+};
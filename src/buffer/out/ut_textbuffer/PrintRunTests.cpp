@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../PrintRun.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace std::string_view_literals;
+
+class PrintRunTests
+{
+    TEST_CLASS(PrintRunTests);
+
+    TEST_METHOD(AsciiIsNotSplitIntoGlyphs)
+    {
+        PrintRun run;
+        run.Compile(L"hello world", 80);
+
+        VERIFY_ARE_EQUAL(L"hello world"sv, run.Text());
+        VERIFY_ARE_EQUAL(L"hello world"sv, run.AsciiPrefix());
+        VERIFY_ARE_EQUAL(11u, run.Columns());
+        VERIFY_IS_TRUE(run.Glyphs().empty());
+
+        Log::Comment(L"Only as much as fits in the columns is compiled.");
+        run.Compile(L"hello world", 5);
+        VERIFY_ARE_EQUAL(L"hello"sv, run.Text());
+        VERIFY_ARE_EQUAL(5u, run.Columns());
+    }
+
+    TEST_METHOD(MeasuresWideGlyphs)
+    {
+        PrintRun run;
+        run.Compile(L"ab\x3042" L"c", 80);
+
+        VERIFY_ARE_EQUAL(L"ab"sv, run.AsciiPrefix());
+        VERIFY_ARE_EQUAL(5u, run.Columns());
+        VERIFY_ARE_EQUAL(2u, run.Glyphs().size());
+
+        const auto& wide = run.Glyphs().at(0);
+        VERIFY_ARE_EQUAL(L"\x3042"sv, wide.chars);
+        VERIFY_ARE_EQUAL(2u, wide.columns);
+        VERIFY_IS_TRUE(wide.dbcsAttr.IsLeading());
+
+        const auto& narrow = run.Glyphs().at(1);
+        VERIFY_ARE_EQUAL(L"c"sv, narrow.chars);
+        VERIFY_ARE_EQUAL(1u, narrow.columns);
+        VERIFY_IS_TRUE(narrow.dbcsAttr.IsSingle());
+
+        Log::Comment(L"A wide glyph that doesn't fit in the last column ends the run.");
+        run.Compile(L"ab\x3042" L"c", 3);
+        VERIFY_ARE_EQUAL(L"ab"sv, run.Text());
+        VERIFY_ARE_EQUAL(2u, run.Columns());
+    }
+
+    TEST_METHOD(KeepsSurrogatePairsTogether)
+    {
+        PrintRun run;
+        run.Compile(L"\xD83D\xDE00x", 80);
+
+        VERIFY_ARE_EQUAL(3u, run.Text().size());
+        VERIFY_ARE_EQUAL(2u, run.Glyphs().size());
+        VERIFY_ARE_EQUAL(L"\xD83D\xDE00"sv, run.Glyphs().at(0).chars);
+        VERIFY_ARE_EQUAL(2u, run.Glyphs().at(0).columns);
+
+        Log::Comment(L"A surrogate on its own becomes a replacement character.");
+        run.Compile(L"\xD83Dx", 80);
+        VERIFY_ARE_EQUAL(2u, run.Text().size());
+        VERIFY_ARE_EQUAL(2u, run.Columns());
+        VERIFY_ARE_EQUAL(std::wstring_view(&UNICODE_REPLACEMENT, 1), run.Glyphs().at(0).chars);
+    }
+
+    TEST_METHOD(StopsAtControlCharactersWhenAsked)
+    {
+        PrintRun run;
+        run.Compile(L"ab\r\ncd", 80, true);
+        VERIFY_ARE_EQUAL(L"ab"sv, run.Text());
+
+        run.Compile(L"\tab", 80, true);
+        VERIFY_IS_TRUE(run.empty());
+
+        Log::Comment(L"Otherwise they're printed like anything else.");
+        run.Compile(L"ab\r\ncd", 80);
+        VERIFY_ARE_EQUAL(L"ab\r\ncd"sv, run.Text());
+        VERIFY_ARE_EQUAL(6u, run.Columns());
+    }
+};
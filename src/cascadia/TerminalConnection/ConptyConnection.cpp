@@ -205,8 +205,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         _environment{ environment },
         _guid{ initialGuid },
         _u8State{},
-        _u16Str{},
-        _buffer{}
+        _buffer{},
+        _u16Buffer{}
     {
         if (_guid == guid{})
         {
@@ -408,44 +408,59 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                 // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
             }
 
-            const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
-            if (FAILED(result))
+            // Convert straight into our own buffer, as often as it takes to make room for all of the output.
+            std::string_view output{ _buffer.data(), read };
+            do
             {
-                if (_isStateAtOrBeyond(ConnectionState::Closing))
+                size_t consumed{};
+                size_t produced{};
+                const HRESULT result{ til::u8u16(output, _u16Buffer, _u8State, consumed, produced) };
+                if (FAILED(result))
                 {
-                    // This termination was expected.
-                    return 0;
+                    if (_isStateAtOrBeyond(ConnectionState::Closing))
+                    {
+                        // This termination was expected.
+                        return 0;
+                    }
+
+                    // EXIT POINT
+                    _indicateExitWithStatus(result); // print a message
+                    _transitionToState(ConnectionState::Failed);
+                    return gsl::narrow_cast<DWORD>(result);
                 }
 
-                // EXIT POINT
-                _indicateExitWithStatus(result); // print a message
-                _transitionToState(ConnectionState::Failed);
-                return gsl::narrow_cast<DWORD>(result);
-            }
+                if (produced == 0)
+                {
+                    if (read == 0)
+                    {
+                        return 0;
+                    }
 
-            if (_u16Str.empty())
-            {
-                return 0;
-            }
+                    // all that was read is the start of a code point, which waits in _u8State for the rest of it
+                    break;
+                }
 
-            if (!_receivedFirstByte)
-            {
-                const auto now = std::chrono::high_resolution_clock::now();
-                const std::chrono::duration<double> delta = now - _startTime;
+                output.remove_prefix(consumed);
+
+                if (!_receivedFirstByte)
+                {
+                    const auto now = std::chrono::high_resolution_clock::now();
+                    const std::chrono::duration<double> delta = now - _startTime;
 
 #pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
-                TraceLoggingWrite(g_hTerminalConnectionProvider,
-                                  "ReceivedFirstByte",
-                                  TraceLoggingDescription("An event emitted when the connection receives the first byte"),
-                                  TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
-                                  TraceLoggingFloat64(delta.count(), "Duration"),
-                                  TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-                                  TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
-                _receivedFirstByte = true;
-            }
+                    TraceLoggingWrite(g_hTerminalConnectionProvider,
+                                      "ReceivedFirstByte",
+                                      TraceLoggingDescription("An event emitted when the connection receives the first byte"),
+                                      TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
+                                      TraceLoggingFloat64(delta.count(), "Duration"),
+                                      TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                                      TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+                    _receivedFirstByte = true;
+                }
 
-            // Pass the output to our registered event handlers
-            _TerminalOutputHandlers(_u16Str);
+                // Pass the output to our registered event handlers
+                _TerminalOutputHandlers(winrt::hstring{ std::wstring_view{ _u16Buffer.data(), produced } });
+            } while (!output.empty());
         }
 
         return 0;
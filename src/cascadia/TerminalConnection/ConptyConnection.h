@@ -62,8 +62,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_threadpool_wait _clientExitWait;
 
         til::u8state _u8State;
-        std::wstring _u16Str;
         std::array<char, 4096> _buffer;
+        std::array<wchar_t, 4096> _u16Buffer;
 
         DWORD _OutputThread();
     };
@@ -34,6 +34,13 @@ constexpr const auto ScrollBarUpdateInterval = std::chrono::milliseconds(8);
 // The minimum delay between updating the TSF input control.
 constexpr const auto TsfRedrawInterval = std::chrono::milliseconds(100);
 
+// The minimum delay between looking for URLs and file paths in new output.
+constexpr const auto UpdatePatternsInterval = std::chrono::milliseconds(250);
+
+// The length of a frame of coalesced mouse input. Mouse moves and wheel
+// events within a frame are reported to the application at most twice.
+constexpr const auto MouseInputFlushInterval = std::chrono::milliseconds(16);
+
 namespace winrt::Microsoft::Terminal::TerminalControl::implementation
 {
     // Helper static function to ensure that all ambiguous-width glyphs are reported as narrow.
@@ -102,12 +109,40 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         // This event is explicitly revoked in the destructor: does not need weak_ref
         auto onReceiveOutputFn = [this](const hstring str) {
             _terminal->Write(str);
+            _updatePatterns->Run();
         };
         _connectionOutputEventToken = _connection.TerminalOutput(onReceiveOutputFn);
 
+        // The pump writes on its own thread, and may outlive a write to a
+        // closed connection; hold on to the connection rather than to this.
+        _pastePump = std::make_unique<::Microsoft::Terminal::Core::PastePump>([connection = _connection](const std::wstring_view chunk) {
+            connection.WriteInput(winrt::hstring{ chunk });
+        });
+        _pastePump->SetProgressCallback([](const size_t written, const size_t total) {
+            TraceLoggingWrite(
+                g_hTerminalControlProvider,
+                "PasteProgress",
+                TraceLoggingDescription("Event emitted after each chunk of a paste is written to the connection"),
+                TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(written), "Written"),
+                TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(total), "Total"),
+                TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+        });
+
         auto inputFn = std::bind(&TermControl::_SendInputToConnection, this, std::placeholders::_1);
         _terminal->SetWriteInputCallback(inputFn);
 
+        // Any-event mouse tracking with a high-rate mouse would otherwise
+        // write a sequence for every single move. _flushMouseInput ends
+        // each frame of coalesced input.
+        _terminal->EnableMouseInputCoalescing(true);
+
+        // Measuring keystroke latency is only worth its (small) cost when
+        // someone's listening for the results, which are traced on Close.
+        if (TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, 0))
+        {
+            _terminal->EnableInputLatencyTracking(true);
+        }
+
         _terminal->UpdateSettings(settings);
 
         // Subscribe to the connection's disconnected event and call our connection closed handlers.
@@ -161,6 +196,39 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
             ScrollBarUpdateInterval,
             Dispatcher());
 
+        // Pattern detection happens here on the UI thread, rather than on the
+        // render thread, and only looks at rows that changed since last time.
+        _updatePatterns = std::make_shared<ThrottledFunc<>>(
+            [weakThis = get_weak()]() {
+                if (auto control{ weakThis.get() })
+                {
+                    if (control->_closing)
+                    {
+                        return;
+                    }
+
+                    auto lock = control->_terminal->LockForWriting();
+                    control->_terminal->UpdatePatterns();
+                }
+            },
+            UpdatePatternsInterval,
+            Dispatcher());
+
+        _flushMouseInput = std::make_shared<ThrottledFunc<>>(
+            [weakThis = get_weak()]() {
+                if (auto control{ weakThis.get() })
+                {
+                    if (control->_closing)
+                    {
+                        return;
+                    }
+
+                    control->_terminal->FlushPendingMouseInput();
+                }
+            },
+            MouseInputFlushInterval,
+            Dispatcher());
+
         static constexpr auto AutoScrollUpdateInterval = std::chrono::microseconds(static_cast<int>(1.0 / 30.0 * 1000000));
         _autoScrollTimer.Interval(AutoScrollUpdateInterval);
         _autoScrollTimer.Tick({ this, &TermControl::_UpdateAutoScroll });
@@ -611,6 +679,11 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
                 }
             });
 
+            // The renderer is torn down in Close, before the terminal is.
+            _renderer->SetFramePresentedCallback([terminal = _terminal.get()]() {
+                terminal->NotifyFramePresented();
+            });
+
             THROW_IF_FAILED(localPointerToThread->Initialize(_renderer.get()));
 
             // Set up the DX Engine
@@ -1001,7 +1074,20 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         }
 
         const auto modifiers = _GetPressedModifierKeys();
-        return _terminal->SendMouseEvent(terminalPosition, uiButton, modifiers, sWheelDelta);
+        const auto handled = _terminal->SendMouseEvent(terminalPosition, uiButton, modifiers, sWheelDelta);
+        _ScheduleMouseInputFlush();
+        return handled;
+    }
+
+    // Method Description:
+    // - Makes sure that mouse input the terminal is holding back for
+    //   coalescing gets written at the end of the frame.
+    void TermControl::_ScheduleMouseInputFlush()
+    {
+        if (_terminal->NeedsMouseInputFlush())
+        {
+            _flushMouseInput->Run();
+        }
     }
 
     // Method Description:
@@ -1225,6 +1311,12 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
                     _TryStopAutoScroll(ptr.PointerId());
                 }
             }
+            else
+            {
+                // Underline the URL or file path under the pointer, if there is one.
+                auto lock = _terminal->LockForWriting();
+                _terminal->SetHoveredCell(_GetTerminalPosition(point.Position()));
+            }
         }
         else if (ptr.PointerDeviceType() == Windows::Devices::Input::PointerDeviceType::Touch && _touchAnchor)
         {
@@ -1261,6 +1353,24 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         args.Handled(true);
     }
 
+    // Method Description:
+    // - Event handler for the PointerExited event. Stops underlining whatever
+    //   pattern the pointer was over.
+    // Arguments:
+    // - sender: the XAML element responding to the pointer input
+    // - args: event data
+    void TermControl::_PointerExitedHandler(Windows::Foundation::IInspectable const& /*sender*/,
+                                            Input::PointerRoutedEventArgs const& /*args*/)
+    {
+        if (_closing)
+        {
+            return;
+        }
+
+        auto lock = _terminal->LockForWriting();
+        _terminal->SetHoveredCell(std::nullopt);
+    }
+
     // Method Description:
     // - Event handler for the PointerReleased event. We use this to de-anchor
     //   touch events, to stop scrolling via touch.
@@ -1360,10 +1470,12 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
             // here with a PointerPoint. However, as of #979, we don't have a
             // PointerPoint to work with. So, we're just going to do a
             // mousewheel event manually
-            return _terminal->SendMouseEvent(_GetTerminalPosition(point),
-                                             WM_MOUSEWHEEL,
-                                             _GetPressedModifierKeys(),
-                                             ::base::saturated_cast<short>(delta));
+            const auto handled = _terminal->SendMouseEvent(_GetTerminalPosition(point),
+                                                           WM_MOUSEWHEEL,
+                                                           _GetPressedModifierKeys(),
+                                                           ::base::saturated_cast<short>(delta));
+            _ScheduleMouseInputFlush();
+            return handled;
         }
 
         const auto ctrlPressed = modifiers.IsCtrlPressed();
@@ -1755,36 +1867,27 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
     // - <none>
     void TermControl::_SendInputToConnection(const std::wstring& wstr)
     {
-        _connection.WriteInput(wstr);
+        _pastePump->Write(wstr);
     }
 
     // Method Description:
-    // - Pre-process text pasted (presumably from the clipboard)
-    //   before sending it over the terminal's connection, converting
-    //   Windows-space \r\n line-endings to \r line-endings
+    // - Sends text pasted (presumably from the clipboard) over the terminal's
+    //   connection. The paste pump converts Windows-space \r\n line-endings
+    //   to \r line-endings, brackets the text if the application asked for
+    //   bracketed pastes, and writes it in chunks on a background thread.
+    // Arguments:
+    // - wstr: the pasted text.
+    // Return Value:
+    // - <none>
     void TermControl::_SendPastedTextToConnection(const std::wstring& wstr)
     {
-        // Some notes on this implementation:
-        //
-        // - std::regex can do this in a single line, but is somewhat
-        //   overkill for a simple search/replace operation (and its
-        //   performance guarantees aren't exactly stellar)
-        // - The STL doesn't have a simple string search/replace method.
-        //   This fact is lamentable.
-        // - This line-ending conversion is intentionally fairly
-        //   conservative, to avoid stripping out lone \n characters
-        //   where they could conceivably be intentional.
-
-        std::wstring stripped{ wstr };
-
-        std::wstring::size_type pos = 0;
-
-        while ((pos = stripped.find(L"\r\n", pos)) != std::wstring::npos)
+        bool bracketed = false;
         {
-            stripped.replace(pos, 2, L"\r");
+            auto lock = _terminal->LockForReading();
+            bracketed = _terminal->IsXtermBracketedPasteModeEnabled();
         }
 
-        _connection.WriteInput(stripped);
+        _pastePump->Paste(wstr, bracketed);
         _terminal->TrySnapOnInput();
     }
 
@@ -2088,6 +2191,9 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
         update.newValue = viewTop;
 
         _updateScrollBar->Run(update);
+
+        // Rows that just scrolled into view may not have been scanned yet.
+        _updatePatterns->Run();
     }
 
     // Method Description:
@@ -2216,6 +2322,48 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
             TSFInputControl().Close(); // Disconnect the TSF input control so it doesn't receive EditContext events.
             _autoScrollTimer.Stop();
 
+            // Don't keep feeding a paste to a connection that's going away.
+            _pastePump->Cancel();
+
+            const auto mouseMetrics = _terminal->GetMouseInputMetrics();
+            if (mouseMetrics.eventsSent != 0)
+            {
+                TraceLoggingWrite(
+                    g_hTerminalControlProvider,
+                    "MouseInputCoalesced",
+                    TraceLoggingDescription("Event emitted when a control is closed, with how much mouse input was reported to the application"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(mouseMetrics.eventsSent), "EventsSent"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(mouseMetrics.eventsDropped), "EventsDropped"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(mouseMetrics.eventsMerged), "EventsMerged"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(mouseMetrics.writes), "Writes"),
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+            }
+
+            const auto latency = _terminal->GetInputLatencyStatistics();
+            if (latency.keyToBuffer.samples != 0)
+            {
+                using namespace std::chrono;
+                const auto us = [](const auto duration) {
+                    return gsl::narrow_cast<uint64_t>(duration_cast<microseconds>(duration).count());
+                };
+                TraceLoggingWrite(
+                    g_hTerminalControlProvider,
+                    "InputLatency",
+                    TraceLoggingDescription("Event emitted when a control is closed, with the time it took keys to be echoed into the buffer and painted, in microseconds"),
+                    TraceLoggingUInt64(latency.inputs, "Keys"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(latency.keyToBuffer.samples), "KeyToBufferSamples"),
+                    TraceLoggingUInt64(us(latency.keyToBuffer.p50), "KeyToBufferP50"),
+                    TraceLoggingUInt64(us(latency.keyToBuffer.p90), "KeyToBufferP90"),
+                    TraceLoggingUInt64(us(latency.keyToBuffer.p99), "KeyToBufferP99"),
+                    TraceLoggingUInt64(us(latency.keyToBuffer.max), "KeyToBufferMax"),
+                    TraceLoggingUInt64(gsl::narrow_cast<uint64_t>(latency.keyToPaint.samples), "KeyToPaintSamples"),
+                    TraceLoggingUInt64(us(latency.keyToPaint.p50), "KeyToPaintP50"),
+                    TraceLoggingUInt64(us(latency.keyToPaint.p90), "KeyToPaintP90"),
+                    TraceLoggingUInt64(us(latency.keyToPaint.p99), "KeyToPaintP99"),
+                    TraceLoggingUInt64(us(latency.keyToPaint.max), "KeyToPaintMax"),
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+            }
+
             // GH#1996 - Close the connection asynchronously on a background
             // thread.
             // Since TermControl::Close is only ever triggered by the UI, we
@@ -2545,7 +2693,7 @@ namespace winrt::Microsoft::Terminal::TerminalControl::implementation
             return;
         }
 
-        _connection.WriteInput(text);
+        _pastePump->Write(text);
     }
 
     // Method Description:
@@ -24,6 +24,7 @@ namespace Microsoft::Terminal::Core
 
         virtual bool SetCursorPosition(short x, short y) noexcept = 0;
         virtual COORD GetCursorPosition() noexcept = 0;
+        virtual COORD GetBufferSize() noexcept = 0;
         virtual bool SetCursorVisibility(const bool visible) noexcept = 0;
         virtual bool CursorLineFeed(const bool withReturn) noexcept = 0;
         virtual bool EnableCursorBlinking(const bool enable) noexcept = 0;
@@ -53,6 +54,7 @@ namespace Microsoft::Terminal::Core
         virtual bool EnableButtonEventMouseMode(const bool enabled) noexcept = 0;
         virtual bool EnableAnyEventMouseMode(const bool enabled) noexcept = 0;
         virtual bool EnableAlternateScrollMode(const bool enabled) noexcept = 0;
+        virtual bool EnableXtermBracketedPasteMode(const bool enabled) noexcept = 0;
 
         virtual bool IsVtInputEnabled() const = 0;
 
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "InputLatencyTracker.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+// Method Description:
+// - Turns tracking on or off. Turning it off forgets anything that's pending,
+//   but keeps the samples collected so far.
+// Arguments:
+// - enable - true to start tracking.
+void InputLatencyTracker::Enable(const bool enable)
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    _enabled = enable;
+    _awaitingEcho.clear();
+    _awaitingPaint.clear();
+}
+
+bool InputLatencyTracker::IsEnabled() const noexcept
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Records that a key is about to be written to the connection. This must
+//   happen before it's written, since its echo can reach the buffer before
+//   the write even returns.
+// Arguments:
+// - time - when the key was handled, before it was written.
+// Return Value:
+// - the sequence number of the input, to be passed to RetractInput if the key
+//   doesn't get written after all. 0 while tracking is off.
+uint64_t InputLatencyTracker::MarkInput(const clock::time_point time)
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock{ _mutex };
+    if (_awaitingEcho.size() == MaxPendingInputs)
+    {
+        _awaitingEcho.pop_front();
+    }
+    _awaitingEcho.push_back({ ++_lastSequence, time });
+    return _lastSequence;
+}
+
+// Method Description:
+// - Forgets an input that was marked, but turned out not to be written.
+// Arguments:
+// - sequence - the sequence number MarkInput returned for it.
+void InputLatencyTracker::RetractInput(const uint64_t sequence)
+{
+    if (sequence == 0)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{ _mutex };
+    const auto matches = [=](const PendingInput& input) { return input.sequence == sequence; };
+    _awaitingEcho.erase(std::remove_if(_awaitingEcho.begin(), _awaitingEcho.end(), matches), _awaitingEcho.end());
+    _awaitingPaint.erase(std::remove_if(_awaitingPaint.begin(), _awaitingPaint.end(), matches), _awaitingPaint.end());
+    if (sequence == _lastSequence)
+    {
+        --_lastSequence;
+    }
+}
+
+// Method Description:
+// - Records that output was written to the buffer. Every input that was
+//   waiting for its echo is considered echoed, and now waits to be painted.
+// Arguments:
+// - time - when the output was done being processed.
+void InputLatencyTracker::MarkBufferUpdated(const clock::time_point time)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{ _mutex };
+    for (const auto& input : _awaitingEcho)
+    {
+        _keyToBuffer.Add(time - input.sent);
+        if (_awaitingPaint.size() == MaxPendingInputs)
+        {
+            _awaitingPaint.pop_front();
+        }
+        _awaitingPaint.push_back(input);
+    }
+    _awaitingEcho.clear();
+}
+
+// Method Description:
+// - Records that a frame was presented. Every input whose echo was in the
+//   buffer is considered to be on screen now.
+// Arguments:
+// - time - when the frame was presented.
+void InputLatencyTracker::MarkPainted(const clock::time_point time)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{ _mutex };
+    for (const auto& input : _awaitingPaint)
+    {
+        _keyToPaint.Add(time - input.sent);
+    }
+    _awaitingPaint.clear();
+}
+
+// Method Description:
+// - Computes the percentiles of the samples collected so far.
+// Return Value:
+// - the key-to-buffer and key-to-paint percentiles.
+InputLatencyTracker::Statistics InputLatencyTracker::GetStatistics() const
+{
+    std::vector<clock::duration> keyToBuffer;
+    std::vector<clock::duration> keyToPaint;
+    Statistics statistics;
+
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        keyToBuffer = _keyToBuffer.samples;
+        keyToPaint = _keyToPaint.samples;
+        statistics.inputs = _lastSequence;
+    }
+
+    statistics.keyToBuffer = s_ComputePercentiles(std::move(keyToBuffer));
+    statistics.keyToPaint = s_ComputePercentiles(std::move(keyToPaint));
+    return statistics;
+}
+
+// Method Description:
+// - Forgets all samples and pending inputs.
+void InputLatencyTracker::Reset()
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    _lastSequence = 0;
+    _awaitingEcho.clear();
+    _awaitingPaint.clear();
+    _keyToBuffer = {};
+    _keyToPaint = {};
+}
+
+// Routine Description:
+// - Computes the nearest-rank percentiles of a set of samples.
+// Arguments:
+// - samples - the samples, in any order.
+// Return Value:
+// - the percentiles. They're all zero if there are no samples.
+InputLatencyTracker::Percentiles InputLatencyTracker::s_ComputePercentiles(std::vector<clock::duration> samples)
+{
+    Percentiles percentiles;
+    percentiles.samples = samples.size();
+    if (samples.empty())
+    {
+        return percentiles;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // The smallest sample that's at least as large as the given percentage
+    // of all the samples.
+    const auto rank = [&](const size_t percent) {
+        const auto index = (percent * samples.size() + 99) / 100;
+        return til::at(samples, std::max<size_t>(index, 1) - 1);
+    };
+
+    percentiles.p50 = rank(50);
+    percentiles.p90 = rank(90);
+    percentiles.p99 = rank(99);
+    percentiles.max = samples.back();
+    return percentiles;
+}
+
+// Method Description:
+// - Adds a sample, replacing the oldest one once the ring is full.
+// Arguments:
+// - sample - the latency to add.
+void InputLatencyTracker::SampleRing::Add(const clock::duration sample)
+{
+    if (samples.size() < MaxSamples)
+    {
+        samples.push_back(sample);
+        return;
+    }
+
+    til::at(samples, next) = sample;
+    next = (next + 1) % MaxSamples;
+}
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// Module Name:
+// - InputLatencyTracker.hpp
+//
+// Abstract:
+// - Measures how long it takes for a key to show up on screen. Every key
+//   that's written to the connection is stamped with the time it was sent and
+//   a sequence number. The next output that reaches the buffer is taken to be
+//   its echo (key-to-buffer), and the next frame presented after that is the
+//   one that shows it (key-to-paint).
+// - The input and its echo can't be matched up exactly, since they go through
+//   ConPTY and the client application, so this is meant to be used with an
+//   application that echoes what's typed, like a shell at its prompt.
+// - Only the most recent samples are kept. Tracking is off by default, and
+//   costs a single check per event while it's off.
+
+#pragma once
+
+namespace Microsoft::Terminal::Core
+{
+    class InputLatencyTracker;
+}
+
+#ifdef UNIT_TESTING
+namespace TerminalCoreUnitTests
+{
+    class InputLatencyTrackerTests;
+};
+#endif
+
+class Microsoft::Terminal::Core::InputLatencyTracker final
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    // The number of samples of each kind that are kept.
+    static constexpr size_t MaxSamples = 1024;
+    // Inputs that never get an echo are forgotten after this many more.
+    static constexpr size_t MaxPendingInputs = 256;
+
+    struct Percentiles
+    {
+        size_t samples{ 0 };
+        clock::duration p50{};
+        clock::duration p90{};
+        clock::duration p99{};
+        clock::duration max{};
+    };
+
+    struct Statistics
+    {
+        Percentiles keyToBuffer;
+        Percentiles keyToPaint;
+        uint64_t inputs{ 0 }; // the sequence number of the last input
+    };
+
+    InputLatencyTracker() = default;
+
+    void Enable(const bool enable);
+    bool IsEnabled() const noexcept;
+
+    uint64_t MarkInput(const clock::time_point time = clock::now());
+    void RetractInput(const uint64_t sequence);
+    void MarkBufferUpdated(const clock::time_point time = clock::now());
+    void MarkPainted(const clock::time_point time = clock::now());
+
+    Statistics GetStatistics() const;
+    void Reset();
+
+    static Percentiles s_ComputePercentiles(std::vector<clock::duration> samples);
+
+private:
+    struct PendingInput
+    {
+        uint64_t sequence;
+        clock::time_point sent;
+    };
+
+    // A fixed number of the latest samples, oldest overwritten first.
+    struct SampleRing
+    {
+        std::vector<clock::duration> samples;
+        size_t next{ 0 };
+
+        void Add(const clock::duration sample);
+    };
+
+    std::atomic<bool> _enabled{ false };
+
+    // The UI thread marks input, the connection's output thread marks the
+    // buffer and the render thread marks paints, so all of this is guarded.
+    mutable std::mutex _mutex;
+    uint64_t _lastSequence{ 0 };
+    std::deque<PendingInput> _awaitingEcho;
+    std::deque<PendingInput> _awaitingPaint;
+    SampleRing _keyToBuffer;
+    SampleRing _keyToPaint;
+
+#ifdef UNIT_TESTING
+    friend class TerminalCoreUnitTests::InputLatencyTrackerTests;
+#endif
+};
@@ -0,0 +1,304 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "PastePump.hpp"
+
+using namespace Microsoft::Terminal::Core;
+
+// Constructor Description:
+// - Creates a pump that writes input with the given callback. The background
+//   thread is only started by the first paste.
+// Arguments:
+// - pfnWrite - writes input to the connection. It's called on the background
+//   thread, and may block until the connection has room for more.
+// - chunkSize - the largest piece of a paste to write at once, in characters.
+PastePump::PastePump(WriteCallback pfnWrite, const size_t chunkSize) :
+    _pfnWrite{ std::move(pfnWrite) },
+    _pfnProgress{ nullptr },
+    _chunkSize{ std::max<size_t>(chunkSize, 2) },
+    _queue{},
+    _busy{ false },
+    _pasting{ false },
+    _exitRequested{ false },
+    _exited{ false },
+    _cancelRequested{ false }
+{
+}
+
+// Destructor Description:
+// - Drops whatever hasn't been written yet and waits for the background thread
+//   to finish the chunk it's writing. A bracketed paste that was cut short
+//   still gets its end marker, unless writing it blocks as well.
+// - A write that blocks because the connection doesn't take any more input
+//   (for instance when the application stopped reading it) is cancelled.
+PastePump::~PastePump()
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    _exitRequested = true;
+    _cancelRequested = true;
+    _queue.clear();
+    _workAvailable.notify_all();
+
+    if (!_thread.joinable())
+    {
+        return;
+    }
+
+    // Give the current write a moment to finish on its own. After that, keep
+    // cancelling whatever the thread is blocked on until it's done: a single
+    // cancellation could happen just before it starts its next write.
+    while (!_idle.wait_for(lock, std::chrono::milliseconds{ 10 }, [this]() { return _exited; }))
+    {
+        CancelSynchronousIo(_thread.native_handle());
+    }
+
+    lock.unlock();
+    _thread.join();
+}
+
+// Method Description:
+// - Sets the callback that's told how far along a paste is, after every chunk.
+//   It's called on the background thread. Set it before pasting.
+// Arguments:
+// - pfn - called with the number of characters of the paste written so far,
+//   and the total.
+void PastePump::SetProgressCallback(ProgressCallback pfn)
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    _pfnProgress.swap(pfn);
+}
+
+// Method Description:
+// - Queues text to be pasted. It's filtered (see s_FilterPaste) right away,
+//   and written in chunks on the background thread.
+// Arguments:
+// - text - the text to paste.
+// - bracketed - true if the application asked for bracketed pastes, in which
+//   case the text is surrounded with the bracketed paste markers.
+void PastePump::Paste(const std::wstring_view text, const bool bracketed)
+{
+    auto filtered = s_FilterPaste(text, bracketed);
+    if (filtered.empty() && !bracketed)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        _EnsureThread();
+        _queue.push_back({ std::move(filtered), true, bracketed });
+    }
+    _workAvailable.notify_one();
+}
+
+// Method Description:
+// - Writes input that isn't a paste, like typed keys. If nothing else is
+//   pending, it's written right away on the calling thread. Otherwise it's
+//   queued behind the paste, so that it can't end up in the middle of it.
+// - Paste and Write are meant to be called from a single thread.
+// Arguments:
+// - text - the input to write.
+void PastePump::Write(const std::wstring_view text)
+{
+    if (text.empty())
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock{ _mutex };
+        if (_busy || !_queue.empty())
+        {
+            _queue.push_back({ std::wstring{ text }, false, false });
+            lock.unlock();
+            _workAvailable.notify_one();
+            return;
+        }
+    }
+
+    _pfnWrite(text);
+}
+
+// Method Description:
+// - Stops the paste that's being written, and drops any pastes that haven't
+//   started yet. Input queued with Write is still written.
+void PastePump::Cancel()
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+
+    _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [](const Item& item) { return item.isPaste; }),
+                 _queue.end());
+
+    if (_pasting)
+    {
+        _cancelRequested = true;
+    }
+}
+
+// Method Description:
+// - Blocks until everything that was queued has been written.
+void PastePump::WaitForIdle()
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    _idle.wait(lock, [this]() { return !_busy && _queue.empty(); });
+}
+
+// Method Description:
+// - Returns true if a paste is being written, or waiting to be.
+bool PastePump::IsPasting() const
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    return _pasting || std::any_of(_queue.begin(), _queue.end(), [](const Item& item) { return item.isPaste; });
+}
+
+// Routine Description:
+// - Prepares text for pasting:
+//   - \r\n line endings become \r, which is what the Enter key sends. Lone
+//     \n's are left alone, since they could conceivably be intentional.
+//   - For a bracketed paste, any end marker in the text is removed, so that
+//     pasted text can't end the paste early and have the rest of it treated
+//     as typed by the application.
+// Arguments:
+// - text - the text to paste.
+// - bracketed - true if the paste will be bracketed.
+// Return Value:
+// - the text to send.
+std::wstring PastePump::s_FilterPaste(const std::wstring_view text, const bool bracketed)
+{
+    std::wstring filtered;
+    filtered.reserve(text.size());
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == L'\n' && i > 0 && text[i - 1] == L'\r')
+        {
+            continue;
+        }
+        filtered.push_back(text[i]);
+    }
+
+    if (bracketed)
+    {
+        for (auto pos = filtered.find(BracketedPasteEnd); pos != std::wstring::npos; pos = filtered.find(BracketedPasteEnd, pos))
+        {
+            filtered.erase(pos, BracketedPasteEnd.size());
+            // The text around the marker we just removed could form another one.
+            pos -= std::min(pos, BracketedPasteEnd.size() - 1);
+        }
+    }
+
+    return filtered;
+}
+
+// Routine Description:
+// - Figures out how much of the text to write next. Surrogate pairs are never
+//   split, since each chunk is converted to UTF-8 on its own.
+// Arguments:
+// - text - the rest of the text to write.
+// - chunkSize - the largest number of characters to write at once. At least 2.
+// Return Value:
+// - the number of characters to write.
+size_t PastePump::s_ChunkLength(const std::wstring_view text, const size_t chunkSize) noexcept
+{
+    auto length = std::min(text.size(), chunkSize);
+    if (length < text.size() && IS_HIGH_SURROGATE(text[length - 1]))
+    {
+        --length;
+    }
+    return length;
+}
+
+// Method Description:
+// - Starts the background thread, if it isn't running yet.
+// - _mutex must be held when calling this method.
+void PastePump::_EnsureThread()
+{
+    if (!_thread.joinable())
+    {
+        _thread = std::thread{ &PastePump::_Run, this };
+    }
+}
+
+// Method Description:
+// - The background thread. Writes the queued items one after the other until
+//   the pump is destroyed.
+void PastePump::_Run()
+{
+    std::unique_lock<std::mutex> lock{ _mutex };
+    for (;;)
+    {
+        _workAvailable.wait(lock, [this]() { return _exitRequested || !_queue.empty(); });
+        if (_exitRequested)
+        {
+            break;
+        }
+
+        const auto item = std::move(_queue.front());
+        _queue.pop_front();
+        _busy = true;
+        _pasting = item.isPaste;
+        _cancelRequested = false;
+        lock.unlock();
+
+        try
+        {
+            if (item.isPaste)
+            {
+                _WritePaste(item);
+            }
+            else
+            {
+                _pfnWrite(item.text);
+            }
+        }
+        CATCH_LOG();
+
+        lock.lock();
+        _busy = false;
+        _pasting = false;
+        if (_queue.empty())
+        {
+            _idle.notify_all();
+        }
+    }
+
+    _busy = false;
+    _pasting = false;
+    _exited = true;
+    _idle.notify_all();
+}
+
+// Method Description:
+// - Writes a paste in chunks, reporting progress after each one, until it's
+//   done or cancelled.
+// Arguments:
+// - item - the paste to write.
+void PastePump::_WritePaste(const Item& item)
+{
+    if (item.bracketed)
+    {
+        _pfnWrite(BracketedPasteStart);
+    }
+
+    const std::wstring_view text{ item.text };
+    const auto total = text.size();
+    size_t written = 0;
+    while (written < total && !_cancelRequested)
+    {
+        const auto length = s_ChunkLength(text.substr(written), _chunkSize);
+        _pfnWrite(text.substr(written, length));
+        written += length;
+
+        if (_pfnProgress)
+        {
+            _pfnProgress(written, total);
+        }
+    }
+
+    // A cancelled paste still has to take the application out of paste mode.
+    if (item.bracketed)
+    {
+        _pfnWrite(BracketedPasteEnd);
+    }
+}
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// Module Name:
+// - PastePump.hpp
+//
+// Abstract:
+// - Delivers input to the connection on a background thread, so that a large
+//   paste doesn't block the thread that started it. Pastes are handed to the
+//   connection in bounded chunks, one after the other: the write callback is
+//   expected to block while the connection can't take more, and that's what
+//   paces the paste. Input written while a paste is in progress is queued
+//   behind it, so that typing can't end up in the middle of pasted text.
+// - The pump never touches the Terminal, and so never holds its lock.
+// - Destroying the pump cancels any synchronous I/O the write callback is
+//   blocked in, since the connection might never take more input.
+
+#pragma once
+
+#include <condition_variable>
+
+namespace Microsoft::Terminal::Core
+{
+    class PastePump;
+}
+
+#ifdef UNIT_TESTING
+namespace TerminalCoreUnitTests
+{
+    class PastePumpTests;
+};
+#endif
+
+class Microsoft::Terminal::Core::PastePump final
+{
+public:
+    using WriteCallback = std::function<void(const std::wstring_view)>;
+    using ProgressCallback = std::function<void(const size_t written, const size_t total)>;
+
+    // The largest piece of a paste that's handed to the connection at once.
+    static constexpr size_t DefaultChunkSize = 4096;
+
+    static constexpr std::wstring_view BracketedPasteStart{ L"\x1b[200~" };
+    static constexpr std::wstring_view BracketedPasteEnd{ L"\x1b[201~" };
+
+    PastePump(WriteCallback pfnWrite, const size_t chunkSize = DefaultChunkSize);
+    ~PastePump();
+
+    PastePump(const PastePump&) = delete;
+    PastePump(PastePump&&) = delete;
+    PastePump& operator=(const PastePump&) = delete;
+    PastePump& operator=(PastePump&&) = delete;
+
+    void SetProgressCallback(ProgressCallback pfn);
+
+    void Paste(const std::wstring_view text, const bool bracketed);
+    void Write(const std::wstring_view text);
+    void Cancel();
+    void WaitForIdle();
+    bool IsPasting() const;
+
+    static std::wstring s_FilterPaste(const std::wstring_view text, const bool bracketed);
+    static size_t s_ChunkLength(const std::wstring_view text, const size_t chunkSize) noexcept;
+
+private:
+    struct Item
+    {
+        std::wstring text;
+        bool isPaste;
+        bool bracketed;
+    };
+
+    WriteCallback _pfnWrite;
+    ProgressCallback _pfnProgress;
+    const size_t _chunkSize;
+
+    // Everything below is guarded by _mutex, except for _cancelRequested,
+    // which the worker polls between chunks.
+    mutable std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _idle;
+    std::deque<Item> _queue;
+    bool _busy;
+    bool _pasting;
+    bool _exitRequested;
+    bool _exited;
+    std::atomic<bool> _cancelRequested;
+    std::thread _thread;
+
+    void _EnsureThread();
+    void _Run();
+    void _WritePaste(const Item& item);
+
+#ifdef UNIT_TESTING
+    friend class TerminalCoreUnitTests::PastePumpTests;
+#endif
+};
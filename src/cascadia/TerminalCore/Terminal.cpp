@@ -46,6 +46,7 @@ Terminal::Terminal() :
     _scrollOffset{ 0 },
     _snapOnInput{ true },
     _altGrAliasing{ true },
+    _bracketedPasteMode{ false },
     _blockSelection{ false },
     _selection{ std::nullopt }
 {
@@ -65,6 +66,17 @@ Terminal::Terminal() :
 
     _terminalInput = std::make_unique<TerminalInput>(passAlongInput);
 
+    // Sequences only have to reach the connection as text, so skip turning
+    // them into a key event per character and back.
+    _terminalInput->SetWriteSequenceCallback([&](const std::wstring_view sequence) {
+        if (!_pfnWriteInput)
+        {
+            return;
+        }
+        _inputSequence.assign(sequence);
+        _pfnWriteInput(_inputSequence);
+    });
+
     _InitializeColorTable();
 }
 
@@ -336,6 +348,11 @@ void Terminal::UpdateSettings(winrt::Microsoft::Terminal::Settings::ICoreSetting
 
     _buffer.swap(newTextBuffer);
 
+    // The reflowed rows are new rows, so anything we knew about the old ones is
+    // useless. Only what's visible will be scanned again, when it's next updated.
+    _patterns.Invalidate();
+    _hoveredPattern.reset();
+
     // GH#3494: Maintain scrollbar position during resize
     // Make sure that we don't scroll past the mutableViewport at the bottom of the buffer
     newVisibleTop = std::min(newVisibleTop, _mutableViewport.Top());
@@ -362,6 +379,70 @@ void Terminal::Write(std::wstring_view stringView)
     auto lock = LockForWriting();
 
     _stateMachine->ProcessString(stringView);
+
+    _inputLatency.MarkBufferUpdated();
+}
+
+// Method Description:
+// - Looks for URLs and file paths in the visible rows that changed since they
+//   were last looked at. This is meant to be called periodically by the
+//   control (not the render thread), after output or scrolling.
+// - The caller must hold the write lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::UpdatePatterns()
+{
+    _patterns.Update(*_buffer, _GetVisibleViewport());
+    _UpdateHoveredPattern();
+}
+
+// Method Description:
+// - Tells the terminal which cell the mouse pointer is over, so that a pattern
+//   under it can be underlined.
+// - The caller must hold the write lock.
+// Arguments:
+// - viewportPos: the cell under the pointer, relative to the viewport, or
+//      nullopt if the pointer isn't over the terminal.
+// Return Value:
+// - <none>
+void Terminal::SetHoveredCell(const std::optional<COORD> viewportPos)
+{
+    _hoveredCell = viewportPos;
+    _UpdateHoveredPattern();
+}
+
+// Method Description:
+// - Looks up the pattern under the hovered cell, and redraws the old and new
+//   pattern if that changed.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::_UpdateHoveredPattern()
+{
+    std::optional<SMALL_RECT> pattern;
+    if (_hoveredCell.has_value())
+    {
+        pattern = _patterns.FindAt(*_buffer, _ConvertToBufferCell(_hoveredCell.value()));
+    }
+
+    if (pattern == _hoveredPattern)
+    {
+        return;
+    }
+
+    auto& renderTarget = _buffer->GetRenderTarget();
+    if (_hoveredPattern.has_value())
+    {
+        renderTarget.TriggerRedraw(Viewport::FromInclusive(_hoveredPattern.value()));
+    }
+    if (pattern.has_value())
+    {
+        renderTarget.TriggerRedraw(Viewport::FromInclusive(pattern.value()));
+    }
+    _hoveredPattern = pattern;
 }
 
 // Method Description:
@@ -393,6 +474,83 @@ bool Terminal::IsTrackingMouseInput() const noexcept
     return _terminalInput->IsTrackingMouseInput();
 }
 
+// Routine Description:
+// - Relays if the application asked for pasted text to be bracketed
+//   (surrounded by ESC[200~ and ESC[201~), with DECSET 2004.
+// Parameters:
+// - <none>
+// Return value:
+// - true, if pastes should be bracketed. False, otherwise
+bool Terminal::IsXtermBracketedPasteModeEnabled() const noexcept
+{
+    return _bracketedPasteMode;
+}
+
+// Method Description:
+// - Turns coalescing of mouse input on or off. While it's on, the caller has
+//   to call FlushPendingMouseInput once per frame, whenever
+//   NeedsMouseInputFlush returns true. See TerminalInput for more information.
+// Arguments:
+// - enable: true to coalesce mouse moves and wheel events within a frame.
+// Return Value:
+// - <none>
+void Terminal::EnableMouseInputCoalescing(const bool enable)
+{
+    _terminalInput->EnableMouseInputCoalescing(enable);
+}
+
+bool Terminal::NeedsMouseInputFlush() const noexcept
+{
+    return _terminalInput->NeedsMouseInputFlush();
+}
+
+// Method Description:
+// - Ends the current frame of coalesced mouse input, writing the mouse
+//   events that were held back.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::FlushPendingMouseInput()
+{
+    _terminalInput->FlushPendingMouseInput();
+}
+
+TerminalInput::MouseInputMetrics Terminal::GetMouseInputMetrics() const noexcept
+{
+    return _terminalInput->GetMouseInputMetrics();
+}
+
+// Method Description:
+// - Starts or stops measuring the time between keys being sent, their echo
+//   reaching the buffer, and it being presented. See InputLatencyTracker.
+// Arguments:
+// - enable: true to start measuring.
+// Return Value:
+// - <none>
+void Terminal::EnableInputLatencyTracking(const bool enable)
+{
+    _inputLatency.Enable(enable);
+}
+
+// Method Description:
+// - Tells the terminal that the renderer presented a frame, so that the keys
+//   whose echo is in the buffer can be counted as painted. Called on the
+//   render thread, without the lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::NotifyFramePresented()
+{
+    _inputLatency.MarkPainted();
+}
+
+InputLatencyTracker::Statistics Terminal::GetInputLatencyStatistics() const
+{
+    return _inputLatency.GetStatistics();
+}
+
 // Method Description:
 // - Send this particular (non-character) key event to the terminal.
 // - The terminal will translate the key and the modifiers pressed into the
@@ -466,8 +624,16 @@ bool Terminal::SendKeyEvent(const WORD vkey,
         return false;
     }
 
+    // The key has to be marked before it's written, since the echo may be
+    // processed before HandleKey even returns.
+    const auto input = keyDown ? _inputLatency.MarkInput() : 0;
     KeyEvent keyEv{ keyDown, 1, vkey, scanCode, ch, states.Value() };
-    return _terminalInput->HandleKey(&keyEv);
+    const auto handled = _terminalInput->HandleKey(&keyEv);
+    if (!handled)
+    {
+        _inputLatency.RetractInput(input);
+    }
+    return handled;
 }
 
 // Method Description:
@@ -531,9 +697,15 @@ bool Terminal::SendCharEvent(const wchar_t ch, const WORD scanCode, const Contro
     // character up event, only a character received event. So fake sending both
     // to the terminal input translator. Unless it's in win32-input-mode, it'll
     // ignore the keyup.
+    // See SendKeyEvent regarding the order of marking and writing.
+    const auto input = _inputLatency.MarkInput();
     KeyEvent keyDown{ true, 1, vkey, scanCode, ch, states.Value() };
     KeyEvent keyUp{ false, 1, vkey, scanCode, ch, states.Value() };
     const auto handledDown = _terminalInput->HandleKey(&keyDown);
+    if (!handledDown)
+    {
+        _inputLatency.RetractInput(input);
+    }
     const auto handledUp = _terminalInput->HandleKey(&keyUp);
     return handledDown || handledUp;
 }
@@ -723,46 +895,40 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
     // We can not waste time displaying a cursor event when we know more text is coming right behind it.
     cursor.StartDeferDrawing();
 
-    for (size_t i = 0; i < stringView.size(); i++)
+    const auto width = _buffer->GetSize().Width();
+    auto remaining = stringView;
+    while (!remaining.empty())
     {
-        const auto wch = stringView.at(i);
         const COORD cursorPosBefore = cursor.GetPosition();
         COORD proposedCursorPosition = cursorPosBefore;
 
-        // TODO: MSFT 21006766
-        // This is not great but I need it demoable. Fix by making a buffer stream writer.
-        //
-        // If wch is a surrogate character we need to read 2 code units
-        // from the stringView to form a single code point.
-        const auto isSurrogate = wch >= 0xD800 && wch <= 0xDFFF;
-        const auto view = stringView.substr(i, isSurrogate ? 2 : 1);
-        const OutputCellIterator it{ view, _buffer->GetCurrentAttributes() };
-        const auto end = _buffer->Write(it);
-        const auto cellDistance = end.GetCellDistance(it);
-        const auto inputDistance = end.GetInputDistance(it);
-
-        if (inputDistance > 0)
+        // Measure and split up as much of the text as fits on the rest of
+        // this row in one pass, then write all of it at once.
+        _printRun.Compile(remaining, gsl::narrow_cast<size_t>(std::max(0, width - cursorPosBefore.X)));
+        if (!_printRun.empty())
         {
-            // If "wch" was a surrogate character, we just consumed 2 code units above.
-            // -> Increment "i" by 1 in that case and thus by 2 in total in this iteration.
-            proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            i += inputDistance - 1;
+            _buffer->WriteRun(_printRun, cursorPosBefore, _buffer->GetCurrentAttributes());
+            proposedCursorPosition.X += gsl::narrow<SHORT>(_printRun.Columns());
+            remaining = remaining.substr(_printRun.Text().size());
         }
         else
         {
-            // If _WriteBuffer() is called with a consecutive string longer than the viewport/buffer width
-            // the call to _buffer->Write() will refuse to write anything on the current line.
-            // GetInputDistance() thus returns 0, which would in turn cause i to be
-            // decremented by 1 below and force the outer loop to loop forever.
-            // This if() basically behaves as if "\r\n" had been encountered above and retries the write.
-            // With well behaving shells during normal operation this safeguard should normally not be encountered.
+            // Nothing fits on the current line anymore, because we're already
+            // past its end, or the next glyph is a wide one and there's only
+            // a single column left. This behaves as if "\r\n" had been
+            // encountered and retries the write on the next line.
             proposedCursorPosition.X = 0;
             proposedCursorPosition.Y++;
 
-            // Try the character again.
-            i--;
+            // A wide glyph that didn't fit leaves the last column padded out.
+            // The padding goes through the buffer, so that it gets painted.
+            if (cursorPosBefore.X < width)
+            {
+                _buffer->FillCells(cursorPosBefore, 1, UNICODE_SPACE, std::nullopt, true);
+                _buffer->GetRowByOffset(cursorPosBefore.Y).GetCharRow().SetDoubleBytePadded(true);
+            }
 
-            // If we write the last cell of the row here, TextBuffer::Write will
+            // If we write the last cell of the row here, TextBuffer::WriteRun will
             // mark this line as wrapped for us. If the next character we
             // process is a newline, the Terminal::CursorLineFeed will unmark
             // this line as wrapped.
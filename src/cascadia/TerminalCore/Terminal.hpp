@@ -6,6 +6,7 @@
 #include <conattrs.hpp>
 
 #include "../../buffer/out/textBuffer.hpp"
+#include "../../buffer/out/PatternIndex.hpp"
 #include "../../renderer/inc/IRenderData.hpp"
 #include "../../terminal/parser/StateMachine.hpp"
 #include "../../terminal/input/terminalInput.hpp"
@@ -15,6 +16,7 @@
 #include "../../types/IUiaData.h"
 #include "../../cascadia/terminalcore/ITerminalApi.hpp"
 #include "../../cascadia/terminalcore/ITerminalInput.hpp"
+#include "../../cascadia/terminalcore/InputLatencyTracker.hpp"
 
 // You have to forward decl the ICoreSettings here, instead of including the header.
 // If you include the header, there will be compilation errors with other
@@ -82,6 +84,7 @@ public:
     void SetTextAttributes(const TextAttribute& attrs) noexcept override;
     bool SetCursorPosition(short x, short y) noexcept override;
     COORD GetCursorPosition() noexcept override;
+    COORD GetBufferSize() noexcept override;
     bool SetCursorVisibility(const bool visible) noexcept override;
     bool EnableCursorBlinking(const bool enable) noexcept override;
     bool CursorLineFeed(const bool withReturn) noexcept override;
@@ -106,6 +109,7 @@ public:
     bool EnableButtonEventMouseMode(const bool enabled) noexcept override;
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override;
     bool EnableAlternateScrollMode(const bool enabled) noexcept override;
+    bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override;
 
     bool IsVtInputEnabled() const noexcept override;
 
@@ -124,6 +128,16 @@ public:
 
     void TrySnapOnInput() override;
     bool IsTrackingMouseInput() const noexcept;
+    bool IsXtermBracketedPasteModeEnabled() const noexcept;
+
+    void EnableMouseInputCoalescing(const bool enable);
+    bool NeedsMouseInputFlush() const noexcept;
+    void FlushPendingMouseInput();
+    ::Microsoft::Console::VirtualTerminal::TerminalInput::MouseInputMetrics GetMouseInputMetrics() const noexcept;
+
+    void EnableInputLatencyTracking(const bool enable);
+    void NotifyFramePresented();
+    InputLatencyTracker::Statistics GetInputLatencyStatistics() const;
 #pragma endregion
 
 #pragma region IBaseData(base to IRenderData and IUiaData)
@@ -150,6 +164,7 @@ public:
     bool IsCursorDoubleWidth() const override;
     bool IsScreenReversed() const noexcept override;
     const std::vector<Microsoft::Console::Render::RenderOverlay> GetOverlays() const noexcept override;
+    const std::vector<SMALL_RECT> GetPatternOverlays() const noexcept override;
     const bool IsGridLineDrawingAllowed() noexcept override;
 #pragma endregion
 
@@ -175,6 +190,9 @@ public:
     void SetCursorOn(const bool isOn);
     bool IsCursorBlinkingAllowed() const noexcept;
 
+    void UpdatePatterns();
+    void SetHoveredCell(const std::optional<COORD> viewportPos);
+
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
     enum class SelectionExpansionMode
@@ -193,6 +211,8 @@ public:
 
 private:
     std::function<void(std::wstring&)> _pfnWriteInput;
+    std::wstring _inputSequence; // reused for every sequence _terminalInput writes
+    InputLatencyTracker _inputLatency;
     std::function<void(const std::wstring_view&)> _pfnTitleChanged;
     std::function<void(const std::wstring_view&)> _pfnCopyToClipboard;
     std::function<void(const int, const int, const int)> _pfnScrollPositionChanged;
@@ -213,6 +233,7 @@ private:
     bool _snapOnInput;
     bool _altGrAliasing;
     bool _suppressApplicationTitle;
+    bool _bracketedPasteMode;
 
 #pragma region Text Selection
     // a selection is represented as a range between two COORDs (start and end)
@@ -224,6 +245,11 @@ private:
         COORD start;
         COORD end;
         COORD pivot;
+
+        // the last buffer position passed to SetSelectionEnd. Mouse drags
+        // report the same cell many times over, and there's no need to
+        // re-expand word/line boundaries when the endpoint didn't move.
+        std::optional<COORD> lastTarget;
     };
     std::optional<SelectionAnchors> _selection;
     bool _blockSelection;
@@ -231,11 +257,17 @@ private:
     SelectionExpansionMode _multiClickSelectionMode;
 #pragma endregion
 
+    // URLs and file paths detected in the buffer, and the one under the mouse (if any)
+    PatternIndex _patterns;
+    std::optional<COORD> _hoveredCell;
+    std::optional<SMALL_RECT> _hoveredPattern;
+
     std::shared_mutex _readWriteLock;
 
     // TODO: These members are not shared by an alt-buffer. They should be
     //      encapsulated, such that a Terminal can have both a main and alt buffer.
     std::unique_ptr<TextBuffer> _buffer;
+    PrintRun _printRun; // reused by _WriteBuffer, to keep its glyphs' allocation around
     Microsoft::Console::Types::Viewport _mutableViewport;
     SHORT _scrollbackLines;
 
@@ -287,6 +319,8 @@ private:
 
     void _NotifyTerminalCursorPositionChanged() noexcept;
 
+    void _UpdateHoveredPattern();
+
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
     std::vector<SMALL_RECT> _GetSelectionRects() const noexcept;
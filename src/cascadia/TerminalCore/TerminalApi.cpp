@@ -64,6 +64,17 @@ COORD Terminal::GetCursorPosition() noexcept
     return newPos;
 }
 
+// Method Description:
+// - Retrieves the size of the text buffer, which is as wide as the viewport.
+// Arguments:
+// - <none>
+// Return value:
+// - the width and height of the buffer
+COORD Terminal::GetBufferSize() noexcept
+{
+    return _buffer->GetSize().Dimensions();
+}
+
 // Method Description:
 // - Moves the cursor down one line, and possibly also to the leftmost column.
 // Arguments:
@@ -103,38 +114,8 @@ CATCH_LOG_RETURN_FALSE()
 bool Terminal::DeleteCharacter(const size_t count) noexcept
 try
 {
-    SHORT dist;
-    if (!SUCCEEDED(SizeTToShort(count, &dist)))
-    {
-        return false;
-    }
     const auto cursorPos = _buffer->GetCursor().GetPosition();
-    const auto copyToPos = cursorPos;
-    const COORD copyFromPos{ cursorPos.X + dist, cursorPos.Y };
-    const auto sourceWidth = _mutableViewport.RightExclusive() - copyFromPos.X;
-    SHORT width;
-    if (!SUCCEEDED(UIntToShort(sourceWidth, &width)))
-    {
-        return false;
-    }
-
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
-    {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
-
+    _buffer->DeleteCells(cursorPos, count, _buffer->GetCurrentAttributes());
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -151,45 +132,8 @@ CATCH_LOG_RETURN_FALSE()
 bool Terminal::InsertCharacter(const size_t count) noexcept
 try
 {
-    // NOTE: the code below is _extremely_ similar to DeleteCharacter
-    // We will want to use this same logic and implement a helper function instead
-    // that does the 'move a region from here to there' operation
-    // TODO: Github issue #2163
-    SHORT dist;
-    if (!SUCCEEDED(SizeTToShort(count, &dist)))
-    {
-        return false;
-    }
     const auto cursorPos = _buffer->GetCursor().GetPosition();
-    const auto copyFromPos = cursorPos;
-    const COORD copyToPos{ cursorPos.X + dist, cursorPos.Y };
-    const auto sourceWidth = _mutableViewport.RightExclusive() - copyFromPos.X;
-    SHORT width;
-    if (!SUCCEEDED(UIntToShort(sourceWidth, &width)))
-    {
-        return false;
-    }
-
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-    const auto sourceOrigin = source.Origin();
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
-    {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), dist);
-    _buffer->Write(eraseIter, cursorPos);
-
+    _buffer->InsertCells(cursorPos, count, _buffer->GetCurrentAttributes());
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -201,8 +145,7 @@ try
     const auto viewport = _GetMutableViewport();
     const short distanceToRight = viewport.RightExclusive() - absoluteCursorPos.X;
     const short fillLimit = std::min(static_cast<short>(numChars), distanceToRight);
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), fillLimit);
-    _buffer->Write(eraseIter, absoluteCursorPos);
+    _buffer->FillCells(absoluteCursorPos, fillLimit, UNICODE_SPACE, _buffer->GetCurrentAttributes());
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -245,10 +188,8 @@ try
         return false;
     }
 
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), nlength);
-
     // Explicitly turn off end-of-line wrap-flag-setting when erasing cells.
-    _buffer->Write(eraseIter, startPos, false);
+    _buffer->FillCells(startPos, nlength, UNICODE_SPACE, _buffer->GetCurrentAttributes(), false);
     return true;
 }
 CATCH_LOG_RETURN_FALSE()
@@ -518,6 +459,12 @@ bool Terminal::EnableAlternateScrollMode(const bool enabled) noexcept
     return true;
 }
 
+bool Terminal::EnableXtermBracketedPasteMode(const bool enabled) noexcept
+{
+    _bracketedPasteMode = enabled;
+    return true;
+}
+
 bool Terminal::IsVtInputEnabled() const noexcept
 {
     // We should never be getting this call in Terminal.
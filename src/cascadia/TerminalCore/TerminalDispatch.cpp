@@ -84,6 +84,84 @@ try
 }
 CATCH_LOG_RETURN_FALSE()
 
+// Method Description:
+// - HTS - sets a tab stop in the cursor's current column.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if handled successfully. False otherwise.
+bool TerminalDispatch::HorizontalTabSet() noexcept
+try
+{
+    const auto cursorPos = _terminalApi.GetCursorPosition();
+    _tabStops.Resize(_terminalApi.GetBufferSize().X);
+    _tabStops.Set(cursorPos.X);
+    return true;
+}
+CATCH_LOG_RETURN_FALSE()
+
+// Method Description:
+// - CHT, HT - moves the cursor to the numTabs'th tab stop following it, or to
+//   the right edge of the buffer if there aren't that many.
+// Arguments:
+// - numTabs - the number of tabs to perform
+// Return Value:
+// - True if handled successfully. False otherwise.
+bool TerminalDispatch::ForwardTab(const size_t numTabs) noexcept
+try
+{
+    const auto cursorPos = _terminalApi.GetCursorPosition();
+    const auto width = _terminalApi.GetBufferSize().X;
+    _tabStops.Resize(width);
+    const auto column = _tabStops.Next(cursorPos.X, numTabs, width);
+    return _terminalApi.SetCursorPosition(gsl::narrow<short>(column), cursorPos.Y);
+}
+CATCH_LOG_RETURN_FALSE()
+
+// Method Description:
+// - CBT - moves the cursor to the numTabs'th tab stop preceding it, or to the
+//   left edge of the buffer if there aren't that many.
+// Arguments:
+// - numTabs - the number of tabs to perform
+// Return Value:
+// - True if handled successfully. False otherwise.
+bool TerminalDispatch::BackwardsTab(const size_t numTabs) noexcept
+try
+{
+    const auto cursorPos = _terminalApi.GetCursorPosition();
+    _tabStops.Resize(_terminalApi.GetBufferSize().X);
+    const auto column = _tabStops.Previous(cursorPos.X, numTabs);
+    return _terminalApi.SetCursorPosition(gsl::narrow<short>(column), cursorPos.Y);
+}
+CATCH_LOG_RETURN_FALSE()
+
+// Method Description:
+// - TBC - clears the tab stop in the cursor's current column, or all of them.
+// Arguments:
+// - clearType - one of DispatchTypes::TabClearType
+// Return Value:
+// - True if handled successfully. False otherwise.
+bool TerminalDispatch::TabClear(const size_t clearType) noexcept
+try
+{
+    switch (clearType)
+    {
+    case DispatchTypes::TabClearType::ClearCurrentColumn:
+    {
+        const auto cursorPos = _terminalApi.GetCursorPosition();
+        _tabStops.Resize(_terminalApi.GetBufferSize().X);
+        _tabStops.Clear(cursorPos.X);
+        return true;
+    }
+    case DispatchTypes::TabClearType::ClearAllColumns:
+        _tabStops.ClearAll();
+        return true;
+    default:
+        return false;
+    }
+}
+CATCH_LOG_RETURN_FALSE()
+
 bool TerminalDispatch::LineFeed(const DispatchTypes::LineFeedType lineFeedType) noexcept
 try
 {
@@ -354,6 +432,19 @@ bool TerminalDispatch::EnableAlternateScroll(const bool enabled) noexcept
     return true;
 }
 
+//Routine Description:
+// Enable Bracketed Paste Mode - Surrounds pasted text with ESC[200~ and
+//      ESC[201~, so that the application can tell it apart from typed input.
+//Arguments:
+// - enabled - true to enable, false to disable.
+// Return value:
+// True if handled successfully. False otherwise.
+bool TerminalDispatch::EnableXtermBracketedPasteMode(const bool enabled) noexcept
+{
+    _terminalApi.EnableXtermBracketedPasteMode(enabled);
+    return true;
+}
+
 bool TerminalDispatch::SetPrivateModes(const gsl::span<const DispatchTypes::PrivateModeParams> params) noexcept
 {
     return _SetResetPrivateModes(params, true);
@@ -432,6 +523,9 @@ bool TerminalDispatch::_PrivateModeParamsHelper(const DispatchTypes::PrivateMode
     case DispatchTypes::PrivateModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::PrivateModeParams::XTERM_BracketedPasteMode:
+        success = EnableXtermBracketedPasteMode(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -511,11 +605,14 @@ bool TerminalDispatch::HardReset() noexcept
     // Set the DECSCNM screen mode back to normal.
     success = SetScreenMode(false) && success;
 
+    // Stop bracketing pastes.
+    success = EnableXtermBracketedPasteMode(false) && success;
+
     // Cursor to 1,1 - the Soft Reset guarantees this is absolute
     success = CursorPosition(1, 1) && success;
 
-    // // Delete all current tab stops and reapply
-    // _ResetTabStops();
+    // Delete all current tab stops and reapply
+    _tabStops.Reset();
 
     return success;
 }
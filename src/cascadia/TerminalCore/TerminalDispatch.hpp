@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 #include "../../terminal/adapter/termDispatch.hpp"
+#include "../../terminal/adapter/tabStops.hpp"
 #include "ITerminalApi.hpp"
 
 class TerminalDispatch : public Microsoft::Console::VirtualTerminal::TermDispatch
@@ -27,6 +28,11 @@ public:
     bool CursorBackward(const size_t distance) noexcept override;
     bool CursorUp(const size_t distance) noexcept override;
 
+    bool HorizontalTabSet() noexcept override; // HTS
+    bool ForwardTab(const size_t numTabs) noexcept override; // CHT, HT
+    bool BackwardsTab(const size_t numTabs) noexcept override; // CBT
+    bool TabClear(const size_t clearType) noexcept override; // TBC
+
     bool LineFeed(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::LineFeedType lineFeedType) noexcept override;
 
     bool EraseCharacters(const size_t numChars) noexcept override;
@@ -58,12 +64,14 @@ public:
     bool EnableButtonEventMouseMode(const bool enabled) noexcept override; // ?1002
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override; // ?1003
     bool EnableAlternateScroll(const bool enabled) noexcept override; // ?1007
+    bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
 
     bool SetPrivateModes(const gsl::span<const ::Microsoft::Console::VirtualTerminal::DispatchTypes::PrivateModeParams> /*params*/) noexcept override; // DECSET
     bool ResetPrivateModes(const gsl::span<const ::Microsoft::Console::VirtualTerminal::DispatchTypes::PrivateModeParams> /*params*/) noexcept override; // DECRST
 
 private:
     ::Microsoft::Terminal::Core::ITerminalApi& _terminalApi;
+    ::Microsoft::Console::VirtualTerminal::TabStops _tabStops;
 
     size_t _SetRgbColorsHelper(const gsl::span<const ::Microsoft::Console::VirtualTerminal::DispatchTypes::GraphicsOptions> options,
                                TextAttribute& attr,
@@ -147,6 +147,14 @@ void Terminal::SetSelectionEnd(const COORD viewportPos, std::optional<SelectionE
 
     const auto textBufferPos = _ConvertToBufferCell(viewportPos);
 
+    // dragging within the same cell doesn't change the selection
+    if (!newExpansionMode.has_value() && _selection->lastTarget.has_value() &&
+        _selection->lastTarget->X == textBufferPos.X && _selection->lastTarget->Y == textBufferPos.Y)
+    {
+        return;
+    }
+    _selection->lastTarget = textBufferPos;
+
     // if this is a shiftClick action, we need to overwrite the _multiClickSelectionMode value (even if it's the same)
     // Otherwise, we may accidentally expand during other selection-based actions
     _multiClickSelectionMode = newExpansionMode.has_value() ? *newExpansionMode : _multiClickSelectionMode;
@@ -116,6 +116,25 @@ const std::vector<RenderOverlay> Terminal::GetOverlays() const noexcept
     return {};
 }
 
+// Method Description:
+// - Gets the detected pattern under the mouse, so that it can be underlined.
+// Return Value:
+// - the region of the buffer covered by the hovered pattern, if there is one.
+const std::vector<SMALL_RECT> Terminal::GetPatternOverlays() const noexcept
+try
+{
+    if (_hoveredPattern.has_value())
+    {
+        return { _hoveredPattern.value() };
+    }
+    return {};
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return {};
+}
+
 const bool Terminal::IsGridLineDrawingAllowed() noexcept
 {
     return true;
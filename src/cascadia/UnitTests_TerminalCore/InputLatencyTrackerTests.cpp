@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
+using namespace std::chrono_literals;
+
+namespace TerminalCoreUnitTests
+{
+    class InputLatencyTrackerTests
+    {
+        TEST_CLASS(InputLatencyTrackerTests);
+
+        TEST_METHOD(ComputesPercentiles);
+        TEST_METHOD(MatchesInputsWithEchoAndPaint);
+        TEST_METHOD(DoesNothingWhileDisabled);
+        TEST_METHOD(MeasuresLocalEcho);
+        TEST_METHOD(MeasuresEchoBeforeTheWriteReturns);
+        TEST_METHOD(RetractedInputsAreNotMeasured);
+    };
+};
+
+using namespace TerminalCoreUnitTests;
+
+void InputLatencyTrackerTests::ComputesPercentiles()
+{
+    Log::Comment(L"No samples, no latency.");
+    auto percentiles = InputLatencyTracker::s_ComputePercentiles({});
+    VERIFY_ARE_EQUAL(0u, percentiles.samples);
+    VERIFY_ARE_EQUAL(0, percentiles.max.count());
+
+    Log::Comment(L"A single sample is every percentile.");
+    percentiles = InputLatencyTracker::s_ComputePercentiles({ 7ms });
+    VERIFY_ARE_EQUAL(1u, percentiles.samples);
+    VERIFY_IS_TRUE(percentiles.p50 == 7ms);
+    VERIFY_IS_TRUE(percentiles.p99 == 7ms);
+    VERIFY_IS_TRUE(percentiles.max == 7ms);
+
+    Log::Comment(L"Samples of 1 to 100ms, in reverse order.");
+    std::vector<InputLatencyTracker::clock::duration> samples;
+    for (auto ms = 100; ms > 0; --ms)
+    {
+        samples.push_back(std::chrono::milliseconds{ ms });
+    }
+    percentiles = InputLatencyTracker::s_ComputePercentiles(samples);
+    VERIFY_ARE_EQUAL(100u, percentiles.samples);
+    VERIFY_IS_TRUE(percentiles.p50 == 50ms);
+    VERIFY_IS_TRUE(percentiles.p90 == 90ms);
+    VERIFY_IS_TRUE(percentiles.p99 == 99ms);
+    VERIFY_IS_TRUE(percentiles.max == 100ms);
+}
+
+void InputLatencyTrackerTests::MatchesInputsWithEchoAndPaint()
+{
+    InputLatencyTracker tracker;
+    tracker.Enable(true);
+
+    const auto start = InputLatencyTracker::clock::now();
+
+    Log::Comment(L"Two keys are echoed by the same output, then painted in the same frame.");
+    tracker.MarkInput(start);
+    tracker.MarkInput(start + 1ms);
+    tracker.MarkBufferUpdated(start + 5ms);
+    tracker.MarkPainted(start + 20ms);
+
+    Log::Comment(L"Output and frames without any keys before them don't count.");
+    tracker.MarkBufferUpdated(start + 30ms);
+    tracker.MarkPainted(start + 40ms);
+
+    const auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(2u, statistics.inputs);
+
+    VERIFY_ARE_EQUAL(2u, tracker._keyToBuffer.samples.size());
+    VERIFY_IS_TRUE(tracker._keyToBuffer.samples.at(0) == 5ms);
+    VERIFY_IS_TRUE(tracker._keyToBuffer.samples.at(1) == 4ms);
+
+    VERIFY_ARE_EQUAL(2u, statistics.keyToPaint.samples);
+    VERIFY_IS_TRUE(statistics.keyToPaint.p50 == 19ms);
+    VERIFY_IS_TRUE(statistics.keyToPaint.max == 20ms);
+
+    Log::Comment(L"Only the latest samples are kept.");
+    for (size_t i = 0; i < InputLatencyTracker::MaxSamples; ++i)
+    {
+        tracker.MarkInput(start);
+        tracker.MarkBufferUpdated(start + 2ms);
+    }
+    VERIFY_ARE_EQUAL(InputLatencyTracker::MaxSamples, tracker.GetStatistics().keyToBuffer.samples);
+    VERIFY_IS_TRUE(tracker.GetStatistics().keyToBuffer.max == 2ms);
+}
+
+void InputLatencyTrackerTests::DoesNothingWhileDisabled()
+{
+    InputLatencyTracker tracker;
+    VERIFY_IS_FALSE(tracker.IsEnabled());
+
+    tracker.MarkInput();
+    tracker.MarkBufferUpdated();
+    tracker.MarkPainted();
+
+    const auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(0u, statistics.inputs);
+    VERIFY_ARE_EQUAL(0u, statistics.keyToBuffer.samples);
+    VERIFY_ARE_EQUAL(0u, statistics.keyToPaint.samples);
+}
+
+void InputLatencyTrackerTests::RetractedInputsAreNotMeasured()
+{
+    InputLatencyTracker tracker;
+    tracker.Enable(true);
+
+    const auto start = InputLatencyTracker::clock::now();
+
+    Log::Comment(L"A key that was never written doesn't wait for an echo.");
+    tracker.MarkInput(start);
+    const auto unhandled = tracker.MarkInput(start + 1ms);
+    VERIFY_ARE_NOT_EQUAL(uint64_t{ 0 }, unhandled);
+    tracker.RetractInput(unhandled);
+    tracker.MarkBufferUpdated(start + 5ms);
+    tracker.MarkPainted(start + 20ms);
+
+    auto statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(1u, statistics.inputs);
+    VERIFY_ARE_EQUAL(1u, statistics.keyToBuffer.samples);
+    VERIFY_IS_TRUE(statistics.keyToBuffer.max == 5ms);
+    VERIFY_ARE_EQUAL(1u, statistics.keyToPaint.samples);
+    VERIFY_IS_TRUE(statistics.keyToPaint.max == 20ms);
+
+    Log::Comment(L"Retracting what wasn't marked is a no-op.");
+    tracker.RetractInput(0);
+    statistics = tracker.GetStatistics();
+    VERIFY_ARE_EQUAL(1u, statistics.inputs);
+}
+
+void InputLatencyTrackerTests::MeasuresLocalEcho()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 80, 32 }, 0, renderTarget);
+    term.EnableInputLatencyTracking(true);
+
+    // A loopback connection: whatever the terminal writes is held until the
+    // "client" reads it and echoes it back, like a shell at its prompt would.
+    std::wstring connection;
+    term.SetWriteInputCallback([&](std::wstring& input) { connection.append(input); });
+
+    const std::wstring_view typed{ L"echo hello" };
+    for (const auto ch : typed)
+    {
+        VERIFY_IS_TRUE(term.SendCharEvent(ch, 0, {}));
+
+        term.Write(connection);
+        connection.clear();
+
+        term.NotifyFramePresented();
+    }
+
+    Log::Comment(L"Keys that the client doesn't echo never reach the buffer.");
+    VERIFY_IS_TRUE(term.SendKeyEvent(VK_UP, 0, {}, true));
+    connection.clear();
+    term.NotifyFramePresented();
+
+    const auto statistics = term.GetInputLatencyStatistics();
+    VERIFY_ARE_EQUAL(typed.size() + 1, statistics.inputs);
+    VERIFY_ARE_EQUAL(typed.size(), statistics.keyToBuffer.samples);
+    VERIFY_ARE_EQUAL(typed.size(), statistics.keyToPaint.samples);
+    VERIFY_IS_TRUE(statistics.keyToBuffer.p50 <= statistics.keyToPaint.p50);
+    VERIFY_IS_TRUE(statistics.keyToBuffer.max <= statistics.keyToPaint.max);
+
+    Log::Comment(NoThrowString().Format(L"key-to-buffer p50 %lldns, key-to-paint p50 %lldns",
+                                        static_cast<long long>(statistics.keyToBuffer.p50.count()),
+                                        static_cast<long long>(statistics.keyToPaint.p50.count())));
+}
+
+void InputLatencyTrackerTests::MeasuresEchoBeforeTheWriteReturns()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 80, 32 }, 0, renderTarget);
+    term.EnableInputLatencyTracking(true);
+
+    // A client that's fast enough echoes the input before the write returns
+    // to the terminal. That echo must still be attributed to the key.
+    term.SetWriteInputCallback([&](std::wstring& input) { term.Write(input); });
+
+    const std::wstring_view typed{ L"dir" };
+    for (const auto ch : typed)
+    {
+        VERIFY_IS_TRUE(term.SendCharEvent(ch, 0, {}));
+        term.NotifyFramePresented();
+    }
+
+    const auto statistics = term.GetInputLatencyStatistics();
+    VERIFY_ARE_EQUAL(typed.size(), statistics.inputs);
+    VERIFY_ARE_EQUAL(typed.size(), statistics.keyToBuffer.samples);
+    VERIFY_ARE_EQUAL(typed.size(), statistics.keyToPaint.samples);
+}
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../cascadia/TerminalCore/PastePump.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Terminal::Core;
+
+namespace TerminalCoreUnitTests
+{
+    class PastePumpTests
+    {
+        TEST_CLASS(PastePumpTests);
+
+        TEST_METHOD(FilterPaste);
+        TEST_METHOD(ChunkLengthKeepsSurrogatePairs);
+        TEST_METHOD(WritesPasteInChunks);
+        TEST_METHOD(WritesAreQueuedBehindPaste);
+        TEST_METHOD(CancelStillEndsBracketedPaste);
+        TEST_METHOD(DestructionCancelsBlockedWrite);
+    };
+};
+
+using namespace TerminalCoreUnitTests;
+
+void PastePumpTests::FilterPaste()
+{
+    Log::Comment(L"\\r\\n becomes \\r, lone \\n's and \\r's are kept.");
+    VERIFY_ARE_EQUAL(L"a\rb\nc\rd\r", std::wstring_view{ PastePump::s_FilterPaste(L"a\r\nb\nc\rd\r\n", false) });
+
+    Log::Comment(L"The end marker only matters to bracketed pastes.");
+    VERIFY_ARE_EQUAL(L"a\x1b[201~b", std::wstring_view{ PastePump::s_FilterPaste(L"a\x1b[201~b", false) });
+    VERIFY_ARE_EQUAL(L"ab", std::wstring_view{ PastePump::s_FilterPaste(L"a\x1b[201~b", true) });
+
+    Log::Comment(L"Removing an end marker must not leave another one behind.");
+    VERIFY_ARE_EQUAL(L"ab", std::wstring_view{ PastePump::s_FilterPaste(L"a\x1b[20\x1b[201~1~b", true) });
+}
+
+void PastePumpTests::ChunkLengthKeepsSurrogatePairs()
+{
+    VERIFY_ARE_EQUAL(3u, PastePump::s_ChunkLength(L"abc", 4));
+    VERIFY_ARE_EQUAL(4u, PastePump::s_ChunkLength(L"abcdef", 4));
+
+    Log::Comment(L"A chunk can't end with the first half of a surrogate pair...");
+    VERIFY_ARE_EQUAL(3u, PastePump::s_ChunkLength(L"abc\xD83D\xDE00", 4));
+
+    Log::Comment(L"...but it can end with the second half.");
+    VERIFY_ARE_EQUAL(4u, PastePump::s_ChunkLength(L"ab\xD83D\xDE00z", 4));
+
+    Log::Comment(L"Leftover high surrogates at the very end are written as is.");
+    VERIFY_ARE_EQUAL(4u, PastePump::s_ChunkLength(L"abc\xD83D", 4));
+}
+
+void PastePumpTests::WritesPasteInChunks()
+{
+    std::vector<std::wstring> written;
+    std::vector<size_t> progress;
+
+    {
+        PastePump pump{ [&](const std::wstring_view chunk) { written.emplace_back(chunk); }, 4 };
+        pump.SetProgressCallback([&](const size_t done, const size_t total) {
+            VERIFY_ARE_EQUAL(10u, total);
+            progress.push_back(done);
+        });
+
+        pump.Paste(L"0123\r\n456789", true);
+        pump.WaitForIdle();
+        VERIFY_IS_FALSE(pump.IsPasting());
+    }
+
+    const std::vector<std::wstring_view> expected{ L"\x1b[200~", L"0123", L"\r456", L"789", L"\x1b[201~" };
+    VERIFY_ARE_EQUAL(expected.size(), written.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expected.at(i), std::wstring_view{ written.at(i) });
+    }
+
+    const std::vector<size_t> expectedProgress{ 4, 8, 10 };
+    VERIFY_ARE_EQUAL(expectedProgress.size(), progress.size());
+    for (size_t i = 0; i < expectedProgress.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expectedProgress.at(i), progress.at(i));
+    }
+}
+
+void PastePumpTests::WritesAreQueuedBehindPaste()
+{
+    std::mutex mutex;
+    std::condition_variable released;
+    bool blocked = true;
+    std::wstring written;
+
+    PastePump pump{ [&](const std::wstring_view chunk) {
+                       std::unique_lock<std::mutex> lock{ mutex };
+                       // Hold up the first chunk, like a connection that's full would.
+                       released.wait(lock, [&]() { return !blocked; });
+                       written.append(chunk);
+                   },
+                    4 };
+
+    pump.Paste(L"pasted text", false);
+    VERIFY_IS_TRUE(pump.IsPasting());
+
+    Log::Comment(L"Typing while the paste is still being written must not end up in the middle of it.");
+    pump.Write(L"typed");
+
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        blocked = false;
+    }
+    released.notify_all();
+
+    pump.WaitForIdle();
+    VERIFY_ARE_EQUAL(L"pasted texttyped", std::wstring_view{ written });
+}
+
+void PastePumpTests::CancelStillEndsBracketedPaste()
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool entered = false;
+    bool blocked = true;
+    std::vector<std::wstring> written;
+
+    PastePump pump{ [&](const std::wstring_view chunk) {
+                       std::unique_lock<std::mutex> lock{ mutex };
+                       entered = true;
+                       changed.notify_all();
+                       changed.wait(lock, [&]() { return !blocked; });
+                       written.emplace_back(chunk);
+                   },
+                    4 };
+
+    pump.Paste(L"0123456789abcdef", true);
+    pump.Paste(L"never written", false);
+    pump.Write(L"typed");
+
+    // Wait until the first paste is being written before cancelling it.
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        changed.wait(lock, [&]() { return entered; });
+    }
+    pump.Cancel();
+
+    {
+        std::unique_lock<std::mutex> lock{ mutex };
+        blocked = false;
+    }
+    changed.notify_all();
+
+    pump.WaitForIdle();
+
+    Log::Comment(L"The paste stops right after its start marker, but is still bracketed; the typed input is kept.");
+    VERIFY_ARE_EQUAL(3u, written.size());
+    VERIFY_ARE_EQUAL(L"\x1b[200~", std::wstring_view{ written.at(0) });
+    VERIFY_ARE_EQUAL(L"\x1b[201~", std::wstring_view{ written.at(1) });
+    VERIFY_ARE_EQUAL(L"typed", std::wstring_view{ written.at(2) });
+}
+
+void PastePumpTests::DestructionCancelsBlockedWrite()
+{
+    wil::unique_handle readPipe;
+    wil::unique_handle writePipe;
+    VERIFY_WIN32_BOOL_SUCCEEDED(CreatePipe(&readPipe, &writePipe, nullptr, 0));
+
+    std::atomic<bool> entered{ false };
+    std::atomic<size_t> failedWrites{ 0 };
+
+    {
+        PastePump pump{ [&](const std::wstring_view chunk) {
+            entered = true;
+            DWORD bytesWritten = 0;
+            if (!WriteFile(writePipe.get(), chunk.data(), gsl::narrow<DWORD>(chunk.size() * sizeof(wchar_t)), &bytesWritten, nullptr))
+            {
+                ++failedWrites;
+            }
+        } };
+
+        Log::Comment(L"Nothing reads from the pipe, so writing the paste fills it up and blocks.");
+        pump.Paste(std::wstring(1024 * 1024, L'x'), false);
+        while (!entered)
+        {
+            Sleep(1);
+        }
+        Sleep(100);
+
+        Log::Comment(L"Destroying the pump must not wait for the pipe to be read.");
+    }
+
+    VERIFY_ARE_EQUAL(1u, failedWrites.load());
+}
@@ -34,6 +34,10 @@ namespace TerminalCoreUnitTests
         // PrintString() is called with more code units than the buffer width.
         TEST_METHOD(PrintStringOfSurrogatePairs);
         TEST_METHOD(CheckDoubleWidthCursor);
+
+        TEST_METHOD(BracketedPasteModeViaStateMachine);
+
+        TEST_METHOD(TabStopsViaStateMachine);
     };
 };
 
@@ -251,3 +255,73 @@ void TerminalApiTest::CheckDoubleWidthCursor()
     term.SetCursorPosition(1, 1);
     VERIFY_IS_TRUE(term.IsCursorDoubleWidth());
 }
+
+void TerminalApiTest::BracketedPasteModeViaStateMachine()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 100, 100 }, 0, emptyRT);
+
+    auto& stateMachine = *(term._stateMachine);
+
+    VERIFY_IS_FALSE(term.IsXtermBracketedPasteModeEnabled());
+
+    stateMachine.ProcessString(L"\x1b[?2004h");
+    VERIFY_IS_TRUE(term.IsXtermBracketedPasteModeEnabled());
+
+    stateMachine.ProcessString(L"\x1b[?2004l");
+    VERIFY_IS_FALSE(term.IsXtermBracketedPasteModeEnabled());
+
+    Log::Comment(L"A hard reset should turn bracketed pastes back off.");
+    stateMachine.ProcessString(L"\x1b[?2004h");
+    VERIFY_IS_TRUE(term.IsXtermBracketedPasteModeEnabled());
+    stateMachine.ProcessString(L"\x1b" L"c");
+    VERIFY_IS_FALSE(term.IsXtermBracketedPasteModeEnabled());
+}
+
+void TerminalApiTest::TabStopsViaStateMachine()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    // Wide enough for the tab stops to span several words of the bitmap.
+    term.Create({ 200, 100 }, 0, emptyRT);
+
+    auto& stateMachine = *(term._stateMachine);
+    const auto column = [&]() { return term.GetCursorPosition().X; };
+
+    Log::Comment(L"The default tab stops are every 8 columns.");
+    stateMachine.ProcessString(L"\t");
+    VERIFY_ARE_EQUAL(8, column());
+    stateMachine.ProcessString(L"\x1b[3I");
+    VERIFY_ARE_EQUAL(32, column());
+    stateMachine.ProcessString(L"\x1b[2Z");
+    VERIFY_ARE_EQUAL(16, column());
+
+    Log::Comment(L"Tabs stop at the right edge, and backwards tabs at the left edge.");
+    stateMachine.ProcessString(L"\x1b[1;190H\t");
+    VERIFY_ARE_EQUAL(192, column());
+    stateMachine.ProcessString(L"\t");
+    VERIFY_ARE_EQUAL(199, column());
+    stateMachine.ProcessString(L"\t");
+    VERIFY_ARE_EQUAL(199, column());
+    stateMachine.ProcessString(L"\x1b[30Z");
+    VERIFY_ARE_EQUAL(0, column());
+
+    Log::Comment(L"Clear all the tab stops, and set a single one in column 130.");
+    stateMachine.ProcessString(L"\x1b[3g\t");
+    VERIFY_ARE_EQUAL(199, column());
+    stateMachine.ProcessString(L"\x1b[1;131H\x1bH\r\t");
+    VERIFY_ARE_EQUAL(130, column());
+    stateMachine.ProcessString(L"\x1b[1;200H\x1b[Z");
+    VERIFY_ARE_EQUAL(130, column());
+    stateMachine.ProcessString(L"\x1b[Z");
+    VERIFY_ARE_EQUAL(0, column());
+
+    Log::Comment(L"Clear the tab stop in column 130.");
+    stateMachine.ProcessString(L"\x1b[1;131H\x1b[g\r\t");
+    VERIFY_ARE_EQUAL(199, column());
+
+    Log::Comment(L"A hard reset should bring the default tab stops back.");
+    stateMachine.ProcessString(L"\x1b" L"c\t");
+    VERIFY_ARE_EQUAL(8, column());
+}
@@ -17,6 +17,47 @@ using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
 
+namespace
+{
+    class MockRedrawRenderTarget final : public ::Microsoft::Console::Render::IRenderTarget
+    {
+    public:
+        ~MockRedrawRenderTarget() override{};
+
+        bool WasRedrawn(const COORD position) const
+        {
+            return std::any_of(_redrawn.begin(), _redrawn.end(), [=](const auto& region) {
+                return region.IsInBounds(position);
+            });
+        }
+
+        void Reset()
+        {
+            _redrawn.clear();
+        }
+
+        virtual void TriggerRedraw(const Microsoft::Console::Types::Viewport& region)
+        {
+            _redrawn.push_back(region);
+        };
+        virtual void TriggerRedraw(const COORD* const position)
+        {
+            _redrawn.push_back(Microsoft::Console::Types::Viewport::FromCoord(*position));
+        };
+        virtual void TriggerRedrawCursor(const COORD* const){};
+        virtual void TriggerRedrawAll(){};
+        virtual void TriggerTeardown(){};
+        virtual void TriggerSelection(){};
+        virtual void TriggerScroll(){};
+        virtual void TriggerScroll(const COORD* const){};
+        virtual void TriggerCircling(){};
+        void TriggerTitleChange(){};
+
+    private:
+        std::vector<Microsoft::Console::Types::Viewport> _redrawn;
+    };
+}
+
 namespace TerminalCoreUnitTests
 {
     class TerminalBufferTests;
@@ -38,6 +79,7 @@ class TerminalCoreUnitTests::TerminalBufferTests final
 
     TEST_METHOD(TestWrappingCharByChar);
     TEST_METHOD(TestWrappingALongString);
+    TEST_METHOD(TestPaddingForWideGlyphIsPainted);
 
     TEST_METHOD_SETUP(MethodSetup)
     {
@@ -149,3 +191,32 @@ void TerminalBufferTests::TestWrappingALongString()
 
     TestUtils::VerifyExpectedString(termTb, TestUtils::Test100CharsString, { 0, 0 });
 }
+
+void TerminalBufferTests::TestPaddingForWideGlyphIsPainted()
+{
+    MockRedrawRenderTarget renderTarget;
+    Terminal terminal;
+    terminal.Create({ TerminalViewWidth, TerminalViewHeight }, TerminalHistoryLength, renderTarget);
+
+    auto& termTb = *terminal._buffer;
+    auto& termSm = *terminal._stateMachine;
+    const SHORT lastColumn = TerminalViewWidth - 1;
+
+    Log::Comment(L"Fill the last column, so that the padding has something to overwrite.");
+    termSm.ProcessString(std::wstring(TerminalViewWidth, L'y'));
+    termSm.ProcessString(L"\x1b[H");
+    renderTarget.Reset();
+
+    Log::Comment(L"A wide glyph doesn't fit in the last column, so that's padded out.");
+    termSm.ProcessString(std::wstring(lastColumn, L'x'));
+    termSm.ProcessString(L"\x65e5");
+
+    const auto& charRow = termTb.GetRowByOffset(0).GetCharRow();
+    VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, std::wstring_view{ charRow.GlyphAt(lastColumn) });
+    VERIFY_IS_TRUE(charRow.WasWrapForced());
+    VERIFY_IS_TRUE(charRow.WasDoubleBytePadded());
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x65e5" }, std::wstring_view{ termTb.GetRowByOffset(1).GetCharRow().GlyphAt(0) });
+
+    Log::Comment(L"The padding has to be painted, or the old glyph stays on the screen.");
+    VERIFY_IS_TRUE(renderTarget.WasRedrawn({ lastColumn, 0 }));
+}
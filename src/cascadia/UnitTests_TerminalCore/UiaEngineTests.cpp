@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include <WexTestClass.h>
+
+#include "../renderer/uia/UiaRenderer.hpp"
+#include "consoletaeftemplates.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+using namespace std::chrono_literals;
+
+namespace TerminalCoreUnitTests
+{
+    class DummyUiaEventDispatcher final : public IUiaEventDispatcher
+    {
+    public:
+        void SignalSelectionChanged() override {}
+        void SignalTextChanged() override { ++textChanged; }
+        void SignalCursorChanged() override {}
+
+        std::atomic<size_t> textChanged{ 0 };
+    };
+
+    class UiaEngineTests
+    {
+        TEST_CLASS(UiaEngineTests);
+
+        TEST_METHOD(RaisesHeldBackTextChangedWithoutAnotherFrame);
+    };
+};
+
+using namespace TerminalCoreUnitTests;
+
+void UiaEngineTests::RaisesHeldBackTextChangedWithoutAnotherFrame()
+{
+    DummyUiaEventDispatcher dispatcher;
+    UiaEngine engine{ &dispatcher };
+    const SMALL_RECT region{ 0, 0, 0, 0 };
+
+    Log::Comment(L"The first change is announced right away.");
+    VERIFY_SUCCEEDED(engine.Invalidate(&region));
+    VERIFY_ARE_EQUAL(S_OK, engine.StartPaint());
+    VERIFY_SUCCEEDED(engine.EndPaint());
+    VERIFY_ARE_EQUAL(1u, dispatcher.textChanged.load());
+
+    Log::Comment(L"A change right after it is held back by the rate limit.");
+    VERIFY_SUCCEEDED(engine.Invalidate(&region));
+    VERIFY_ARE_EQUAL(S_OK, engine.StartPaint());
+    VERIFY_SUCCEEDED(engine.EndPaint());
+    VERIFY_ARE_EQUAL(1u, engine.GetDeferredEventCount());
+    VERIFY_ARE_EQUAL(1u, dispatcher.textChanged.load());
+
+    Log::Comment(L"Nothing else is painted, and it's still raised once the interval is over.");
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (dispatcher.textChanged.load() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        Sleep(10);
+    }
+    VERIFY_ARE_EQUAL(2u, dispatcher.textChanged.load());
+
+    Log::Comment(L"It's raised once only, and leaves nothing for the next frame.");
+    VERIFY_ARE_EQUAL(S_FALSE, engine.StartPaint());
+    Sleep(100);
+    VERIFY_ARE_EQUAL(2u, dispatcher.textChanged.load());
+}
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "AccessibilityEventAggregator.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console;
+
+// Routine Description:
+// - Creates a new aggregator.
+// Arguments:
+// - window - the span of time over which changed regions are merged together.
+// - maxEventsPerSecond - the most notifications that will be released in any
+//      one second. The effective interval between notifications is the longer
+//      of the window and 1s / maxEventsPerSecond. 0 means no rate limit.
+AccessibilityEventAggregator::AccessibilityEventAggregator(const std::chrono::milliseconds window,
+                                                           const size_t maxEventsPerSecond) noexcept :
+    _interval{ std::max<clock::duration>(window,
+                                         maxEventsPerSecond ? clock::duration{ std::chrono::seconds{ 1 } } / maxEventsPerSecond : clock::duration::zero()) },
+    _pending{},
+    _lastEmit{},
+    _emitted{ 0 },
+    _merged{ 0 },
+    _dropped{ 0 }
+{
+}
+
+// Routine Description:
+// - Records that the given region of the buffer changed.
+// Arguments:
+// - changed - the inclusive rectangle that changed.
+// - now - the current time.
+// Return Value:
+// - The region that should be announced right now, if any. When nothing is
+//   returned, the change was merged into a pending region that will be
+//   released by a later call to Add or Flush.
+std::optional<SMALL_RECT> AccessibilityEventAggregator::Add(const SMALL_RECT changed, const clock::time_point now) noexcept
+{
+    if (_pending.has_value())
+    {
+        auto& pending = _pending.value();
+        pending.Left = std::min(pending.Left, changed.Left);
+        pending.Top = std::min(pending.Top, changed.Top);
+        pending.Right = std::max(pending.Right, changed.Right);
+        pending.Bottom = std::max(pending.Bottom, changed.Bottom);
+        ++_merged;
+    }
+    else
+    {
+        _pending = changed;
+    }
+
+    return _TryEmit(now);
+}
+
+// Routine Description:
+// - Releases the pending region if the rate limit allows it. This should be
+//   called periodically so that the tail end of a burst of output is
+//   announced even when no further changes arrive.
+// Arguments:
+// - now - the current time.
+// Return Value:
+// - The region that should be announced right now, if any.
+std::optional<SMALL_RECT> AccessibilityEventAggregator::Flush(const clock::time_point now) noexcept
+{
+    return _TryEmit(now);
+}
+
+// Routine Description:
+// - Records that a change was discarded without being announced, because
+//   nobody is listening. Any pending region is discarded as well.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void AccessibilityEventAggregator::Drop() noexcept
+{
+    if (_pending.has_value())
+    {
+        _pending.reset();
+        ++_dropped;
+    }
+    ++_dropped;
+}
+
+bool AccessibilityEventAggregator::IsPending() const noexcept
+{
+    return _pending.has_value();
+}
+
+// Routine Description:
+// - Gets how long the pending region has to wait until Flush releases it.
+// Arguments:
+// - now - the current time.
+// Return Value:
+// - The time left until the rate limit allows the next notification, which
+//   may be zero, or nothing if no region is pending.
+std::optional<AccessibilityEventAggregator::clock::duration> AccessibilityEventAggregator::TimeUntilFlush(const clock::time_point now) const noexcept
+{
+    if (!_pending.has_value())
+    {
+        return std::nullopt;
+    }
+
+    if (!_lastEmit.has_value() || now - _lastEmit.value() >= _interval)
+    {
+        return clock::duration::zero();
+    }
+
+    return _interval - (now - _lastEmit.value());
+}
+
+// Routine Description:
+// - Gets the number of notifications that were actually released.
+size_t AccessibilityEventAggregator::GetEmittedCount() const noexcept
+{
+    return _emitted;
+}
+
+// Routine Description:
+// - Gets the number of changes that were folded into an already pending
+//   region instead of being announced on their own.
+size_t AccessibilityEventAggregator::GetMergedCount() const noexcept
+{
+    return _merged;
+}
+
+// Routine Description:
+// - Gets the number of changes (or pending regions) that were thrown away
+//   because nobody was listening.
+size_t AccessibilityEventAggregator::GetDroppedCount() const noexcept
+{
+    return _dropped;
+}
+
+std::optional<SMALL_RECT> AccessibilityEventAggregator::_TryEmit(const clock::time_point now) noexcept
+{
+    if (!_pending.has_value())
+    {
+        return std::nullopt;
+    }
+
+    if (_lastEmit.has_value() && now - _lastEmit.value() < _interval)
+    {
+        return std::nullopt;
+    }
+
+    _lastEmit = now;
+    ++_emitted;
+
+    const auto region = _pending;
+    _pending.reset();
+    return region;
+}
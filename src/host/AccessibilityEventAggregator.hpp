@@ -0,0 +1,62 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- AccessibilityEventAggregator.hpp
+
+Abstract:
+- Coalesces the "region changed" accessibility notifications raised by the
+  screen buffer. Output that touches many cells in quick succession (a flood of
+  text, a scrolling app, a progress bar) would otherwise raise one WinEvent and
+  one UIA TextChanged event per write. Instead, changed regions are merged into
+  their bounding rectangle and released at most once per interval.
+- The first change after a quiet period is released immediately so that
+  interactive echo (typing at a prompt) is not delayed. Anything that arrives
+  inside the interval is folded into a pending region that is released by the
+  next change or by Flush once the interval has elapsed. TimeUntilFlush says
+  when that is, so that the owner can schedule the Flush.
+
+Author(s):
+- Microsoft Console Team
+--*/
+
+#pragma once
+
+namespace Microsoft::Console
+{
+    class AccessibilityEventAggregator final
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        static constexpr std::chrono::milliseconds DefaultWindow{ 50 };
+        static constexpr size_t DefaultMaxEventsPerSecond = 20;
+
+        AccessibilityEventAggregator(const std::chrono::milliseconds window = DefaultWindow,
+                                     const size_t maxEventsPerSecond = DefaultMaxEventsPerSecond) noexcept;
+
+        [[nodiscard]] std::optional<SMALL_RECT> Add(const SMALL_RECT changed, const clock::time_point now) noexcept;
+        [[nodiscard]] std::optional<SMALL_RECT> Flush(const clock::time_point now) noexcept;
+        void Drop() noexcept;
+
+        bool IsPending() const noexcept;
+        std::optional<clock::duration> TimeUntilFlush(const clock::time_point now) const noexcept;
+
+        size_t GetEmittedCount() const noexcept;
+        size_t GetMergedCount() const noexcept;
+        size_t GetDroppedCount() const noexcept;
+
+    private:
+        std::optional<SMALL_RECT> _TryEmit(const clock::time_point now) noexcept;
+
+        const clock::duration _interval;
+
+        std::optional<SMALL_RECT> _pending;
+        std::optional<clock::time_point> _lastEmit;
+
+        size_t _emitted;
+        size_t _merged;
+        size_t _dropped;
+    };
+}
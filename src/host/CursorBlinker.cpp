@@ -12,7 +12,9 @@ using namespace Microsoft::Console::Interactivity;
 CursorBlinker::CursorBlinker() :
     _hCaretBlinkTimer(INVALID_HANDLE_VALUE),
     _hCaretBlinkTimerQueue(THROW_LAST_ERROR_IF_NULL(CreateTimerQueue())),
-    _uCaretBlinkTime(INFINITE) // default to no blink
+    _uCaretBlinkTime(INFINITE), // default to no blink
+    _hAccessibilityFlushTimer(INVALID_HANDLE_VALUE),
+    _fAccessibilityFlushPending(false)
 {
 }
 
@@ -69,6 +71,9 @@ void CursorBlinker::TimerRoutine(SCREEN_INFORMATION& ScreenInfo)
         goto DoScroll;
     }
 
+    // Announce the tail end of any burst of output that was coalesced.
+    ScreenInfo.FlushAccessibilityEventing();
+
     // Update the cursor pos in USER so accessibility will work.
     if (cursor.HasMoved())
     {
@@ -176,6 +181,36 @@ void CALLBACK CursorTimerRoutineWrapper(_In_ PVOID /* lpParam */, _In_ BOOLEAN /
     }
 }
 
+// Routine Description:
+// - Announces the accessibility events that the active screen buffer held back
+//   because they arrived too soon after the previous ones. Unlike the blink
+//   timer, this also runs while the console doesn't have the focus.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CursorBlinker::AccessibilityFlushTimerRoutine()
+{
+    _fAccessibilityFlushPending = false;
+
+    // The console lock mustn't be waited for here, for the same reasons as in
+    // CursorTimerRoutineWrapper. If it's taken, the flush is skipped, and the
+    // next change to the buffer schedules another one.
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+    if (gci.TryLockConsole() != false)
+    {
+        gci.GetActiveOutputBuffer().FlushAccessibilityEventing();
+        gci.UnlockConsole();
+    }
+}
+
+void CALLBACK AccessibilityFlushTimerRoutineWrapper(_In_ PVOID /* lpParam */, _In_ BOOLEAN /* TimerOrWaitFired */)
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.GetCursorBlinker().AccessibilityFlushTimerRoutine();
+}
+
 // Routine Description:
 // - If guCaretBlinkTime is -1, we don't want to blink the caret. However, we
 //   need to make sure it gets drawn, so we'll set a short timer. When that
@@ -228,3 +263,53 @@ void CursorBlinker::KillCaretTimer()
         }
     }
 }
+
+// Routine Description:
+// - Arms a one-shot timer that announces held back accessibility events once
+//   the rate limit allows it. Only one is ever needed, since a flush announces
+//   everything that is pending at that point.
+// - NOTE: Must be called with the console lock held.
+// Arguments:
+// - dwDueTime - the time in milliseconds until the flush
+// Return Value:
+// - <none>
+void CursorBlinker::SetAccessibilityFlushTimer(const DWORD dwDueTime)
+{
+    if (_fAccessibilityFlushPending.exchange(true))
+    {
+        return;
+    }
+
+    // The previous one-shot timer has fired by now, but it still has to be deleted.
+    KillAccessibilityFlushTimer();
+
+    const bool bRet = CreateTimerQueueTimer(&_hAccessibilityFlushTimer,
+                                            _hCaretBlinkTimerQueue,
+                                            AccessibilityFlushTimerRoutineWrapper,
+                                            this,
+                                            dwDueTime,
+                                            0,
+                                            WT_EXECUTEONLYONCE);
+    if (!bRet)
+    {
+        LOG_LAST_ERROR();
+        _hAccessibilityFlushTimer = INVALID_HANDLE_VALUE;
+        _fAccessibilityFlushPending = false;
+    }
+}
+
+void CursorBlinker::KillAccessibilityFlushTimer()
+{
+    if (_hAccessibilityFlushTimer != INVALID_HANDLE_VALUE)
+    {
+        // See KillCaretTimer for why ERROR_IO_PENDING counts as a success.
+        if (!DeleteTimerQueueTimer(_hCaretBlinkTimerQueue, _hAccessibilityFlushTimer, nullptr) && GetLastError() != ERROR_IO_PENDING)
+        {
+            LOG_LAST_ERROR();
+        }
+        else
+        {
+            _hAccessibilityFlushTimer = INVALID_HANDLE_VALUE;
+        }
+    }
+}
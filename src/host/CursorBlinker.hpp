@@ -26,6 +26,8 @@ namespace Microsoft::Console
         void UpdateSystemMetrics();
         void SettingsChanged();
         void TimerRoutine(SCREEN_INFORMATION& ScreenInfo);
+        void SetAccessibilityFlushTimer(const DWORD dwDueTime);
+        void AccessibilityFlushTimerRoutine();
 
     private:
         // These use Timer Queues:
@@ -33,7 +35,10 @@ namespace Microsoft::Console
         HANDLE _hCaretBlinkTimer; // timer used to periodically blink the cursor
         HANDLE _hCaretBlinkTimerQueue; // timer queue where the blink timer lives
         UINT _uCaretBlinkTime;
+        HANDLE _hAccessibilityFlushTimer; // one-shot timer that announces accessibility events held back by the rate limit
+        std::atomic<bool> _fAccessibilityFlushPending;
         void SetCaretTimer();
         void KillCaretTimer();
+        void KillAccessibilityFlushTimer();
     };
 }
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "InputRecordQueue.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console;
+
+// The first allocation holds this many records. Must be a power of two.
+static constexpr size_t InitialCapacity = 64;
+
+InputRecordQueue::InputRecordQueue() noexcept :
+    _buffer{},
+    _head{ 0 },
+    _size{ 0 }
+{
+}
+
+size_t InputRecordQueue::size() const noexcept
+{
+    return _size;
+}
+
+bool InputRecordQueue::empty() const noexcept
+{
+    return _size == 0;
+}
+
+size_t InputRecordQueue::capacity() const noexcept
+{
+    return _buffer.size();
+}
+
+// Routine Description:
+// - Gets the record at the given position, counting from the front of the queue.
+// Arguments:
+// - index - the position of the record. Must be less than size().
+// Return Value:
+// - the record.
+INPUT_RECORD& InputRecordQueue::operator[](const size_t index) noexcept
+{
+    return til::at(_buffer, _Physical(index));
+}
+
+const INPUT_RECORD& InputRecordQueue::operator[](const size_t index) const noexcept
+{
+    return til::at(_buffer, _Physical(index));
+}
+
+INPUT_RECORD& InputRecordQueue::front() noexcept
+{
+    return (*this)[0];
+}
+
+const INPUT_RECORD& InputRecordQueue::front() const noexcept
+{
+    return (*this)[0];
+}
+
+INPUT_RECORD& InputRecordQueue::back() noexcept
+{
+    return (*this)[_size - 1];
+}
+
+const INPUT_RECORD& InputRecordQueue::back() const noexcept
+{
+    return (*this)[_size - 1];
+}
+
+// Routine Description:
+// - Adds a record to the end of the queue.
+// Arguments:
+// - record - the record to add.
+// Return Value:
+// - <none>
+void InputRecordQueue::push_back(const INPUT_RECORD& record)
+{
+    _Reserve(_size + 1);
+    til::at(_buffer, _Physical(_size)) = record;
+    ++_size;
+}
+
+// Routine Description:
+// - Adds a record to the front of the queue.
+// Arguments:
+// - record - the record to add.
+// Return Value:
+// - <none>
+void InputRecordQueue::push_front(const INPUT_RECORD& record)
+{
+    _Reserve(_size + 1);
+    _head = (_head + _buffer.size() - 1) & (_buffer.size() - 1);
+    til::at(_buffer, _head) = record;
+    ++_size;
+}
+
+// Routine Description:
+// - Adds records to the end of the queue, growing it at most once.
+// Arguments:
+// - records - the records to add, in order.
+// Return Value:
+// - <none>
+void InputRecordQueue::append(const gsl::span<const INPUT_RECORD> records)
+{
+    _Reserve(_size + records.size());
+
+    // Copy in at most two pieces: up to the end of the buffer, then from its start.
+    const auto tail = _Physical(_size);
+    const auto first = std::min(records.size(), _buffer.size() - tail);
+    std::copy_n(records.begin(), first, _buffer.begin() + tail);
+    std::copy(records.begin() + first, records.end(), _buffer.begin());
+
+    _size += records.size();
+}
+
+void InputRecordQueue::pop_front() noexcept
+{
+    pop_front(1);
+}
+
+// Routine Description:
+// - Removes records from the front of the queue.
+// Arguments:
+// - count - the number of records to remove. Clamped to size().
+// Return Value:
+// - <none>
+void InputRecordQueue::pop_front(const size_t count) noexcept
+{
+    const auto removed = std::min(count, _size);
+    _size -= removed;
+    _head = _size ? _Physical(removed) : 0;
+}
+
+void InputRecordQueue::clear() noexcept
+{
+    _head = 0;
+    _size = 0;
+}
+
+// Routine Description:
+// - Rearranges the storage so that the queued records are contiguous, front first.
+// Return Value:
+// - a view of every queued record. It's invalidated by the next change to the queue.
+gsl::span<const INPUT_RECORD> InputRecordQueue::linearize() noexcept
+{
+    if (_head + _size > _buffer.size())
+    {
+        std::rotate(_buffer.begin(), _buffer.begin() + _head, _buffer.end());
+        _head = 0;
+    }
+    return { _buffer.data() + _head, _size };
+}
+
+size_t InputRecordQueue::_Physical(const size_t index) const noexcept
+{
+    return (_head + index) & (_buffer.size() - 1);
+}
+
+// Routine Description:
+// - Makes sure there's room for at least the given number of records,
+//   reallocating and unwrapping the queue if there isn't.
+// Arguments:
+// - count - the number of records that need to fit.
+// Return Value:
+// - <none>
+void InputRecordQueue::_Reserve(const size_t count)
+{
+    if (count <= _buffer.size())
+    {
+        return;
+    }
+
+    auto newCapacity = std::max(_buffer.size(), InitialCapacity);
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+
+    std::vector<INPUT_RECORD> newBuffer(newCapacity);
+    for (size_t i = 0; i < _size; ++i)
+    {
+        til::at(newBuffer, i) = (*this)[i];
+    }
+
+    _buffer.swap(newBuffer);
+    _head = 0;
+}
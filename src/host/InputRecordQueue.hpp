@@ -0,0 +1,83 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- InputRecordQueue.hpp
+
+Abstract:
+- A growable ring buffer of INPUT_RECORDs, used as the backing store of the
+  input buffer. INPUT_RECORD is already a tagged union of every kind of input
+  event, so storing records by value means that queueing a keystroke, a mouse
+  move or a character of a paste doesn't cost a heap allocation, and that
+  peeking at the queue doesn't have to clone anything.
+- The capacity is always a power of two so that wrapping around is a mask.
+  Storage only ever grows; clearing the queue keeps its capacity.
+
+Author(s):
+- Microsoft Console Team
+--*/
+
+#pragma once
+
+namespace Microsoft::Console
+{
+    class InputRecordQueue final
+    {
+    public:
+        InputRecordQueue() noexcept;
+
+        size_t size() const noexcept;
+        bool empty() const noexcept;
+        size_t capacity() const noexcept;
+
+        INPUT_RECORD& operator[](const size_t index) noexcept;
+        const INPUT_RECORD& operator[](const size_t index) const noexcept;
+
+        INPUT_RECORD& front() noexcept;
+        const INPUT_RECORD& front() const noexcept;
+        INPUT_RECORD& back() noexcept;
+        const INPUT_RECORD& back() const noexcept;
+
+        void push_back(const INPUT_RECORD& record);
+        void push_front(const INPUT_RECORD& record);
+        void append(const gsl::span<const INPUT_RECORD> records);
+
+        void pop_front() noexcept;
+        void pop_front(const size_t count) noexcept;
+        void clear() noexcept;
+
+        gsl::span<const INPUT_RECORD> linearize() noexcept;
+
+        // Routine Description:
+        // - Removes every record for which the predicate returns true,
+        //   keeping the order of the remaining records.
+        // Arguments:
+        // - predicate - called with each record, in order.
+        // Return Value:
+        // - <none>
+        template<typename Predicate>
+        void erase_if(Predicate predicate)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < _size; ++i)
+            {
+                const auto& record = (*this)[i];
+                if (!predicate(record))
+                {
+                    (*this)[kept] = record;
+                    ++kept;
+                }
+            }
+            _size = kept;
+        }
+
+    private:
+        size_t _Physical(const size_t index) const noexcept;
+        void _Reserve(const size_t count);
+
+        std::vector<INPUT_RECORD> _buffer;
+        size_t _head;
+        size_t _size;
+    };
+}
@@ -18,6 +18,10 @@
 using namespace Microsoft::Console;
 using namespace Microsoft::Console::Interactivity;
 using namespace Microsoft::Console::VirtualTerminal;
+
+// How often the input throughput gets reported, while there is input.
+static constexpr std::chrono::seconds ThroughputReportInterval{ 1 };
+
 // Constructor Description:
 // - Creates the VT Input Thread.
 // Arguments:
@@ -28,10 +32,17 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
                              const bool inheritCursor) :
     _hFile{ std::move(hPipe) },
     _hThread{},
+    _pDispatch{ nullptr },
     _u8State{},
     _dwThreadId{ 0 },
     _exitRequested{ false },
-    _exitResult{ S_OK }
+    _exitResult{ S_OK },
+    _readBuffer(ReadBufferSize),
+    _wstr{},
+    _throughputStart{ std::chrono::steady_clock::now() },
+    _busyTime{ 0 },
+    _bytesRead{ 0 },
+    _eventsWritten{ 0 }
 {
     THROW_HR_IF(E_HANDLE, _hFile.get() == INVALID_HANDLE_VALUE);
 
@@ -41,6 +52,8 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
 
     auto dispatch = std::make_unique<InteractDispatch>(std::move(pGetSet));
 
+    _pDispatch = dispatch.get();
+
     auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch), inheritCursor);
 
     auto engineRef = engine.get();
@@ -56,6 +69,8 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
 // - Processes a string of input characters. The characters should be UTF-8
 //      encoded, and will get converted to wstring to be processed by the
 //      input state machine.
+// - All of the input events parsed out of the string are written to the input
+//      buffer at once, rather than one sequence at a time.
 // Arguments:
 // - u8Str - the UTF-8 string received.
 // Return Value:
@@ -70,22 +85,62 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+    const auto start = std::chrono::steady_clock::now();
+
     try
     {
-        std::wstring wstr{};
-        auto hr = til::u8u16(u8Str, wstr, _u8State);
+        // _wstr keeps its capacity between calls, so this only allocates when
+        // a read brings in more text than any read before it.
+        auto hr = til::u8u16(u8Str, _wstr, _u8State);
         // If we hit a parsing error, eat it. It's bad utf-8, we can't do anything with it.
         if (FAILED(hr))
         {
             return S_FALSE;
         }
-        _pInputStateMachine->ProcessString(wstr);
+
+        _pDispatch->BeginInputBatch();
+        auto endBatch = wil::scope_exit([&] {
+            size_t eventsWritten = 0;
+            LOG_HR_IF(E_FAIL, !_pDispatch->EndInputBatch(eventsWritten));
+            _UpdateThroughput(u8Str.size(), eventsWritten, std::chrono::steady_clock::now() - start);
+        });
+
+        _pInputStateMachine->ProcessString(_wstr);
     }
     CATCH_RETURN();
 
     return S_OK;
 }
 
+// Method Description:
+// - Accumulates input throughput, and reports it once enough time has passed
+//      since the last report.
+// Arguments:
+// - bytes - the number of bytes that were just processed.
+// - events - the number of input events they produced.
+// - busyTime - the time it took to process them.
+// Return Value:
+// - <none>
+void VtInputThread::_UpdateThroughput(const size_t bytes,
+                                      const size_t events,
+                                      const std::chrono::nanoseconds busyTime) noexcept
+{
+    _bytesRead += bytes;
+    _eventsWritten += events;
+    _busyTime += busyTime;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _throughputStart >= ThroughputReportInterval)
+    {
+        Tracing::s_TraceVtInputThroughput(_bytesRead, _eventsWritten, _busyTime);
+
+        _throughputStart = now;
+        _busyTime = std::chrono::nanoseconds::zero();
+        _bytesRead = 0;
+        _eventsWritten = 0;
+    }
+}
+
 // Function Description:
 // - Static function used for initializing an instance's ThreadProc.
 // Arguments:
@@ -108,9 +163,12 @@ DWORD WINAPI VtInputThread::StaticVtInputThreadProc(_In_ LPVOID lpParameter)
 // - <none>
 void VtInputThread::DoReadInput(const bool throwOnFail)
 {
-    char buffer[256];
     DWORD dwRead = 0;
-    bool fSuccess = !!ReadFile(_hFile.get(), buffer, ARRAYSIZE(buffer), &dwRead, nullptr);
+    bool fSuccess = !!ReadFile(_hFile.get(),
+                               _readBuffer.data(),
+                               gsl::narrow_cast<DWORD>(_readBuffer.size()),
+                               &dwRead,
+                               nullptr);
 
     // If we failed to read because the terminal broke our pipe (usually due
     //      to dying itself), close gracefully with ERROR_BROKEN_PIPE.
@@ -123,7 +181,7 @@ void VtInputThread::DoReadInput(const bool throwOnFail)
         return;
     }
 
-    HRESULT hr = _HandleRunInput({ buffer, gsl::narrow_cast<size_t>(dwRead) });
+    HRESULT hr = _HandleRunInput({ _readBuffer.data(), gsl::narrow_cast<size_t>(dwRead) });
     if (FAILED(hr))
     {
         if (throwOnFail)
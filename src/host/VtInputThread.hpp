@@ -16,6 +16,11 @@ Author(s):
 
 #include "..\terminal\parser\StateMachine.hpp"
 
+namespace Microsoft::Console::VirtualTerminal
+{
+    class InteractDispatch;
+}
+
 namespace Microsoft::Console
 {
     class VtInputThread
@@ -27,9 +32,14 @@ namespace Microsoft::Console
         static DWORD WINAPI StaticVtInputThreadProc(_In_ LPVOID lpParameter);
         void DoReadInput(const bool throwOnFail);
 
+        // The size of a single read from the pipe. Large enough that a paste
+        // usually arrives in one piece.
+        static constexpr size_t ReadBufferSize = 16 * 1024;
+
     private:
         [[nodiscard]] HRESULT _HandleRunInput(const std::string_view u8Str);
         DWORD _InputThread();
+        void _UpdateThroughput(const size_t bytes, const size_t events, const std::chrono::nanoseconds busyTime) noexcept;
 
         wil::unique_hfile _hFile;
         wil::unique_handle _hThread;
@@ -39,6 +49,18 @@ namespace Microsoft::Console
         HRESULT _exitResult;
 
         std::unique_ptr<Microsoft::Console::VirtualTerminal::StateMachine> _pInputStateMachine;
+        // Owned by the state machine's engine.
+        Microsoft::Console::VirtualTerminal::InteractDispatch* _pDispatch;
         til::u8state _u8State;
+
+        // Reused by every read, so that reading and converting input doesn't allocate.
+        std::vector<char> _readBuffer;
+        std::wstring _wstr;
+
+        // Input throughput since it was last reported.
+        std::chrono::steady_clock::time_point _throughputStart;
+        std::chrono::nanoseconds _busyTime;
+        size_t _bytesRead;
+        size_t _eventsWritten;
     };
 }
@@ -14,6 +14,7 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../types/inc/Viewport.hpp"
 #include "../types/inc/convert.hpp"
+#include "../types/inc/GlyphWidth.hpp"
 #include "../types/inc/Utf16Parser.hpp"
 
 #include <algorithm>
@@ -218,11 +219,8 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
 
     try
     {
-        TextAttribute useThisAttr(attribute);
-        const OutputCellIterator it(useThisAttr, lengthToWrite);
-        const auto done = screenBuffer.Write(it, startingCoordinate);
-
-        cellsModified = done.GetCellDistance(it);
+        const TextAttribute useThisAttr(attribute);
+        cellsModified = screenBuffer.GetTextBuffer().FillCells(startingCoordinate, lengthToWrite, std::nullopt, useThisAttr);
 
         // Notify accessibility
         auto endingCoordinate = startingCoordinate;
@@ -276,12 +274,19 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     HRESULT hr = S_OK;
     try
     {
-        const OutputCellIterator it(character, lengthToWrite);
-
         // when writing to the buffer, specifically unset wrap if we get to the last column.
         // a fill operation should UNSET wrap in that scenario. See GH #1126 for more details.
-        const auto done = screenInfo.Write(it, startingCoordinate, false);
-        cellsModified = done.GetInputDistance(it);
+        if (IsGlyphFullWidth(character))
+        {
+            // Full-width characters take up two cells each, so they go through the iterator.
+            const OutputCellIterator it(character, lengthToWrite);
+            const auto done = screenInfo.Write(it, startingCoordinate, false);
+            cellsModified = done.GetInputDistance(it);
+        }
+        else
+        {
+            cellsModified = screenInfo.GetTextBuffer().FillCells(startingCoordinate, lengthToWrite, character, std::nullopt, false);
+        }
 
         // Notify accessibility
         auto endingCoordinate = startingCoordinate;
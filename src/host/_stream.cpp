@@ -340,6 +340,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     NTSTATUS Status = STATUS_SUCCESS;
     SHORT XPosition;
     WCHAR LocalBuffer[LOCAL_BUFFER_SIZE];
+    PrintRun printRun;
     size_t TempNumSpaces = 0;
     const bool fUnprocessed = WI_IsFlagClear(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT);
     const bool fWrapAtEOL = WI_IsFlagSet(screenInfo.OutputMode, ENABLE_WRAP_AT_EOL_OUTPUT);
@@ -378,7 +379,32 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         XPosition = cursor.GetPosition().X;
         size_t i = 0;
         wchar_t* LocalBufPtr = LocalBuffer;
-        while (*pcb < BufferSize && i < LOCAL_BUFFER_SIZE && XPosition < coordScreenBufferSize.X)
+
+        // Most of the time, the characters are a run of printable text. That's
+        // measured and written straight from the string in a single pass,
+        // rather than being measured here and then again while it's written.
+        bool printedRun = false;
+        if ((IS_GLYPH_CHAR(*pwchRealUnicode) || fUnprocessed) && XPosition < coordScreenBufferSize.X)
+        {
+            printRun.Compile({ lpString, (BufferSize - *pcb) / sizeof(WCHAR) },
+                             gsl::narrow_cast<size_t>(coordScreenBufferSize.X - XPosition),
+                             !fUnprocessed);
+
+            // If not even the first glyph fits, it's a wide one in the last
+            // column, and the loop below takes care of padding the row.
+            printedRun = !printRun.empty();
+            if (printedRun)
+            {
+                const auto consumed = printRun.Text().size();
+                XPosition += gsl::narrow<SHORT>(printRun.Columns());
+                pwchBuffer += consumed;
+                lpString += consumed;
+                pwchRealUnicode += consumed;
+                *pcb += consumed * sizeof(WCHAR);
+            }
+        }
+
+        while (!printedRun && *pcb < BufferSize && i < LOCAL_BUFFER_SIZE && XPosition < coordScreenBufferSize.X)
         {
 #pragma prefast(suppress : 26019, "Buffer is taken in multiples of 2. Validation is ok.")
             const wchar_t Char = *lpString;
@@ -521,7 +547,20 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             *pcb += sizeof(WCHAR);
         }
     EndWhile:
-        if (i != 0)
+        if (printedRun)
+        {
+            CursorPosition = cursor.GetPosition();
+
+            // line was wrapped if we're writing up to the end of the current row
+            textBuffer.WriteRun(printRun, CursorPosition, Attributes);
+
+            // Notify accessibility
+            const auto cells = printRun.Columns();
+            screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, CursorPosition.X + gsl::narrow<SHORT>(cells - 1), CursorPosition.Y);
+
+            TempNumSpaces += cells;
+        }
+        else if (i != 0)
         {
             CursorPosition = cursor.GetPosition();
 
@@ -541,6 +580,10 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
             // when/if we need to erase the command line.
             TempNumSpaces += itEnd.GetCellDistance(it);
+        }
+
+        if (printedRun || i != 0)
+        {
             CursorPosition.X = XPosition;
 
             // enforce a delayed newline if we're about to pass the end and the WC_DELAY_EOL_WRAP flag is set.
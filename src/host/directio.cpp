@@ -444,21 +444,71 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 }
 
 // Routine Description:
-// - Writes events to the input buffer already formed into IInputEvents (private call)
+// - Writes records to the input buffer as they are, without forming IInputEvents.
 // Arguments:
 // - context - the input buffer to write to
-// - events - the events to written
+// - records - the records to written
 // - written  - on output, the number of events written
 // - append - true if events should be written to the end of the input
 // buffer, false if they should be written to the front
 // Return Value:
 // - HRESULT indicating success or failure
+[[nodiscard]] static HRESULT _WriteConsoleInputWImplHelper(InputBuffer& context,
+                                                           const gsl::span<const INPUT_RECORD> records,
+                                                           size_t& written,
+                                                           const bool append) noexcept
+{
+    try
+    {
+        written = 0;
+
+        // Reject the same records that IInputEvent::Create would.
+        for (const auto& record : records)
+        {
+            switch (record.EventType)
+            {
+            case KEY_EVENT:
+            case MOUSE_EVENT:
+            case WINDOW_BUFFER_SIZE_EVENT:
+            case MENU_EVENT:
+            case FOCUS_EVENT:
+                break;
+            default:
+                return E_INVALIDARG;
+            }
+        }
+
+        // add to InputBuffer
+        if (append)
+        {
+            written = context.Write(records);
+        }
+        else
+        {
+            written = context.Prepend(records);
+        }
+
+        return S_OK;
+    }
+    CATCH_RETURN();
+}
+
+// Routine Description:
+// - Writes input records to the input buffer (private call)
+// Arguments:
+// - pInputBuffer - the input buffer to write to
+// - records - the records to written
+// - eventsWritten  - on output, the number of events written
+// - append - true if events should be written to the end of the input
+// buffer, false if they should be written to the front
+// Return Value:
+// - HRESULT indicating success or failure
 [[nodiscard]] HRESULT DoSrvPrivateWriteConsoleInputW(_Inout_ InputBuffer* const pInputBuffer,
-                                                     _Inout_ std::deque<std::unique_ptr<IInputEvent>>& events,
+                                                     const gsl::span<const INPUT_RECORD> records,
                                                      _Out_ size_t& eventsWritten,
                                                      const bool append) noexcept
 {
-    return _WriteConsoleInputWImplHelper(*pInputBuffer, events, eventsWritten, append);
+    return _WriteConsoleInputWImplHelper(*pInputBuffer, records, eventsWritten, append);
 }
 
 // Routine Description:
@@ -525,13 +575,7 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
     LockConsole();
     auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
-    try
-    {
-        auto events = IInputEvent::Create(buffer);
-
-        return _WriteConsoleInputWImplHelper(context, events, written, append);
-    }
-    CATCH_RETURN();
+    return _WriteConsoleInputWImplHelper(context, buffer, written, append);
 }
 
 // Function Description:
@@ -14,6 +14,7 @@
 #include "cmdline.h"
 
 #include "../types/inc/convert.hpp"
+#include "../types/inc/GlyphWidth.hpp"
 #include "../types/inc/viewport.hpp"
 
 #include "ApiRoutines.h"
@@ -2141,8 +2142,17 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        // The fill is done a row at a time, unless it's with a full-width
+        // character, which has to be laid out in pairs of cells.
+        if (IsGlyphFullWidth(fillChar))
+        {
+            const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
+            screenInfo.Write(fillData, startPosition, false);
+        }
+        else
+        {
+            screenInfo.GetTextBuffer().FillCells(startPosition, fillLength, fillChar, fillAttrs, false);
+        }
 
         // Notify accessibility
         auto endPosition = startPosition;
@@ -5,6 +5,7 @@
 #include "inputBuffer.hpp"
 #include "dbcs.h"
 #include "stream.h"
+#include "../types/inc/convert.hpp"
 #include "../types/inc/GlyphWidth.hpp"
 
 #include <functional>
@@ -151,6 +152,8 @@ void InputBuffer::ReinitializeInputBuffer()
     ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
     InputMode = INPUT_BUFFER_DEFAULT_INPUT_MODE;
     _storage.clear();
+    _textChunks.clear();
+    _textChunkOffset = 0;
 }
 
 // Routine Description:
@@ -183,9 +186,17 @@ void InputBuffer::TerminateRead(_In_ WaitTerminationReason Flag)
 // - The number of events currently in the input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
+// - Text written by WriteText counts as one event per character. Reading it
+//   as records may produce more than that, since some characters take several
+//   key events to type.
 size_t InputBuffer::GetNumberOfReadyEvents() const noexcept
 {
-    return _storage.size();
+    size_t count = _storage.size() - _textChunks.size();
+    for (const auto& text : _textChunks)
+    {
+        count += text.size();
+    }
+    return count - _textChunkOffset;
 }
 
 // Routine Description:
@@ -199,6 +210,8 @@ size_t InputBuffer::GetNumberOfReadyEvents() const noexcept
 void InputBuffer::Flush()
 {
     _storage.clear();
+    _textChunks.clear();
+    _textChunkOffset = 0;
     ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
 }
 
@@ -212,10 +225,10 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event) {
-        return event->EventType() != InputEventType::KeyEvent;
+    // Text chunks stand in for key events, so they stay too.
+    _storage.erase_if([](const INPUT_RECORD& record) noexcept {
+        return record.EventType != KEY_EVENT && record.EventType != TextChunkEventType;
     });
-    _storage.erase(newEnd, _storage.end());
 }
 
 // Routine Description:
@@ -254,10 +267,10 @@ void InputBuffer::FlushAllButKeys()
         }
 
         // read from buffer
-        std::deque<std::unique_ptr<IInputEvent>> events;
+        std::vector<INPUT_RECORD> records;
         size_t eventsRead;
         bool resetWaitEvent;
-        _ReadBuffer(events,
+        _ReadBuffer(records,
                     AmountToRead,
                     eventsRead,
                     Peek,
@@ -265,11 +278,10 @@ void InputBuffer::FlushAllButKeys()
                     Unicode,
                     Stream);
 
-        // copy events to outEvents
-        while (!events.empty())
+        // The records only become IInputEvents here, where the caller wants them.
+        for (const auto& record : records)
         {
-            OutEvents.push_back(std::move(events.front()));
-            events.pop_front();
+            OutEvents.push_back(IInputEvent::Create(record));
         }
 
         if (resetWaitEvent)
@@ -332,7 +344,7 @@ void InputBuffer::FlushAllButKeys()
 // Routine Description:
 // - This routine reads from a buffer. It does the buffer manipulation.
 // Arguments:
-// - outEvents - where read events are placed
+// - outRecords - where read records are appended
 // - readCount - amount of events to read
 // - eventsRead - where to store number of events read
 // - peek - if true , don't remove data from buffer, just copy it.
@@ -343,7 +355,7 @@ void InputBuffer::FlushAllButKeys()
 // - <none>
 // Note:
 // - The console lock must be held when calling this routine.
-void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+void InputBuffer::_ReadBuffer(_Out_ std::vector<INPUT_RECORD>& outRecords,
                               const size_t readCount,
                               _Out_ size_t& eventsRead,
                               const bool peek,
@@ -357,93 +369,62 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
 
     resetWaitEvent = false;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
+    // Any text that this read might reach has to be turned into key events.
+    if (!_textChunks.empty())
+    {
+        _ExpandTextChunks(readCount);
+    }
+
+    const size_t initialOutSize = outRecords.size();
     // we need another var to keep track of how many we've read
     // because dbcs records count for two when we aren't doing a
     // unicode read but the eventsRead count should return the number
     // of events actually put into outRecords.
     size_t virtualReadCount = 0;
+    // records are copied out without being removed, and only dropped
+    // from the front of storage at the end if we aren't peeking.
+    size_t consumed = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    while (consumed < _storage.size() && virtualReadCount < readCount)
     {
-        bool performNormalRead = true;
+        auto record = _storage[consumed];
+
         // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
+        if (streamRead &&
+            record.EventType == KEY_EVENT &&
+            record.Event.KeyEvent.wRepeatCount > 1)
         {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
+            // hand out a single repeat and leave the rest in storage
+            record.Event.KeyEvent.wRepeatCount = 1;
+            if (!peek)
             {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
-                {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
-                }
+                --_storage[consumed].Event.KeyEvent.wRepeatCount;
             }
         }
-
-        if (performNormalRead)
+        else
         {
-            readEvents.push_back(std::move(_storage.front()));
-            _storage.pop_front();
+            ++consumed;
         }
 
+        outRecords.push_back(record);
+
         ++virtualReadCount;
         if (!unicode)
         {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            if (record.EventType == KEY_EVENT &&
+                IsGlyphFullWidth(record.Event.KeyEvent.uChar.UnicodeChar))
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
-                {
-                    ++virtualReadCount;
-                }
+                ++virtualReadCount;
             }
         }
     }
 
     // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
-    {
-        if (streamRead)
-        {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                             static_cast<const KeyEvent&>(*_storage.front())))
-            {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
-            else
-            {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
-            }
-        }
-        else
-        {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
-            {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
-            }
-        }
-    }
+    eventsRead = outRecords.size() - initialOutSize;
 
-    // move events read to proper deque
-    while (!readEvents.empty())
+    if (!peek)
     {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        _storage.pop_front(consumed);
     }
 
     // signal if we emptied the buffer
@@ -457,19 +438,40 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
 // -  Writes events to the beginning of the input buffer.
 // Arguments:
 // - inEvents - events to write to buffer.
-// - eventsWritten - The number of events written to the buffer on exit.
 // Return Value:
-// S_OK if successful.
+// - The number of events written to the buffer.
 // Note:
 // - The console lock must be held when calling this routine.
 size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
+    {
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        return Prepend(inRecords);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// -  Writes records to the beginning of the input buffer.
+// Arguments:
+// - inRecords - records to write to buffer.
+// Return Value:
+// - The number of events written to the buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Prepend(const gsl::span<const INPUT_RECORD> inRecords)
 {
     try
     {
         _vtInputShouldSuppress = true;
         auto resetVtInputSuppress = wil::scope_exit([&]() { _vtInputShouldSuppress = false; });
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto records = _HandleConsoleSuspensionEvents(inRecords);
+        if (records.empty())
         {
             return STATUS_SUCCESS;
         }
@@ -478,23 +480,23 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // this way to handle any coalescing that might occur.
 
         // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        Microsoft::Console::InputRecordQueue existingStorage;
+        std::swap(existingStorage, _storage);
 
         // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
-        // However, because we swapped the storage out from under it with an empty deque, it will always
-        // return true after the first one (as it is filling the newly emptied backing deque.)
+        // However, because we swapped the storage out from under it with an empty queue, it will always
+        // return true after the first one (as it is filling the newly emptied backing queue.)
         // Then after the second one, because we've inserted some input, it will always say false.
         bool unusedWaitStatus = false;
 
         // write the prepend records
         size_t prependEventsWritten;
-        _WriteBuffer(inEvents, prependEventsWritten, unusedWaitStatus);
+        _WriteBuffer(records, prependEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(unusedWaitStatus));
 
         // write all previously existing records
         size_t existingEventsWritten;
-        _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
+        _WriteBuffer(existingStorage.linearize(), existingEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(!unusedWaitStatus));
 
         // We need to set the wait event if there were 0 events in the
@@ -534,9 +536,8 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 {
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents;
-        inEvents.push_back(std::move(inEvent));
-        return Write(inEvents);
+        const auto inRecord = inEvent->ToInputRecord();
+        return Write(gsl::make_span(&inRecord, 1));
     }
     catch (...)
     {
@@ -545,6 +546,20 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
     }
 }
 
+// Routine Description:
+// - Writes a record to the input buffer. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - inRecord - input record to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Write(const INPUT_RECORD& inRecord)
+{
+    return Write(gsl::make_span(&inRecord, 1));
+}
+
 // Routine Description:
 // - Writes events to the input buffer. Wakes up any readers that are
 // waiting for additional input events.
@@ -555,13 +570,36 @@ size_t InputBuffer::Write(_Inout_ std::unique_ptr<IInputEvent> inEvent)
 // Note:
 // - The console lock must be held when calling this routine.
 size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+{
+    try
+    {
+        const auto inRecords = IInputEvent::ToInputRecords(inEvents);
+        return Write(inRecords);
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
+// Routine Description:
+// - Writes records to the input buffer. Wakes up any readers that are
+// waiting for additional input events.
+// Arguments:
+// - inRecords - input records to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::Write(const gsl::span<const INPUT_RECORD> inRecords)
 {
     try
     {
         _vtInputShouldSuppress = true;
         auto resetVtInputSuppress = wil::scope_exit([&]() { _vtInputShouldSuppress = false; });
-        _HandleConsoleSuspensionEvents(inEvents);
-        if (inEvents.empty())
+        const auto records = _HandleConsoleSuspensionEvents(inRecords);
+        if (records.empty())
         {
             return 0;
         }
@@ -569,7 +607,7 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
         // Write to buffer.
         size_t EventsWritten;
         bool SetWaitEvent;
-        _WriteBuffer(inEvents, EventsWritten, SetWaitEvent);
+        _WriteBuffer(records, EventsWritten, SetWaitEvent);
 
         if (SetWaitEvent)
         {
@@ -588,246 +626,322 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
 }
 
 // Routine Description:
-// - Coalesces input events and transfers them to storage queue.
+// - Writes text to the input buffer, as if it had been typed. Wakes up any
+// readers that are waiting for additional input events.
+// - The text is stored as it is. Stream reads (ReadConsole) take characters
+// straight from it, and it's only turned into key events if something reads
+// records (ReadConsoleInput). A large paste therefore doesn't turn into
+// hundreds of thousands of key events unless a client asks for them.
 // Arguments:
-// - inRecords - The events to store.
-// - eventsWritten - The number of events written since this function
-// was called.
-// - setWaitEvent - on exit, true if buffer became non-empty.
+// - text - the text to store in the buffer.
 // Return Value:
-// - None
+// - The number of characters that were written to input buffer.
 // Note:
 // - The console lock must be held when calling this routine.
-// - will throw on failure
-void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
-                               _Out_ size_t& eventsWritten,
-                               _Out_ bool& setWaitEvent)
+size_t InputBuffer::WriteText(const std::wstring_view text)
 {
-    eventsWritten = 0;
-    setWaitEvent = false;
-    const bool initiallyEmptyQueue = _storage.empty();
-    const size_t initialInEventsSize = inEvents.size();
-    const bool vtInputMode = IsInVirtualTerminalInputMode();
-
-    while (!inEvents.empty())
+    try
     {
-        // Pop the next event.
-        // If we're in vt mode, try and handle it with the vt input module.
-        // If it was handled, do nothing else for it.
-        // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
-        // If it's not coalesced, append it to the buffer.
-        std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (vtInputMode)
+        if (text.empty())
         {
-            const bool handled = _termInput.HandleKey(inEvent.get());
-            if (handled)
-            {
-                eventsWritten++;
-                continue;
-            }
+            return 0;
         }
 
-        // we only check for possible coalescing when storing one
-        // record at a time because this is the original behavior of
-        // the input buffer. Changing this behavior may break stuff
-        // that was depending on it.
-        if (initialInEventsSize == 1 && !_storage.empty())
+        // The VT input module translates key events one at a time, and a
+        // suspended console resumes on the first key press. Both need the
+        // text as key events right away.
+        const CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        if (IsInVirtualTerminalInputMode() || WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED))
         {
-            // coalescing requires a deque of events, so push it back onto the front.
-            inEvents.push_front(std::move(inEvent));
-
-            bool coalesced = false;
-            // this looks kinda weird but we don't want to coalesce a
-            // mouse event and then try to coalesce a key event right after.
-            //
-            // we also pass the whole deque to the coalescing methods
-            // even though they only want one event because it should
-            // be their responsibility to maintain the correct state
-            // of the deque if they process any records in it.
-            if (_CoalesceMouseMovedEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            else if (_CoalesceRepeatedKeyPressEvents(inEvents))
-            {
-                coalesced = true;
-            }
-            if (coalesced)
-            {
-                eventsWritten = 1;
-                return;
-            }
-            else
-            {
-                // We didn't coalesce the event. pull it from the queue again,
-                //  to keep the state consistent with the start of this block.
-                inEvent = std::move(inEvents.front());
-                inEvents.pop_front();
-            }
+            std::vector<INPUT_RECORD> keyRecords;
+            _AppendTextAsKeyRecords(text, keyRecords);
+            Write(keyRecords);
+            return text.size();
+        }
+
+        const bool initiallyEmptyQueue = _storage.empty();
+        if (!initiallyEmptyQueue && _storage.back().EventType == TextChunkEventType)
+        {
+            // Text that directly follows other text joins its chunk.
+            _textChunks.back().append(text);
+        }
+        else
+        {
+            INPUT_RECORD placeholder{ 0 };
+            placeholder.EventType = TextChunkEventType;
+
+            _textChunks.emplace_back(text);
+            auto removeChunk = wil::scope_exit([&]() { _textChunks.pop_back(); });
+            _storage.push_back(placeholder);
+            removeChunk.release();
+        }
+
+        if (initiallyEmptyQueue)
+        {
+            ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
-        // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
-        ++eventsWritten;
+        WakeUpReadersWaitingForData();
+        return text.size();
     }
-    if (initiallyEmptyQueue && !_storage.empty())
+    catch (...)
     {
-        setWaitEvent = true;
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
     }
 }
 
 // Routine Description:
-// - Checks if the last saved event and the first event of inRecords are
-// both MOUSE_MOVED events. If they are, the last saved event is
-// updated with the new mouse position and the first event of inRecords is
-// dropped.
+// - Reads the next character of text written by WriteText, if that's what's
+// at the front of the input buffer.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - wch - on success, the character.
 // Return Value:
-// true if events were coalesced, false if they were not.
+// - true if a character was read. false if the buffer is empty or starts with
+// some other kind of event, in which case nothing was removed.
 // Note:
-// - The size of inRecords must be 1.
-// - Coalescing here means updating a record that already exists in
-// the buffer with updated values from an incoming event, instead of
-// storing the incoming event (which would make the original one
-// redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
-{
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
-    {
-        const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
-
-        if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
+// - The console lock must be held when calling this routine.
+bool InputBuffer::ReadTextChar(_Out_ wchar_t& wch) noexcept
+{
+    wch = UNICODE_NULL;
+    if (_storage.empty() || _storage.front().EventType != TextChunkEventType)
+    {
+        return false;
+    }
+
+    const auto& text = _textChunks.front();
+    wch = til::at(text, _textChunkOffset);
+    ++_textChunkOffset;
+
+    if (_textChunkOffset == text.size())
+    {
+        _textChunks.pop_front();
+        _textChunkOffset = 0;
+        _storage.pop_front();
+
+        if (_storage.empty())
         {
-            // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
-            return true;
+            ServiceLocator::LocateGlobals().hInputEvent.ResetEvent();
         }
     }
-    return false;
+    return true;
 }
 
 // Routine Description:
-// - checks two KeyEvents to see if they're similar enough to be coalesced
+// - Replaces the text chunks among the first records of storage with the key
+// events that would type them.
 // Arguments:
-// - a - the first KeyEvent
-// - b - the other KeyEvent
+// - recordCount - how many records from the front of storage must not be text
+// chunks afterwards.
 // Return Value:
-// - true if the events could be coalesced, false otherwise
-bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept
+// - <none>
+// Note:
+// - The console lock must be held when calling this routine.
+// - will throw on failure, leaving the storage untouched.
+void InputBuffer::_ExpandTextChunks(const size_t recordCount)
 {
-    if (WI_IsFlagSet(a.GetActiveModifierKeys(), NLS_IME_CONVERSION) &&
-        a.GetCharData() == b.GetCharData() &&
-        a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    const auto limit = std::min(recordCount, _storage.size());
+
+    size_t chunksToExpand = 0;
+    for (size_t i = 0; i < limit; ++i)
     {
-        return true;
+        if (_storage[i].EventType == TextChunkEventType)
+        {
+            ++chunksToExpand;
+        }
     }
-    // other key events check
-    else if (a.GetVirtualScanCode() == b.GetVirtualScanCode() &&
-             a.GetCharData() == b.GetCharData() &&
-             a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+
+    if (chunksToExpand == 0)
     {
-        return true;
+        return;
     }
-    return false;
+
+    Microsoft::Console::InputRecordQueue expanded;
+    std::vector<INPUT_RECORD> keyRecords;
+    size_t chunk = 0;
+    for (size_t i = 0; i < _storage.size(); ++i)
+    {
+        const auto& record = _storage[i];
+        if (record.EventType == TextChunkEventType && chunk < chunksToExpand)
+        {
+            std::wstring_view text{ _textChunks.at(chunk) };
+            if (chunk == 0)
+            {
+                text.remove_prefix(_textChunkOffset);
+            }
+
+            keyRecords.clear();
+            _AppendTextAsKeyRecords(text, keyRecords);
+            expanded.append(keyRecords);
+            ++chunk;
+        }
+        else
+        {
+            expanded.push_back(record);
+        }
+    }
+
+    // The chunks that were expanded are always the first ones.
+    _textChunks.erase(_textChunks.begin(), _textChunks.begin() + chunksToExpand);
+    _textChunkOffset = 0;
+    std::swap(_storage, expanded);
 }
 
-// Routine Description::
-// - If the last input event saved and the first input event in inRecords
-// are both a keypress down event for the same key, update the repeat
-// count of the saved event and drop the first from inRecords.
+// Routine Description:
+// - Converts text into the key events that would type it.
 // Arguments:
-// - inRecords - The incoming records to process.
+// - text - the text to convert.
+// - records - the records are appended to this.
 // Return Value:
-// true if events were coalesced, false if they were not.
+// - <none>
 // Note:
-// - The size of inRecords must be 1.
-// - Coalescing here means updating a record that already exists in
-// the buffer with updated values from an incoming event, instead of
-// storing the incoming event (which would make the original one
-// redundant/out of date with the most current state).
-bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
-{
-    FAIL_FAST_IF(!(inEvents.size() == 1));
-    FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
-    {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
-
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+// - will throw on failure
+void InputBuffer::_AppendTextAsKeyRecords(const std::wstring_view text, std::vector<INPUT_RECORD>& records)
+{
+    const auto codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+
+    // Most characters become a key down and a key up.
+    records.reserve(records.size() + text.size() * 2);
+    for (const auto wch : text)
+    {
+        for (const auto& keyEvent : CharToKeyEvents(wch, codepage))
         {
-            // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
-
-            inEvents.pop_front();
-            return true;
+            records.push_back(keyEvent->ToInputRecord());
         }
     }
-    return false;
 }
 
 // Routine Description:
-// - Handles records that suspend/resume the console.
+// - Coalesces input records and transfers them to storage queue.
 // Arguments:
-// - records - records to check for pause/unpause events
+// - inRecords - The records to store.
+// - eventsWritten - The number of events written since this function
+// was called.
+// - setWaitEvent - on exit, true if buffer became non-empty.
 // Return Value:
 // - None
 // Note:
 // - The console lock must be held when calling this routine.
+// - will throw on failure
+void InputBuffer::_WriteBuffer(const gsl::span<const INPUT_RECORD> inRecords,
+                               _Out_ size_t& eventsWritten,
+                               _Out_ bool& setWaitEvent)
+{
+    eventsWritten = 0;
+    setWaitEvent = false;
+    const bool initiallyEmptyQueue = _storage.empty();
+    const bool vtInputMode = IsInVirtualTerminalInputMode();
+
+    // we only check for possible coalescing when storing one
+    // record at a time because this is the original behavior of
+    // the input buffer. Changing this behavior may break stuff
+    // that was depending on it.
+    if (!vtInputMode && inRecords.size() != 1)
+    {
+        // Nothing can happen to these records on the way in, so
+        // they can be stored in one go.
+        _storage.append(inRecords);
+        eventsWritten = inRecords.size();
+    }
+    else
+    {
+        for (const auto& inRecord : inRecords)
+        {
+            // If we're in vt mode, try and handle it with the vt input module.
+            // If it was handled, do nothing else for it.
+            // If there was one event passed in, try coalescing it with the previous event currently in the buffer.
+            // If it's not coalesced, append it to the buffer.
+            if (vtInputMode && inRecord.EventType == KEY_EVENT)
+            {
+                // TerminalInput only looks at key events, so there's no need
+                // to allocate one to hand it.
+                const KeyEvent keyEvent{ inRecord.Event.KeyEvent };
+                const bool handled = _termInput.HandleKey(&keyEvent);
+                if (handled)
+                {
+                    eventsWritten++;
+                    continue;
+                }
+            }
+
+            if (inRecords.size() == 1 && !_storage.empty())
+            {
+                // this looks kinda weird but we don't want to coalesce a
+                // mouse event and then try to coalesce a key event right after.
+                if (CoalesceMouseMoved(_storage.back(), inRecord) ||
+                    CoalesceRepeatedKeyPress(_storage.back(), inRecord))
+                {
+                    eventsWritten = 1;
+                    return;
+                }
+            }
+            // At this point, the event was neither coalesced, nor processed by VT.
+            _storage.push_back(inRecord);
+            ++eventsWritten;
+        }
+    }
+    if (initiallyEmptyQueue && !_storage.empty())
+    {
+        setWaitEvent = true;
+    }
+}
+
+// Routine Description:
+// - Handles records that suspend/resume the console.
+// Arguments:
+// - inRecords - records to check for pause/unpause events
+// Return Value:
+// - The records that should still be written. This is inRecords itself
+//   unless some had to be dropped, in which case the survivors are copied
+//   into _filteredRecords, which stays valid until the next call.
+// Note:
+// - The console lock must be held when calling this routine.
 // - will throw exception on error
-void InputBuffer::_HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents)
+gsl::span<const INPUT_RECORD> InputBuffer::_HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> inRecords)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
 
-    std::deque<std::unique_ptr<IInputEvent>> outEvents;
-    while (!inEvents.empty())
+    bool filtered = false;
+    for (size_t i = 0; i < inRecords.size(); ++i)
     {
-        std::unique_ptr<IInputEvent> currEvent = std::move(inEvents.front());
-        inEvents.pop_front();
-        if (currEvent->EventType() == InputEventType::KeyEvent)
+        const auto& currRecord = til::at(inRecords, i);
+        bool drop = false;
+        if (currRecord.EventType == KEY_EVENT)
         {
-            const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(currEvent.get());
-            if (pKeyEvent->IsKeyDown())
+            const KeyEvent keyEvent{ currRecord.Event.KeyEvent };
+            if (keyEvent.IsKeyDown())
             {
                 if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED) &&
-                    !IsSystemKey(pKeyEvent->GetVirtualKeyCode()))
+                    !IsSystemKey(keyEvent.GetVirtualKeyCode()))
                 {
                     UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
-                    continue;
+                    drop = true;
                 }
-                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && pKeyEvent->IsPauseKey())
+                else if (WI_IsFlagSet(InputMode, ENABLE_LINE_INPUT) && keyEvent.IsPauseKey())
                 {
                     WI_SetFlag(gci.Flags, CONSOLE_SUSPENDED);
-                    continue;
+                    drop = true;
                 }
             }
         }
-        outEvents.push_back(std::move(currEvent));
+
+        if (drop && !filtered)
+        {
+            // Only start copying once we know that something has to go.
+            const auto kept = inRecords.first(i);
+            _filteredRecords.assign(kept.begin(), kept.end());
+            filtered = true;
+        }
+        else if (!drop && filtered)
+        {
+            _filteredRecords.push_back(currRecord);
+        }
+    }
+
+    if (filtered)
+    {
+        return _filteredRecords;
     }
-    inEvents.swap(outEvents);
+    return inRecords;
 }
 
 // Routine Description:
@@ -853,12 +967,11 @@ void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInput
     try
     {
         // add all input events to the storage queue
-        while (!inEvents.empty())
+        for (const auto& inEvent : inEvents)
         {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
-            inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
+            _storage.push_back(inEvent->ToInputRecord());
         }
+        inEvents.clear();
 
         if (!_vtInputShouldSuppress)
         {
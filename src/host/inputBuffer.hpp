@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "inputReadHandleData.h"
+#include "InputRecordQueue.hpp"
 #include "readData.hpp"
 #include "../types/inc/IInputEvent.hpp"
 
@@ -69,15 +70,22 @@ public:
                                 const bool Stream);
 
     size_t Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t Prepend(const gsl::span<const INPUT_RECORD> inRecords);
 
     size_t Write(_Inout_ std::unique_ptr<IInputEvent> inEvent);
+    size_t Write(const INPUT_RECORD& inRecord);
     size_t Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t Write(const gsl::span<const INPUT_RECORD> inRecords);
+
+    // storage API for text written in bulk, like a paste
+    size_t WriteText(const std::wstring_view text);
+    bool ReadTextChar(_Out_ wchar_t& wch) noexcept;
 
     bool IsInVirtualTerminalInputMode() const;
     Microsoft::Console::VirtualTerminal::TerminalInput& GetTerminalInput();
 
 private:
-    std::deque<std::unique_ptr<IInputEvent>> _storage;
+    Microsoft::Console::InputRecordQueue _storage;
     std::unique_ptr<IInputEvent> _readPartialByteSequence;
     std::unique_ptr<IInputEvent> _writePartialByteSequence;
     Microsoft::Console::VirtualTerminal::TerminalInput _termInput;
@@ -88,7 +96,20 @@ private:
     // Otherwise, we should be calling them.
     bool _vtInputShouldSuppress{ false };
 
-    void _ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
+    // Reused by _HandleConsoleSuspensionEvents when it has to drop records.
+    std::vector<INPUT_RECORD> _filteredRecords;
+
+    // Text written by WriteText is kept as it is, rather than as the key
+    // events that would type it. Each chunk has a placeholder record of
+    // this type in _storage, in the same order as _textChunks. Stream reads
+    // take characters straight out of the chunk; anything that needs records
+    // gets the placeholder expanded into key events first.
+    static constexpr WORD TextChunkEventType = 0x8000;
+    std::deque<std::wstring> _textChunks;
+    // how much of the first chunk has been read already
+    size_t _textChunkOffset{ 0 };
+
+    void _ReadBuffer(_Out_ std::vector<INPUT_RECORD>& outRecords,
                      const size_t readCount,
                      _Out_ size_t& eventsRead,
                      const bool peek,
@@ -96,14 +117,14 @@ private:
                      const bool unicode,
                      const bool streamRead);
 
-    void _WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inRecords,
+    void _WriteBuffer(const gsl::span<const INPUT_RECORD> inRecords,
                       _Out_ size_t& eventsWritten,
                       _Out_ bool& setWaitEvent);
 
-    bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
-    bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
-    void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    void _ExpandTextChunks(const size_t recordCount);
+    static void _AppendTextAsKeyRecords(const std::wstring_view text, std::vector<INPUT_RECORD>& records);
+
+    gsl::span<const INPUT_RECORD> _HandleConsoleSuspensionEvents(const gsl::span<const INPUT_RECORD> inRecords);
 
     void _HandleTerminalInputCallback(_In_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
 
@@ -92,7 +92,20 @@ static void _CopyRectangle(SCREEN_INFORMATION& screenInfo,
         }
     }
 
-    // 2. We can move any other scenario in-place without copying. We just have to carefully
+    // 2. If we're only moving cells left or right within the same rows (like ICH and DCH do),
+    //    then each row can copy its cells over in one go instead of one cell at a time.
+    if (targetOrigin.Y == source.Top())
+    {
+        auto& textBuffer = screenInfo.GetTextBuffer();
+        for (auto row = source.Top(); row < source.BottomExclusive(); ++row)
+        {
+            textBuffer.GetRowByOffset(row).CopyCells(source.Left(), source.Width(), targetOrigin.X);
+        }
+
+        return;
+    }
+
+    // 3. We can move any other scenario in-place without copying. We just have to carefully
     //    choose which direction we walk through filling up the target so it doesn't accidentally
     //    erase the source material before it can be copied/moved to the new location.
     {
@@ -128,6 +128,76 @@ bool ConhostInternalGetSet::SetConsoleCursorPosition(const COORD position)
     return SUCCEEDED(ServiceLocator::LocateGlobals().api.SetConsoleCursorPositionImpl(_io.GetActiveOutputBuffer(), position));
 }
 
+// Method Description:
+// - Retrieves the cursor position of the active screen buffer. This is the
+//   same as the dwCursorPosition of GetConsoleScreenBufferInfoEx, without
+//   having to fill in the rest of that structure.
+// Arguments:
+// - position: Receives the cursor position, in buffer coordinates.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateGetCursorPosition(COORD& position) const
+{
+    position = _io.GetActiveOutputBuffer().GetActiveBuffer().GetTextBuffer().GetCursor().GetPosition();
+    return true;
+}
+
+// Method Description:
+// - Retrieves the viewport of the active screen buffer. Like the srWindow of
+//   GetConsoleScreenBufferInfoEx, this is an exclusive rectangle.
+// Arguments:
+// - viewport: Receives the viewport, in buffer coordinates.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateGetViewport(SMALL_RECT& viewport) const
+{
+    viewport = _io.GetActiveOutputBuffer().GetActiveBuffer().GetViewport().ToExclusive();
+    return true;
+}
+
+// Method Description:
+// - Retrieves the dimensions of the active screen buffer.
+// Arguments:
+// - size: Receives the width and height of the buffer.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateGetBufferSize(COORD& size) const
+{
+    size = _io.GetActiveOutputBuffer().GetActiveBuffer().GetBufferSize().Dimensions();
+    return true;
+}
+
+// Method Description:
+// - Starts a batch of updates from the state machine. Until the batch ends,
+//   the cursor isn't redrawn and accessibility notifications are held back,
+//   so that each happens once for the whole batch instead of once per update.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateBeginUpdateBatch()
+{
+    auto& screenInfo = _io.GetActiveOutputBuffer().GetActiveBuffer();
+    screenInfo.GetTextBuffer().GetCursor().StartDeferDrawing();
+    screenInfo.StartDeferringAccessibilityEventing();
+    return true;
+}
+
+// Method Description:
+// - Ends a batch of updates started by PrivateBeginUpdateBatch, redrawing the
+//   cursor and announcing what changed during the batch.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateEndUpdateBatch()
+{
+    auto& screenInfo = _io.GetActiveOutputBuffer().GetActiveBuffer();
+    screenInfo.GetTextBuffer().GetCursor().EndDeferDrawing();
+    screenInfo.EndDeferringAccessibilityEventing();
+    return true;
+}
+
 // Routine Description:
 // - Connects the GetConsoleCursorInfo API call directly into our Driver Message servicing call inside Conhost.exe
 // Arguments:
@@ -182,25 +252,56 @@ bool ConhostInternalGetSet::PrivateSetTextAttributes(const TextAttribute& attrs)
     return true;
 }
 
+// Method Description:
+// - Changes the current TextAttribute of the active screen buffer, like a
+//   rendition sequence would, without a separate call to get it first.
+// Arguments:
+// - delta: The flags to clear and set, and the colors to replace.
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateModifyTextAttributes(const TextAttributeDelta& delta)
+{
+    auto& screenInfo = _io.GetActiveOutputBuffer();
+    auto attrs = screenInfo.GetAttributes();
+    attrs.ApplyDelta(delta);
+    screenInfo.SetAttributes(attrs);
+    return true;
+}
+
 // Routine Description:
 // - Connects the WriteConsoleInput API call directly into our Driver Message servicing call inside Conhost.exe
 // Arguments:
-// - events - the input events to be copied into the head of the input
+// - records - the input records to be copied into the tail of the input
 //            buffer for the underlying attached process
 // - eventsWritten - on output, the number of events written
 // Return Value:
 // - true if successful (see DoSrvWriteConsoleInput). false otherwise.
-bool ConhostInternalGetSet::PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+bool ConhostInternalGetSet::PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> records,
                                                       size_t& eventsWritten)
 {
     eventsWritten = 0;
 
     return SUCCEEDED(DoSrvPrivateWriteConsoleInputW(_io.GetActiveInputBuffer(),
-                                                    events,
+                                                    records,
                                                     eventsWritten,
                                                     true)); // append
 }
 
+// Routine Description:
+// - Writes text to the tail of the input buffer, as if it had been typed. The
+//   input buffer keeps it as text until a client reads it as input records.
+// Arguments:
+// - text - the text to write
+// - charsWritten - on output, the number of characters written
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateWriteConsoleInputText(const std::wstring_view text,
+                                                         size_t& charsWritten)
+{
+    charsWritten = _io.GetActiveInputBuffer()->WriteText(text);
+    return charsWritten == text.size();
+}
+
 // Routine Description:
 // - Connects the SetConsoleWindowInfo API call directly into our Driver Message servicing call inside Conhost.exe
 // Arguments:
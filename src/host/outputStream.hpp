@@ -59,14 +59,24 @@ public:
 
     bool SetConsoleCursorPosition(const COORD position) override;
 
+    bool PrivateGetCursorPosition(COORD& position) const override;
+    bool PrivateGetViewport(SMALL_RECT& viewport) const override;
+    bool PrivateGetBufferSize(COORD& size) const override;
+
+    bool PrivateBeginUpdateBatch() override;
+    bool PrivateEndUpdateBatch() override;
+
     bool GetConsoleCursorInfo(CONSOLE_CURSOR_INFO& cursorInfo) const override;
     bool SetConsoleCursorInfo(const CONSOLE_CURSOR_INFO& cursorInfo) override;
 
     bool PrivateGetTextAttributes(TextAttribute& attrs) const override;
     bool PrivateSetTextAttributes(const TextAttribute& attrs) override;
+    bool PrivateModifyTextAttributes(const TextAttributeDelta& delta) override;
 
-    bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+    bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> records,
                                    size_t& eventsWritten) override;
+    bool PrivateWriteConsoleInputText(const std::wstring_view text,
+                                      size_t& charsWritten) override;
 
     bool SetConsoleWindowInfo(bool const absolute,
                               const SMALL_RECT& window) override;
@@ -269,6 +269,16 @@ const std::vector<Microsoft::Console::Render::RenderOverlay> RenderData::GetOver
     return overlays;
 }
 
+// Routine Description:
+// - Retrieves regions of the buffer that should be underlined as detected patterns.
+// - Conhost doesn't detect patterns, so there are never any.
+// Return Value:
+// - An empty set of regions
+const std::vector<SMALL_RECT> RenderData::GetPatternOverlays() const noexcept
+{
+    return {};
+}
+
 // Method Description:
 // - Returns true if the cursor should be drawn twice as wide as usual because
 //      the cursor is currently over a cell with a double-wide character in it.
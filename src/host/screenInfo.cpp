@@ -46,6 +46,9 @@ SCREEN_INFORMATION::SCREEN_INFORMATION(
     ScrollScale{ 1ul },
     _pConsoleWindowMetrics{ pMetrics },
     _pAccessibilityNotifier{ pNotifier },
+    _accessibilityEvents{},
+    _deferAccessibilityEventing{ false },
+    _deferredAccessibilityRegion{},
     _stateMachine{ nullptr },
     _scrollMargins{ Viewport::FromCoord({ 0 }) },
     _viewport(Viewport::Empty()),
@@ -258,6 +261,9 @@ void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
         auto defaults = std::make_unique<WriteBuffer>(*this);
         auto adapter = std::make_unique<AdaptDispatch>(std::move(getset), std::move(defaults));
         auto engine = std::make_unique<OutputStateMachineEngine>(std::move(adapter));
+        // Cursor movements, renditions and text are dispatched in batches, so
+        //      the cursor and accessibility are only updated once per batch.
+        engine->SetBatchDispatch(true);
         // Note that at this point in the setup, we haven't determined if we're
         //      in VtIo mode or not yet. We'll set the OutputStateMachine's
         //      TerminalConnection later, in VtIo::StartIfNeeded
@@ -568,6 +574,9 @@ void SCREEN_INFORMATION::UpdateFont(const FontInfo* const pfiNewFont)
 // to aggregate drawing metadata to determine whether or not to use PolyTextOut.
 // After the Nov 2015 graphics refactor, the metadata drawing flag calculation is no longer necessary.
 // This now only notifies accessibility apps of a change.
+// - Changes are coalesced by _accessibilityEvents, so a burst of writes is
+//   announced as one merged region instead of one event per write. Whatever is
+//   still pending at the end of a burst is released by FlushAccessibilityEventing.
 void SCREEN_INFORMATION::NotifyAccessibilityEventing(const short sStartX,
                                                      const short sStartY,
                                                      const short sEndX,
@@ -579,34 +588,177 @@ void SCREEN_INFORMATION::NotifyAccessibilityEventing(const short sStartX,
         const COORD coordScreenBufferSize = GetBufferSize().Dimensions();
         FAIL_FAST_IF(!(sEndX < coordScreenBufferSize.X));
 
-        if (sStartX == sEndX && sStartY == sEndY)
+        // Nobody is listening, so there's no point in building up a region to announce.
+        if (!_pAccessibilityNotifier->HasListeners())
         {
-            try
-            {
-                const auto cellData = GetCellDataAt({ sStartX, sStartY });
-                const LONG charAndAttr = MAKELONG(Utf16ToUcs2(cellData->Chars()),
-                                                  cellData->TextAttr().GetLegacyAttributes());
-                _pAccessibilityNotifier->NotifyConsoleUpdateSimpleEvent(MAKELONG(sStartX, sStartY),
-                                                                        charAndAttr);
-            }
-            catch (...)
+            _accessibilityEvents.Drop();
+            _deferredAccessibilityRegion.reset();
+            return;
+        }
+
+        // While a batch of VT output is being processed, only remember what
+        // changed, and announce all of it once the batch is done.
+        if (_deferAccessibilityEventing)
+        {
+            SMALL_RECT changed{ sStartX, sStartY, sEndX, sEndY };
+            if (_deferredAccessibilityRegion.has_value())
             {
-                LOG_HR(wil::ResultFromCaughtException());
-                return;
+                const auto& deferred = _deferredAccessibilityRegion.value();
+                changed.Left = std::min(changed.Left, deferred.Left);
+                changed.Top = std::min(changed.Top, deferred.Top);
+                changed.Right = std::max(changed.Right, deferred.Right);
+                changed.Bottom = std::max(changed.Bottom, deferred.Bottom);
             }
+            _deferredAccessibilityRegion = changed;
+            return;
+        }
+
+        const auto now = AccessibilityEventAggregator::clock::now();
+        const auto region = _accessibilityEvents.Add({ sStartX, sStartY, sEndX, sEndY }, now);
+        if (region.has_value())
+        {
+            _NotifyAccessibilityRegion(region.value());
         }
         else
         {
-            _pAccessibilityNotifier->NotifyConsoleUpdateRegionEvent(MAKELONG(sStartX, sStartY),
-                                                                    MAKELONG(sEndX, sEndY));
+            _ScheduleAccessibilityFlush(now);
         }
-        IConsoleWindow* pConsoleWindow = ServiceLocator::LocateConsoleWindow();
-        if (pConsoleWindow)
+    }
+}
+
+// Routine Description:
+// - Announces any changed region that was held back by NotifyAccessibilityEventing
+//   because it arrived too soon after the previous announcement.
+// - Called by the one-shot timer that _ScheduleAccessibilityFlush arms, and
+//   from the cursor blink timer while the console has focus.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::FlushAccessibilityEventing()
+{
+    if (!_accessibilityEvents.IsPending())
+    {
+        return;
+    }
+
+    if (!IsActiveScreenBuffer() || !_pAccessibilityNotifier->HasListeners())
+    {
+        _accessibilityEvents.Drop();
+        return;
+    }
+
+    const auto now = AccessibilityEventAggregator::clock::now();
+    const auto region = _accessibilityEvents.Flush(now);
+    if (region.has_value())
+    {
+        _NotifyAccessibilityRegion(region.value());
+    }
+    else
+    {
+        // The timer went off a little early.
+        _ScheduleAccessibilityFlush(now);
+    }
+}
+
+// Routine Description:
+// - Makes sure that a region held back by _accessibilityEvents is announced once
+//   the rate limit allows it, even if no further changes arrive to release it.
+// Arguments:
+// - now - the current time.
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::_ScheduleAccessibilityFlush(const AccessibilityEventAggregator::clock::time_point now)
+{
+    const auto delay = _accessibilityEvents.TimeUntilFlush(now);
+    if (delay.has_value())
+    {
+        const auto dueTime = std::chrono::ceil<std::chrono::milliseconds>(delay.value()).count();
+        ServiceLocator::LocateGlobals().getConsoleInformation().GetCursorBlinker().SetAccessibilityFlushTimer(gsl::narrow_cast<DWORD>(dueTime));
+    }
+}
+
+// Routine Description:
+// - Holds back accessibility notifications until EndDeferringAccessibilityEventing
+//   is called, so that a batch of changes is announced as a single region.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::StartDeferringAccessibilityEventing() noexcept
+{
+    _deferAccessibilityEventing = true;
+}
+
+// Routine Description:
+// - Stops holding back accessibility notifications, and announces the region
+//   that changed while they were held back, if any.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::EndDeferringAccessibilityEventing()
+{
+    _deferAccessibilityEventing = false;
+
+    if (_deferredAccessibilityRegion.has_value())
+    {
+        const auto deferred = _deferredAccessibilityRegion.value();
+        _deferredAccessibilityRegion.reset();
+        NotifyAccessibilityEventing(deferred.Left, deferred.Top, deferred.Right, deferred.Bottom);
+    }
+}
+
+// Routine Description:
+// - Gets the aggregator used to coalesce accessibility notifications, so that
+//   its merged/dropped counters can be inspected.
+const AccessibilityEventAggregator& SCREEN_INFORMATION::GetAccessibilityEventAggregator() const noexcept
+{
+    return _accessibilityEvents;
+}
+
+// Routine Description:
+// - Raises the WinEvent and UIA notifications for a single changed region.
+//   A region covering exactly one cell is reported with the simple event,
+//   which carries the character and attribute along with it.
+// Arguments:
+// - region - the inclusive rectangle that changed.
+// Return Value:
+// - <none>
+void SCREEN_INFORMATION::_NotifyAccessibilityRegion(const SMALL_RECT region)
+{
+    // The buffer may have been resized while this region was pending.
+    const auto bufferSize = GetBufferSize();
+    const COORD start{ std::min(region.Left, bufferSize.RightInclusive()), std::min(region.Top, bufferSize.BottomInclusive()) };
+    const COORD end{ std::min(region.Right, bufferSize.RightInclusive()), std::min(region.Bottom, bufferSize.BottomInclusive()) };
+
+    if (start == end)
+    {
+        try
         {
-            LOG_IF_FAILED(pConsoleWindow->SignalUia(UIA_Text_TextChangedEventId));
-            // TODO MSFT 7960168 do we really need this event to not signal?
-            //pConsoleWindow->SignalUia(UIA_LayoutInvalidatedEventId);
+            const auto cellData = GetCellDataAt(start);
+            const LONG charAndAttr = MAKELONG(Utf16ToUcs2(cellData->Chars()),
+                                              cellData->TextAttr().GetLegacyAttributes());
+            _pAccessibilityNotifier->NotifyConsoleUpdateSimpleEvent(MAKELONG(start.X, start.Y),
+                                                                    charAndAttr);
         }
+        catch (...)
+        {
+            LOG_HR(wil::ResultFromCaughtException());
+            return;
+        }
+    }
+    else
+    {
+        _pAccessibilityNotifier->NotifyConsoleUpdateRegionEvent(MAKELONG(start.X, start.Y),
+                                                                MAKELONG(end.X, end.Y));
+    }
+    IConsoleWindow* pConsoleWindow = ServiceLocator::LocateConsoleWindow();
+    if (pConsoleWindow)
+    {
+        LOG_IF_FAILED(pConsoleWindow->SignalUia(UIA_Text_TextChangedEventId));
+        // TODO MSFT 7960168 do we really need this event to not signal?
+        //pConsoleWindow->SignalUia(UIA_LayoutInvalidatedEventId);
     }
 }
 
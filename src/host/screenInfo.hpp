@@ -23,6 +23,7 @@ Revision History:
 #include "settings.hpp"
 #include "outputStream.hpp"
 #include "ScreenBufferRenderTarget.hpp"
+#include "AccessibilityEventAggregator.hpp"
 
 #include "../buffer/out/OutputCellRect.hpp"
 #include "../buffer/out/TextAttribute.hpp"
@@ -100,6 +101,10 @@ public:
     [[nodiscard]] NTSTATUS ResizeScreenBuffer(const COORD coordNewScreenSize, const bool fDoScrollBarUpdate);
 
     void NotifyAccessibilityEventing(const short sStartX, const short sStartY, const short sEndX, const short sEndY);
+    void FlushAccessibilityEventing();
+    void StartDeferringAccessibilityEventing() noexcept;
+    void EndDeferringAccessibilityEventing();
+    const Microsoft::Console::AccessibilityEventAggregator& GetAccessibilityEventAggregator() const noexcept;
 
     void UpdateScrollBars();
     void InternalUpdateScrollBars();
@@ -249,6 +254,12 @@ private:
 
     Microsoft::Console::Interactivity::IWindowMetrics* _pConsoleWindowMetrics;
     Microsoft::Console::Interactivity::IAccessibilityNotifier* _pAccessibilityNotifier;
+    Microsoft::Console::AccessibilityEventAggregator _accessibilityEvents;
+    bool _deferAccessibilityEventing;
+    std::optional<SMALL_RECT> _deferredAccessibilityRegion;
+
+    void _NotifyAccessibilityRegion(const SMALL_RECT region);
+    void _ScheduleAccessibilityFlush(const Microsoft::Console::AccessibilityEventAggregator::clock::time_point now);
 
     [[nodiscard]] HRESULT _AdjustScreenBufferHelper(const RECT* const prcClientNew,
                                                     const COORD coordBufferOld,
@@ -21,6 +21,30 @@
 
 using Microsoft::Console::Interactivity::ServiceLocator;
 
+// Routine Description:
+// - Gets the modifier keys that the key events typing the given character
+//   would report, based on the current keyboard layout.
+// Arguments:
+// - wch - the character
+// Return Value:
+// - the console control key state for typing the character.
+static DWORD _GetKeyStateForChar(const wchar_t wch) noexcept
+{
+    const short keyState = ServiceLocator::LocateInputServices()->VkKeyScanW(wch);
+    if (keyState == -1)
+    {
+        return 0;
+    }
+
+    // This follows SynthesizeKeyboardEvents.
+    const byte modifierState = HIBYTE(keyState);
+    DWORD dwKeyState = 0;
+    WI_SetFlagIf(dwKeyState, SHIFT_PRESSED, WI_IsFlagSet(modifierState, VkKeyScanModState::ShiftPressed));
+    WI_SetFlagIf(dwKeyState, LEFT_CTRL_PRESSED, WI_IsFlagSet(modifierState, VkKeyScanModState::CtrlPressed));
+    WI_SetFlagIf(dwKeyState, RIGHT_ALT_PRESSED, WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed));
+    return dwKeyState;
+}
+
 // Routine Description:
 // - This routine is used in stream input.  It gets input and filters it for unicode characters.
 // Arguments:
@@ -60,6 +84,38 @@ using Microsoft::Console::Interactivity::ServiceLocator;
     NTSTATUS Status;
     for (;;)
     {
+        // Pasted text can be handed out directly, without becoming key events.
+        // It's filtered the same way the key events that type it would be:
+        // Escape and Newline are ignored unless VT input is on, and none of
+        // it counts as a line editing or popup key.
+        wchar_t wch;
+        if (pInputBuffer->ReadTextChar(wch))
+        {
+            if ((wch == UNICODE_ESC || wch == UNICODE_LINEFEED) &&
+                WI_IsFlagClear(pInputBuffer->InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT))
+            {
+                continue;
+            }
+
+            if (nullptr != pCommandLineEditingKeys)
+            {
+                *pCommandLineEditingKeys = false;
+            }
+
+            if (nullptr != pPopupKeys)
+            {
+                *pPopupKeys = false;
+            }
+
+            if (nullptr != pdwKeyState)
+            {
+                *pdwKeyState = _GetKeyStateForChar(wch);
+            }
+
+            *pwchOut = wch;
+            return STATUS_SUCCESS;
+        }
+
         std::unique_ptr<IInputEvent> inputEvent;
         Status = pInputBuffer->Read(inputEvent,
                                     false, // peek
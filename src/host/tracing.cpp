@@ -379,6 +379,35 @@ void Tracing::s_TraceInputRecord(const INPUT_RECORD& inputRecord)
     }
 }
 
+// Routine Description:
+// - Reports how much VT input was read from the input pipe and turned into
+//   input events over a stretch of time.
+// Arguments:
+// - bytes - the number of bytes read from the pipe.
+// - events - the number of input events written to the input buffer.
+// - busyTime - the time spent converting and parsing those bytes. The rates
+//   are computed over this, so that time spent waiting on the pipe doesn't
+//   count against them.
+// Return Value:
+// - <none>
+void Tracing::s_TraceVtInputThroughput(const size_t bytes, const size_t events, const std::chrono::nanoseconds busyTime)
+{
+    const auto seconds = std::chrono::duration<double>(busyTime).count();
+    const auto bytesPerSecond = seconds > 0 ? bytes / seconds : 0.0;
+    const auto eventsPerSecond = seconds > 0 ? events / seconds : 0.0;
+
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "VT Input Throughput",
+        TraceLoggingUInt64(bytes, "Bytes"),
+        TraceLoggingUInt64(events, "Events"),
+        TraceLoggingFloat64(seconds * 1000.0, "BusyMilliseconds"),
+        TraceLoggingFloat64(bytesPerSecond, "BytesPerSecond"),
+        TraceLoggingFloat64(eventsPerSecond, "EventsPerSecond"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TraceKeywords::Input));
+}
+
 void __stdcall Tracing::TraceFailure(const wil::FailureInfo& failure) noexcept
 {
     TraceLoggingWrite(
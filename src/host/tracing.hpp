@@ -61,6 +61,7 @@ public:
 
     static void s_TraceWindowMessage(const MSG& msg);
     static void s_TraceInputRecord(const INPUT_RECORD& inputRecord);
+    static void s_TraceVtInputThroughput(const size_t bytes, const size_t events, const std::chrono::nanoseconds busyTime);
 
     static void __stdcall TraceFailure(const wil::FailureInfo& failure) noexcept;
 
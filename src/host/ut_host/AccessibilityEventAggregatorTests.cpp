@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "..\..\inc\consoletaeftemplates.hpp"
+
+#include "../AccessibilityEventAggregator.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using Microsoft::Console::AccessibilityEventAggregator;
+using namespace std::chrono_literals;
+
+class AccessibilityEventAggregatorTests
+{
+    TEST_CLASS(AccessibilityEventAggregatorTests);
+
+    TEST_METHOD(FirstChangeIsReleasedImmediately)
+    {
+        AccessibilityEventAggregator aggregator{ 50ms, 20 };
+        const auto now = AccessibilityEventAggregator::clock::now();
+
+        const SMALL_RECT changed{ 1, 2, 3, 2 };
+        const auto region = aggregator.Add(changed, now);
+
+        VERIFY_IS_TRUE(region.has_value());
+        VERIFY_ARE_EQUAL(changed, region.value());
+        VERIFY_IS_FALSE(aggregator.IsPending());
+        VERIFY_ARE_EQUAL(1u, aggregator.GetEmittedCount());
+        VERIFY_ARE_EQUAL(0u, aggregator.GetMergedCount());
+    }
+
+    TEST_METHOD(BurstIsMergedIntoBoundingRegion)
+    {
+        AccessibilityEventAggregator aggregator{ 50ms, 20 };
+        const auto start = AccessibilityEventAggregator::clock::now();
+
+        VERIFY_IS_TRUE(aggregator.Add({ 0, 0, 0, 0 }, start).has_value());
+
+        Log::Comment(L"Changes inside the window are held back.");
+        VERIFY_IS_FALSE(aggregator.Add({ 5, 3, 10, 3 }, start + 10ms).has_value());
+        VERIFY_IS_FALSE(aggregator.Add({ 2, 7, 4, 8 }, start + 20ms).has_value());
+        VERIFY_IS_FALSE(aggregator.Add({ 8, 4, 12, 4 }, start + 30ms).has_value());
+        VERIFY_IS_TRUE(aggregator.IsPending());
+        VERIFY_IS_FALSE(aggregator.Flush(start + 40ms).has_value());
+
+        Log::Comment(L"Once the window elapses, the union of the held back changes is released.");
+        const auto region = aggregator.Flush(start + 50ms);
+        VERIFY_IS_TRUE(region.has_value());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 2, 3, 12, 8 }), region.value());
+        VERIFY_IS_FALSE(aggregator.IsPending());
+
+        VERIFY_ARE_EQUAL(2u, aggregator.GetEmittedCount());
+        VERIFY_ARE_EQUAL(2u, aggregator.GetMergedCount());
+        VERIFY_ARE_EQUAL(0u, aggregator.GetDroppedCount());
+    }
+
+    TEST_METHOD(HeldBackChangeKnowsWhenToFlush)
+    {
+        AccessibilityEventAggregator aggregator{ 50ms, 20 };
+        const auto start = AccessibilityEventAggregator::clock::now();
+
+        VERIFY_IS_FALSE(aggregator.TimeUntilFlush(start).has_value());
+
+        VERIFY_IS_TRUE(aggregator.Add({ 0, 0, 1, 0 }, start).has_value());
+        VERIFY_IS_FALSE(aggregator.TimeUntilFlush(start).has_value());
+
+        Log::Comment(L"A change held back 10ms into the window has to wait for the other 40ms.");
+        VERIFY_IS_FALSE(aggregator.Add({ 0, 1, 1, 1 }, start + 10ms).has_value());
+        const auto delay = aggregator.TimeUntilFlush(start + 10ms);
+        VERIFY_IS_TRUE(delay.has_value());
+        VERIFY_IS_TRUE(delay.value() == 40ms);
+
+        Log::Comment(L"Flushing after that delay releases it, without any further change.");
+        VERIFY_IS_TRUE(aggregator.Flush(start + 10ms + delay.value()).has_value());
+        VERIFY_IS_FALSE(aggregator.TimeUntilFlush(start + 50ms).has_value());
+    }
+
+    TEST_METHOD(RateLimitOutlastsWindow)
+    {
+        Log::Comment(L"With at most 4 events per second, a 10ms window still waits 250ms between events.");
+        AccessibilityEventAggregator aggregator{ 10ms, 4 };
+        const auto start = AccessibilityEventAggregator::clock::now();
+
+        VERIFY_IS_TRUE(aggregator.Add({ 0, 0, 1, 0 }, start).has_value());
+        VERIFY_IS_FALSE(aggregator.Add({ 0, 1, 1, 1 }, start + 100ms).has_value());
+        VERIFY_IS_FALSE(aggregator.Flush(start + 200ms).has_value());
+        VERIFY_IS_TRUE(aggregator.Flush(start + 250ms).has_value());
+    }
+
+    TEST_METHOD(DropDiscardsPending)
+    {
+        AccessibilityEventAggregator aggregator{ 50ms, 20 };
+        const auto start = AccessibilityEventAggregator::clock::now();
+
+        VERIFY_IS_TRUE(aggregator.Add({ 0, 0, 1, 0 }, start).has_value());
+        VERIFY_IS_FALSE(aggregator.Add({ 0, 1, 1, 1 }, start + 10ms).has_value());
+
+        aggregator.Drop();
+        VERIFY_IS_FALSE(aggregator.IsPending());
+        VERIFY_IS_FALSE(aggregator.Flush(start + 1s).has_value());
+        VERIFY_ARE_EQUAL(2u, aggregator.GetDroppedCount());
+
+        aggregator.Drop();
+        VERIFY_ARE_EQUAL(3u, aggregator.GetDroppedCount());
+    }
+};
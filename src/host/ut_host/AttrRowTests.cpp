@@ -705,6 +705,29 @@ class AttrRowTests
         }
     }
 
+    TEST_METHOD(TestGetRuns)
+    {
+        Log::Comment(L"A range inside a single run gets one run, cut to fit.");
+        auto runs = pSingle->GetRuns(5, 10);
+        VERIFY_ARE_EQUAL(1u, runs.size());
+        VERIFY_ARE_EQUAL(10u, runs.at(0).GetLength());
+        VERIFY_ARE_EQUAL(_DefaultAttr, runs.at(0).GetAttributes());
+
+        Log::Comment(L"A range across runs gets the end of the first, the middle ones whole, and the start of the last.");
+        runs = pChain->GetRuns(sChainSegLength - 1, sChainSegLength + 2);
+        VERIFY_ARE_EQUAL(3u, runs.size());
+        VERIFY_ARE_EQUAL(1u, runs.at(0).GetLength());
+        VERIFY_ARE_EQUAL(TextAttribute{ 0 }, runs.at(0).GetAttributes());
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(sChainSegLength), runs.at(1).GetLength());
+        VERIFY_ARE_EQUAL(TextAttribute{ 1 }, runs.at(1).GetAttributes());
+        VERIFY_ARE_EQUAL(1u, runs.at(2).GetLength());
+        VERIFY_ARE_EQUAL(TextAttribute{ 2 }, runs.at(2).GetAttributes());
+
+        Log::Comment(L"The whole row gets all the runs, and an empty range none.");
+        VERIFY_ARE_EQUAL(pChain->GetNumberOfRuns(), pChain->GetRuns(0, _sDefaultLength).size());
+        VERIFY_ARE_EQUAL(0u, pChain->GetRuns(_sDefaultLength, 0).size());
+    }
+
     TEST_METHOD(TestResize)
     {
         CommonState state;
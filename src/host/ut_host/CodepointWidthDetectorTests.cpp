@@ -8,6 +8,7 @@
 
 #include "../types/inc/CodepointWidthDetector.hpp"
 
+using namespace WEX::Common;
 using namespace WEX::Logging;
 
 static constexpr std::wstring_view emoji = L"\xD83E\xDD22"; // U+1F922 nauseated face
@@ -24,6 +25,9 @@ static const std::vector<std::tuple<unsigned int, std::wstring, CodepointWidth>>
     { 0x306A, L"\x306A", CodepointWidth::Wide }, // U+306A hiragana na
     { 0x30CA, L"\x30CA", CodepointWidth::Wide }, // U+30CA katakana na
     { 0x72D7, L"\x72D7", CodepointWidth::Wide }, // U+72D7
+    { 0x30FC, L"\x30FC", CodepointWidth::Wide }, // U+30FC katakana-hiragana prolonged sound mark
+    { 0x20BB7, L"\xD842\xDFB7", CodepointWidth::Wide }, // U+20BB7 CJK unified ideograph extension B
+    { 0xE0001, L"\xDB40\xDC01", CodepointWidth::Narrow }, // U+E0001 language tag
     { 0x1F47E, L"\xD83D\xDC7E", CodepointWidth::Wide }, // U+1F47E alien monster
     { 0x1F51C, L"\xD83D\xDD1C", CodepointWidth::Wide } // U+1F51C SOON
 };
@@ -76,26 +80,131 @@ class CodepointWidthDetectorTests
 
     TEST_METHOD(AmbiguousCache)
     {
-        // Set up a detector with fallback.
+        // Set up a detector with fallback that counts how often it's asked.
+        size_t fallbackCalls = 0;
         CodepointWidthDetector widthDetector;
-        widthDetector.SetFallbackMethod(std::bind(&FallbackMethod, std::placeholders::_1));
+        widthDetector.SetFallbackMethod([&](const std::wstring_view glyph) {
+            ++fallbackCalls;
+            return FallbackMethod(glyph);
+        });
 
         // Ensure fallback cache is empty.
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_IS_FALSE(widthDetector._findCodepointInFallbackCache(0x414).has_value());
 
         // Lookup ambiguous width character.
-        widthDetector.IsWide(ambiguous);
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(1u, fallbackCalls);
+
+        // Cache should hold it, keyed by its codepoint, with the answer we expect.
+        const auto cached = widthDetector._findCodepointInFallbackCache(0x414);
+        VERIFY_IS_TRUE(cached.has_value());
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), cached.value());
 
-        // Cache should hold it.
-        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackCache.size());
+        // Looking it up again shouldn't ask the fallback.
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), widthDetector.IsWide(ambiguous));
+        VERIFY_ARE_EQUAL(1u, fallbackCalls);
 
-        // Cached item should match what we expect
-        const auto it = widthDetector._fallbackCache.begin();
-        VERIFY_ARE_EQUAL(ambiguous, it->first);
-        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), it->second);
+        const auto statistics = widthDetector.GetFallbackCacheStatistics();
+        VERIFY_ARE_EQUAL(1u, statistics.hits);
+        VERIFY_ARE_EQUAL(1u, statistics.misses);
+        VERIFY_ARE_EQUAL(0u, statistics.evictions);
 
         // Cache should empty when font changes.
         widthDetector.NotifyFontChanged();
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_IS_FALSE(widthDetector._findCodepointInFallbackCache(0x414).has_value());
+        widthDetector.IsWide(ambiguous);
+        VERIFY_ARE_EQUAL(2u, fallbackCalls);
+    }
+
+    TEST_METHOD(AmbiguousCacheEvicts)
+    {
+        CodepointWidthDetector widthDetector;
+
+        Log::Comment(L"Fill the cache with far more codepoints than it has room for.");
+        constexpr unsigned int first = 0xE000;
+        constexpr unsigned int count = 0x1000 * 4;
+        for (auto codepoint = first; codepoint < first + count; ++codepoint)
+        {
+            widthDetector._addCodepointToFallbackCache(codepoint, codepoint % 2 == 1);
+        }
+
+        const auto statistics = widthDetector.GetFallbackCacheStatistics();
+        VERIFY_IS_GREATER_THAN_OR_EQUAL(statistics.evictions, size_t{ count - 0x1000 });
+
+        Log::Comment(L"Whatever is still cached must have kept its own answer.");
+        size_t found = 0;
+        for (auto codepoint = first; codepoint < first + count; ++codepoint)
+        {
+            if (const auto cached = widthDetector._findCodepointInFallbackCache(codepoint))
+            {
+                VERIFY_ARE_EQUAL(codepoint % 2 == 1, cached.value());
+                ++found;
+            }
+        }
+        VERIFY_IS_LESS_THAN_OR_EQUAL(found, size_t{ 0x1000 });
+
+        Log::Comment(L"The most recently added codepoint is always found.");
+        VERIFY_IS_TRUE(widthDetector._findCodepointInFallbackCache(first + count - 1).has_value());
+    }
+
+    TEST_METHOD(AmbiguousCacheHoldsClusters)
+    {
+        size_t fallbackCalls = 0;
+        CodepointWidthDetector widthDetector;
+        widthDetector.SetFallbackMethod([&](const std::wstring_view) {
+            ++fallbackCalls;
+            return true;
+        });
+
+        // A regional indicator pair is a single glyph made of two codepoints.
+        const std::wstring_view flag{ L"\xD83C\xDDFA\xD83C\xDDF8" };
+        VERIFY_IS_TRUE(widthDetector._checkFallbackViaCache(flag));
+        VERIFY_IS_TRUE(widthDetector._checkFallbackViaCache(flag));
+        VERIFY_ARE_EQUAL(1u, fallbackCalls);
+        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackClusterCache.size());
+
+        widthDetector.NotifyFontChanged();
+        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackClusterCache.size());
+    }
+
+    TEST_METHOD(CjkPerformance)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        CodepointWidthDetector widthDetector;
+
+        // Split the text into glyphs up front, so only the width lookups are measured.
+        const auto measure = [&](const std::wstring_view name, const std::wstring_view text, const size_t expectedWide) {
+            std::vector<std::wstring_view> glyphs;
+            for (size_t i = 0; i < text.size();)
+            {
+                const auto length = IS_HIGH_SURROGATE(text.at(i)) ? 2 : 1;
+                glyphs.emplace_back(text.substr(i, length));
+                i += length;
+            }
+
+            constexpr size_t iterations = 100000;
+            size_t wide = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                for (const auto glyph : glyphs)
+                {
+                    wide += widthDetector.GetWidth(glyph) == CodepointWidth::Wide;
+                }
+            }
+            const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            Log::Comment(NoThrowString().Format(L"Measured %zu glyphs of %.*s text in %lld ms", iterations * glyphs.size(), gsl::narrow<int>(name.size()), name.data(), delta));
+            VERIFY_ARE_EQUAL(iterations * expectedWide, wide);
+        };
+
+        // Ideographs and kana from the BMP are mostly answered by GetQuickCharWidth.
+        measure(L"BMP CJK", L"\x65e5\x672c\x8a9e\x306e\x30c6\x30ad\x30b9\x30c8\x3092\x8868\x793a\x3059\x308b", 13);
+
+        // The prolonged sound mark, ideographs from the supplementary planes and emoji
+        // all have to be looked up in the width table.
+        measure(L"supplementary CJK", L"\x30b5\x30fc\x30d0\x30fc \xD842\xDFB7\xD869\xDEB2\xD840\xDC0B \xD83D\xDE00\xD83D\xDC7E", 9);
     }
 };
@@ -119,6 +119,7 @@ class ConptyOutputTests
     TEST_METHOD(WriteTwoLinesUsesNewline);
     TEST_METHOD(WriteAFewSimpleLines);
     TEST_METHOD(InvalidateUntilOneBeforeEnd);
+    TEST_METHOD(InvalidateOnlyChangedSelectionRows);
 
 private:
     bool _writeCallback(const char* const pch, size_t const cch);
@@ -364,3 +365,41 @@ void ConptyOutputTests::InvalidateUntilOneBeforeEnd()
 
     VERIFY_SUCCEEDED(renderer.PaintFrame());
 }
+
+void ConptyOutputTests::InvalidateOnlyChangedSelectionRows()
+{
+    Log::Comment(NoThrowString().Format(
+        L"Dragging a selection should only invalidate the rows whose selected span changed"));
+
+    // A selection from (2,1) to (10,3), one rectangle per row.
+    const std::vector<SMALL_RECT> previous{
+        { 2, 1, 79, 1 },
+        { 0, 2, 79, 2 },
+        { 0, 3, 10, 3 },
+    };
+
+    Log::Comment(L"The same selection again doesn't invalidate anything.");
+    VERIFY_IS_TRUE(Renderer::_GetChangedSelectionRects(previous, previous).empty());
+
+    Log::Comment(L"Moving the endpoint within the last row only invalidates that row, before and after.");
+    std::vector<SMALL_RECT> current{ previous };
+    current.back().Right = 15;
+    auto dirty = Renderer::_GetChangedSelectionRects(previous, current);
+    VERIFY_ARE_EQUAL(2u, dirty.size());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 3, 10, 3 }), dirty.at(0));
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 3, 15, 3 }), dirty.at(1));
+
+    Log::Comment(L"Extending the selection by a row invalidates the old last row and the new rows only.");
+    current = previous;
+    current.back().Right = 79;
+    current.push_back({ 0, 4, 5, 4 });
+    dirty = Renderer::_GetChangedSelectionRects(previous, current);
+    VERIFY_ARE_EQUAL(3u, dirty.size());
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 3, 10, 3 }), dirty.at(0));
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 3, 79, 3 }), dirty.at(1));
+    VERIFY_ARE_EQUAL(SMALL_RECT({ 0, 4, 5, 4 }), dirty.at(2));
+
+    Log::Comment(L"Clearing the selection invalidates everything that was selected.");
+    dirty = Renderer::_GetChangedSelectionRects(previous, {});
+    VERIFY_ARE_EQUAL(previous.size(), dirty.size());
+}
@@ -5,10 +5,12 @@
 #include "WexTestClass.h"
 #include "..\..\inc\consoletaeftemplates.hpp"
 #include "CommonState.hpp"
+#include "stream.h"
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\types\inc\IInputEvent.hpp"
 
+using namespace WEX::Common;
 using namespace WEX::Logging;
 using Microsoft::Console::Interactivity::ServiceLocator;
 
@@ -78,7 +80,7 @@ class InputBufferTests
             INPUT_RECORD record;
             record.EventType = MENU_EVENT;
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back()->ToInputRecord());
+            VERIFY_ARE_EQUAL(record, inputBuffer._storage.back());
         }
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT);
     }
@@ -98,7 +100,7 @@ class InputBufferTests
         // verify that the events are the same in storage
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i]->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i], record);
         }
     }
 
@@ -121,10 +123,9 @@ class InputBufferTests
         // check that they coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), 1u);
         // check that the mouse position is being updated correctly
-        const IInputEvent* const pOutEvent = inputBuffer._storage.front().get();
-        const MouseEvent* const pMouseEvent = static_cast<const MouseEvent* const>(pOutEvent);
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
-        VERIFY_ARE_EQUAL(pMouseEvent->GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
+        const MouseEvent mouseEvent{ inputBuffer._storage.front().Event.MouseEvent };
+        VERIFY_ARE_EQUAL(mouseEvent.GetPosition().X, static_cast<SHORT>(RECORD_INSERT_COUNT));
+        VERIFY_ARE_EQUAL(mouseEvent.GetPosition().Y, static_cast<SHORT>(RECORD_INSERT_COUNT * 2));
 
         // add a key event and another mouse event to make sure that
         // an event between two mouse events stopped the coalescing.
@@ -162,10 +163,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), mouseRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), mouseRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), mouseRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], mouseRecords[i]);
         }
     }
 
@@ -221,10 +222,10 @@ class InputBufferTests
         // no events should have been coalesced
         VERIFY_ARE_EQUAL(inputBuffer.GetNumberOfReadyEvents(), RECORD_INSERT_COUNT + 1);
         // check that the events stored match those inserted
-        VERIFY_ARE_EQUAL(inputBuffer._storage.front()->ToInputRecord(), keyRecords[0]);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front(), keyRecords[0]);
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
-            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1]->ToInputRecord(), keyRecords[i]);
+            VERIFY_ARE_EQUAL(inputBuffer._storage[i + 1], keyRecords[i]);
         }
     }
 
@@ -239,7 +240,7 @@ class InputBufferTests
         for (size_t i = 0; i < RECORD_INSERT_COUNT; ++i)
         {
             VERIFY_IS_GREATER_THAN(inputBuffer.Write(IInputEvent::Create(record)), 0u);
-            VERIFY_ARE_EQUAL(inputBuffer._storage.back()->ToInputRecord(), record);
+            VERIFY_ARE_EQUAL(inputBuffer._storage.back(), record);
         }
 
         // The events shouldn't be coalesced
@@ -382,10 +383,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read one record, make sure ResetWaitEvent isn't set
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords;
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 1,
                                 eventsRead,
                                 false,
@@ -396,8 +397,8 @@ class InputBufferTests
         VERIFY_IS_FALSE(!!resetWaitEvent);
 
         // read the rest, resetWaitEvent should be set to true
-        outEvents.clear();
-        inputBuffer._ReadBuffer(outEvents,
+        outRecords.clear();
+        inputBuffer._ReadBuffer(outRecords,
                                 RECORD_INSERT_COUNT - 1,
                                 eventsRead,
                                 false,
@@ -431,10 +432,10 @@ class InputBufferTests
         VERIFY_IS_GREATER_THAN(inputBuffer.Write(inEvents), 0u);
 
         // read them out non-unicode style and compare
-        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        std::vector<INPUT_RECORD> outRecords;
         size_t eventsRead = 0;
         bool resetWaitEvent = false;
-        inputBuffer._ReadBuffer(outEvents,
+        inputBuffer._ReadBuffer(outRecords,
                                 recordInsertCount,
                                 eventsRead,
                                 false,
@@ -444,10 +445,10 @@ class InputBufferTests
         // the dbcs record should have counted for two elements in
         // the array, making it so that we get less events read
         VERIFY_ARE_EQUAL(eventsRead, recordInsertCount - 1);
-        VERIFY_ARE_EQUAL(eventsRead, outEvents.size());
+        VERIFY_ARE_EQUAL(eventsRead, outRecords.size());
         for (size_t i = 0; i < eventsRead; ++i)
         {
-            VERIFY_ARE_EQUAL(outEvents[i]->ToInputRecord(), inRecords[i]);
+            VERIFY_ARE_EQUAL(outRecords[i], inRecords[i]);
         }
     }
 
@@ -589,22 +590,17 @@ class InputBufferTests
     {
         InputBuffer inputBuffer;
         INPUT_RECORD record = MakeKeyEvent(true, 1, L'a', 0, L'a', 0);
-        std::unique_ptr<IInputEvent> inputEvent = IInputEvent::Create(record);
         size_t eventsWritten;
         bool waitEvent = false;
         inputBuffer.Flush();
         // write one event to an empty buffer
-        std::deque<std::unique_ptr<IInputEvent>> storage;
-        storage.push_back(std::move(inputEvent));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer(gsl::make_span(&record, 1), eventsWritten, waitEvent);
         VERIFY_IS_TRUE(waitEvent);
         // write another, it shouldn't signal this time
         INPUT_RECORD record2 = MakeKeyEvent(true, 1, L'b', 0, L'b', 0);
-        std::unique_ptr<IInputEvent> inputEvent2 = IInputEvent::Create(record2);
         // write another event to a non-empty buffer
         waitEvent = false;
-        storage.push_back(std::move(inputEvent2));
-        inputBuffer._WriteBuffer(storage, eventsWritten, waitEvent);
+        inputBuffer._WriteBuffer(gsl::make_span(&record2, 1), eventsWritten, waitEvent);
 
         VERIFY_IS_FALSE(waitEvent);
     }
@@ -625,7 +621,7 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount - 1);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount - 1);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
 
@@ -645,7 +641,212 @@ class InputBufferTests
                                                  true));
         VERIFY_ARE_EQUAL(outEvents.size(), 1u);
         VERIFY_ARE_EQUAL(inputBuffer._storage.size(), 1u);
-        VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*inputBuffer._storage.front()).GetRepeatCount(), repeatCount);
+        VERIFY_ARE_EQUAL(inputBuffer._storage.front().Event.KeyEvent.wRepeatCount, repeatCount);
         VERIFY_ARE_EQUAL(static_cast<const KeyEvent&>(*outEvents.front()).GetRepeatCount(), 1u);
     }
+
+    TEST_METHOD(StreamReadingTakesTextDirectly)
+    {
+        InputBuffer inputBuffer;
+        const INPUT_RECORD before = MakeKeyEvent(TRUE, 1, L'X', 0, L'X', 0);
+        const INPUT_RECORD after = MakeKeyEvent(TRUE, 1, L'Y', 0, L'Y', 0);
+
+        VERIFY_ARE_EQUAL(1u, inputBuffer.Write(before));
+        VERIFY_ARE_EQUAL(3u, inputBuffer.WriteText(L"abc"));
+        VERIFY_ARE_EQUAL(2u, inputBuffer.WriteText(L"de"));
+        VERIFY_ARE_EQUAL(1u, inputBuffer.Write(after));
+
+        Log::Comment(L"Text written back to back shares a chunk.");
+        VERIFY_ARE_EQUAL(1u, inputBuffer._textChunks.size());
+        VERIFY_ARE_EQUAL(3u, inputBuffer._storage.size());
+        VERIFY_ARE_EQUAL(7u, inputBuffer.GetNumberOfReadyEvents());
+
+        Log::Comment(L"Text is only handed out once the records before it have been read.");
+        wchar_t wch;
+        VERIFY_IS_FALSE(inputBuffer.ReadTextChar(wch));
+
+        std::unique_ptr<IInputEvent> outEvent;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outEvent, false, false, true, true));
+        VERIFY_ARE_EQUAL(before, outEvent->ToInputRecord());
+
+        std::wstring text;
+        while (inputBuffer.ReadTextChar(wch))
+        {
+            text.push_back(wch);
+        }
+        VERIFY_ARE_EQUAL(L"abcde", std::wstring_view{ text });
+        VERIFY_IS_TRUE(inputBuffer._textChunks.empty());
+
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outEvent, false, false, true, true));
+        VERIFY_ARE_EQUAL(after, outEvent->ToInputRecord());
+        VERIFY_ARE_EQUAL(0u, inputBuffer.GetNumberOfReadyEvents());
+    }
+
+    TEST_METHOD(GetCharFiltersTextLikeKeyEvents)
+    {
+        InputBuffer inputBuffer;
+        WI_ClearFlag(inputBuffer.InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT);
+        VERIFY_ARE_EQUAL(4u, inputBuffer.WriteText(L"a\x1b\nb"));
+
+        Log::Comment(L"Escape and Newline are dropped, and the out parameters describe a plain key press.");
+        std::wstring text;
+        wchar_t wch;
+        bool commandLineEditingKeys = true;
+        DWORD keyState = MAXDWORD;
+        while (NT_SUCCESS(GetChar(&inputBuffer, &wch, false, &commandLineEditingKeys, nullptr, &keyState)))
+        {
+            text.push_back(wch);
+            VERIFY_IS_FALSE(commandLineEditingKeys);
+            VERIFY_ARE_EQUAL(0u, keyState);
+            commandLineEditingKeys = true;
+            keyState = MAXDWORD;
+        }
+        VERIFY_ARE_EQUAL(L"ab", std::wstring_view{ text });
+
+        Log::Comment(L"With VT input, they're handed out like the key events would be.");
+        WI_SetFlag(inputBuffer.InputMode, ENABLE_VIRTUAL_TERMINAL_INPUT);
+        VERIFY_ARE_EQUAL(4u, inputBuffer.WriteText(L"a\x1b\nb"));
+        text.clear();
+        while (NT_SUCCESS(GetChar(&inputBuffer, &wch, false, nullptr, nullptr, nullptr)))
+        {
+            text.push_back(wch);
+        }
+        VERIFY_ARE_EQUAL(L"a\x1b\nb", std::wstring_view{ text });
+    }
+
+    TEST_METHOD(ReadingRecordsExpandsText)
+    {
+        InputBuffer inputBuffer;
+        const INPUT_RECORD after = MakeKeyEvent(TRUE, 1, L'Y', 0, L'Y', 0);
+
+        VERIFY_ARE_EQUAL(4u, inputBuffer.WriteText(L"wxyz"));
+        VERIFY_ARE_EQUAL(1u, inputBuffer.Write(after));
+
+        Log::Comment(L"Take part of the text first, as a ReadConsole would.");
+        wchar_t wch;
+        VERIFY_IS_TRUE(inputBuffer.ReadTextChar(wch));
+        VERIFY_ARE_EQUAL(L'w', wch);
+
+        Log::Comment(L"The rest comes out as the key events that type it, followed by the record.");
+        std::deque<std::unique_ptr<IInputEvent>> outEvents;
+        VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outEvents, 100, false, false, true, false));
+        VERIFY_IS_TRUE(inputBuffer._textChunks.empty());
+        VERIFY_ARE_EQUAL(0u, inputBuffer.GetNumberOfReadyEvents());
+        VERIFY_ARE_EQUAL(after, outEvents.back()->ToInputRecord());
+        outEvents.pop_back();
+
+        std::wstring typed;
+        for (const auto& event : outEvents)
+        {
+            VERIFY_ARE_EQUAL(InputEventType::KeyEvent, event->EventType());
+            const auto& keyEvent = static_cast<const KeyEvent&>(*event);
+            if (keyEvent.IsKeyDown() && keyEvent.GetCharData() != 0)
+            {
+                typed.push_back(keyEvent.GetCharData());
+            }
+        }
+        VERIFY_ARE_EQUAL(L"xyz", std::wstring_view{ typed });
+    }
+
+    TEST_METHOD(FlushingAllButKeysKeepsText)
+    {
+        InputBuffer inputBuffer;
+        INPUT_RECORD mouseRecord{ 0 };
+        mouseRecord.EventType = MOUSE_EVENT;
+
+        VERIFY_ARE_EQUAL(1u, inputBuffer.Write(mouseRecord));
+        VERIFY_ARE_EQUAL(2u, inputBuffer.WriteText(L"ab"));
+        inputBuffer.FlushAllButKeys();
+        VERIFY_ARE_EQUAL(2u, inputBuffer.GetNumberOfReadyEvents());
+
+        inputBuffer.Flush();
+        VERIFY_IS_TRUE(inputBuffer._textChunks.empty());
+        VERIFY_ARE_EQUAL(0u, inputBuffer.GetNumberOfReadyEvents());
+    }
+
+    TEST_METHOD(PasteLargeTextPerformance)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // 1 MB of UTF-16 text, with every character pasted as a key down and a key up.
+        constexpr size_t textLength = 1024 * 1024 / sizeof(wchar_t);
+        std::vector<INPUT_RECORD> records;
+        records.reserve(textLength * 2);
+        for (size_t i = 0; i < textLength; ++i)
+        {
+            const auto wch = static_cast<WCHAR>(L'a' + i % 26);
+            records.push_back(MakeKeyEvent(TRUE, 1, wch, 0, wch, 0));
+            records.push_back(MakeKeyEvent(FALSE, 1, wch, 0, wch, 0));
+        }
+
+        const auto readAll = [](InputBuffer& inputBuffer) {
+            size_t eventsRead = 0;
+            std::deque<std::unique_ptr<IInputEvent>> outEvents;
+            while (inputBuffer.GetNumberOfReadyEvents() > 0)
+            {
+                outEvents.clear();
+                VERIFY_SUCCESS_NTSTATUS(inputBuffer.Read(outEvents, 4096, false, false, true, false));
+                eventsRead += outEvents.size();
+            }
+            return eventsRead;
+        };
+
+        {
+            Log::Comment(L"Paste as records, the way WriteConsoleInput and the VT input thread write.");
+            InputBuffer inputBuffer;
+            auto now = std::chrono::steady_clock::now();
+            VERIFY_ARE_EQUAL(records.size(), inputBuffer.Write(records));
+            auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Wrote %zu records in %lld ms", records.size(), delta));
+
+            now = std::chrono::steady_clock::now();
+            VERIFY_ARE_EQUAL(records.size(), readAll(inputBuffer));
+            delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Read them back in %lld ms", delta));
+        }
+
+        {
+            Log::Comment(L"Paste as text, the way the clipboard writes, and read it the way ReadConsole does.");
+            std::wstring text;
+            text.reserve(textLength);
+            for (size_t i = 0; i < textLength; ++i)
+            {
+                text.push_back(static_cast<WCHAR>(L'a' + i % 26));
+            }
+
+            InputBuffer inputBuffer;
+            auto now = std::chrono::steady_clock::now();
+            VERIFY_ARE_EQUAL(text.size(), inputBuffer.WriteText(text));
+            auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Wrote %zu characters in %lld ms", text.size(), delta));
+
+            now = std::chrono::steady_clock::now();
+            size_t charsRead = 0;
+            wchar_t wch;
+            while (inputBuffer.ReadTextChar(wch))
+            {
+                ++charsRead;
+            }
+            VERIFY_ARE_EQUAL(text.size(), charsRead);
+            delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Read them back in %lld ms", delta));
+        }
+
+        {
+            Log::Comment(L"For comparison, paste as IInputEvents, one key down and up per character.");
+            InputBuffer inputBuffer;
+            auto now = std::chrono::steady_clock::now();
+            auto events = IInputEvent::Create(records);
+            VERIFY_ARE_EQUAL(records.size(), inputBuffer.Write(events));
+            auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Created and wrote %zu events in %lld ms", records.size(), delta));
+
+            now = std::chrono::steady_clock::now();
+            VERIFY_ARE_EQUAL(records.size(), readAll(inputBuffer));
+            delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+            Log::Comment(NoThrowString().Format(L"Read them back in %lld ms", delta));
+        }
+    }
 };
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "..\..\inc\consoletaeftemplates.hpp"
+
+#include "../InputRecordQueue.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using Microsoft::Console::InputRecordQueue;
+
+class InputRecordQueueTests
+{
+    TEST_CLASS(InputRecordQueueTests);
+
+    static INPUT_RECORD MakeRecord(const WORD id)
+    {
+        INPUT_RECORD record{ 0 };
+        record.EventType = MENU_EVENT;
+        record.Event.MenuEvent.dwCommandId = id;
+        return record;
+    }
+
+    static void VerifyContents(const InputRecordQueue& queue, const std::vector<WORD>& expected)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), queue.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(static_cast<UINT>(expected.at(i)), queue[i].Event.MenuEvent.dwCommandId);
+        }
+    }
+
+    TEST_METHOD(PushesAndPopsInOrder)
+    {
+        InputRecordQueue queue;
+        VERIFY_IS_TRUE(queue.empty());
+
+        queue.push_back(MakeRecord(1));
+        queue.push_back(MakeRecord(2));
+        queue.push_front(MakeRecord(0));
+        VerifyContents(queue, { 0, 1, 2 });
+
+        queue.pop_front();
+        VerifyContents(queue, { 1, 2 });
+        VERIFY_ARE_EQUAL(1u, queue.front().Event.MenuEvent.dwCommandId);
+        VERIFY_ARE_EQUAL(2u, queue.back().Event.MenuEvent.dwCommandId);
+
+        queue.pop_front(5);
+        VERIFY_IS_TRUE(queue.empty());
+    }
+
+    TEST_METHOD(GrowsWhileWrappedAround)
+    {
+        InputRecordQueue queue;
+        queue.push_back(MakeRecord(0));
+        const auto capacity = queue.capacity();
+
+        Log::Comment(L"Walk the front of the queue to the end of the storage so that it wraps.");
+        for (WORD i = 1; i < capacity; ++i)
+        {
+            queue.push_back(MakeRecord(i));
+            queue.pop_front();
+        }
+        queue.push_back(MakeRecord(gsl::narrow<WORD>(capacity)));
+        VerifyContents(queue, { gsl::narrow<WORD>(capacity - 1), gsl::narrow<WORD>(capacity) });
+        VERIFY_ARE_EQUAL(capacity, queue.capacity());
+
+        Log::Comment(L"Appending more than fits must keep the order.");
+        std::vector<INPUT_RECORD> records;
+        std::vector<WORD> expected{ gsl::narrow<WORD>(capacity - 1), gsl::narrow<WORD>(capacity) };
+        for (WORD i = 0; i < capacity; ++i)
+        {
+            const auto id = gsl::narrow_cast<WORD>(1000 + i);
+            records.push_back(MakeRecord(id));
+            expected.push_back(id);
+        }
+        queue.append(records);
+        VERIFY_IS_GREATER_THAN(queue.capacity(), capacity);
+        VerifyContents(queue, expected);
+    }
+
+    TEST_METHOD(AppendsAcrossTheEndOfStorage)
+    {
+        InputRecordQueue queue;
+        queue.push_back(MakeRecord(0));
+        const auto capacity = queue.capacity();
+        queue.pop_front();
+
+        Log::Comment(L"Leave a single record right before the end of the storage.");
+        for (WORD i = 0; i < capacity - 2; ++i)
+        {
+            queue.push_back(MakeRecord(i));
+        }
+        queue.pop_front(capacity - 3);
+
+        const std::vector<INPUT_RECORD> records{ MakeRecord(10), MakeRecord(11), MakeRecord(12), MakeRecord(13) };
+        queue.append(records);
+        VERIFY_ARE_EQUAL(capacity, queue.capacity());
+        VerifyContents(queue, { gsl::narrow<WORD>(capacity - 3), 10, 11, 12, 13 });
+
+        Log::Comment(L"Linearizing must put the records back in one piece, in order.");
+        const auto linear = queue.linearize();
+        VERIFY_ARE_EQUAL(5u, linear.size());
+        VERIFY_ARE_EQUAL(static_cast<UINT>(capacity - 3), linear[0].Event.MenuEvent.dwCommandId);
+        VERIFY_ARE_EQUAL(13u, linear[4].Event.MenuEvent.dwCommandId);
+        VerifyContents(queue, { gsl::narrow<WORD>(capacity - 3), 10, 11, 12, 13 });
+    }
+
+    TEST_METHOD(EraseIfKeepsOrder)
+    {
+        InputRecordQueue queue;
+        for (WORD i = 0; i < 10; ++i)
+        {
+            queue.push_back(MakeRecord(i));
+        }
+
+        queue.erase_if([](const INPUT_RECORD& record) {
+            return record.Event.MenuEvent.dwCommandId % 3 == 0;
+        });
+        VerifyContents(queue, { 1, 2, 4, 5, 7, 8 });
+    }
+};
@@ -13,6 +13,7 @@
 #include "input.h"
 #include "getset.h"
 #include "_stream.h" // For WriteCharsLegacy
+#include "outputStream.hpp" // For ConhostInternalGetSet
 
 #include "..\interactivity\inc\ServiceLocator.hpp"
 #include "..\..\inc\conattrs.hpp"
@@ -214,6 +215,19 @@ class ScreenBufferTests
     TEST_METHOD(UpdateVirtualBottomWhenCursorMovesBelowIt);
 
     TEST_METHOD(TestWriteConsoleVTQuirkMode);
+
+    TEST_METHOD(NarrowQueriesMatchScreenBufferInfo);
+    TEST_METHOD(CursorAddressingPerformance);
+
+    TEST_METHOD(TranslateCharsetsInStrings);
+    TEST_METHOD(CharsetTranslationPerformance);
+
+    TEST_METHOD(GraphicsRenditionPerformance);
+
+    TEST_METHOD(ErasePerformance);
+    TEST_METHOD(InsertDeletePerformance);
+    TEST_METHOD(TabStopPerformance);
+    TEST_METHOD(PrintPerformance);
 };
 
 void ScreenBufferTests::SingleAlternateBufferCreationTest()
@@ -3286,6 +3300,34 @@ auto _ValidateLinesContain(int startLine, int endLine, T expectedContent, TextAt
     return true;
 };
 
+// Routine Description:
+// - Feeds the given output to the active buffer's state machine over and over,
+//   and logs how long that took. The timing is only meaningful in a release
+//   build, which is why the tests that use this are marked as perf tests.
+// Arguments:
+// - description - what the output is, for the log.
+// - output - the output to process.
+// - iterations - how many times to process it.
+void _MeasureProcessString(const std::wstring_view description, const std::wstring_view output, const size_t iterations)
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& stateMachine = gci.GetActiveOutputBuffer().GetActiveBuffer().GetStateMachine();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        stateMachine.ProcessString(output);
+    }
+    const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    Log::Comment(NoThrowString().Format(L"Processed %zu times %.*s of %zu characters in %lld ms",
+                                        iterations,
+                                        gsl::narrow<int>(description.size()),
+                                        description.data(),
+                                        output.size(),
+                                        delta));
+}
+
 void ScreenBufferTests::ScrollOperations()
 {
     enum ScrollType : int
@@ -4773,6 +4815,265 @@ void ScreenBufferTests::HardResetBuffer()
     VERIFY_ARE_EQUAL(TextAttribute{}, si.GetAttributes());
 }
 
+void ScreenBufferTests::ErasePerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+
+    // Redraw the screen the way full-screen applications do: clear it, then
+    // clear to the end of each line and erase a few characters as it's drawn.
+    // The characters are erased in another color, to tell them apart.
+    std::wstring redraw = L"\x1b[48;5;4m\x1b[H\x1b[2J";
+    const auto height = si.GetViewport().Height();
+    for (auto line = 1; line <= height; ++line)
+    {
+        redraw += wil::str_printf<std::wstring>(L"\x1b[%d;1Hline %d\x1b[K\x1b[%d;40HXXXXXXXXXXXXXXXXXXXX", line, line, line);
+        redraw += wil::str_printf<std::wstring>(L"\x1b[%d;40H\x1b[48;5;1m\x1b[10X\x1b[48;5;4m", line);
+    }
+    redraw += L"\x1b[m";
+
+    _MeasureProcessString(L"screen redraws", redraw, 1000);
+
+    TextAttribute drawnAttr{};
+    drawnAttr.SetBackground(TextColor{ gsl::narrow_cast<BYTE>(Xterm256ToWindowsIndex(4)), true });
+    TextAttribute erasedAttr{};
+    erasedAttr.SetBackground(TextColor{ gsl::narrow_cast<BYTE>(Xterm256ToWindowsIndex(1)), true });
+
+    Log::Comment(L"Every line is cleared in the color it was drawn with after its text, and the");
+    Log::Comment(L"erased characters are blank in the color they were erased with.");
+    const auto viewport = si.GetViewport();
+    for (auto line = 1; line <= height; ++line)
+    {
+        const auto row = gsl::narrow<SHORT>(viewport.Top() + line - 1);
+        auto text = wil::str_printf<std::wstring>(L"line %d", line);
+        text.resize(39, L' ');
+
+        VERIFY_IS_TRUE(_ValidateLineContains({ 0, row }, text, drawnAttr));
+        VERIFY_IS_TRUE(_ValidateLineContains({ 59, row }, std::wstring(viewport.Width() - 59, L' '), drawnAttr));
+        VERIFY_IS_TRUE(_ValidateLineContains({ 39, row }, L"          ", erasedAttr));
+        VERIFY_IS_TRUE(_ValidateLineContains({ 49, row }, L"XXXXXXXXXX", drawnAttr));
+    }
+}
+
+void ScreenBufferTests::InsertDeletePerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+    const auto& textBuffer = si.GetTextBuffer();
+
+    // Edit a file the way a full-screen editor draws it: keep the status line
+    // out of the scrolling region, insert and delete characters as they're
+    // typed in the middle of a line, then open and delete whole lines.
+    const auto height = si.GetViewport().Height();
+    std::wstring edit = wil::str_printf<std::wstring>(L"\x1b[1;%dr", height - 1);
+    for (auto line = 1; line < height; ++line)
+    {
+        edit += wil::str_printf<std::wstring>(L"\x1b[%d;1H    auto value%d = Compute(argument, %d);", line, line, line);
+    }
+    edit += L"\x1b[10;10H";
+    for (const auto ch : std::wstring_view{ L"NewName" })
+    {
+        edit += L"\x1b[@";
+        edit += ch;
+    }
+    edit += L"\x1b[7D\x1b[7P";
+    for (auto line = 0; line < 10; ++line)
+    {
+        edit += L"\x1b[12;1H\x1b[L    inserted line;\x1b[20;1H\x1b[M";
+    }
+    edit += L"\x1b[r";
+
+    _MeasureProcessString(L"editing sessions", edit, 500);
+
+    const auto top = si.GetViewport().Top();
+    const auto width = si.GetViewport().Width();
+    const auto verifyLine = [&](const int line, const std::wstring_view expected) {
+        std::wstring expectedRow{ expected };
+        expectedRow.resize(width, L' ');
+        VERIFY_ARE_EQUAL(expectedRow, textBuffer.GetRowByOffset(top + line - 1).GetText());
+    };
+    const auto originalLine = [](const int line) {
+        return wil::str_printf<std::wstring>(L"    auto value%d = Compute(argument, %d);", line, line);
+    };
+
+    Log::Comment(L"The lines above the inserted ones are as they were written.");
+    for (auto line = 1; line < 12; ++line)
+    {
+        verifyLine(line, originalLine(line));
+    }
+
+    Log::Comment(L"Every DL at line 20 deleted an inserted line once they reached it.");
+    for (auto line = 12; line < 20; ++line)
+    {
+        verifyLine(line, L"    inserted line;");
+    }
+
+    Log::Comment(L"The lines below them moved back up where they were written, but the");
+    Log::Comment(L"last line of the margins was pulled in blank, and the status line was kept.");
+    for (auto line = 20; line < height - 1; ++line)
+    {
+        verifyLine(line, originalLine(line));
+    }
+    verifyLine(height - 1, L"");
+    verifyLine(height, L"");
+
+    Log::Comment(L"ICH shifts the rest of the line right, and DCH pulls it back.");
+    stateMachine.ProcessString(L"\x1b[10;10H\x1b[3@New");
+    verifyLine(10, L"    auto Newvalue10 = Compute(argument, 10);");
+    stateMachine.ProcessString(L"\x1b[3D\x1b[3P");
+    verifyLine(10, originalLine(10));
+}
+
+void ScreenBufferTests::PrintPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    const auto& textBuffer = si.GetTextBuffer();
+    const auto viewport = si.GetViewport();
+    const auto height = viewport.Height();
+    const auto width = viewport.Width();
+
+    // Fill the screen with lines of plain ASCII, like a build log, then with
+    // lines that mix in wide characters, which have to be measured, and then
+    // with lines that wrap because their last wide character doesn't fit.
+    const auto measure = [&](const std::wstring_view name, const std::wstring_view line, const int rowsPerLine) {
+        std::wstring screen;
+        for (auto row = 1; row <= height; row += rowsPerLine)
+        {
+            screen += wil::str_printf<std::wstring>(L"\x1b[%d;1H", row);
+            screen += line;
+        }
+        _MeasureProcessString(name, screen, 1000);
+    };
+    const auto rowAt = [&](const int row) -> const ROW& {
+        return textBuffer.GetRowByOffset(viewport.Top() + row);
+    };
+
+    const std::wstring_view ascii{ L"[  42%] Building CXX object src/CMakeFiles/core.dir/parser.cpp.o" };
+    measure(L"ASCII screens", ascii, 1);
+
+    Log::Comment(L"Every row holds the line, and none of them wrapped.");
+    std::wstring expectedText{ ascii };
+    expectedText.resize(width, L' ');
+    for (auto row = 0; row < height; ++row)
+    {
+        VERIFY_ARE_EQUAL(expectedText, rowAt(row).GetText());
+        VERIFY_IS_FALSE(rowAt(row).GetCharRow().WasWrapForced());
+    }
+
+    const std::wstring_view mixed{ L"\x66f4\x65b0: \x65e5\x672c\x8a9e\x306e\x30c6\x30ad\x30b9\x30c8 and some ASCII" };
+    measure(L"mixed screens", mixed, 1);
+
+    Log::Comment(L"The wide characters take two cells each, and the old line is left after the new one.");
+    const auto& charRow = rowAt(0).GetCharRow();
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x66f4" }, std::wstring_view{ charRow.GlyphAt(0) });
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(0).IsLeading());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(1).IsTrailing());
+    VERIFY_ARE_EQUAL(std::wstring_view{ L":" }, std::wstring_view{ charRow.GlyphAt(4) });
+    const size_t wideCharacters = 10;
+    expectedText = mixed;
+    expectedText += ascii.substr(mixed.size() + wideCharacters);
+    expectedText.resize(width - wideCharacters, L' ');
+    VERIFY_ARE_EQUAL(expectedText, rowAt(0).GetText());
+    VERIFY_IS_FALSE(charRow.WasWrapForced());
+
+    std::wstring wrapped(width - 1, L'x');
+    wrapped += L"\x65e5\x672c";
+    measure(L"wrapping screens", wrapped, 2);
+
+    Log::Comment(L"A wide character that doesn't fit pads the row and moves to the next one.");
+    for (auto row = 0; row + 1 < height; row += 2)
+    {
+        const auto& first = rowAt(row).GetCharRow();
+        VERIFY_ARE_EQUAL(std::wstring(width - 1, L'x'), rowAt(row).GetText().substr(0, width - 1));
+        VERIFY_IS_TRUE(first.WasWrapForced());
+        VERIFY_IS_TRUE(first.WasDoubleBytePadded());
+
+        const auto& second = rowAt(row + 1).GetCharRow();
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x65e5" }, std::wstring_view{ second.GlyphAt(0) });
+        VERIFY_ARE_EQUAL(std::wstring_view{ L"\x672c" }, std::wstring_view{ second.GlyphAt(2) });
+        VERIFY_IS_FALSE(second.WasWrapForced());
+    }
+}
+
+void ScreenBufferTests::TabStopPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+    const auto& textBuffer = si.GetTextBuffer();
+
+    // Lay out a tab-separated table with a few sparse tab stops, the way a
+    // tool dumping TSV would, and jump around it with CHT and CBT.
+    stateMachine.ProcessString(L"\x1b[3g\x1b[1;13H\x1bH\x1b[1;41H\x1bH\x1b[1;61H\x1bH");
+
+    const auto height = si.GetViewport().Height();
+    std::wstring table;
+    for (auto line = 1; line <= height; ++line)
+    {
+        table += wil::str_printf<std::wstring>(L"\x1b[%d;1Hid%d\tname%d\tvalue\t%d\x1b[9Z\x1b[2I", line, line, line, line);
+    }
+
+    _MeasureProcessString(L"tables", table, 2000);
+
+    VERIFY_ARE_EQUAL(40, textBuffer.GetCursor().GetPosition().X);
+
+    Log::Comment(L"Only the stops that were set are there, going forward and backward.");
+    const auto& cursor = textBuffer.GetCursor();
+    const auto lastColumn = si.GetViewport().Width() - 1;
+    stateMachine.ProcessString(L"\x1b[1;1H");
+    for (const auto expectedColumn : { 12, 40, 60, lastColumn })
+    {
+        stateMachine.ProcessString(L"\t");
+        VERIFY_ARE_EQUAL(expectedColumn, cursor.GetPosition().X);
+    }
+    for (const auto expectedColumn : { 60, 40, 12, 0 })
+    {
+        stateMachine.ProcessString(L"\x1b[Z");
+        VERIFY_ARE_EQUAL(expectedColumn, cursor.GetPosition().X);
+    }
+
+    const auto top = si.GetViewport().Top();
+    const auto line = textBuffer.GetRowByOffset(top).GetText();
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"id1" }, std::wstring_view{ line }.substr(0, 3));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"name1" }, std::wstring_view{ line }.substr(12, 5));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"value" }, std::wstring_view{ line }.substr(40, 5));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"1" }, std::wstring_view{ line }.substr(60, 1));
+}
+
 void ScreenBufferTests::RestoreDownAltBufferWithTerminalScrolling()
 {
     // This is a test for microsoft/terminal#1206. Refer to that issue for more
@@ -6043,3 +6344,240 @@ void ScreenBufferTests::TestWriteConsoleVTQuirkMode()
         verifyLastAttribute(vtWhiteOnBlack256Attribute);
     }
 }
+
+void ScreenBufferTests::NarrowQueriesMatchScreenBufferInfo()
+{
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+    const ConhostInternalGetSet conApi{ gci };
+
+    const auto verifyQueries = [&]() {
+        CONSOLE_SCREEN_BUFFER_INFOEX csbiex{ 0 };
+        csbiex.cbSize = sizeof(csbiex);
+        VERIFY_IS_TRUE(conApi.GetConsoleScreenBufferInfoEx(csbiex));
+
+        COORD cursorPosition{ 0 };
+        SMALL_RECT viewport{ 0 };
+        COORD bufferSize{ 0 };
+        VERIFY_IS_TRUE(conApi.PrivateGetCursorPosition(cursorPosition));
+        VERIFY_IS_TRUE(conApi.PrivateGetViewport(viewport));
+        VERIFY_IS_TRUE(conApi.PrivateGetBufferSize(bufferSize));
+
+        VERIFY_ARE_EQUAL(csbiex.dwCursorPosition, cursorPosition);
+        VERIFY_ARE_EQUAL(csbiex.srWindow, viewport);
+        VERIFY_ARE_EQUAL(csbiex.dwSize, bufferSize);
+    };
+
+    Log::Comment(L"Move the cursor and the viewport away from the origin.");
+    VERIFY_SUCCEEDED(si.SetViewportOrigin(true, { 0, 5 }, true));
+    stateMachine.ProcessString(L"\x1b[3;7H");
+    verifyQueries();
+
+    Log::Comment(L"The queries should report on the alt buffer while it's active.");
+    stateMachine.ProcessString(L"\x1b[?1049h");
+    stateMachine.ProcessString(L"\x1b[10;20H");
+    verifyQueries();
+
+    stateMachine.ProcessString(L"\x1b[?1049l");
+    verifyQueries();
+}
+
+void ScreenBufferTests::CursorAddressingPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    const auto viewport = si.GetViewport();
+
+    // A full screen redraw the way htop or vim would do it: every line is
+    // addressed with a CUP, cleared with an EL, and then gets a few colored
+    // fields. That's mostly cursor and viewport queries, and very little text.
+    std::wstring frame;
+    auto lastColumn = 1;
+    for (auto row = 1; row <= viewport.Height(); ++row)
+    {
+        frame += wil::str_printf<std::wstring>(L"\x1b[%d;1H\x1b[K", row);
+        for (auto col = 1; col + 10 < viewport.Width(); col += 10)
+        {
+            frame += wil::str_printf<std::wstring>(L"\x1b[%d;%dH\x1b[3%dm%04d\x1b[m", row, col, col % 8, row);
+            lastColumn = col;
+        }
+        frame += L"\x1b[2X";
+    }
+
+    _MeasureProcessString(L"full screen frames", frame, 1000);
+
+    Log::Comment(L"The cursor is left after the last field of the last line.");
+    const COORD expectedCursor{ gsl::narrow<SHORT>(lastColumn - 1 + 4), viewport.BottomInclusive() };
+    VERIFY_ARE_EQUAL(expectedCursor, si.GetTextBuffer().GetCursor().GetPosition());
+
+    Log::Comment(L"Every field is where it was addressed, in its own color.");
+    for (auto col = 1; col <= lastColumn; col += 10)
+    {
+        TextAttribute expectedAttr{};
+        expectedAttr.SetIndexedForeground((BYTE)XtermToWindowsIndex(col % 8));
+        VERIFY_IS_TRUE(_ValidateLineContains({ gsl::narrow<SHORT>(col - 1), viewport.Top() }, L"0001", expectedAttr));
+        VERIFY_IS_TRUE(_ValidateLineContains({ gsl::narrow<SHORT>(col - 1), viewport.BottomInclusive() },
+                                             wil::str_printf<std::wstring>(L"%04d", viewport.Height()),
+                                             expectedAttr));
+    }
+    VERIFY_IS_TRUE(_ValidateLineContains({ 4, viewport.Top() }, L"      ", TextAttribute{}));
+}
+
+void ScreenBufferTests::TranslateCharsetsInStrings()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    auto& stateMachine = si.GetStateMachine();
+    auto& cursor = si.GetTextBuffer().GetCursor();
+    const auto defaultAttrs = TextAttribute{};
+
+    Log::Comment(L"Make sure the viewport is at 0,0");
+    VERIFY_SUCCEEDED(si.SetViewportOrigin(true, COORD({ 0, 0 }), true));
+
+    Log::Comment(L"Text that the active set doesn't change is printed as it is, the rest is translated.");
+    cursor.SetPosition(COORD{ 0, 0 });
+    stateMachine.ProcessString(L"\x1b(0");
+    stateMachine.ProcessString(L"ABCDEFGHIJKLMNOPQRSTUVWXYZ lqk ABC");
+    VERIFY_IS_TRUE(_ValidateLineContains(COORD({ 0, 0 }), L"ABCDEFGHIJKLMNOPQRSTUVWXYZ ┌─┐ ABC", defaultAttrs));
+    stateMachine.ProcessString(L"\x1b(B");
+
+    Log::Comment(L"A single shift only applies to the first character.");
+    cursor.SetPosition(COORD{ 0, 1 });
+    stateMachine.ProcessString(L"\x1b*0");
+    stateMachine.ProcessString(L"\x1bNqq");
+    VERIFY_IS_TRUE(_ValidateLineContains(COORD({ 0, 1 }), L"─q", defaultAttrs));
+    stateMachine.ProcessString(L"\x1b*B");
+
+    Log::Comment(L"GR is translated too, once ISO-2022 is selected.");
+    cursor.SetPosition(COORD{ 0, 2 });
+    stateMachine.ProcessString(L"\x1b%@");
+    stateMachine.ProcessString(L"\x1b.B");
+    stateMachine.ProcessString(L"abcdefghijklmnopqrstuvwxyz \xa3");
+    VERIFY_IS_TRUE(_ValidateLineContains(COORD({ 0, 2 }), L"abcdefghijklmnopqrstuvwxyz \u0141", defaultAttrs));
+    stateMachine.ProcessString(L"\x1b.A");
+    stateMachine.ProcessString(L"\x1b%G");
+}
+
+void ScreenBufferTests::CharsetTranslationPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    StateMachine& stateMachine = si.GetStateMachine();
+    const auto viewport = si.GetViewport();
+
+    // A full screen of boxes the way ncurses or mc would draw them: the
+    // borders in DEC Special Graphics, and the text in between them without
+    // switching back to ASCII first.
+    std::wstring frame{ L"\x1b(0" };
+    std::wstring expectedLine;
+    for (auto row = 1; row <= viewport.Height(); ++row)
+    {
+        frame += wil::str_printf<std::wstring>(L"\x1b[%d;1H", row);
+        for (auto col = 1; col + 20 < viewport.Width(); col += 20)
+        {
+            frame += L"x  FILE NAME.TXT  x";
+            frame += L"q";
+            if (row == 1)
+            {
+                expectedLine += L"│  FILE NAME.TXT  │─";
+            }
+        }
+    }
+    frame += L"\x1b(B";
+
+    _MeasureProcessString(L"frames of boxes", frame, 1000);
+
+    Log::Comment(L"Every line has its borders translated, and the text in between them left as it is.");
+    VERIFY_IS_TRUE(_ValidateLinesContain(viewport.Top(), viewport.BottomExclusive(), expectedLine, TextAttribute{}));
+
+    Log::Comment(L"Once ASCII is designated again, nothing is translated.");
+    stateMachine.ProcessString(L"\x1b[1;1Hxq");
+    VERIFY_IS_TRUE(_ValidateLineContains(COORD({ 0, viewport.Top() }), L"xq  FILE NAME.TXT  │─", TextAttribute{}));
+}
+
+void ScreenBufferTests::GraphicsRenditionPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    auto& g = ServiceLocator::LocateGlobals();
+    CONSOLE_INFORMATION& gci = g.getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+
+    // Output the way git diff colors it: a rendition around almost every
+    // line, and a few within them, all drawn from a handful of styles.
+    std::wstring diff;
+    for (auto file = 0; file < 20; ++file)
+    {
+        diff += wil::str_printf<std::wstring>(L"\x1b[1mdiff --git a/src/file%d.cpp b/src/file%d.cpp\x1b[m\r\n", file, file);
+        diff += wil::str_printf<std::wstring>(L"\x1b[1m--- a/src/file%d.cpp\x1b[m\r\n", file);
+        diff += wil::str_printf<std::wstring>(L"\x1b[1m+++ b/src/file%d.cpp\x1b[m\r\n", file);
+        for (auto hunk = 0; hunk < 5; ++hunk)
+        {
+            diff += wil::str_printf<std::wstring>(L"\x1b[36m@@ -%d,7 +%d,7 @@\x1b[m void Function%d()\r\n", hunk * 20, hunk * 20, hunk);
+            diff += L"     {\r\n";
+            diff += L"\x1b[31m-    auto value = \x1b[1;31mOldName\x1b[0;31m(argument);\x1b[m\r\n";
+            diff += L"\x1b[32m+\x1b[m\x1b[32m    auto value = \x1b[1;32mNewName\x1b[0;32m(argument);\x1b[m\r\n";
+            diff += L"\x1b[32m+\x1b[m\x1b[41m    \x1b[m\r\n";
+            diff += L"     }\r\n";
+        }
+    }
+
+    _MeasureProcessString(L"colored diffs", diff, 100);
+
+    VERIFY_ARE_EQUAL(TextAttribute{}, si.GetAttributes());
+
+    TextAttribute red{};
+    red.SetIndexedForeground((BYTE)XtermToWindowsIndex(1));
+    TextAttribute boldRed{ red };
+    boldRed.SetBold(true);
+    TextAttribute green{};
+    green.SetIndexedForeground((BYTE)XtermToWindowsIndex(2));
+    TextAttribute boldGreen{ green };
+    boldGreen.SetBold(true);
+    TextAttribute redBackground{};
+    redBackground.SetIndexedBackground((BYTE)XtermToWindowsIndex(1));
+
+    const auto lastLine = si.GetTextBuffer().GetCursor().GetPosition().Y;
+    const auto line = [=](const int offset) { return gsl::narrow<SHORT>(lastLine - offset); };
+
+    Log::Comment(L"The removed line is red, with the old name in bold.");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, line(4) }, L"-    auto value = ", red));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 18, line(4) }, L"OldName", boldRed));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 25, line(4) }, L"(argument);", red));
+
+    Log::Comment(L"The added line is green, with the new name in bold.");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, line(3) }, L"+    auto value = ", green));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 18, line(3) }, L"NewName", boldGreen));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 25, line(3) }, L"(argument);", green));
+
+    Log::Comment(L"The added whitespace is highlighted, and the context is left alone.");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, line(2) }, L"+", green));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 1, line(2) }, L"    ", redBackground));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, line(1) }, L"     }", TextAttribute{}));
+}
@@ -136,6 +136,11 @@ class TextBufferTests
 
     TEST_METHOD(TestRepeatCharacter);
 
+    TEST_METHOD(TestFillCells);
+    TEST_METHOD(TestWriteRun);
+    TEST_METHOD(TestInsertDeleteCells);
+    TEST_METHOD(TestScrollRowsInCircularBuffer);
+
     TEST_METHOD(ResizeTraditional);
 
     TEST_METHOD(ResizeTraditionalRotationPreservesHighUnicode);
@@ -148,6 +153,7 @@ class TextBufferTests
 
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
+    TEST_METHOD(DelimiterTableClassification);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
@@ -1720,6 +1726,189 @@ void TextBufferTests::TestRepeatCharacter()
     }
 }
 
+void TextBufferTests::TestFillCells()
+{
+    const COORD bufferSize = { 5, 3 };
+    const TextAttribute defaultAttr(0);
+    const TextAttribute redAttr(FOREGROUND_RED);
+    const TextAttribute blueAttr(BACKGROUND_BLUE);
+
+    TextBuffer buffer(bufferSize, defaultAttr, 12, _renderTarget);
+    buffer.Write(OutputCellIterator(L"0123456789ABCDE"), { 0, 0 });
+
+    Log::Comment(L"Fill text and color from the middle of the first row into the second.");
+    VERIFY_ARE_EQUAL(5u, buffer.FillCells({ 3, 0 }, 5, L'x', redAttr, false));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"012xx" }, std::wstring_view{ buffer.GetRowByOffset(0).GetText() });
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"xxx89" }, std::wstring_view{ buffer.GetRowByOffset(1).GetText() });
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(0).GetCharRow().WasWrapForced());
+
+    const auto& firstAttrs = buffer.GetRowByOffset(0).GetAttrRow();
+    VERIFY_ARE_EQUAL(2u, firstAttrs.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(defaultAttr, firstAttrs.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(redAttr, firstAttrs.GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(redAttr, firstAttrs.GetAttrByColumn(4));
+
+    const auto& secondAttrs = buffer.GetRowByOffset(1).GetAttrRow();
+    VERIFY_ARE_EQUAL(2u, secondAttrs.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(redAttr, secondAttrs.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(defaultAttr, secondAttrs.GetAttrByColumn(3));
+
+    Log::Comment(L"Filling a whole row leaves a single run, and sets the wrap flag when asked to.");
+    VERIFY_ARE_EQUAL(5u, buffer.FillCells({ 0, 1 }, 5, L' ', blueAttr, true));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"     " }, std::wstring_view{ buffer.GetRowByOffset(1).GetText() });
+    VERIFY_ARE_EQUAL(1u, secondAttrs.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(blueAttr, secondAttrs.GetAttrByColumn(0));
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(1).GetCharRow().WasWrapForced());
+
+    Log::Comment(L"Color only fills keep the text, and text only fills keep the colors.");
+    VERIFY_ARE_EQUAL(2u, buffer.FillCells({ 0, 2 }, 2, std::nullopt, blueAttr));
+    VERIFY_ARE_EQUAL(2u, buffer.FillCells({ 1, 2 }, 2, L'y', std::nullopt));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"AyyDE" }, std::wstring_view{ buffer.GetRowByOffset(2).GetText() });
+    const auto& thirdAttrs = buffer.GetRowByOffset(2).GetAttrRow();
+    VERIFY_ARE_EQUAL(blueAttr, thirdAttrs.GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(defaultAttr, thirdAttrs.GetAttrByColumn(2));
+
+    Log::Comment(L"Fills stop at the end of the buffer.");
+    VERIFY_ARE_EQUAL(2u, buffer.FillCells({ 3, 2 }, 10, L'z', redAttr));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"Ayyzz" }, std::wstring_view{ buffer.GetRowByOffset(2).GetText() });
+}
+
+void TextBufferTests::TestWriteRun()
+{
+    const COORD bufferSize = { 8, 1 };
+    const TextAttribute defaultAttr(0);
+    const TextAttribute redAttr(FOREGROUND_RED);
+
+    TextBuffer buffer(bufferSize, defaultAttr, 12, _renderTarget);
+    const auto& charRow = buffer.GetRowByOffset(0).GetCharRow();
+    const auto glyphAt = [&](const size_t column) { return std::wstring_view{ charRow.GlyphAt(column) }; };
+
+    // An ASCII prefix, a wide BMP glyph, a wide surrogate pair (alien monster) and a narrow glyph.
+    const std::wstring_view alien{ L"\xD83D\xDC7E" };
+    PrintRun run;
+    run.Compile(L"ab\x3042\xD83D\xDC7E" L"c", 7);
+    VERIFY_ARE_EQUAL(7u, run.Columns());
+
+    buffer.WriteRun(run, { 1, 0 }, redAttr);
+
+    VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, glyphAt(0));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"a" }, glyphAt(1));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"b" }, glyphAt(2));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x3042" }, glyphAt(3));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"\x3042" }, glyphAt(4));
+    VERIFY_ARE_EQUAL(alien, glyphAt(5));
+    VERIFY_ARE_EQUAL(alien, glyphAt(6));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"c" }, glyphAt(7));
+
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(2).IsSingle());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(3).IsLeading());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(4).IsTrailing());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(5).IsLeading());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(6).IsTrailing());
+    VERIFY_IS_TRUE(charRow.DbcsAttrAt(7).IsSingle());
+
+    Log::Comment(L"The text is one color, and reaching the end of the row wraps it.");
+    const auto& attrRow = buffer.GetRowByOffset(0).GetAttrRow();
+    VERIFY_ARE_EQUAL(2u, attrRow.GetNumberOfRuns());
+    VERIFY_ARE_EQUAL(defaultAttr, attrRow.GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(7));
+    VERIFY_IS_TRUE(charRow.WasWrapForced());
+}
+
+void TextBufferTests::TestInsertDeleteCells()
+{
+    const COORD bufferSize = { 6, 1 };
+    const TextAttribute defaultAttr(0);
+    const TextAttribute redAttr(FOREGROUND_RED);
+    const TextAttribute blueAttr(BACKGROUND_BLUE);
+
+    TextBuffer buffer(bufferSize, defaultAttr, 12, _renderTarget);
+    buffer.Write(OutputCellIterator(L"abc", defaultAttr), { 0, 0 }, false);
+    buffer.Write(OutputCellIterator(L"def", redAttr), { 3, 0 }, false);
+
+    // This is the fire emoji, which has to be kept in the unicode storage.
+    const std::wstring_view fire{ L"\xD83D\xDD25" };
+    buffer.GetRowByOffset(0).GetCharRow().GlyphAt(4) = fire;
+
+    const auto& row = buffer.GetRowByOffset(0);
+    const auto& attrRow = row.GetAttrRow();
+    const auto glyphAt = [&](const size_t column) { return std::wstring_view{ row.GetCharRow().GlyphAt(column) }; };
+
+    Log::Comment(L"Inserting pushes the cells to the right, along with their colors and glyphs.");
+    buffer.InsertCells({ 2, 0 }, 1, blueAttr);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"b" }, glyphAt(1));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, glyphAt(2));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"c" }, glyphAt(3));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"d" }, glyphAt(4));
+    VERIFY_ARE_EQUAL(fire, glyphAt(5));
+    VERIFY_ARE_EQUAL(defaultAttr, attrRow.GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(blueAttr, attrRow.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(defaultAttr, attrRow.GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(5));
+
+    Log::Comment(L"Deleting pulls them back to the left, and blanks the end of the row.");
+    buffer.DeleteCells({ 1, 0 }, 2, blueAttr);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"a" }, glyphAt(0));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"c" }, glyphAt(1));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"d" }, glyphAt(2));
+    VERIFY_ARE_EQUAL(fire, glyphAt(3));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, glyphAt(4));
+    VERIFY_ARE_EQUAL(std::wstring_view{ L" " }, glyphAt(5));
+    VERIFY_ARE_EQUAL(defaultAttr, attrRow.GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(2));
+    VERIFY_ARE_EQUAL(redAttr, attrRow.GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(blueAttr, attrRow.GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(blueAttr, attrRow.GetAttrByColumn(5));
+
+    Log::Comment(L"Counts past the end of the row blank everything from the target on.");
+    buffer.InsertCells({ 1, 0 }, 100, defaultAttr);
+    VERIFY_ARE_EQUAL(std::wstring_view{ L"a     " }, std::wstring_view{ row.GetText() });
+    VERIFY_ARE_EQUAL(1u, attrRow.GetNumberOfRuns());
+}
+
+void TextBufferTests::TestScrollRowsInCircularBuffer()
+{
+    const COORD bufferSize = { 4, 6 };
+    const TextAttribute defaultAttr(0);
+
+    TextBuffer buffer(bufferSize, defaultAttr, 12, _renderTarget);
+
+    // Move the start of the circular buffer along, so that the rows we scroll
+    // sit on either side of the end of the storage.
+    for (auto i = 0; i < 4; ++i)
+    {
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+    }
+    VERIFY_ARE_EQUAL(4, buffer.GetFirstRowIndex());
+
+    const auto writeRows = [&]() {
+        for (SHORT y = 0; y < bufferSize.Y; ++y)
+        {
+            buffer.Write(OutputCellIterator(std::wstring(bufferSize.X, gsl::narrow_cast<wchar_t>(L'0' + y)), defaultAttr), { 0, y }, false);
+        }
+    };
+    const auto verifyRows = [&](const std::wstring_view expected) {
+        for (SHORT y = 0; y < bufferSize.Y; ++y)
+        {
+            VERIFY_ARE_EQUAL(til::at(expected, y), buffer.GetRowByOffset(y).GetText().at(0));
+            VERIFY_ARE_EQUAL(buffer.GetRowByOffset(y).GetId(), buffer.GetRowByOffset(y).GetCharRow().GetStorageKey(0).Y);
+        }
+    };
+
+    Log::Comment(L"Rows that don't straddle the end of the storage are rotated in place.");
+    writeRows();
+    buffer.ScrollRows(0, 1, 1);
+    verifyRows(L"102345");
+    VERIFY_ARE_EQUAL(4, buffer.GetFirstRowIndex());
+
+    Log::Comment(L"Rows that do are still rotated correctly.");
+    writeRows();
+    buffer.ScrollRows(3, 2, -2);
+    verifyRows(L"034125");
+}
+
 void TextBufferTests::ResizeTraditional()
 {
     BEGIN_TEST_METHOD_PROPERTIES()
@@ -2129,6 +2318,39 @@ void TextBufferTests::GetWordBoundaries()
     }
 }
 
+void TextBufferTests::DelimiterTableClassification()
+{
+    // U+2502 is outside the lookup table and has to be found through the fallback
+    const std::wstring_view delimiters = L" /\\()\u2502";
+    const DelimiterTable table{ delimiters };
+
+    VERIFY_ARE_EQUAL(DelimiterClass::ControlChar, table.Classify(L'\0'));
+    VERIFY_ARE_EQUAL(DelimiterClass::ControlChar, table.Classify(L'\t'));
+    VERIFY_ARE_EQUAL(DelimiterClass::ControlChar, table.Classify(L' '));
+    VERIFY_ARE_EQUAL(DelimiterClass::DelimiterChar, table.Classify(L'/'));
+    VERIFY_ARE_EQUAL(DelimiterClass::DelimiterChar, table.Classify(L'('));
+    VERIFY_ARE_EQUAL(DelimiterClass::DelimiterChar, table.Classify(L'\u2502'));
+    VERIFY_ARE_EQUAL(DelimiterClass::RegularChar, table.Classify(L'a'));
+    VERIFY_ARE_EQUAL(DelimiterClass::RegularChar, table.Classify(L'\u00e9'));
+    VERIFY_ARE_EQUAL(DelimiterClass::RegularChar, table.Classify(L'\u2500'));
+
+    // The table has to agree with the row's own classification for every cell.
+    COORD bufferSize{ 20, 2 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+    WriteLinesToBuffer({ L"a/b (c)\u2502 d\u00e9f" }, *_buffer);
+
+    const auto& charRow = _buffer->GetRowByOffset(0).GetCharRow();
+    std::vector<DelimiterClass> classes;
+    charRow.GetDelimiterClasses(table, classes);
+    VERIFY_ARE_EQUAL(charRow.size(), classes.size());
+    for (size_t i = 0; i < classes.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(charRow.DelimiterClassAt(i, delimiters), classes.at(i));
+    }
+}
+
 void TextBufferTests::GetGlyphBoundaries()
 {
     struct ExpectedResult
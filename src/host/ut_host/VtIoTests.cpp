@@ -350,6 +350,11 @@ public:
         return std::vector<RenderOverlay>{};
     }
 
+    const std::vector<SMALL_RECT> GetPatternOverlays() const noexcept override
+    {
+        return std::vector<SMALL_RECT>{};
+    }
+
     const bool IsGridLineDrawingAllowed() noexcept override
     {
         return false;
@@ -8,12 +8,17 @@ Module Name:
 Abstract:
 - Defines classes which hold the status of the current partials handling.
 - Defines functions for converting between UTF-8 and UTF-16 strings.
+- Defines functions for converting into buffers provided by the caller, which
+  write as much as fits and report how much of the input they used up.
 
 Tests have been made in order to investigate whether or not own algorithms
 could overcome disadvantages of syscalls. Test results can be read up
 in PR #4093 and the test algorithms are available in src\tools\U8U16Test.
 Based on the results the decision was made to keep using the platform
 functions MultiByteToWideChar and WideCharToMultiByte.
+The exception is a leading run of ASCII, which is by far the most common
+content of terminal output. It's converted here, 8 bytes at a time, and only
+the rest of the string is handed to the platform functions.
 
 Author(s):
 - Steffen Illhardt (german-one) 2020
@@ -23,9 +28,19 @@ Author(s):
 
 namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
+    template<class charT>
+    class u8u16state;
+
+    [[nodiscard]] inline HRESULT u8u16(const std::string_view in, const gsl::span<wchar_t> out, u8u16state<char>& state, size_t& consumed, size_t& produced) noexcept;
+    [[nodiscard]] inline HRESULT u16u8(const std::wstring_view in, const gsl::span<char> out, u8u16state<wchar_t>& state, size_t& consumed, size_t& produced) noexcept;
+
     template<class charT>
     class u8u16state final
     {
+        // the conversions into caller-provided buffers keep their partials here as well
+        friend HRESULT u8u16(const std::string_view in, const gsl::span<wchar_t> out, u8u16state<char>& state, size_t& consumed, size_t& produced) noexcept;
+        friend HRESULT u16u8(const std::wstring_view in, const gsl::span<char> out, u8u16state<wchar_t>& state, size_t& consumed, size_t& produced) noexcept;
+
     public:
         u8u16state() noexcept :
             _buffer{},
@@ -78,32 +93,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _buffer.append(in);
                 size_t remainingLength{ _buffer.length() };
 
-                auto backIter = _buffer.end();
-                // If the last byte in the string was a byte belonging to a UTF-8 multi-byte character
-                if ((*(backIter - 1) & _Utf8BitMasks::MaskAsciiByte) > _Utf8BitMasks::IsAsciiByte)
+                const size_t sequenceLen{ _partialLength(_buffer) };
+                if (sequenceLen != 0u)
                 {
-                    // Check only up to 3 last bytes, if no Lead Byte was found then the byte before must be the Lead Byte and no partials are in the string
-                    const size_t stopLen{ std::min(_buffer.length(), gsl::narrow_cast<size_t>(3u)) };
-                    for (size_t sequenceLen{ 1u }; sequenceLen <= stopLen; ++sequenceLen)
-                    {
-                        --backIter;
-                        // If Lead Byte found
-                        if ((*backIter & _Utf8BitMasks::MaskContinuationByte) > _Utf8BitMasks::IsContinuationByte)
-                        {
-                            // If the Lead Byte indicates that the last bytes in the string is a partial UTF-8 code point then cache them:
-                            //  Use the bitmask at index `sequenceLen`. Compare the result with the operand having the same index. If they
-                            //  are not equal then the sequence has to be cached because it is a partial code point. Otherwise the
-                            //  sequence is a complete UTF-8 code point and the whole string is ready for the conversion into a UTF-16 string.
-                            if ((*backIter & _cmpMasks.at(sequenceLen)) != _cmpOperands.at(sequenceLen))
-                            {
-                                std::move(backIter, _buffer.end(), _utfPartials.begin());
-                                remainingLength -= sequenceLen;
-                                _partialsLen = sequenceLen;
-                            }
-
-                            break;
-                        }
-                    }
+                    std::move(_buffer.end() - sequenceLen, _buffer.end(), _utfPartials.begin());
+                    remainingLength -= sequenceLen;
+                    _partialsLen = sequenceLen;
                 }
 
                 // populate the part of the string that contains complete code points only
@@ -213,6 +208,76 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         }
 
     private:
+        // Method Description:
+        // - Finds the code units at the end of a string that belong to a code point which isn't complete yet.
+        // Arguments:
+        // - str - string_view potentially ending with a partial code point
+        // Return Value:
+        // - the number of code units of the partial code point, or 0 if the string ends with a complete one
+        static size_t _partialLength(const std::basic_string_view<charT> str) noexcept
+        {
+            if (str.empty())
+            {
+                return 0u;
+            }
+
+            if constexpr (std::is_same_v<charT, wchar_t>)
+            {
+                // a high surrogate at the end still waits for its low surrogate
+                return str.back() >= 0xD800u && str.back() <= 0xDBFFu ? 1u : 0u;
+            }
+            else
+            {
+                // If the last byte in the string was a byte belonging to a UTF-8 multi-byte character
+                if ((str.back() & _Utf8BitMasks::MaskAsciiByte) > _Utf8BitMasks::IsAsciiByte)
+                {
+                    // Check only up to 3 last bytes, if no Lead Byte was found then the byte before must be the Lead Byte and no partials are in the string
+                    const size_t stopLen{ std::min(str.length(), gsl::narrow_cast<size_t>(3u)) };
+                    for (size_t sequenceLen{ 1u }; sequenceLen <= stopLen; ++sequenceLen)
+                    {
+                        const auto byte{ str[str.length() - sequenceLen] };
+                        // If Lead Byte found
+                        if ((byte & _Utf8BitMasks::MaskContinuationByte) > _Utf8BitMasks::IsContinuationByte)
+                        {
+                            // If the Lead Byte indicates that the last bytes in the string is a partial UTF-8 code point then cache them:
+                            //  Use the bitmask at index `sequenceLen`. Compare the result with the operand having the same index. If they
+                            //  are not equal then the sequence has to be cached because it is a partial code point. Otherwise the
+                            //  sequence is a complete UTF-8 code point and the whole string is ready for the conversion into a UTF-16 string.
+                            return (byte & _cmpMasks.at(sequenceLen)) != _cmpOperands.at(sequenceLen) ? sequenceLen : 0u;
+                        }
+                    }
+                }
+
+                return 0u;
+            }
+        }
+
+        // Method Description:
+        // - Gets the length of the UTF-8 code point that a lead byte announces.
+        // Arguments:
+        // - lead - the first code unit of the code point
+        // Return Value:
+        // - 2..4 for a lead byte of a multi-byte sequence, 1 for anything else
+        static size_t _sequenceLength(const char lead) noexcept
+        {
+            if ((lead & _Utf8BitMasks::MaskLeadByteTwoByteSequence) == _Utf8BitMasks::IsLeadByteTwoByteSequence)
+            {
+                return 2u;
+            }
+
+            if ((lead & _Utf8BitMasks::MaskLeadByteThreeByteSequence) == _Utf8BitMasks::IsLeadByteThreeByteSequence)
+            {
+                return 3u;
+            }
+
+            if ((lead & _Utf8BitMasks::MaskLeadByteFourByteSequence) == _Utf8BitMasks::IsLeadByteFourByteSequence)
+            {
+                return 4u;
+            }
+
+            return 1u;
+        }
+
         enum _Utf8BitMasks : BYTE
         {
             IsAsciiByte = 0b0'0000000, // Any byte representing an ASCII character has the MSB set to 0
@@ -252,11 +317,58 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     typedef u8u16state<char> u8state;
     typedef u8u16state<wchar_t> u16state;
 
+    namespace details
+    {
+        // Routine Description:
+        // - Copies the leading ASCII code units of a string to another one of a different
+        //   code unit type, stopping at the first code unit that isn't ASCII. ASCII is never
+        //   part of a longer UTF-8 sequence or a surrogate pair, so the rest of the string
+        //   converts exactly the same as it would have as part of the whole string.
+        // Arguments:
+        // - in - the string to copy from
+        // - length - the number of code units in the string
+        // - out - the string to copy to, which must have room for length code units
+        // Return Value:
+        // - the number of code units copied
+        template<class inCharT, class outCharT>
+        size_t copy_ascii_prefix(const inCharT* const in, const size_t length, outCharT* const out) noexcept
+        {
+            // The bits that are only set in code units that aren't ASCII, for a 64-bit word of them.
+            constexpr uint64_t nonAsciiBits{ sizeof(inCharT) == 1 ? 0x8080808080808080u : 0xFF80FF80FF80FF80u };
+            constexpr size_t unitsPerWord{ sizeof(uint64_t) / sizeof(inCharT) };
+            static_assert(sizeof(inCharT) <= 2, "the code units must be UTF-8 or UTF-16");
+
+            size_t i{};
+            for (; i + unitsPerWord <= length; i += unitsPerWord)
+            {
+                uint64_t word;
+                memcpy(&word, in + i, sizeof(word));
+                if ((word & nonAsciiBits) != 0)
+                {
+                    break;
+                }
+
+                for (size_t j{}; j < unitsPerWord; ++j)
+                {
+                    out[i + j] = static_cast<outCharT>(in[i + j]);
+                }
+            }
+
+            // The rest of the string, or the word that wasn't all ASCII.
+            for (; i < length && static_cast<std::make_unsigned_t<inCharT>>(in[i]) < 0x80u; ++i)
+            {
+                out[i] = static_cast<outCharT>(in[i]);
+            }
+
+            return i;
+        }
+    }
+
     // Routine Description:
     // - Takes a UTF-8 string and performs the conversion to UTF-16. NOTE: The function relies on getting complete UTF-8 characters at the string boundaries.
     // Arguments:
     // - in - UTF-8 string to be converted
-    // - out - reference to the resulting UTF-16 string
+    // - out - reference to the resulting UTF-16 string, which is empty if the conversion failed
     // Return Value:
     // - S_OK          - the conversion succeeded
     // - E_OUTOFMEMORY - the function failed to allocate memory for the resulting string
@@ -275,25 +387,44 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 return S_OK;
             }
 
-            int lengthRequired{};
             // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1 if UTF-8 consists of ASCII only.
-            RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthRequired));
             out.resize(in.length()); // avoid to call MultiByteToWideChar twice only to get the required size
-            const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthRequired, out.data(), lengthRequired);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
+            const size_t lengthAscii{ details::copy_ascii_prefix(in.data(), in.length(), out.data()) };
+            if (lengthAscii == in.length())
+            {
+                return S_OK;
+            }
+
+            // Don't leave the ASCII prefix behind if the rest of the string can't be converted.
+            int lengthRequired{};
+            if (!base::MakeCheckedNum(in.length() - lengthAscii).AssignIfValid(&lengthRequired))
+            {
+                out.clear();
+                RETURN_HR(E_ABORT);
+            }
+            const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data() + lengthAscii, lengthRequired, out.data() + lengthAscii, lengthRequired);
+            if (lengthOut == 0)
+            {
+                out.clear();
+                return E_UNEXPECTED;
+            }
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+            out.resize(lengthAscii + gsl::narrow_cast<size_t>(lengthOut));
+            return S_OK;
         }
         catch (std::length_error&)
         {
+            out.clear();
             return E_ABORT;
         }
         catch (std::bad_alloc&)
         {
+            out.clear();
             return E_OUTOFMEMORY;
         }
         catch (...)
         {
+            out.clear();
             return E_UNEXPECTED;
         }
     }
@@ -302,7 +433,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     // - Takes a UTF-8 string, complements and/or caches partials, and performs the conversion to UTF-16.
     // Arguments:
     // - in - UTF-8 string to be converted
-    // - out - reference to the resulting UTF-16 string
+    // - out - reference to the resulting UTF-16 string, which is empty if the conversion failed
     // - state - reference to a til::u8state class holding the status of the current partials handling
     // Return Value:
     // - S_OK          - the conversion succeeded
@@ -314,7 +445,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     u8u16(const inT in, outT& out, u8state& state) noexcept
     {
         std::string_view sv{};
-        RETURN_IF_FAILED(state(std::string_view{ in }, sv));
+        const auto hr = state(std::string_view{ in }, sv);
+        if (FAILED(hr))
+        {
+            out.clear();
+            RETURN_HR(hr);
+        }
         return til::u8u16(sv, out);
     }
 
@@ -322,7 +458,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     // - Takes a UTF-16 string and performs the conversion to UTF-8. NOTE: The function relies on getting complete UTF-16 characters at the string boundaries.
     // Arguments:
     // - in - UTF-16 string to be converted
-    // - out - reference to the resulting UTF-8 string
+    // - out - reference to the resulting UTF-8 string, which is empty if the conversion failed
     // Return Value:
     // - S_OK          - the conversion succeeded
     // - E_OUTOFMEMORY - the function failed to allocate memory for the resulting string
@@ -341,28 +477,49 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 return S_OK;
             }
 
+            // ASCII is converted 1 to 1, so only the rest of the string needs room for more.
+            out.resize(in.length());
+            const size_t lengthAscii{ details::copy_ascii_prefix(in.data(), in.length(), out.data()) };
+            if (lengthAscii == in.length())
+            {
+                return S_OK;
+            }
+
             int lengthIn{};
             int lengthRequired{};
             // Code Point U+0000..U+FFFF: 1 UTF-16 code unit --> 1..3 UTF-8 code units.
             // Code Points >U+FFFF: 2 UTF-16 code units --> 4 UTF-8 code units.
             // Thus, the worst ratio of UTF-16 code units to UTF-8 code units is 1 to 3.
-            RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
-            out.resize(gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
-            const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthIn, out.data(), lengthRequired, nullptr, nullptr);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
+            // Don't leave the ASCII prefix behind if the rest of the string can't be converted.
+            if (!base::MakeCheckedNum(in.length() - lengthAscii).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired))
+            {
+                out.clear();
+                RETURN_HR(E_ABORT);
+            }
+            out.resize(lengthAscii + gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
+            const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data() + lengthAscii, lengthIn, out.data() + lengthAscii, lengthRequired, nullptr, nullptr);
+            if (lengthOut == 0)
+            {
+                out.clear();
+                return E_UNEXPECTED;
+            }
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+            out.resize(lengthAscii + gsl::narrow_cast<size_t>(lengthOut));
+            return S_OK;
         }
         catch (std::length_error&)
         {
+            out.clear();
             return E_ABORT;
         }
         catch (std::bad_alloc&)
         {
+            out.clear();
             return E_OUTOFMEMORY;
         }
         catch (...)
         {
+            out.clear();
             return E_UNEXPECTED;
         }
     }
@@ -371,7 +528,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     // - Takes a UTF-16 string, complements and/or caches partials, and performs the conversion to UTF-8.
     // Arguments:
     // - in - UTF-16 string to be converted
-    // - out - reference to the resulting UTF-8 string
+    // - out - reference to the resulting UTF-8 string, which is empty if the conversion failed
     // - state - reference to a til::u16state class holding the status of the current partials handling
     // Return Value:
     // - S_OK          - the conversion succeeded without any change of the represented code points
@@ -383,7 +540,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
     u16u8(const inT in, outT& out, u16state& state) noexcept
     {
         std::wstring_view sv{};
-        RETURN_IF_FAILED(state(std::wstring_view{ in }, sv));
+        const auto hr = state(std::wstring_view{ in }, sv);
+        if (FAILED(hr))
+        {
+            out.clear();
+            RETURN_HR(hr);
+        }
         return u16u8(sv, out);
     }
 
@@ -452,4 +614,176 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
         THROW_IF_FAILED(u16u8(std::wstring_view{ in }, out, state));
         return out;
     }
+
+    // Routine Description:
+    // - Takes a UTF-8 string and converts as much of it as fits into a buffer provided by the caller, so that the result
+    //   can be written right where it's needed. A partial code point at the end of the string is cached in the state and
+    //   completed by the next call. An empty string converts what is still cached, like the other overloads do.
+    // Arguments:
+    // - in - UTF-8 string to be converted
+    // - out - the buffer the UTF-16 result is written to
+    // - state - reference to a til::u8state class holding the status of the current partials handling
+    // - consumed - on return, the number of code units of in that were converted or cached
+    // - produced - on return, the number of code units written to out
+    // Return Value:
+    // - S_OK                    - the conversion succeeded. If consumed is less than the length of in, out is full and the rest needs another call.
+    // - E_NOT_SUFFICIENT_BUFFER - out doesn't have room for the next code point. Room for 4 UTF-16 code units is always sufficient.
+    // - E_ABORT                 - the string length exceeds the upper boundary of an int and thus, the conversion was aborted
+    // - E_UNEXPECTED            - an unexpected error occurred
+    [[nodiscard]] inline HRESULT u8u16(const std::string_view in, const gsl::span<wchar_t> out, u8state& state, size_t& consumed, size_t& produced) noexcept
+    {
+        consumed = 0u;
+        produced = 0u;
+
+        // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1, so the caller makes sure
+        // that there is room for as many UTF-16 code units as there are UTF-8 code units in the part.
+        const auto convert = [&](const std::string_view part) noexcept -> HRESULT {
+            const size_t lengthAscii{ details::copy_ascii_prefix(part.data(), part.length(), out.data() + produced) };
+            produced += lengthAscii;
+            if (lengthAscii == part.length())
+            {
+                return S_OK;
+            }
+
+            int lengthIn{};
+            RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(part.length() - lengthAscii).AssignIfValid(&lengthIn));
+            const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, part.data() + lengthAscii, lengthIn, out.data() + produced, lengthIn);
+            RETURN_HR_IF(E_UNEXPECTED, lengthOut == 0);
+            produced += gsl::narrow_cast<size_t>(lengthOut);
+            return S_OK;
+        };
+
+        if (state._partialsLen != 0u)
+        {
+            // Complete the cached code point with the continuation bytes it's still missing. If the string
+            // goes on with something else, the partial is converted as it is, which results in U+FFFD.
+            auto sequence{ state._utfPartials };
+            size_t sequenceLen{ state._partialsLen };
+            const size_t expectedLen{ u8state::_sequenceLength(sequence.front()) };
+            size_t taken{};
+            while (sequenceLen < expectedLen && taken < in.length() && (in[taken] & u8state::MaskContinuationByte) == u8state::IsContinuationByte)
+            {
+                til::at(sequence, sequenceLen++) = in[taken++];
+            }
+
+            if (sequenceLen < expectedLen && taken == in.length() && !in.empty())
+            {
+                // the string ended before the code point did
+                std::copy_n(sequence.cbegin(), sequenceLen, state._utfPartials.begin());
+                state._partialsLen = sequenceLen;
+                consumed = in.length();
+                return S_OK;
+            }
+
+            RETURN_HR_IF(E_NOT_SUFFICIENT_BUFFER, out.size() < sequenceLen);
+            state._partialsLen = 0u;
+            RETURN_IF_FAILED(convert({ sequence.data(), sequenceLen }));
+            consumed = taken;
+        }
+
+        const auto rest{ in.substr(consumed) };
+        if (rest.empty())
+        {
+            return S_OK;
+        }
+
+        // Only convert as much as fits. A partial code point at the end of that is cached if the
+        // string ends there, and otherwise it's left for the next call, when there's room again.
+        size_t length{ std::min(rest.length(), out.size() - produced) };
+        const size_t partialLen{ u8state::_partialLength(rest.substr(0u, length)) };
+        length -= partialLen;
+        RETURN_HR_IF(E_NOT_SUFFICIENT_BUFFER, consumed == 0u && produced == 0u && length == 0u && partialLen != rest.length());
+
+        RETURN_IF_FAILED(convert(rest.substr(0u, length)));
+        consumed += length;
+
+        if (partialLen != 0u && length + partialLen == rest.length())
+        {
+            std::copy_n(rest.cend() - partialLen, partialLen, state._utfPartials.begin());
+            state._partialsLen = partialLen;
+            consumed += partialLen;
+        }
+
+        return S_OK;
+    }
+
+    // Routine Description:
+    // - Takes a UTF-16 string and converts as much of it as fits into a buffer provided by the caller, so that the result
+    //   can be written right where it's needed. A high surrogate at the end of the string is cached in the state and
+    //   completed by the next call. An empty string converts what is still cached, like the other overloads do.
+    // Arguments:
+    // - in - UTF-16 string to be converted
+    // - out - the buffer the UTF-8 result is written to
+    // - state - reference to a til::u16state class holding the status of the current partials handling
+    // - consumed - on return, the number of code units of in that were converted or cached
+    // - produced - on return, the number of code units written to out
+    // Return Value:
+    // - S_OK                    - the conversion succeeded. If consumed is less than the length of in, out is full and the rest needs another call.
+    // - E_NOT_SUFFICIENT_BUFFER - out doesn't have room for the next code point. Room for 6 UTF-8 code units is always sufficient.
+    // - E_ABORT                 - the string length exceeds the upper boundary of an int and thus, the conversion was aborted
+    // - E_UNEXPECTED            - an unexpected error occurred
+    [[nodiscard]] inline HRESULT u16u8(const std::wstring_view in, const gsl::span<char> out, u16state& state, size_t& consumed, size_t& produced) noexcept
+    {
+        consumed = 0u;
+        produced = 0u;
+
+        // Code Point U+0000..U+FFFF: 1 UTF-16 code unit --> 1..3 UTF-8 code units.
+        // Code Points >U+FFFF: 2 UTF-16 code units --> 4 UTF-8 code units.
+        // Thus, the caller makes sure that there is room for 3 UTF-8 code units per UTF-16 code unit in the part.
+        const auto convert = [&](const std::wstring_view part) noexcept -> HRESULT {
+            int lengthIn{};
+            int lengthRequired{};
+            RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(part.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
+            const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, part.data(), lengthIn, out.data() + produced, lengthRequired, nullptr, nullptr);
+            RETURN_HR_IF(E_UNEXPECTED, lengthOut == 0);
+            produced += gsl::narrow_cast<size_t>(lengthOut);
+            return S_OK;
+        };
+
+        if (state._partialsLen != 0u)
+        {
+            // The cached high surrogate is completed by a low surrogate at the start of the string.
+            // Anything else, including the end of the output, turns it into U+FFFD.
+            const bool paired{ !in.empty() && in.front() >= 0xDC00u && in.front() <= 0xDFFFu };
+            const std::array<wchar_t, 2> sequence{ state._utfPartials.front(), paired ? in.front() : L'\0' };
+            RETURN_HR_IF(E_NOT_SUFFICIENT_BUFFER, out.size() < 6u);
+            state._partialsLen = 0u;
+            RETURN_IF_FAILED(convert({ sequence.data(), paired ? 2u : 1u }));
+            consumed = paired ? 1u : 0u;
+        }
+
+        const auto rest{ in.substr(consumed) };
+        if (rest.empty())
+        {
+            return S_OK;
+        }
+
+        // ASCII is converted 1 to 1, so it's only limited by the room that is left.
+        const size_t lengthAscii{ details::copy_ascii_prefix(rest.data(), std::min(rest.length(), out.size() - produced), out.data() + produced) };
+        consumed += lengthAscii;
+        produced += lengthAscii;
+
+        // Only convert as much of the rest as is sure to fit. A high surrogate at the end of that is cached
+        // if the string ends there, and otherwise it's left for the next call, when there's room again.
+        const auto remaining{ rest.substr(lengthAscii) };
+        size_t length{ std::min(remaining.length(), (out.size() - produced) / 3u) };
+        const size_t partialLen{ u16state::_partialLength(remaining.substr(0u, length)) };
+        length -= partialLen;
+        RETURN_HR_IF(E_NOT_SUFFICIENT_BUFFER, consumed == 0u && produced == 0u && length == 0u && partialLen != remaining.length());
+
+        if (length != 0u)
+        {
+            RETURN_IF_FAILED(convert(remaining.substr(0u, length)));
+            consumed += length;
+        }
+
+        if (partialLen != 0u && length + partialLen == remaining.length())
+        {
+            state._utfPartials.front() = remaining.back();
+            state._partialsLen = 1u;
+            ++consumed;
+        }
+
+        return S_OK;
+    }
 }
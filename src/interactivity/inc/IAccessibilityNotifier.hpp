@@ -38,6 +38,10 @@ namespace Microsoft::Console::Interactivity
         virtual void NotifyConsoleStartApplicationEvent(_In_ DWORD processId) = 0;
         virtual void NotifyConsoleEndApplicationEvent(_In_ DWORD processId) = 0;
 
+        // Returns false when no accessibility client could possibly observe an
+        // update event, so that callers can skip gathering the data for one.
+        virtual bool HasListeners() = 0;
+
     protected:
         IAccessibilityNotifier() {}
 
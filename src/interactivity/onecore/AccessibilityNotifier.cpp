@@ -38,3 +38,8 @@ void AccessibilityNotifier::NotifyConsoleStartApplicationEvent(_In_ DWORD /*proc
 void AccessibilityNotifier::NotifyConsoleEndApplicationEvent(_In_ DWORD /*processId*/)
 {
 }
+
+bool AccessibilityNotifier::HasListeners()
+{
+    return false;
+}
@@ -31,5 +31,6 @@ namespace Microsoft::Console::Interactivity::OneCore
         void NotifyConsoleLayoutEvent();
         void NotifyConsoleStartApplicationEvent(_In_ DWORD processId);
         void NotifyConsoleEndApplicationEvent(_In_ DWORD processId);
+        bool HasListeners();
     };
 }
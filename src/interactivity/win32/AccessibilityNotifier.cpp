@@ -133,3 +133,18 @@ void AccessibilityNotifier::NotifyConsoleEndApplicationEvent(_In_ DWORD processI
                        0);
     }
 }
+
+// Routine Description:
+// - Checks whether anyone could observe a console update event. Both
+//   IsWinEventHookInstalled and UiaClientsAreListening are documented as cheap
+//   checks intended for exactly this purpose.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if a WinEvent hook for console updates or a UIA client is present.
+bool AccessibilityNotifier::HasListeners()
+{
+    return IsWinEventHookInstalled(EVENT_CONSOLE_UPDATE_REGION) ||
+           IsWinEventHookInstalled(EVENT_CONSOLE_UPDATE_SIMPLE) ||
+           UiaClientsAreListening();
+}
@@ -35,5 +35,6 @@ namespace Microsoft::Console::Interactivity::Win32
         void NotifyConsoleLayoutEvent();
         void NotifyConsoleStartApplicationEvent(_In_ DWORD processId);
         void NotifyConsoleEndApplicationEvent(_In_ DWORD processId);
+        bool HasListeners();
     };
 }
@@ -107,8 +107,10 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
-        gci.pInputBuffer->Write(inEvents);
+        // The input buffer keeps the text as it is, and only turns it into
+        // key events if a client reads input records.
+        const auto text = FilterTextOnPaste(pData, cchData);
+        gci.pInputBuffer->WriteText(text);
     }
     catch (...)
     {
@@ -133,10 +135,41 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                     const size_t cchData)
 {
-    THROW_HR_IF_NULL(E_INVALIDARG, pData);
+    const auto text = FilterTextOnPaste(pData, cchData);
 
     std::deque<std::unique_ptr<IInputEvent>> keyEvents;
 
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+    for (const auto wch : text)
+    {
+        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(wch, codepage);
+        while (!convertedEvents.empty())
+        {
+            keyEvents.push_back(std::move(convertedEvents.front()));
+            convertedEvents.pop_front();
+        }
+    }
+    return keyEvents;
+}
+
+// Routine Description:
+// - Prepares text for being pasted as input: drops the characters that
+// shouldn't be pasted and normalizes line endings.
+// Arguments:
+// - pData - the text to filter
+// - cchData - the size of pData, in wchars
+// Return Value:
+// - the text to write to the input buffer
+// Note:
+// - will throw exception on error
+std::wstring Clipboard::FilterTextOnPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                          const size_t cchData)
+{
+    THROW_HR_IF_NULL(E_INVALIDARG, pData);
+
+    std::wstring text;
+    text.reserve(cchData);
+
     for (size_t i = 0; i < cchData; ++i)
     {
         wchar_t currentChar = pData[i];
@@ -173,15 +206,9 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
             currentChar = UNICODE_CARRIAGERETURN;
         }
 
-        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
-        while (!convertedEvents.empty())
-        {
-            keyEvents.push_back(std::move(convertedEvents.front()));
-            convertedEvents.pop_front();
-        }
+        text.push_back(currentChar);
     }
-    return keyEvents;
+    return text;
 }
 
 // Routine Description:
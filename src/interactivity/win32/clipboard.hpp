@@ -37,6 +37,8 @@ namespace Microsoft::Console::Interactivity::Win32
     private:
         std::deque<std::unique_ptr<IInputEvent>> TextToKeyEvents(_In_reads_(cchData) const wchar_t* const pData,
                                                                  const size_t cchData);
+        std::wstring FilterTextOnPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                       const size_t cchData);
 
         void StoreSelectionToClipboard(_In_ bool const fAlsoCopyFormatting);
 
@@ -1079,4 +1079,140 @@ class UiaTextRangeTests
             VERIFY_ARE_EQUAL(test.expected.end, utr->_end);
         }
     }
+
+    TEST_METHOD(CanMoveEndpointByUnitWordAtEndOfDocument)
+    {
+        const SHORT bottomRow = gsl::narrow<SHORT>(_pTextBuffer->TotalRowCount() - 1);
+
+        // write "hello world" into the last row of the document
+        const std::wstring_view text{ L"hello world" };
+        auto& charRow = _pTextBuffer->GetRowByOffset(bottomRow).GetCharRow();
+        for (size_t col = 0; col < text.size(); ++col)
+        {
+            charRow.GlyphAt(col) = std::wstring_view{ &text.at(col), 1 };
+        }
+
+        // clang-format off
+        const std::vector<MoveEndpointTest> testData =
+        {
+            MoveEndpointTest{
+                L"moving _end forward past the last word stops at the end of the document",
+                {0, bottomRow},
+                {6, bottomRow},
+                2,
+                TextPatternRangeEndpoint_End,
+                {
+                    1,
+                    {0, bottomRow},
+                    {0, bottomRow+1}
+                }
+            },
+
+            MoveEndpointTest{
+                L"can't move _end forward by word when it's already at the end of the document",
+                {0, bottomRow},
+                {0, bottomRow+1},
+                1,
+                TextPatternRangeEndpoint_End,
+                {
+                    0,
+                    {0, bottomRow},
+                    {0, bottomRow+1}
+                }
+            },
+
+            MoveEndpointTest{
+                L"moving _start forward past the last word creates degenerate range at end of document",
+                {0, bottomRow},
+                {0, bottomRow},
+                3,
+                TextPatternRangeEndpoint_Start,
+                {
+                    2,
+                    {0, bottomRow+1},
+                    {0, bottomRow+1}
+                }
+            }
+        };
+        // clang-format on
+
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        for (auto test : testData)
+        {
+            Log::Comment(test.comment.c_str());
+            int amountMoved;
+
+            THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, test.start, test.end));
+            THROW_IF_FAILED(utr->MoveEndpointByUnit(test.endpoint, TextUnit::TextUnit_Word, test.moveAmt, &amountMoved));
+
+            VERIFY_ARE_EQUAL(test.expected.moveAmt, amountMoved);
+            VERIFY_ARE_EQUAL(test.expected.start, utr->_start);
+            VERIFY_ARE_EQUAL(test.expected.end, utr->_end);
+        }
+    }
+
+    TEST_METHOD(MoveAcrossLargeBufferPerformance)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        // Swap in a 10k line buffer, filled with 16 words per row.
+        constexpr SHORT bufferWidth = 80;
+        constexpr SHORT bufferHeight = 10000;
+        _state->CleanupNewTextBufferInfo();
+        _state->PrepareNewTextBufferInfo(true, bufferWidth, bufferHeight);
+        _pTextBuffer = &_pScreenInfo->GetTextBuffer();
+
+        const std::wstring_view pattern{ L"word " };
+        for (UINT i = 0; i < _pTextBuffer->TotalRowCount(); ++i)
+        {
+            auto& charRow = _pTextBuffer->GetRowByOffset(i).GetCharRow();
+            size_t col = 0;
+            for (auto& cell : charRow)
+            {
+                cell.Char() = pattern.at(col++ % pattern.size());
+            }
+        }
+
+        const COORD origin{ 0, 0 };
+        const COORD lastCell{ bufferWidth - 1, bufferHeight - 1 };
+        Microsoft::WRL::ComPtr<UiaTextRange> utr;
+        int amountMoved;
+
+        Log::Comment(L"Move by character from the start to the end of the buffer.");
+        THROW_IF_FAILED(Microsoft::WRL::MakeAndInitialize<UiaTextRange>(&utr, _pUiaData, &_dummyProvider, origin, origin));
+        auto now = std::chrono::steady_clock::now();
+        THROW_IF_FAILED(utr->Move(TextUnit::TextUnit_Character, bufferWidth * bufferHeight, &amountMoved));
+        auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+        Log::Comment(NoThrowString().Format(L"Moved %d characters in %lld ms", amountMoved, delta));
+        VERIFY_ARE_EQUAL(bufferWidth * bufferHeight - 1, amountMoved);
+        VERIFY_ARE_EQUAL(lastCell, utr->_start);
+
+        Log::Comment(L"Move by character back to the start of the buffer.");
+        now = std::chrono::steady_clock::now();
+        THROW_IF_FAILED(utr->Move(TextUnit::TextUnit_Character, -bufferWidth * bufferHeight, &amountMoved));
+        delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+        Log::Comment(NoThrowString().Format(L"Moved %d characters in %lld ms", amountMoved, delta));
+        VERIFY_ARE_EQUAL(-(bufferWidth * bufferHeight - 1), amountMoved);
+        VERIFY_ARE_EQUAL(origin, utr->_start);
+
+        Log::Comment(L"Move by word from the start to the end of the buffer.");
+        now = std::chrono::steady_clock::now();
+        THROW_IF_FAILED(utr->Move(TextUnit::TextUnit_Word, bufferWidth * bufferHeight, &amountMoved));
+        delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+        Log::Comment(NoThrowString().Format(L"Moved %d words in %lld ms", amountMoved, delta));
+        VERIFY_ARE_EQUAL(16 * bufferHeight - 1, amountMoved);
+
+        Log::Comment(L"Get the text of the entire buffer.");
+        THROW_IF_FAILED(utr->ExpandToEnclosingUnit(TextUnit::TextUnit_Document));
+        now = std::chrono::steady_clock::now();
+        wil::unique_bstr text;
+        THROW_IF_FAILED(utr->GetText(-1, &text));
+        delta = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - now).count();
+        Log::Comment(NoThrowString().Format(L"Retrieved %u characters in %lld ms", SysStringLen(text.get()), delta));
+
+        // every row but the last one is followed by a CRLF
+        VERIFY_ARE_EQUAL(static_cast<UINT>(bufferWidth * bufferHeight + 2 * (bufferHeight - 1)), SysStringLen(text.get()));
+    }
 };
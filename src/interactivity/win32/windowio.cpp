@@ -893,12 +893,11 @@ BOOL HandleMouseEvent(const SCREEN_INFORMATION& ScreenInfo,
     ULONG EventsWritten = 0;
     try
     {
-        std::unique_ptr<MouseEvent> mouseEvent = std::make_unique<MouseEvent>(
-            MousePosition,
-            ConvertMouseButtonState(ButtonFlags, static_cast<UINT>(wParam)),
-            GetControlKeyState(0),
-            EventFlags);
-        EventsWritten = static_cast<ULONG>(gci.pInputBuffer->Write(std::move(mouseEvent)));
+        const MouseEvent mouseEvent{ MousePosition,
+                                     ConvertMouseButtonState(ButtonFlags, static_cast<UINT>(wParam)),
+                                     GetControlKeyState(0),
+                                     EventFlags };
+        EventsWritten = static_cast<ULONG>(gci.pInputBuffer->Write(mouseEvent.ToInputRecord()));
     }
     catch (...)
     {
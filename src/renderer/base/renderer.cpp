@@ -65,6 +65,7 @@ Renderer::~Renderer()
         return S_FALSE;
     }
 
+    bool presented = false;
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
         auto tries = maxRetriesForRenderEngine;
@@ -97,13 +98,28 @@ Renderer::~Renderer()
                 continue;
             }
             LOG_IF_FAILED(hr);
+            presented |= hr == S_OK;
             break;
         }
     }
 
+    // Engines that don't put anything on screen (like the UIA engine) don't
+    // count, and a frame shown by more than one engine is still one frame.
+    if (presented && _pfnFramePresented)
+    {
+        _pfnFramePresented();
+    }
+
     return S_OK;
 }
 
+// Routine Description:
+// - Paints a frame with the given engine and presents it.
+// Arguments:
+// - pEngine - the engine to paint with.
+// Return Value:
+// - S_OK if the engine presented a frame, S_FALSE if there was nothing to
+//   paint or present, or a relevant error code.
 [[nodiscard]] HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
 try
 {
@@ -126,7 +142,7 @@ try
     //      engine won't know that.
     if (S_FALSE == hr)
     {
-        return S_OK;
+        return S_FALSE;
     }
 
     auto endPaint = wil::scope_exit([&]() {
@@ -148,16 +164,19 @@ try
     // 2. Paint Rows of Text
     _PaintBufferOutput(pEngine);
 
-    // 3. Paint overlays that reside above the text buffer
+    // 3. Underline any detected patterns (URLs, file paths) that should be highlighted
+    _PaintPatternOverlays(pEngine);
+
+    // 4. Paint overlays that reside above the text buffer
     _PaintOverlays(pEngine);
 
-    // 4. Paint Selection
+    // 5. Paint Selection
     _PaintSelection(pEngine);
 
-    // 5. Paint Cursor
+    // 6. Paint Cursor
     _PaintCursor(pEngine);
 
-    // 6. Paint window title
+    // 7. Paint window title
     RETURN_IF_FAILED(_PaintTitle(pEngine));
 
     // Force scope exit end paint to finish up collecting information and possibly painting
@@ -167,10 +186,11 @@ try
     unlock.reset();
 
     // Trigger out-of-lock presentation for renderers that can support it
-    RETURN_IF_FAILED(pEngine->Present());
+    const auto presentHr = pEngine->Present();
+    RETURN_IF_FAILED(presentHr);
 
     // As we leave the scope, EndPaint will be called (declared above)
-    return S_OK;
+    return presentHr;
 }
 CATCH_RETURN()
 
@@ -318,7 +338,7 @@ void Renderer::TriggerSelection()
     try
     {
         // Get selection rectangles
-        const auto rects = _GetSelectionRects();
+        auto rects = _GetSelectionRects();
 
         // Restrict all previous selection rectangles to inside the current viewport bounds
         for (auto& sr : _previousSelection)
@@ -336,12 +356,17 @@ void Renderer::TriggerSelection()
             sr = Viewport::FromInclusive(rc).ToExclusive();
         }
 
-        std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
-            LOG_IF_FAILED(pEngine->InvalidateSelection(_previousSelection));
-            LOG_IF_FAILED(pEngine->InvalidateSelection(rects));
-        });
+        // Only the rows whose selected span actually changed need to be redrawn.
+        // While dragging, that's usually just the row(s) the endpoint moved across.
+        const auto dirty = _GetChangedSelectionRects(_previousSelection, rects);
+        if (!dirty.empty())
+        {
+            std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+                LOG_IF_FAILED(pEngine->InvalidateSelection(dirty));
+            });
+        }
 
-        _previousSelection = rects;
+        _previousSelection = std::move(rects);
 
         _NotifyPaintFrame();
     }
@@ -1045,6 +1070,60 @@ void Renderer::_PaintOverlays(_In_ IRenderEngine* const pEngine)
     CATCH_LOG();
 }
 
+// Routine Description:
+// - Paint helper to underline the detected patterns (URLs, file paths) that the
+//   data source wants highlighted, typically the one under the mouse pointer.
+// - The underline is drawn in the foreground color of the pattern's first cell.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_PaintPatternOverlays(_In_ IRenderEngine* const pEngine)
+{
+    try
+    {
+        const auto patterns = _pData->GetPatternOverlays();
+        if (patterns.empty())
+        {
+            return;
+        }
+
+        const auto view = _pData->GetViewport();
+        const auto& buffer = _pData->GetTextBuffer();
+        const auto dirtyAreas = pEngine->GetDirtyArea();
+
+        for (const auto& pattern : patterns)
+        {
+            // Patterns are in buffer coordinates. Clip them to what's visible and
+            // move them to the screen, where the dirty areas live.
+            auto rect = pattern;
+            if (!view.TrimToViewport(&rect))
+            {
+                continue;
+            }
+            view.ConvertToOrigin(&rect);
+
+            const auto attr = buffer.GetCellDataAt({ pattern.Left, pattern.Top })->TextAttr();
+            const auto color = _pData->GetAttributeColors(attr).first;
+
+            for (const auto& dirtyRect : dirtyAreas)
+            {
+                auto rectCopy = rect;
+                const auto dirtyView = Viewport::FromInclusive(dirtyRect);
+                if (dirtyView.TrimToViewport(&rectCopy))
+                {
+                    for (auto row = rectCopy.Top; row <= rectCopy.Bottom; ++row)
+                    {
+                        const auto cchLine = gsl::narrow_cast<size_t>(rectCopy.Right - rectCopy.Left + 1);
+                        LOG_IF_FAILED(pEngine->PaintBufferGridLines(IRenderEngine::GridLines::Bottom, color, cchLine, { rectCopy.Left, row }));
+                    }
+                }
+            }
+        }
+    }
+    CATCH_LOG();
+}
+
 // Routine Description:
 // - Paint helper to draw the selected area of the window.
 // Arguments:
@@ -1134,6 +1213,42 @@ std::vector<SMALL_RECT> Renderer::_GetSelectionRects() const
     return result;
 }
 
+// Routine Description:
+// - Helper to determine which parts of the selection changed between two frames.
+// - Selection rectangles are produced line by line, so any rectangle present in
+//   both lists describes a row whose selection state did not change. Only the
+//   rectangles that appear in exactly one of the lists need to be invalidated.
+// Arguments:
+// - previous - The selection rectangles that were invalidated last time
+// - current - The selection rectangles we're about to invalidate
+// Return Value:
+// - The rectangles that appear in only one of the two lists.
+std::vector<SMALL_RECT> Renderer::_GetChangedSelectionRects(std::vector<SMALL_RECT> previous,
+                                                            std::vector<SMALL_RECT> current)
+{
+    const auto lessThan = [](const SMALL_RECT& a, const SMALL_RECT& b) noexcept {
+        return std::tie(a.Top, a.Left, a.Bottom, a.Right) < std::tie(b.Top, b.Left, b.Bottom, b.Right);
+    };
+
+    // Rectangles generally arrive sorted top to bottom already,
+    // in which case this is just a linear check.
+    if (!std::is_sorted(previous.begin(), previous.end(), lessThan))
+    {
+        std::sort(previous.begin(), previous.end(), lessThan);
+    }
+    if (!std::is_sorted(current.begin(), current.end(), lessThan))
+    {
+        std::sort(current.begin(), current.end(), lessThan);
+    }
+
+    std::vector<SMALL_RECT> result;
+    std::set_symmetric_difference(previous.begin(), previous.end(),
+                                  current.begin(), current.end(),
+                                  std::back_inserter(result),
+                                  lessThan);
+    return result;
+}
+
 // Method Description:
 // - Offsets all of the selection rectangles we might be holding onto
 //   as the previously selected area. If the whole viewport scrolls,
@@ -1188,6 +1303,19 @@ void Renderer::SetRendererEnteredErrorStateCallback(std::function<void()> pfn)
     _pfnRendererEnteredErrorState = std::move(pfn);
 }
 
+// Method Description:
+// - Registers a callback that will be called once after each frame that at
+//   least one engine actually presented. It's called on the render thread,
+//   after the console lock was released.
+// Arguments:
+// - pfn: the callback
+// Return Value:
+// - <none>
+void Renderer::SetFramePresentedCallback(std::function<void()> pfn)
+{
+    _pfnFramePresented = std::move(pfn);
+}
+
 // Method Description:
 // - Attempts to restart the renderer.
 void Renderer::ResetErrorStateAndResume()
@@ -78,6 +78,7 @@ namespace Microsoft::Console::Render
         void AddRenderEngine(_In_ IRenderEngine* const pEngine) override;
 
         void SetRendererEnteredErrorStateCallback(std::function<void()> pfn);
+        void SetFramePresentedCallback(std::function<void()> pfn);
         void ResetErrorStateAndResume();
 
     private:
@@ -115,6 +116,7 @@ namespace Microsoft::Console::Render
 
         void _PaintOverlays(_In_ IRenderEngine* const pEngine);
         void _PaintOverlay(IRenderEngine& engine, const RenderOverlay& overlay);
+        void _PaintPatternOverlays(_In_ IRenderEngine* const pEngine);
 
         [[nodiscard]] HRESULT _UpdateDrawingBrushes(_In_ IRenderEngine* const pEngine, const TextAttribute attr, const bool isSettingDefaultBrushes);
 
@@ -126,6 +128,8 @@ namespace Microsoft::Console::Render
         std::vector<Cluster> _clusterBuffer;
 
         std::vector<SMALL_RECT> _GetSelectionRects() const;
+        static std::vector<SMALL_RECT> _GetChangedSelectionRects(std::vector<SMALL_RECT> previous,
+                                                                 std::vector<SMALL_RECT> current);
         void _ScrollPreviousSelection(const til::point delta);
         std::vector<SMALL_RECT> _previousSelection;
 
@@ -139,6 +143,7 @@ namespace Microsoft::Console::Render
         bool _fDebug = false;
 
         std::function<void()> _pfnRendererEnteredErrorState;
+        std::function<void()> _pfnFramePresented;
 
 #ifdef UNIT_TESTING
         friend class ConptyOutputTests;
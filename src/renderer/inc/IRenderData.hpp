@@ -63,6 +63,10 @@ namespace Microsoft::Console::Render
 
         virtual const std::vector<RenderOverlay> GetOverlays() const noexcept = 0;
 
+        // Regions of the buffer (URLs, file paths, ...) that should be underlined,
+        // such as the detected pattern under the mouse pointer.
+        virtual const std::vector<SMALL_RECT> GetPatternOverlays() const noexcept = 0;
+
         virtual const bool IsGridLineDrawingAllowed() noexcept = 0;
         virtual const std::wstring GetConsoleTitle() const noexcept = 0;
 
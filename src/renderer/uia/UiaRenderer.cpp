@@ -21,8 +21,27 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     _cursorChanged{ false },
     _isEnabled{ true },
     _prevSelection{},
+    _lastTextChanged{},
+    _mergedEvents{ 0 },
+    _deferredEvents{ 0 },
+    _droppedEvents{ 0 },
+    _textChangedPending{ false },
     RenderEngineBase()
 {
+    // A TextChanged event that is held back by the rate limit is raised by this
+    // timer once the interval is over, even if no other frame is painted by then.
+    _textChangedTimer.reset(CreateThreadpoolTimer(
+        [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID context, PTP_TIMER /*timer*/) noexcept {
+            UiaEngine* const pInstance = static_cast<UiaEngine*>(context);
+            if (pInstance)
+            {
+                pInstance->_FlushTextChanged();
+            }
+        },
+        this,
+        nullptr));
+
+    THROW_LAST_ERROR_IF_NULL(_textChangedTimer);
 }
 
 // Routine Description:
@@ -46,9 +65,63 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
 [[nodiscard]] HRESULT UiaEngine::Disable() noexcept
 {
     _isEnabled = false;
+
+    const auto lock = _textChangedLock.lock_exclusive();
+    if (_textChangedPending)
+    {
+        _textChangedPending = false;
+        ++_droppedEvents;
+    }
     return S_OK;
 }
 
+// Routine Description:
+// - Gets the number of text buffer changes that were folded into a
+//   TextChanged event that was already pending.
+size_t UiaEngine::GetMergedEventCount() const noexcept
+{
+    return _mergedEvents;
+}
+
+// Routine Description:
+// - Gets the number of frames in which a pending TextChanged event was held
+//   back because one was raised too recently.
+size_t UiaEngine::GetDeferredEventCount() const noexcept
+{
+    return _deferredEvents;
+}
+
+// Routine Description:
+// - Gets the number of text buffer changes that were discarded because this
+//   engine was disabled.
+size_t UiaEngine::GetDroppedEventCount() const noexcept
+{
+    return _droppedEvents;
+}
+
+// Routine Description:
+// - Records that the text buffer changed, keeping count of how many changes
+//   are coalesced into a single TextChanged event.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void UiaEngine::_MarkTextBufferChanged() noexcept
+{
+    if (!_isEnabled)
+    {
+        // Nobody will hear about it, so don't queue anything up.
+        ++_droppedEvents;
+        return;
+    }
+
+    if (_textBufferChanged)
+    {
+        ++_mergedEvents;
+    }
+    _textBufferChanged = true;
+}
+
 // Routine Description:
 // - Notifies us that the console has changed the character region specified.
 // - NOTE: This typically triggers on cursor or text buffer changes
@@ -58,7 +131,7 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
 // - S_OK, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT UiaEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
 {
-    _textBufferChanged = true;
+    _MarkTextBufferChanged();
     return S_OK;
 }
 
@@ -163,7 +236,7 @@ CATCH_RETURN();
 // - S_OK, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT UiaEngine::InvalidateAll() noexcept
 {
-    _textBufferChanged = true;
+    _MarkTextBufferChanged();
     return S_OK;
 }
 
@@ -217,6 +290,9 @@ CATCH_RETURN();
 
 // Routine Description:
 // - Ends batch drawing and notifies automation clients of updated regions
+// - TextChanged is rate limited to MaxTextChangedEventsPerSecond. When it is
+//   held back, it stays pending and is raised by _textChangedTimer once the
+//   interval is over.
 // Arguments:
 // - <none>
 // Return Value:
@@ -237,11 +313,29 @@ CATCH_RETURN();
     }
     if (_textBufferChanged)
     {
-        try
+        constexpr auto minInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds{ 1 }) / MaxTextChangedEventsPerSecond;
+        const auto now = std::chrono::steady_clock::now();
+
+        const auto lock = _textChangedLock.lock_exclusive();
+        if (_lastTextChanged.has_value() && now - _lastTextChanged.value() < minInterval)
         {
-            _dispatcher->SignalTextChanged();
+            if (!_textChangedPending)
+            {
+                _textChangedPending = true;
+                _ScheduleTextChangedFlush(minInterval - (now - _lastTextChanged.value()));
+            }
+            ++_deferredEvents;
+        }
+        else
+        {
+            _textChangedPending = false;
+            _lastTextChanged = now;
+            try
+            {
+                _dispatcher->SignalTextChanged();
+            }
+            CATCH_LOG();
         }
-        CATCH_LOG();
     }
     if (_cursorChanged)
     {
@@ -260,6 +354,48 @@ CATCH_RETURN();
     return S_OK;
 }
 
+// Routine Description:
+// - Arms _textChangedTimer to raise the pending TextChanged event after the given delay.
+// - NOTE: Must be called with _textChangedLock held.
+// Arguments:
+// - delay - the time left until the rate limit allows the next TextChanged event
+// Return Value:
+// - <none>
+void UiaEngine::_ScheduleTextChangedFlush(const std::chrono::steady_clock::duration delay) noexcept
+{
+    // A negative due time is relative to now, in 100ns units.
+    ULARGE_INTEGER dueTime;
+    dueTime.QuadPart = static_cast<ULONGLONG>(-std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10000000>>>(delay).count());
+    FILETIME fileTime;
+    fileTime.dwLowDateTime = dueTime.LowPart;
+    fileTime.dwHighDateTime = dueTime.HighPart;
+    SetThreadpoolTimer(_textChangedTimer.get(), &fileTime, 0, 0);
+}
+
+// Routine Description:
+// - Raises the TextChanged event that EndPaint held back, unless a later frame already did.
+// - Runs on the threadpool, from _textChangedTimer.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void UiaEngine::_FlushTextChanged() noexcept
+{
+    const auto lock = _textChangedLock.lock_exclusive();
+    if (!_textChangedPending)
+    {
+        return;
+    }
+
+    _textChangedPending = false;
+    _lastTextChanged = std::chrono::steady_clock::now();
+    try
+    {
+        _dispatcher->SignalTextChanged();
+    }
+    CATCH_LOG();
+}
+
 // Routine Description:
 // - Used to perform longer running presentation steps outside the lock so the
 //      other threads can continue.
@@ -33,6 +33,14 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Enable() noexcept;
         [[nodiscard]] HRESULT Disable() noexcept;
 
+        // TextChanged is raised at most this many times per second. Changes
+        // that arrive sooner are folded into one event raised once the interval is over.
+        static constexpr size_t MaxTextChangedEventsPerSecond = 20;
+
+        size_t GetMergedEventCount() const noexcept;
+        size_t GetDeferredEventCount() const noexcept;
+        size_t GetDroppedEventCount() const noexcept;
+
         // IRenderEngine Members
         [[nodiscard]] HRESULT StartPaint() noexcept override;
         [[nodiscard]] HRESULT EndPaint() noexcept override;
@@ -87,5 +95,19 @@ namespace Microsoft::Console::Render
 
         std::vector<SMALL_RECT> _prevSelection;
         til::point _prevCursorPos;
+
+        std::optional<std::chrono::steady_clock::time_point> _lastTextChanged;
+        size_t _mergedEvents;
+        size_t _deferredEvents;
+        size_t _droppedEvents;
+
+        // guards the TextChanged rate limit, which the timer callback shares with EndPaint
+        wil::srwlock _textChangedLock;
+        bool _textChangedPending;
+        wil::unique_threadpool_timer _textChangedTimer;
+
+        void _MarkTextBufferChanged() noexcept;
+        void _ScheduleTextChangedFlush(const std::chrono::steady_clock::duration delay) noexcept;
+        void _FlushTextChanged() noexcept;
     };
 }
@@ -99,6 +99,7 @@ namespace Microsoft::Console::VirtualTerminal::DispatchTypes
         SGR_EXTENDED_MODE = 1006,
         ALTERNATE_SCROLL = 1007,
         ASB_AlternateScreenBuffer = 1049,
+        XTERM_BracketedPasteMode = 2004,
         W32IM_Win32InputMode = 9001
     };
 
@@ -145,6 +146,32 @@ namespace Microsoft::Console::VirtualTerminal::DispatchTypes
         DependsOnMode
     };
 
+    enum class BatchedCommandType : unsigned int
+    {
+        CursorUp,
+        CursorDown,
+        CursorForward,
+        CursorBackward,
+        CursorHorizontalPositionAbsolute,
+        VerticalLinePositionAbsolute,
+        CursorPosition,
+        SetGraphicsRendition,
+        PrintString
+    };
+
+    // One of the simple operations that the output engine can collect into a
+    // batch, instead of dispatching it right away. The options and the text
+    // aren't owned by the command, and are only valid while the batch is
+    // being dispatched.
+    struct BatchedCommand
+    {
+        BatchedCommandType type;
+        size_t distance; // the distance, line or column to move to. Only used by the cursor movements.
+        size_t column; // only used by CursorPosition.
+        gsl::span<const GraphicsOptions> options; // only used by SetGraphicsRendition.
+        std::wstring_view text; // only used by PrintString.
+    };
+
     constexpr short s_sDECCOLMSetColumns = 132;
     constexpr short s_sDECCOLMResetColumns = 80;
 
@@ -28,7 +28,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual ~IInteractDispatch() = default;
 #pragma warning(pop)
 
-        virtual bool WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inputEvents) = 0;
+        virtual bool WriteInput(const gsl::span<const INPUT_RECORD> inputRecords) = 0;
 
         virtual bool WriteCtrlKey(const KeyEvent& event) = 0;
 
@@ -78,6 +78,7 @@ public:
     virtual bool EnableButtonEventMouseMode(const bool enabled) = 0; // ?1002
     virtual bool EnableAnyEventMouseMode(const bool enabled) = 0; // ?1003
     virtual bool EnableAlternateScroll(const bool enabled) = 0; // ?1007
+    virtual bool EnableXtermBracketedPasteMode(const bool enabled) = 0; // ?2004
     virtual bool SetColorTableEntry(const size_t tableIndex, const DWORD color) = 0; // OSCColorTable
     virtual bool SetDefaultForeground(const DWORD color) = 0; // OSCDefaultForeground
     virtual bool SetDefaultBackground(const DWORD color) = 0; // OSCDefaultBackground
@@ -117,6 +118,62 @@ public:
     // DTTERM_WindowManipulation
     virtual bool WindowManipulation(const DispatchTypes::WindowManipulationType function,
                                     const gsl::span<const size_t> parameters) = 0;
+
+    // A run of cursor movements, renditions and text collected by the engine.
+    virtual bool DispatchBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands) = 0;
+
+protected:
+    bool _ReplayBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands);
 };
 inline Microsoft::Console::VirtualTerminal::ITermDispatch::~ITermDispatch() {}
+
+// Routine Description:
+// - Dispatches each command of a batch through the matching method, in order.
+//   This is how a batch is dispatched by default, and dispatchers that want to
+//   do something once per batch can wrap this.
+// Arguments:
+// - commands - the commands to dispatch.
+// Return Value:
+// - True if every command was handled successfully. False otherwise.
+inline bool Microsoft::Console::VirtualTerminal::ITermDispatch::_ReplayBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands)
+{
+    bool success = true;
+    for (const auto& command : commands)
+    {
+        switch (command.type)
+        {
+        case DispatchTypes::BatchedCommandType::CursorUp:
+            success = CursorUp(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::CursorDown:
+            success = CursorDown(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::CursorForward:
+            success = CursorForward(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::CursorBackward:
+            success = CursorBackward(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::CursorHorizontalPositionAbsolute:
+            success = CursorHorizontalPositionAbsolute(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::VerticalLinePositionAbsolute:
+            success = VerticalLinePositionAbsolute(command.distance) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::CursorPosition:
+            success = CursorPosition(command.distance, command.column) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::SetGraphicsRendition:
+            success = SetGraphicsRendition(command.options) && success;
+            break;
+        case DispatchTypes::BatchedCommandType::PrintString:
+            PrintString(command.text);
+            break;
+        default:
+            success = false;
+            break;
+        }
+    }
+    return success;
+}
 #pragma warning(pop)
@@ -15,7 +15,11 @@ using namespace Microsoft::Console::VirtualTerminal;
 
 // takes ownership of pConApi
 InteractDispatch::InteractDispatch(std::unique_ptr<ConGetSet> pConApi) :
-    _pConApi(std::move(pConApi))
+    _pConApi(std::move(pConApi)),
+    _batchingInput{ false },
+    _batchedInput{},
+    _batchedInputLeadsAlone{ false },
+    _batchedEventsWritten{ 0 }
 {
     THROW_HR_IF_NULL(E_INVALIDARG, _pConApi.get());
 }
@@ -26,14 +30,40 @@ InteractDispatch::InteractDispatch(std::unique_ptr<ConGetSet> pConApi) :
 //  If Ctrl+C is written with this function, it will not trigger a Ctrl-C
 //      interrupt in the client, but instead write a Ctrl+C to the input buffer
 //      to be read by the client.
+//  While a batch is open (see BeginInputBatch), the input is held back and
+//      written along with the rest of the batch. Single records are coalesced
+//      with the batch the same way the input buffer coalesces them.
 // Arguments:
-// - inputEvents: a collection of IInputEvents
+// - inputRecords: a collection of input records
 // Return Value:
 // True if handled successfully. False otherwise.
-bool InteractDispatch::WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
+bool InteractDispatch::WriteInput(const gsl::span<const INPUT_RECORD> inputRecords)
 {
+    if (_batchingInput)
+    {
+        // The input buffer only coalesces records that are written one at a
+        // time, and it would never see those within a batch. So the batch
+        // has to take care of it instead.
+        if (inputRecords.size() == 1)
+        {
+            if (_batchedInput.empty())
+            {
+                _batchedInputLeadsAlone = true;
+            }
+            else if (_CoalesceBatchedInput(til::at(inputRecords, 0)))
+            {
+                // The input buffer counts a coalesced record as written, too.
+                ++_batchedEventsWritten;
+                return true;
+            }
+        }
+
+        _batchedInput.insert(_batchedInput.end(), inputRecords.begin(), inputRecords.end());
+        return true;
+    }
+
     size_t written = 0;
-    return _pConApi->PrivateWriteConsoleInputW(inputEvents, written);
+    return _pConApi->PrivateWriteConsoleInputW(inputRecords, written);
 }
 
 // Method Description:
@@ -47,12 +77,15 @@ bool InteractDispatch::WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inpu
 // True if handled successfully. False otherwise.
 bool InteractDispatch::WriteCtrlKey(const KeyEvent& event)
 {
+    // Anything typed before the control key has to reach the buffer first.
+    _FlushInputBatch();
     return _pConApi->PrivateWriteConsoleControlInput(event);
 }
 
 // Method Description:
-// - Writes a string of input to the host. The string is converted to keystrokes
-//      that will faithfully represent the input by CharToKeyEvents.
+// - Writes a string of input to the host. The host keeps it as text, and only
+//      converts it to the keystrokes that would type it (see CharToKeyEvents)
+//      if a client reads input records.
 // Arguments:
 // - string : a string to write to the console.
 // Return Value:
@@ -64,23 +97,12 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
         return true;
     }
 
-    unsigned int codepage = 0;
-    bool success = _pConApi->GetConsoleOutputCP(codepage);
-    if (success)
-    {
-        std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    // Anything batched so far came before this text.
+    bool success = _FlushInputBatch();
 
-        for (const auto& wch : string)
-        {
-            std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(wch, codepage);
-
-            std::move(convertedEvents.begin(),
-                      convertedEvents.end(),
-                      std::back_inserter(keyEvents));
-        }
-
-        success = WriteInput(keyEvents);
-    }
+    size_t written = 0;
+    success = _pConApi->PrivateWriteConsoleInputText(string, written) && success;
+    _batchedEventsWritten += written;
     return success;
 }
 
@@ -98,6 +120,10 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
 bool InteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulationType function,
                                           const gsl::span<const size_t> parameters)
 {
+    // A resize writes its own event into the input buffer, after anything
+    // that came before it.
+    _FlushInputBatch();
+
     bool success = false;
     // Other Window Manipulation functions:
     //  MSFT:13271098 - QueryViewport
@@ -142,6 +168,8 @@ bool InteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulatio
 //  or if any API calls failed.
 bool InteractDispatch::MoveCursor(const size_t row, const size_t col)
 {
+    _FlushInputBatch();
+
     size_t rowFixed = row;
     size_t colFixed = col;
 
@@ -214,3 +242,100 @@ bool InteractDispatch::IsVtInputEnabled() const
 {
     return _pConApi->PrivateIsVtInputEnabled();
 }
+
+// Method Description:
+// - Starts holding back the input written by WriteInput and WriteString, so
+//   that everything parsed out of one read of the input pipe can be written
+//   to the input buffer with a single call. Anything else that touches the
+//   input buffer writes out the pending input first, so ordering is kept.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InteractDispatch::BeginInputBatch() noexcept
+{
+    _batchingInput = true;
+    _batchedEventsWritten = 0;
+}
+
+// Method Description:
+// - Writes out the input held back since BeginInputBatch and stops batching.
+// Arguments:
+// - eventsWritten - receives the number of events the input buffer accepted
+//   over the whole batch.
+// Return Value:
+// - True if the input was written successfully. False otherwise.
+bool InteractDispatch::EndInputBatch(size_t& eventsWritten) noexcept
+{
+    bool success = false;
+    try
+    {
+        success = _FlushInputBatch();
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        _batchedInput.clear();
+    }
+
+    _batchingInput = false;
+    eventsWritten = _batchedEventsWritten;
+    return success;
+}
+
+// Method Description:
+// - Writes out any input held back by the current batch. The batch stays open.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if there was nothing to write or it was written successfully. False otherwise.
+bool InteractDispatch::_FlushInputBatch()
+{
+    if (_batchedInput.empty())
+    {
+        return true;
+    }
+
+    bool success = true;
+    size_t written = 0;
+    auto records = gsl::make_span(_batchedInput);
+
+    // If the batch started with a record that was written on its own, the
+    // input buffer would have coalesced it with the last record it holds.
+    // Hand it over on its own, so that it still can.
+    if (_batchedInputLeadsAlone && records.size() > 1)
+    {
+        success = _pConApi->PrivateWriteConsoleInputW(records.first(1), written);
+        _batchedEventsWritten += written;
+        records = records.subspan(1);
+    }
+
+    success = _pConApi->PrivateWriteConsoleInputW(records, written) && success;
+    _batchedEventsWritten += written;
+    // clear() keeps the capacity, so the next batch doesn't allocate.
+    _batchedInput.clear();
+    _batchedInputLeadsAlone = false;
+    return success;
+}
+
+// Method Description:
+// - Coalesces a record that was written on its own with the last record of
+//   the batch, following the same rules as the input buffer.
+// Arguments:
+// - inRecord - the incoming record. The batch must not be empty.
+// Return Value:
+// - True if the record was coalesced and mustn't be added to the batch. False otherwise.
+bool InteractDispatch::_CoalesceBatchedInput(const INPUT_RECORD& inRecord)
+{
+    auto& lastRecord = _batchedInput.back();
+    if (CoalesceMouseMoved(lastRecord, inRecord))
+    {
+        return true;
+    }
+
+    // In VT input mode the input buffer translates key events into sequences
+    // rather than storing them, so they don't get coalesced there either.
+    return inRecord.EventType == KEY_EVENT &&
+           !_pConApi->PrivateIsVtInputEnabled() &&
+           CoalesceRepeatedKeyPress(lastRecord, inRecord);
+}
@@ -25,7 +25,7 @@ namespace Microsoft::Console::VirtualTerminal
     public:
         InteractDispatch(std::unique_ptr<ConGetSet> pConApi);
 
-        bool WriteInput(std::deque<std::unique_ptr<IInputEvent>>& inputEvents) override;
+        bool WriteInput(const gsl::span<const INPUT_RECORD> inputRecords) override;
         bool WriteCtrlKey(const KeyEvent& event) override;
         bool WriteString(const std::wstring_view string) override;
         bool WindowManipulation(const DispatchTypes::WindowManipulationType function,
@@ -34,7 +34,20 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool IsVtInputEnabled() const override;
 
+        void BeginInputBatch() noexcept;
+        bool EndInputBatch(size_t& eventsWritten) noexcept;
+
     private:
         std::unique_ptr<ConGetSet> _pConApi;
+
+        // While batching, WriteInput collects records here instead of
+        // writing them, so that they reach the input buffer in one call.
+        bool _batchingInput;
+        std::vector<INPUT_RECORD> _batchedInput;
+        bool _batchedInputLeadsAlone;
+        size_t _batchedEventsWritten;
+
+        bool _FlushInputBatch();
+        bool _CoalesceBatchedInput(const INPUT_RECORD& inRecord);
     };
 }
@@ -32,7 +32,10 @@ AdaptDispatch::AdaptDispatch(std::unique_ptr<ConGetSet> pConApi,
     _usingAltBuffer(false),
     _isOriginModeRelative(false), // by default, the DECOM origin mode is absolute.
     _isDECCOLMAllowed(false), // by default, DECCOLM is not allowed.
-    _termOutput()
+    _termOutput(),
+    _graphicsRenditionCache{},
+    _graphicsRenditionCacheUsed(0),
+    _graphicsRenditionCacheNext(0)
 {
     THROW_HR_IF_NULL(E_INVALIDARG, _pConApi.get());
     THROW_HR_IF_NULL(E_INVALIDARG, _pDefaults.get());
@@ -69,14 +72,15 @@ void AdaptDispatch::PrintString(const std::wstring_view string)
 {
     try
     {
-        if (_termOutput.NeedToTranslate())
+        // Even with a translation table active, most text usually doesn't
+        // contain anything it changes, and can be printed as it is.
+        const auto firstTranslated = _termOutput.NeedToTranslate() ?
+                                         _termOutput.FindFirstTranslatedChar(string) :
+                                         std::wstring_view::npos;
+        if (firstTranslated != std::wstring_view::npos)
         {
-            std::wstring buffer;
-            buffer.reserve(string.size());
-            for (auto& wch : string)
-            {
-                buffer.push_back(_termOutput.TranslateKey(wch));
-            }
+            std::wstring buffer{ string };
+            _termOutput.TranslateString(gsl::make_span(buffer).subspan(firstTranslated));
             _pDefaults->PrintString(buffer);
         }
         else
@@ -178,18 +182,22 @@ bool AdaptDispatch::_CursorMovePosition(const Offset rowOffset, const Offset col
     bool success = true;
 
     // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    success = (_pConApi->MoveToBottom() &&
+               _pConApi->PrivateGetViewport(viewport) &&
+               _pConApi->PrivateGetCursorPosition(cursorPosition) &&
+               _pConApi->PrivateGetBufferSize(bufferSize));
 
     if (success)
     {
         // Calculate the viewport boundaries as inclusive values.
-        // srWindow is exclusive so we need to subtract 1 from the bottom.
-        const int viewportTop = csbiex.srWindow.Top;
-        const int viewportBottom = csbiex.srWindow.Bottom - 1;
+        // The viewport is exclusive so we need to subtract 1 from the bottom.
+        const int viewportTop = viewport.Top;
+        const int viewportBottom = viewport.Bottom - 1;
 
         // Calculate the absolute margins of the scrolling area.
         const int topMargin = viewportTop + _scrollMargins.Top;
@@ -198,8 +206,8 @@ bool AdaptDispatch::_CursorMovePosition(const Offset rowOffset, const Offset col
 
         // For relative movement, the given offsets will be relative to
         // the current cursor position.
-        int row = csbiex.dwCursorPosition.Y;
-        int col = csbiex.dwCursorPosition.X;
+        int row = cursorPosition.Y;
+        int col = cursorPosition.X;
 
         // But if the row is absolute, it will be relative to the top of the
         // viewport, or the top margin, depending on the origin mode.
@@ -219,7 +227,7 @@ bool AdaptDispatch::_CursorMovePosition(const Offset rowOffset, const Offset col
         // The row is constrained within the viewport's vertical boundaries,
         // while the column is constrained by the buffer width.
         row = std::clamp(row + rowOffset.Value, viewportTop, viewportBottom);
-        col = std::clamp(col + colOffset.Value, 0, csbiex.dwSize.X - 1);
+        col = std::clamp(col + colOffset.Value, 0, bufferSize.X - 1);
 
         // If the operation needs to be clamped inside the margins, or the origin
         // mode is relative (which always requires margin clamping), then the row
@@ -234,11 +242,11 @@ bool AdaptDispatch::_CursorMovePosition(const Offset rowOffset, const Offset col
             // to the bottom margin. See
             // ScreenBufferTests::CursorUpDownOutsideMargins for a test of that
             // behavior.
-            if (csbiex.dwCursorPosition.Y >= topMargin)
+            if (cursorPosition.Y >= topMargin)
             {
                 row = std::max(row, topMargin);
             }
-            if (csbiex.dwCursorPosition.Y <= bottomMargin)
+            if (cursorPosition.Y <= bottomMargin)
             {
                 row = std::min(row, bottomMargin);
             }
@@ -321,11 +329,13 @@ bool AdaptDispatch::CursorPosition(const size_t line, const size_t column)
 bool AdaptDispatch::CursorSaveState()
 {
     // First retrieve some information about the buffer
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
+    COORD coordCursor = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    bool success = (_pConApi->MoveToBottom() &&
+                    _pConApi->PrivateGetViewport(viewport) &&
+                    _pConApi->PrivateGetCursorPosition(coordCursor));
 
     TextAttribute attributes;
     success = success && (_pConApi->PrivateGetTextAttributes(attributes));
@@ -334,8 +344,7 @@ bool AdaptDispatch::CursorSaveState()
     {
         // The cursor is given to us by the API as relative to the whole buffer.
         // But in VT speak, the cursor row should be relative to the current viewport top.
-        COORD coordCursor = csbiex.dwCursorPosition;
-        coordCursor.Y -= csbiex.srWindow.Top;
+        coordCursor.Y -= viewport.Top;
 
         // VT is also 1 based, not 0 based, so correct by 1.
         auto& savedCursorState = _savedCursorState.at(_usingAltBuffer);
@@ -422,15 +431,13 @@ bool AdaptDispatch::_InsertDeleteHelper(const size_t count, const bool isInsert)
     SHORT distance;
     RETURN_BOOL_IF_FALSE(SUCCEEDED(SizeTToShort(count, &distance)));
 
-    // get current cursor, attributes
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    // get current cursor
+    COORD cursor = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
     RETURN_BOOL_IF_FALSE(_pConApi->MoveToBottom());
-    RETURN_BOOL_IF_FALSE(_pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    RETURN_BOOL_IF_FALSE(_pConApi->PrivateGetCursorPosition(cursor));
 
-    const auto cursor = csbiex.dwCursorPosition;
     // Rectangle to cut out of the existing buffer. This is inclusive.
     // It will be clipped to the buffer boundaries so SHORT_MAX gives us the full buffer width.
     SMALL_RECT srScroll;
@@ -493,13 +500,15 @@ bool AdaptDispatch::DeleteCharacter(const size_t count)
 // - Internal helper to erase one particular line of the buffer. Either from beginning to the cursor, from the cursor to the end, or the entire line.
 // - Used by both erase line (used just once) and by erase screen (used in a loop) to erase a portion of the buffer.
 // Arguments:
-// - csbiex - Pointer to the console screen buffer that we will be erasing (and getting cursor data from within)
+// - cursorPosition - The current position of the cursor in the buffer.
+// - bufferWidth - The width of the buffer that we will be erasing.
 // - eraseType - Enumeration mode of which kind of erase to perform: beginning to cursor, cursor to end, or entire line.
 // - lineId - The line number (array index value, starts at 0) of the line to operate on within the buffer.
 //           - This is not aware of circular buffer. Line 0 is always the top visible line if you scrolled the whole way up the window.
 // Return Value:
 // - True if handled successfully. False otherwise.
-bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& csbiex,
+bool AdaptDispatch::_EraseSingleLineHelper(const COORD cursorPosition,
+                                           const SHORT bufferWidth,
                                            const DispatchTypes::EraseType eraseType,
                                            const size_t lineId) const
 {
@@ -518,7 +527,7 @@ bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& c
         coordStartPosition.X = 0; // from beginning and the whole line start from the left most edge of the buffer.
         break;
     case DispatchTypes::EraseType::ToEnd:
-        coordStartPosition.X = csbiex.dwCursorPosition.X; // from the current cursor position (including it)
+        coordStartPosition.X = cursorPosition.X; // from the current cursor position (including it)
         break;
     }
 
@@ -529,12 +538,12 @@ bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& c
     {
     case DispatchTypes::EraseType::FromBeginning:
         // +1 because if cursor were at the left edge, the length would be 0 and we want to paint at least the 1 character the cursor is on.
-        nLength = csbiex.dwCursorPosition.X + 1;
+        nLength = cursorPosition.X + 1;
         break;
     case DispatchTypes::EraseType::ToEnd:
     case DispatchTypes::EraseType::All:
         // Remember the .X value is 1 farther than the right most column in the buffer. Therefore no +1.
-        nLength = csbiex.dwSize.X - coordStartPosition.X;
+        nLength = bufferWidth - coordStartPosition.X;
         break;
     }
 
@@ -553,15 +562,14 @@ bool AdaptDispatch::_EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& c
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::EraseCharacters(const size_t numChars)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD startPosition = { 0 };
+    COORD bufferSize = { 0 };
+    bool success = (_pConApi->PrivateGetCursorPosition(startPosition) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
 
     if (success)
     {
-        const COORD startPosition = csbiex.dwCursorPosition;
-
-        const SHORT remainingSpaces = csbiex.dwSize.X - startPosition.X;
+        const SHORT remainingSpaces = bufferSize.X - startPosition.X;
         const size_t actualRemaining = gsl::narrow_cast<size_t>((remainingSpaces < 0) ? 0 : remainingSpaces);
         // erase at max the number of characters remaining in the line from the current position.
         const auto eraseLength = (numChars <= actualRemaining) ? numChars : actualRemaining;
@@ -612,11 +620,15 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
         return eraseAllResult && (!isPty);
     }
 
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    bool success = (_pConApi->MoveToBottom() &&
+                    _pConApi->PrivateGetViewport(viewport) &&
+                    _pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
 
     if (success)
     {
@@ -633,9 +645,9 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
         if (eraseType == DispatchTypes::EraseType::FromBeginning)
         {
             // For beginning and all, erase all complete lines before (above vertically) from the cursor position.
-            for (SHORT startLine = csbiex.srWindow.Top; startLine < csbiex.dwCursorPosition.Y; startLine++)
+            for (SHORT startLine = viewport.Top; startLine < cursorPosition.Y; startLine++)
             {
-                success = _EraseSingleLineHelper(csbiex, DispatchTypes::EraseType::All, startLine);
+                success = _EraseSingleLineHelper(cursorPosition, bufferSize.X, DispatchTypes::EraseType::All, startLine);
 
                 if (!success)
                 {
@@ -647,7 +659,7 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
         if (success)
         {
             // 2. Cursor Line
-            success = _EraseSingleLineHelper(csbiex, eraseType, csbiex.dwCursorPosition.Y);
+            success = _EraseSingleLineHelper(cursorPosition, bufferSize.X, eraseType, cursorPosition.Y);
         }
 
         if (success)
@@ -657,9 +669,9 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
             {
                 // For beginning and all, erase all complete lines after (below vertically) the cursor position.
                 // Remember that the viewport bottom value is 1 beyond the viewable area of the viewport.
-                for (SHORT startLine = csbiex.dwCursorPosition.Y + 1; startLine < csbiex.srWindow.Bottom; startLine++)
+                for (SHORT startLine = cursorPosition.Y + 1; startLine < viewport.Bottom; startLine++)
                 {
-                    success = _EraseSingleLineHelper(csbiex, DispatchTypes::EraseType::All, startLine);
+                    success = _EraseSingleLineHelper(cursorPosition, bufferSize.X, DispatchTypes::EraseType::All, startLine);
 
                     if (!success)
                     {
@@ -681,13 +693,14 @@ bool AdaptDispatch::EraseInDisplay(const DispatchTypes::EraseType eraseType)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::EraseInLine(const DispatchTypes::EraseType eraseType)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
+    bool success = (_pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
 
     if (success)
     {
-        success = _EraseSingleLineHelper(csbiex, eraseType, csbiex.dwCursorPosition.Y);
+        success = _EraseSingleLineHelper(cursorPosition, bufferSize.X, eraseType, cursorPosition.Y);
     }
 
     return success;
@@ -789,19 +802,19 @@ bool AdaptDispatch::_OperatingStatus() const
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_CursorPositionReport() const
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
+    // First pull the cursor position relative to the entire buffer out of the console.
+    COORD coordCursorPos = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    bool success = (_pConApi->MoveToBottom() &&
+                    _pConApi->PrivateGetViewport(viewport) &&
+                    _pConApi->PrivateGetCursorPosition(coordCursorPos));
 
     if (success)
     {
-        // First pull the cursor position relative to the entire buffer out of the console.
-        COORD coordCursorPos = csbiex.dwCursorPosition;
-
         // Now adjust it for its position in respect to the current viewport top.
-        coordCursorPos.Y -= csbiex.srWindow.Top;
+        coordCursorPos.Y -= viewport.Top;
 
         // NOTE: 1,1 is the top-left corner of the viewport in VT-speak, so add 1.
         coordCursorPos.X++;
@@ -875,12 +888,11 @@ bool AdaptDispatch::_ScrollMovement(const ScrollDirection scrollDirection, const
 
     if (success)
     {
-        // get current cursor
-        CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-        csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+        // get current viewport
+        SMALL_RECT viewport = { 0 };
         // Make sure to reset the viewport (with MoveToBottom )to where it was
         //      before the user scrolled the console output
-        success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+        success = (_pConApi->MoveToBottom() && _pConApi->PrivateGetViewport(viewport));
 
         if (success)
         {
@@ -889,13 +901,13 @@ bool AdaptDispatch::_ScrollMovement(const ScrollDirection scrollDirection, const
             SMALL_RECT srScreen;
             srScreen.Left = 0;
             srScreen.Right = SHORT_MAX;
-            srScreen.Top = csbiex.srWindow.Top;
-            srScreen.Bottom = csbiex.srWindow.Bottom - 1; // srWindow is exclusive, hence the - 1
+            srScreen.Top = viewport.Top;
+            srScreen.Bottom = viewport.Bottom - 1; // viewport is exclusive, hence the - 1
             // Clip to the DECSTBM margin boundaries
             if (_scrollMargins.Top < _scrollMargins.Bottom)
             {
-                srScreen.Top = csbiex.srWindow.Top + _scrollMargins.Top;
-                srScreen.Bottom = csbiex.srWindow.Top + _scrollMargins.Bottom;
+                srScreen.Top = viewport.Top + _scrollMargins.Top;
+                srScreen.Bottom = viewport.Top + _scrollMargins.Bottom;
             }
 
             // Paste coordinate for cut text above
@@ -1060,6 +1072,9 @@ bool AdaptDispatch::_PrivateModeParamsHelper(const DispatchTypes::PrivateModePar
     case DispatchTypes::PrivateModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::PrivateModeParams::XTERM_BracketedPasteMode:
+        success = EnableXtermBracketedPasteMode(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -1280,11 +1295,10 @@ bool AdaptDispatch::SetAutoWrapMode(const bool wrapAtEOL)
 bool AdaptDispatch::_DoSetTopBottomScrollingMargins(const size_t topMargin,
                                                     const size_t bottomMargin)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = (_pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex));
+    bool success = (_pConApi->MoveToBottom() && _pConApi->PrivateGetViewport(viewport));
 
     // so notes time: (input -> state machine out -> adapter out -> conhost internal)
     // having only a top param is legal         ([3;r   -> 3,0   -> 3,h  -> 3,h,true)
@@ -1298,7 +1312,7 @@ bool AdaptDispatch::_DoSetTopBottomScrollingMargins(const size_t topMargin,
         success = SUCCEEDED(SizeTToShort(topMargin, &actualTop)) && SUCCEEDED(SizeTToShort(bottomMargin, &actualBottom));
         if (success)
         {
-            const SHORT screenHeight = csbiex.srWindow.Bottom - csbiex.srWindow.Top;
+            const SHORT screenHeight = viewport.Bottom - viewport.Top;
             // The default top margin is line 1
             if (actualTop == 0)
             {
@@ -1475,16 +1489,17 @@ bool AdaptDispatch::UseMainScreenBuffer()
 // True if handled successfully. False otherwise.
 bool AdaptDispatch::HorizontalTabSet()
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    const bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
+    const bool success = (_pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                          _pConApi->PrivateGetBufferSize(bufferSize));
     if (success)
     {
-        const auto width = csbiex.dwSize.X;
-        const auto column = csbiex.dwCursorPosition.X;
+        const auto width = bufferSize.X;
+        const auto column = cursorPosition.X;
 
-        _InitTabStopsForWidth(width);
-        _tabStopColumns.at(column) = true;
+        _tabStops.Resize(width);
+        _tabStops.Set(column);
     }
     return success;
 }
@@ -1500,25 +1515,17 @@ bool AdaptDispatch::HorizontalTabSet()
 // True if handled successfully. False otherwise.
 bool AdaptDispatch::ForwardTab(const size_t numTabs)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
+    bool success = (_pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
     if (success)
     {
-        const auto width = csbiex.dwSize.X;
-        const auto row = csbiex.dwCursorPosition.Y;
-        auto column = csbiex.dwCursorPosition.X;
-        auto tabsPerformed = 0u;
+        const auto width = bufferSize.X;
+        const auto row = cursorPosition.Y;
 
-        _InitTabStopsForWidth(width);
-        while (column + 1 < width && tabsPerformed < numTabs)
-        {
-            column++;
-            if (til::at(_tabStopColumns, column))
-            {
-                tabsPerformed++;
-            }
-        }
+        _tabStops.Resize(width);
+        const auto column = gsl::narrow_cast<SHORT>(_tabStops.Next(cursorPosition.X, numTabs, width));
 
         success = _pConApi->SetConsoleCursorPosition({ column, row });
     }
@@ -1534,25 +1541,17 @@ bool AdaptDispatch::ForwardTab(const size_t numTabs)
 // True if handled successfully. False otherwise.
 bool AdaptDispatch::BackwardsTab(const size_t numTabs)
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
+    bool success = (_pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
     if (success)
     {
-        const auto width = csbiex.dwSize.X;
-        const auto row = csbiex.dwCursorPosition.Y;
-        auto column = csbiex.dwCursorPosition.X;
-        auto tabsPerformed = 0u;
+        const auto width = bufferSize.X;
+        const auto row = cursorPosition.Y;
 
-        _InitTabStopsForWidth(width);
-        while (column > 0 && tabsPerformed < numTabs)
-        {
-            column--;
-            if (til::at(_tabStopColumns, column))
-            {
-                tabsPerformed++;
-            }
-        }
+        _tabStops.Resize(width);
+        const auto column = gsl::narrow_cast<SHORT>(_tabStops.Previous(cursorPosition.X, numTabs));
 
         success = _pConApi->SetConsoleCursorPosition({ column, row });
     }
@@ -1590,72 +1589,44 @@ bool AdaptDispatch::TabClear(const size_t clearType)
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_ClearSingleTabStop()
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
-    const bool success = _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    COORD cursorPosition = { 0 };
+    COORD bufferSize = { 0 };
+    const bool success = (_pConApi->PrivateGetCursorPosition(cursorPosition) &&
+                          _pConApi->PrivateGetBufferSize(bufferSize));
     if (success)
     {
-        const auto width = csbiex.dwSize.X;
-        const auto column = csbiex.dwCursorPosition.X;
+        const auto width = bufferSize.X;
+        const auto column = cursorPosition.X;
 
-        _InitTabStopsForWidth(width);
-        _tabStopColumns.at(column) = false;
+        _tabStops.Resize(width);
+        _tabStops.Clear(column);
     }
     return success;
 }
 
 // Routine Description:
-// - Clears all tab stops and resets the _initDefaultTabStops flag to indicate
-//    that they shouldn't be reinitialized at the default positions.
+// - Clears all tab stops and indicates that they shouldn't be reinitialized
+//    at the default positions.
 // Arguments:
 // - <none>
 // Return value:
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::_ClearAllTabStops() noexcept
 {
-    _tabStopColumns.clear();
-    _initDefaultTabStops = false;
+    _tabStops.ClearAll();
     return true;
 }
 
 // Routine Description:
-// - Clears all tab stops and sets the _initDefaultTabStops flag to indicate
-//    that the default positions should be reinitialized when needed.
+// - Clears all tab stops and indicates that the default positions should be
+//    reinitialized when needed.
 // Arguments:
 // - <none>
 // Return value:
 // - <none>
 void AdaptDispatch::_ResetTabStops() noexcept
 {
-    _tabStopColumns.clear();
-    _initDefaultTabStops = true;
-}
-
-// Routine Description:
-// - Resizes the _tabStopColumns table so it's large enough to support the
-//    current screen width, initializing tab stops every 8 columns in the
-//    newly allocated space, iff the _initDefaultTabStops flag is set.
-// Arguments:
-// - width - the width of the screen buffer that we need to accomodate
-// Return value:
-// - <none>
-void AdaptDispatch::_InitTabStopsForWidth(const size_t width)
-{
-    const auto initialWidth = _tabStopColumns.size();
-    if (width > initialWidth)
-    {
-        _tabStopColumns.resize(width);
-        if (_initDefaultTabStops)
-        {
-            for (auto column = 8u; column < _tabStopColumns.size(); column += 8)
-            {
-                if (column >= initialWidth)
-                {
-                    til::at(_tabStopColumns, column) = true;
-                }
-            }
-        }
-    }
+    _tabStops.Reset();
 }
 
 //Routine Description:
@@ -1894,17 +1865,19 @@ bool AdaptDispatch::HardReset()
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::ScreenAlignmentPattern()
 {
-    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
-    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    SMALL_RECT viewport = { 0 };
+    COORD bufferSize = { 0 };
     // Make sure to reset the viewport (with MoveToBottom )to where it was
     //      before the user scrolled the console output
-    bool success = _pConApi->MoveToBottom() && _pConApi->GetConsoleScreenBufferInfoEx(csbiex);
+    bool success = (_pConApi->MoveToBottom() &&
+                    _pConApi->PrivateGetViewport(viewport) &&
+                    _pConApi->PrivateGetBufferSize(bufferSize));
 
     if (success)
     {
         // Fill the screen with the letter E using the default attributes.
-        auto fillPosition = COORD{ 0, csbiex.srWindow.Top };
-        const auto fillLength = (csbiex.srWindow.Bottom - csbiex.srWindow.Top) * csbiex.dwSize.X;
+        auto fillPosition = COORD{ 0, viewport.Top };
+        const auto fillLength = (viewport.Bottom - viewport.Top) * bufferSize.X;
         success = _pConApi->PrivateFillRegion(fillPosition, fillLength, L'E', false);
         // Reset the meta/extended attributes (but leave the colors unchanged).
         TextAttribute attr;
@@ -2140,6 +2113,20 @@ bool AdaptDispatch::EnableAlternateScroll(const bool enabled)
     return success;
 }
 
+//Routine Description:
+// Enable Bracketed Paste Mode - Asks the terminal to surround pasted text with
+//      ESC[200~ and ESC[201~. The console doesn't paste VT sequences itself,
+//      so this is never handled here. In conpty mode, failing lets the
+//      sequence pass through to the connected terminal, which does the pasting.
+//Arguments:
+// - enabled - true to enable, false to disable.
+// Return value:
+// - false, always.
+bool AdaptDispatch::EnableXtermBracketedPasteMode(const bool /*enabled*/) noexcept
+{
+    return false;
+}
+
 //Routine Description:
 // Set Cursor Style - Changes the cursor's style to match the given Dispatch
 //      cursor style. Unix styles are a combination of the shape and the blinking state.
@@ -2335,6 +2322,34 @@ bool AdaptDispatch::WindowManipulation(const DispatchTypes::WindowManipulationTy
     return success;
 }
 
+// Routine Description:
+// - Dispatches a batch of cursor movements, renditions and text that were
+//   collected by the engine. The console is told when the batch starts and
+//   ends, so that it can redraw the cursor and notify accessibility clients
+//   once for the whole batch, rather than after every command.
+// Arguments:
+// - commands - the commands to dispatch, in order.
+// Return Value:
+// - True if handled successfully. False otherwise.
+bool AdaptDispatch::DispatchBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands)
+{
+    bool success = _pConApi->PrivateBeginUpdateBatch();
+
+    try
+    {
+        success = _ReplayBatch(commands) && success;
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        success = false;
+    }
+
+    // The batch has to be ended even if it failed, or the cursor would never
+    // be redrawn again.
+    return _pConApi->PrivateEndUpdateBatch() && success;
+}
+
 // Routine Description:
 // - Determines whether we should pass any sequence that manipulates
 //   TerminalInput's input generator through the PTY. It encapsulates
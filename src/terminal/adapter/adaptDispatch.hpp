@@ -19,6 +19,7 @@ Author(s):
 #include "conGetSet.hpp"
 #include "adaptDefaults.hpp"
 #include "terminalOutput.hpp"
+#include "tabStops.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
 {
@@ -105,6 +106,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool EnableButtonEventMouseMode(const bool enabled) override; // ?1002
         bool EnableAnyEventMouseMode(const bool enabled) override; // ?1003
         bool EnableAlternateScroll(const bool enabled) override; // ?1007
+        bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
         bool SetCursorStyle(const DispatchTypes::CursorStyle cursorStyle) override; // DECSCUSR
         bool SetCursorColor(const COLORREF cursorColor) override;
 
@@ -118,6 +120,8 @@ namespace Microsoft::Console::VirtualTerminal
         bool WindowManipulation(const DispatchTypes::WindowManipulationType function,
                                 const gsl::span<const size_t> parameters) override; // DTTERM_WindowManipulation
 
+        bool DispatchBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands) override;
+
     private:
         enum class ScrollDirection
         {
@@ -145,7 +149,8 @@ namespace Microsoft::Console::VirtualTerminal
         };
 
         bool _CursorMovePosition(const Offset rowOffset, const Offset colOffset, const bool clampInMargins) const;
-        bool _EraseSingleLineHelper(const CONSOLE_SCREEN_BUFFER_INFOEX& csbiex,
+        bool _EraseSingleLineHelper(const COORD cursorPosition,
+                                    const SHORT bufferWidth,
                                     const DispatchTypes::EraseType eraseType,
                                     const size_t lineId) const;
         bool _EraseScrollback();
@@ -166,12 +171,10 @@ namespace Microsoft::Console::VirtualTerminal
         bool _ClearSingleTabStop();
         bool _ClearAllTabStops() noexcept;
         void _ResetTabStops() noexcept;
-        void _InitTabStopsForWidth(const size_t width);
 
         bool _ShouldPassThroughInputModeChange() const;
 
-        std::vector<bool> _tabStopColumns;
-        bool _initDefaultTabStops = true;
+        TabStops _tabStops;
 
         std::unique_ptr<ConGetSet> _pConApi;
         std::unique_ptr<AdaptDefaults> _pDefaults;
@@ -192,8 +195,27 @@ namespace Microsoft::Console::VirtualTerminal
 
         bool _isDECCOLMAllowed;
 
-        size_t _SetRgbColorsHelper(const gsl::span<const DispatchTypes::GraphicsOptions> options,
-                                   TextAttribute& attr,
-                                   const bool isForeground) noexcept;
+        // The longest SGR option list that's cached, and how many are kept.
+        static constexpr size_t MaxCachedGraphicsOptions = 8;
+        static constexpr size_t GraphicsRenditionCacheSize = 16;
+
+        struct CachedGraphicsRendition
+        {
+            std::array<DispatchTypes::GraphicsOptions, MaxCachedGraphicsOptions> options;
+            size_t optionCount;
+            TextAttributeDelta delta;
+        };
+
+        // Applications tend to use the same few renditions over and over, so
+        // the most recently seen ones are kept already compiled.
+        std::array<CachedGraphicsRendition, GraphicsRenditionCacheSize> _graphicsRenditionCache;
+        size_t _graphicsRenditionCacheUsed;
+        size_t _graphicsRenditionCacheNext;
+
+        TextAttributeDelta _GetGraphicsRendition(const gsl::span<const DispatchTypes::GraphicsOptions> options) noexcept;
+        static TextAttributeDelta s_CompileGraphicsRendition(const gsl::span<const DispatchTypes::GraphicsOptions> options) noexcept;
+        static size_t s_CompileRgbColors(const gsl::span<const DispatchTypes::GraphicsOptions> options,
+                                         TextAttributeDelta& delta,
+                                         const bool isForeground) noexcept;
     };
 }
@@ -43,14 +43,15 @@ const BYTE BRIGHT_WHITE   = BRIGHT_ATTR | RED_ATTR | GREEN_ATTR | BLUE_ATTR;
 //      Xterm index will use the param that follows to use a color from the preset 256 color xterm color table.
 // Arguments:
 // - options - An array of options that will be used to generate the RGB color
-// - attr - The attribute that will be updated with the parsed color.
+// - delta - The change that will be updated with the parsed color.
 // - isForeground - Whether or not the parsed color is for the foreground.
 // Return Value:
 // - The number of options consumed, not including the initial 38/48.
-size_t AdaptDispatch::_SetRgbColorsHelper(const gsl::span<const DispatchTypes::GraphicsOptions> options,
-                                          TextAttribute& attr,
-                                          const bool isForeground) noexcept
+size_t AdaptDispatch::s_CompileRgbColors(const gsl::span<const DispatchTypes::GraphicsOptions> options,
+                                         TextAttributeDelta& delta,
+                                         const bool isForeground) noexcept
 {
+    auto& color = isForeground ? delta.foreground : delta.background;
     size_t optionsConsumed = 0;
     if (options.size() >= 1)
     {
@@ -66,7 +67,7 @@ size_t AdaptDispatch::_SetRgbColorsHelper(const gsl::span<const DispatchTypes::G
             if (red <= 255 && green <= 255 && blue <= 255)
             {
                 const COLORREF rgbColor = RGB(red, green, blue);
-                attr.SetColor(rgbColor, isForeground);
+                color = TextColor{ rgbColor };
             }
         }
         else if (typeOpt == DispatchTypes::GraphicsOptions::BlinkOrXterm256Index && options.size() >= 2)
@@ -76,20 +77,240 @@ size_t AdaptDispatch::_SetRgbColorsHelper(const gsl::span<const DispatchTypes::G
             if (tableIndex <= 255)
             {
                 const auto adjustedIndex = gsl::narrow_cast<BYTE>(::Xterm256ToWindowsIndex(tableIndex));
-                if (isForeground)
-                {
-                    attr.SetIndexedForeground256(adjustedIndex);
-                }
-                else
-                {
-                    attr.SetIndexedBackground256(adjustedIndex);
-                }
+                color = TextColor{ adjustedIndex, true };
             }
         }
     }
     return optionsConsumed;
 }
 
+// Routine Description:
+// - Compiles a list of SGR options into the change it makes to the current
+//   attributes. The options are applied in order, so later ones win over
+//   earlier ones, just as if they were applied to the attributes directly.
+// Arguments:
+// - options - An array of SGR options.
+// Return Value:
+// - The flags to clear and set, and the colors to replace.
+TextAttributeDelta AdaptDispatch::s_CompileGraphicsRendition(const gsl::span<const DispatchTypes::GraphicsOptions> options) noexcept
+{
+    TextAttributeDelta delta;
+
+    // Run through the graphics options and compile them
+    for (size_t i = 0; i < options.size(); i++)
+    {
+        const auto opt = til::at(options, i);
+        switch (opt)
+        {
+        case Off:
+            delta.foreground = TextColor{};
+            delta.background = TextColor{};
+            delta.SetStandardErase();
+            break;
+        case ForegroundDefault:
+            delta.foreground = TextColor{};
+            break;
+        case BackgroundDefault:
+            delta.background = TextColor{};
+            break;
+        case BoldBright:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Bold, true);
+            break;
+        case RGBColorOrFaint:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Faint, true);
+            break;
+        case NotBoldOrFaint:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Bold | ExtendedAttributes::Faint, false);
+            break;
+        case Italics:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Italics, true);
+            break;
+        case NotItalics:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Italics, false);
+            break;
+        case BlinkOrXterm256Index:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Blinking, true);
+            break;
+        case Steady:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Blinking, false);
+            break;
+        case Invisible:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Invisible, true);
+            break;
+        case Visible:
+            delta.UpdateExtendedFlags(ExtendedAttributes::Invisible, false);
+            break;
+        case CrossedOut:
+            delta.UpdateExtendedFlags(ExtendedAttributes::CrossedOut, true);
+            break;
+        case NotCrossedOut:
+            delta.UpdateExtendedFlags(ExtendedAttributes::CrossedOut, false);
+            break;
+        case Negative:
+            delta.UpdateLegacyFlags(COMMON_LVB_REVERSE_VIDEO, true);
+            break;
+        case Positive:
+            delta.UpdateLegacyFlags(COMMON_LVB_REVERSE_VIDEO, false);
+            break;
+        case Underline:
+            delta.UpdateLegacyFlags(COMMON_LVB_UNDERSCORE, true);
+            break;
+        case NoUnderline:
+            delta.UpdateLegacyFlags(COMMON_LVB_UNDERSCORE, false);
+            break;
+        case Overline:
+            delta.UpdateLegacyFlags(COMMON_LVB_GRID_HORIZONTAL, true);
+            break;
+        case NoOverline:
+            delta.UpdateLegacyFlags(COMMON_LVB_GRID_HORIZONTAL, false);
+            break;
+        case ForegroundBlack:
+            delta.foreground = TextColor{ DARK_BLACK, false };
+            break;
+        case ForegroundBlue:
+            delta.foreground = TextColor{ DARK_BLUE, false };
+            break;
+        case ForegroundGreen:
+            delta.foreground = TextColor{ DARK_GREEN, false };
+            break;
+        case ForegroundCyan:
+            delta.foreground = TextColor{ DARK_CYAN, false };
+            break;
+        case ForegroundRed:
+            delta.foreground = TextColor{ DARK_RED, false };
+            break;
+        case ForegroundMagenta:
+            delta.foreground = TextColor{ DARK_MAGENTA, false };
+            break;
+        case ForegroundYellow:
+            delta.foreground = TextColor{ DARK_YELLOW, false };
+            break;
+        case ForegroundWhite:
+            delta.foreground = TextColor{ DARK_WHITE, false };
+            break;
+        case BackgroundBlack:
+            delta.background = TextColor{ DARK_BLACK, false };
+            break;
+        case BackgroundBlue:
+            delta.background = TextColor{ DARK_BLUE, false };
+            break;
+        case BackgroundGreen:
+            delta.background = TextColor{ DARK_GREEN, false };
+            break;
+        case BackgroundCyan:
+            delta.background = TextColor{ DARK_CYAN, false };
+            break;
+        case BackgroundRed:
+            delta.background = TextColor{ DARK_RED, false };
+            break;
+        case BackgroundMagenta:
+            delta.background = TextColor{ DARK_MAGENTA, false };
+            break;
+        case BackgroundYellow:
+            delta.background = TextColor{ DARK_YELLOW, false };
+            break;
+        case BackgroundWhite:
+            delta.background = TextColor{ DARK_WHITE, false };
+            break;
+        case BrightForegroundBlack:
+            delta.foreground = TextColor{ BRIGHT_BLACK, false };
+            break;
+        case BrightForegroundBlue:
+            delta.foreground = TextColor{ BRIGHT_BLUE, false };
+            break;
+        case BrightForegroundGreen:
+            delta.foreground = TextColor{ BRIGHT_GREEN, false };
+            break;
+        case BrightForegroundCyan:
+            delta.foreground = TextColor{ BRIGHT_CYAN, false };
+            break;
+        case BrightForegroundRed:
+            delta.foreground = TextColor{ BRIGHT_RED, false };
+            break;
+        case BrightForegroundMagenta:
+            delta.foreground = TextColor{ BRIGHT_MAGENTA, false };
+            break;
+        case BrightForegroundYellow:
+            delta.foreground = TextColor{ BRIGHT_YELLOW, false };
+            break;
+        case BrightForegroundWhite:
+            delta.foreground = TextColor{ BRIGHT_WHITE, false };
+            break;
+        case BrightBackgroundBlack:
+            delta.background = TextColor{ BRIGHT_BLACK, false };
+            break;
+        case BrightBackgroundBlue:
+            delta.background = TextColor{ BRIGHT_BLUE, false };
+            break;
+        case BrightBackgroundGreen:
+            delta.background = TextColor{ BRIGHT_GREEN, false };
+            break;
+        case BrightBackgroundCyan:
+            delta.background = TextColor{ BRIGHT_CYAN, false };
+            break;
+        case BrightBackgroundRed:
+            delta.background = TextColor{ BRIGHT_RED, false };
+            break;
+        case BrightBackgroundMagenta:
+            delta.background = TextColor{ BRIGHT_MAGENTA, false };
+            break;
+        case BrightBackgroundYellow:
+            delta.background = TextColor{ BRIGHT_YELLOW, false };
+            break;
+        case BrightBackgroundWhite:
+            delta.background = TextColor{ BRIGHT_WHITE, false };
+            break;
+        case ForegroundExtended:
+            i += s_CompileRgbColors(options.subspan(i + 1), delta, true);
+            break;
+        case BackgroundExtended:
+            i += s_CompileRgbColors(options.subspan(i + 1), delta, false);
+            break;
+        }
+    }
+
+    return delta;
+}
+
+// Routine Description:
+// - Gets the change that a list of SGR options makes, from the cache if it
+//   was seen recently, and compiles and caches it otherwise. Only the change
+//   is cached, never the resulting attributes, since those depend on the
+//   attributes the change is applied to.
+// Arguments:
+// - options - An array of SGR options.
+// Return Value:
+// - The flags to clear and set, and the colors to replace.
+TextAttributeDelta AdaptDispatch::_GetGraphicsRendition(const gsl::span<const DispatchTypes::GraphicsOptions> options) noexcept
+{
+    if (options.size() > MaxCachedGraphicsOptions)
+    {
+        return s_CompileGraphicsRendition(options);
+    }
+
+    for (size_t i = 0; i < _graphicsRenditionCacheUsed; i++)
+    {
+        const auto& cached = til::at(_graphicsRenditionCache, i);
+        if (cached.optionCount == options.size() &&
+            std::equal(options.begin(), options.end(), cached.options.begin()))
+        {
+            return cached.delta;
+        }
+    }
+
+    // Replace the entries in the order they were added, which keeps the
+    // lookup cheap and is good enough for the handful of renditions that
+    // applications tend to switch between.
+    auto& cached = til::at(_graphicsRenditionCache, _graphicsRenditionCacheNext);
+    std::copy(options.begin(), options.end(), cached.options.begin());
+    cached.optionCount = options.size();
+    cached.delta = s_CompileGraphicsRendition(options);
+
+    _graphicsRenditionCacheNext = (_graphicsRenditionCacheNext + 1) % _graphicsRenditionCache.size();
+    _graphicsRenditionCacheUsed = std::min(_graphicsRenditionCacheUsed + 1, _graphicsRenditionCache.size());
+    return cached.delta;
+}
+
 // Routine Description:
 // - SGR - Modifies the graphical rendering options applied to the next
 //   characters written into the buffer.
@@ -102,186 +323,7 @@ size_t AdaptDispatch::_SetRgbColorsHelper(const gsl::span<const DispatchTypes::G
 // - True if handled successfully. False otherwise.
 bool AdaptDispatch::SetGraphicsRendition(const gsl::span<const DispatchTypes::GraphicsOptions> options)
 {
-    TextAttribute attr;
-    bool success = _pConApi->PrivateGetTextAttributes(attr);
-
-    if (success)
-    {
-        // Run through the graphics options and apply them
-        for (size_t i = 0; i < options.size(); i++)
-        {
-            const auto opt = til::at(options, i);
-            switch (opt)
-            {
-            case Off:
-                attr.SetDefaultForeground();
-                attr.SetDefaultBackground();
-                attr.SetStandardErase();
-                break;
-            case ForegroundDefault:
-                attr.SetDefaultForeground();
-                break;
-            case BackgroundDefault:
-                attr.SetDefaultBackground();
-                break;
-            case BoldBright:
-                attr.SetBold(true);
-                break;
-            case RGBColorOrFaint:
-                attr.SetFaint(true);
-                break;
-            case NotBoldOrFaint:
-                attr.SetBold(false);
-                attr.SetFaint(false);
-                break;
-            case Italics:
-                attr.SetItalic(true);
-                break;
-            case NotItalics:
-                attr.SetItalic(false);
-                break;
-            case BlinkOrXterm256Index:
-                attr.SetBlinking(true);
-                break;
-            case Steady:
-                attr.SetBlinking(false);
-                break;
-            case Invisible:
-                attr.SetInvisible(true);
-                break;
-            case Visible:
-                attr.SetInvisible(false);
-                break;
-            case CrossedOut:
-                attr.SetCrossedOut(true);
-                break;
-            case NotCrossedOut:
-                attr.SetCrossedOut(false);
-                break;
-            case Negative:
-                attr.SetReverseVideo(true);
-                break;
-            case Positive:
-                attr.SetReverseVideo(false);
-                break;
-            case Underline:
-                attr.SetUnderlined(true);
-                break;
-            case NoUnderline:
-                attr.SetUnderlined(false);
-                break;
-            case Overline:
-                attr.SetOverlined(true);
-                break;
-            case NoOverline:
-                attr.SetOverlined(false);
-                break;
-            case ForegroundBlack:
-                attr.SetIndexedForeground(DARK_BLACK);
-                break;
-            case ForegroundBlue:
-                attr.SetIndexedForeground(DARK_BLUE);
-                break;
-            case ForegroundGreen:
-                attr.SetIndexedForeground(DARK_GREEN);
-                break;
-            case ForegroundCyan:
-                attr.SetIndexedForeground(DARK_CYAN);
-                break;
-            case ForegroundRed:
-                attr.SetIndexedForeground(DARK_RED);
-                break;
-            case ForegroundMagenta:
-                attr.SetIndexedForeground(DARK_MAGENTA);
-                break;
-            case ForegroundYellow:
-                attr.SetIndexedForeground(DARK_YELLOW);
-                break;
-            case ForegroundWhite:
-                attr.SetIndexedForeground(DARK_WHITE);
-                break;
-            case BackgroundBlack:
-                attr.SetIndexedBackground(DARK_BLACK);
-                break;
-            case BackgroundBlue:
-                attr.SetIndexedBackground(DARK_BLUE);
-                break;
-            case BackgroundGreen:
-                attr.SetIndexedBackground(DARK_GREEN);
-                break;
-            case BackgroundCyan:
-                attr.SetIndexedBackground(DARK_CYAN);
-                break;
-            case BackgroundRed:
-                attr.SetIndexedBackground(DARK_RED);
-                break;
-            case BackgroundMagenta:
-                attr.SetIndexedBackground(DARK_MAGENTA);
-                break;
-            case BackgroundYellow:
-                attr.SetIndexedBackground(DARK_YELLOW);
-                break;
-            case BackgroundWhite:
-                attr.SetIndexedBackground(DARK_WHITE);
-                break;
-            case BrightForegroundBlack:
-                attr.SetIndexedForeground(BRIGHT_BLACK);
-                break;
-            case BrightForegroundBlue:
-                attr.SetIndexedForeground(BRIGHT_BLUE);
-                break;
-            case BrightForegroundGreen:
-                attr.SetIndexedForeground(BRIGHT_GREEN);
-                break;
-            case BrightForegroundCyan:
-                attr.SetIndexedForeground(BRIGHT_CYAN);
-                break;
-            case BrightForegroundRed:
-                attr.SetIndexedForeground(BRIGHT_RED);
-                break;
-            case BrightForegroundMagenta:
-                attr.SetIndexedForeground(BRIGHT_MAGENTA);
-                break;
-            case BrightForegroundYellow:
-                attr.SetIndexedForeground(BRIGHT_YELLOW);
-                break;
-            case BrightForegroundWhite:
-                attr.SetIndexedForeground(BRIGHT_WHITE);
-                break;
-            case BrightBackgroundBlack:
-                attr.SetIndexedBackground(BRIGHT_BLACK);
-                break;
-            case BrightBackgroundBlue:
-                attr.SetIndexedBackground(BRIGHT_BLUE);
-                break;
-            case BrightBackgroundGreen:
-                attr.SetIndexedBackground(BRIGHT_GREEN);
-                break;
-            case BrightBackgroundCyan:
-                attr.SetIndexedBackground(BRIGHT_CYAN);
-                break;
-            case BrightBackgroundRed:
-                attr.SetIndexedBackground(BRIGHT_RED);
-                break;
-            case BrightBackgroundMagenta:
-                attr.SetIndexedBackground(BRIGHT_MAGENTA);
-                break;
-            case BrightBackgroundYellow:
-                attr.SetIndexedBackground(BRIGHT_YELLOW);
-                break;
-            case BrightBackgroundWhite:
-                attr.SetIndexedBackground(BRIGHT_WHITE);
-                break;
-            case ForegroundExtended:
-                i += _SetRgbColorsHelper(options.subspan(i + 1), attr, true);
-                break;
-            case BackgroundExtended:
-                i += _SetRgbColorsHelper(options.subspan(i + 1), attr, false);
-                break;
-            }
-        }
-        success = _pConApi->PrivateSetTextAttributes(attr);
-    }
-
-    return success;
+    // The options are compiled into a single change, which is applied to the
+    // current attributes in one call.
+    return _pConApi->PrivateModifyTextAttributes(_GetGraphicsRendition(options));
 }
@@ -34,13 +34,23 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool SetConsoleCursorInfo(const CONSOLE_CURSOR_INFO& cursorInfo) = 0;
         virtual bool SetConsoleCursorPosition(const COORD position) = 0;
 
+        virtual bool PrivateGetCursorPosition(COORD& position) const = 0;
+        virtual bool PrivateGetViewport(SMALL_RECT& viewport) const = 0;
+        virtual bool PrivateGetBufferSize(COORD& size) const = 0;
+
+        virtual bool PrivateBeginUpdateBatch() = 0;
+        virtual bool PrivateEndUpdateBatch() = 0;
+
         virtual bool PrivateIsVtInputEnabled() const = 0;
 
         virtual bool PrivateGetTextAttributes(TextAttribute& attrs) const = 0;
         virtual bool PrivateSetTextAttributes(const TextAttribute& attrs) = 0;
+        virtual bool PrivateModifyTextAttributes(const TextAttributeDelta& delta) = 0;
 
-        virtual bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+        virtual bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> records,
                                                size_t& eventsWritten) = 0;
+        virtual bool PrivateWriteConsoleInputText(const std::wstring_view text,
+                                                  size_t& charsWritten) = 0;
         virtual bool SetConsoleWindowInfo(const bool absolute,
                                           const SMALL_RECT& window) = 0;
         virtual bool PrivateSetCursorKeysMode(const bool applicationMode) = 0;
@@ -0,0 +1,252 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- tabStops.hpp
+
+Abstract:
+- Keeps track of the VT tab stops of a screen, one bit per column, packed
+    into 64-bit words. Finding the next or previous tab stop skips over whole
+    words without stops at a time, and finds the stop within a word without
+    walking its columns, so a tab costs the same however far apart the stops are.
+- This is header only, so that both the console's AdaptDispatch and the
+    Terminal's TerminalDispatch can use it without sharing the adapter library.
+--*/
+#pragma once
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    namespace TabStopsDetails
+    {
+        // A de Bruijn sequence, in which every 6-bit pattern occurs exactly
+        // once. Multiplying it by a power of two and taking the top 6 bits
+        // gives a unique index for each bit position.
+        constexpr uint64_t DeBruijn = 0x03f79d71b4cb0a89;
+
+        constexpr std::array<uint8_t, 64> MakeDeBruijnTable() noexcept
+        {
+            std::array<uint8_t, 64> table{};
+            for (uint8_t bit = 0; bit < 64; ++bit)
+            {
+                table[(DeBruijn << bit) >> 58] = bit;
+            }
+            return table;
+        }
+
+        constexpr auto DeBruijnTable = MakeDeBruijnTable();
+
+        // Returns the position of the lowest set bit of a non-zero word.
+        constexpr size_t LowestSetBit(const uint64_t word) noexcept
+        {
+            const auto lowest = word & (~word + 1);
+            return DeBruijnTable[(lowest * DeBruijn) >> 58];
+        }
+
+        // Returns the position of the highest set bit of a non-zero word.
+        constexpr size_t HighestSetBit(uint64_t word) noexcept
+        {
+            // Smear the highest bit into all the bits below it, then keep only it.
+            word |= word >> 1;
+            word |= word >> 2;
+            word |= word >> 4;
+            word |= word >> 8;
+            word |= word >> 16;
+            word |= word >> 32;
+            const auto highest = word ^ (word >> 1);
+            return DeBruijnTable[(highest * DeBruijn) >> 58];
+        }
+    }
+
+    class TabStops final
+    {
+    public:
+        // Routine Description:
+        // - Grows the table so it's large enough to support the given screen
+        //    width, placing the default tab stops in the newly allocated
+        //    columns, iff default tab stops haven't been cleared. The table
+        //    never shrinks, so that tab stops survive a narrower screen.
+        // Arguments:
+        // - width - the width of the screen buffer that we need to accommodate
+        void Resize(const size_t width)
+        {
+            if (width <= _width)
+            {
+                return;
+            }
+
+            _words.resize((width + BitsPerWord - 1) / BitsPerWord);
+            if (_initDefaultTabStops)
+            {
+                // 64 is a multiple of 8, so every word has its default stops in the same places.
+                constexpr uint64_t defaultStops = 0x0101010101010101;
+                for (auto index = _width / BitsPerWord; index < _words.size(); ++index)
+                {
+                    // Only touch the columns that are new to the table.
+                    const auto wordStart = index * BitsPerWord;
+                    auto newColumns = ~uint64_t{ 0 };
+                    if (_width > wordStart)
+                    {
+                        newColumns <<= _width - wordStart;
+                    }
+                    if (width < wordStart + BitsPerWord)
+                    {
+                        newColumns &= ~uint64_t{ 0 } >> (wordStart + BitsPerWord - width);
+                    }
+                    til::at(_words, index) |= defaultStops & newColumns;
+                }
+
+                // There's no default stop at the left edge of the screen.
+                if (_width == 0)
+                {
+                    til::at(_words, 0) &= ~uint64_t{ 1 };
+                }
+            }
+            _width = width;
+        }
+
+        // Routine Description:
+        // - Sets a tab stop. The table must already be large enough for it.
+        // Arguments:
+        // - column - the column to set the tab stop in
+        void Set(const size_t column)
+        {
+            THROW_HR_IF(E_INVALIDARG, column >= _width);
+            til::at(_words, column / BitsPerWord) |= _Bit(column);
+        }
+
+        // Routine Description:
+        // - Clears a tab stop, if there is one. The table must already be
+        //    large enough for it.
+        // Arguments:
+        // - column - the column to clear the tab stop from
+        void Clear(const size_t column)
+        {
+            THROW_HR_IF(E_INVALIDARG, column >= _width);
+            til::at(_words, column / BitsPerWord) &= ~_Bit(column);
+        }
+
+        // Routine Description:
+        // - Clears all tab stops, and stops the default ones from being placed
+        //    in columns that are added later.
+        void ClearAll() noexcept
+        {
+            _words.clear();
+            _width = 0;
+            _initDefaultTabStops = false;
+        }
+
+        // Routine Description:
+        // - Clears all tab stops, so the default ones are placed again the next
+        //    time the table is resized.
+        void Reset() noexcept
+        {
+            _words.clear();
+            _width = 0;
+            _initDefaultTabStops = true;
+        }
+
+        bool IsSet(const size_t column) const noexcept
+        {
+            return column < _width && (til::at(_words, column / BitsPerWord) & _Bit(column)) != 0;
+        }
+
+        // Routine Description:
+        // - Finds where a number of forward tabs take the cursor. Each one
+        //    moves it to the next tab stop, or to the right edge of the screen
+        //    if there are no more stops before it.
+        // Arguments:
+        // - column - the column the cursor starts in
+        // - count - the number of tabs to perform
+        // - width - the width of the screen
+        // Return Value:
+        // - the column the cursor ends up in
+        size_t Next(size_t column, size_t count, const size_t width) const noexcept
+        {
+            const auto lastColumn = width > 0 ? width - 1 : 0;
+            for (; count > 0 && column < lastColumn; --count)
+            {
+                column = _FindSetBit(column + 1, lastColumn).value_or(lastColumn);
+            }
+            return column;
+        }
+
+        // Routine Description:
+        // - Finds where a number of backward tabs take the cursor. Each one
+        //    moves it to the previous tab stop, or to the left edge of the
+        //    screen if there are no more stops after it.
+        // Arguments:
+        // - column - the column the cursor starts in
+        // - count - the number of tabs to perform
+        // Return Value:
+        // - the column the cursor ends up in
+        size_t Previous(size_t column, size_t count) const noexcept
+        {
+            for (; count > 0 && column > 0; --count)
+            {
+                column = _FindPreviousSetBit(column - 1).value_or(0);
+            }
+            return column;
+        }
+
+    private:
+        static constexpr size_t BitsPerWord = 64;
+
+        std::vector<uint64_t> _words;
+        size_t _width = 0;
+        bool _initDefaultTabStops = true;
+
+        static constexpr uint64_t _Bit(const size_t column) noexcept
+        {
+            return uint64_t{ 1 } << (column % BitsPerWord);
+        }
+
+        // Finds the first tab stop in the columns from first to last, inclusive.
+        std::optional<size_t> _FindSetBit(const size_t first, const size_t last) const noexcept
+        {
+            const auto end = std::min(last + 1, _width);
+            if (first >= end)
+            {
+                return std::nullopt;
+            }
+
+            const auto lastIndex = (end - 1) / BitsPerWord;
+            auto index = first / BitsPerWord;
+            auto word = til::at(_words, index) & (~uint64_t{ 0 } << (first % BitsPerWord));
+            while (word == 0)
+            {
+                if (index == lastIndex)
+                {
+                    return std::nullopt;
+                }
+                word = til::at(_words, ++index);
+            }
+
+            const auto column = index * BitsPerWord + TabStopsDetails::LowestSetBit(word);
+            return column < end ? std::optional<size_t>{ column } : std::nullopt;
+        }
+
+        // Finds the last tab stop in the columns from 0 to last, inclusive.
+        std::optional<size_t> _FindPreviousSetBit(const size_t last) const noexcept
+        {
+            if (_width == 0)
+            {
+                return std::nullopt;
+            }
+
+            const auto lastColumn = std::min(last, _width - 1);
+            auto index = lastColumn / BitsPerWord;
+            auto word = til::at(_words, index) & (~uint64_t{ 0 } >> (BitsPerWord - 1 - lastColumn % BitsPerWord));
+            while (word == 0)
+            {
+                if (index == 0)
+                {
+                    return std::nullopt;
+                }
+                word = til::at(_words, --index);
+            }
+
+            return index * BitsPerWord + TabStopsDetails::HighestSetBit(word);
+        }
+    };
+}
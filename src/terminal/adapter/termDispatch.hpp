@@ -72,6 +72,7 @@ public:
     bool EnableButtonEventMouseMode(const bool /*enabled*/) noexcept override { return false; } // ?1002
     bool EnableAnyEventMouseMode(const bool /*enabled*/) noexcept override { return false; } // ?1003
     bool EnableAlternateScroll(const bool /*enabled*/) noexcept override { return false; } // ?1007
+    bool EnableXtermBracketedPasteMode(const bool /*enabled*/) noexcept override { return false; } // ?2004
     bool SetColorTableEntry(const size_t /*tableIndex*/, const DWORD /*color*/) noexcept override { return false; } // OSCColorTable
     bool SetDefaultForeground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultForeground
     bool SetDefaultBackground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultBackground
@@ -111,4 +112,6 @@ public:
     // DTTERM_WindowManipulation
     bool WindowManipulation(const DispatchTypes::WindowManipulationType /*function*/,
                             const gsl::span<const size_t> /*params*/) noexcept override { return false; }
+
+    bool DispatchBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands) override { return _ReplayBatch(commands); }
 };
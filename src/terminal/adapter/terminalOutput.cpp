@@ -15,6 +15,7 @@ TerminalOutput::TerminalOutput() noexcept
     _gsetTranslationTables.at(1) = Ascii;
     _gsetTranslationTables.at(2) = Latin1;
     _gsetTranslationTables.at(3) = Latin1;
+    _UpdateTranslationTable();
 }
 
 bool TerminalOutput::Designate94Charset(size_t gsetNumber, const std::pair<wchar_t, wchar_t> charset)
@@ -131,6 +132,7 @@ bool TerminalOutput::LockingShift(const size_t gsetNumber)
     {
         _glTranslationTable = {};
     }
+    _UpdateTranslationTable();
     return true;
 }
 
@@ -144,6 +146,7 @@ bool TerminalOutput::LockingShiftRight(const size_t gsetNumber)
     {
         _grTranslationTable = {};
     }
+    _UpdateTranslationTable();
     return true;
 }
 
@@ -187,18 +190,89 @@ wchar_t TerminalOutput::TranslateKey(const wchar_t wch) const noexcept
         }
         _ssTranslationTable = {};
     }
-    else
+    else if (wch < _translationTable.size())
     {
-        if (wch - 0x20u < _glTranslationTable.size())
+        wchFound = til::at(_translationTable, wch);
+    }
+    return wchFound;
+}
+
+// Routine Description:
+// - Finds the first character in the given text that would be changed by
+//      translating it. Text is checked in blocks that are scanned without
+//      branching, so that the compiler can vectorize the check, and it's only
+//      looked at character by character once a block may need translating.
+// Arguments:
+// - text - The text to check.
+// Return Value:
+// - The index of the first character that has to be translated, or npos if
+//      the text can be printed as it is.
+size_t TerminalOutput::FindFirstTranslatedChar(const std::wstring_view text) const noexcept
+{
+    // A single shift applies to the first character, whatever it is.
+    if (!_ssTranslationTable.empty())
+    {
+        return text.empty() ? std::wstring_view::npos : 0;
+    }
+
+    if (_lastTranslatedChar < _firstTranslatedChar)
+    {
+        return std::wstring_view::npos;
+    }
+
+    const unsigned int translatedRange = _lastTranslatedChar - _firstTranslatedChar;
+    constexpr size_t blockSize = 16;
+
+    size_t i = 0;
+    for (; i + blockSize <= text.size(); i += blockSize)
+    {
+        bool mayTranslate = false;
+        for (size_t j = 0; j < blockSize; j++)
         {
-            wchFound = _glTranslationTable.at(wch - 0x20u);
+            mayTranslate |= static_cast<unsigned int>(til::at(text, i + j) - _firstTranslatedChar) <= translatedRange;
         }
-        else if (wch - 0xA0u < _grTranslationTable.size())
+        if (mayTranslate)
         {
-            wchFound = _grTranslationTable.at(wch - 0xA0u);
+            break;
+        }
+    }
+
+    for (; i < text.size(); i++)
+    {
+        const auto wch = til::at(text, i);
+        if (wch < _translationTable.size() && til::at(_translationTable, wch) != wch)
+        {
+            return i;
+        }
+    }
+    return std::wstring_view::npos;
+}
+
+// Routine Description:
+// - Translates the given text in place. This is the equivalent of calling
+//      TranslateKey for every character, including the single shift being
+//      applied to the first one only.
+// Arguments:
+// - text - The text to translate.
+// Return Value:
+// - <none>
+void TerminalOutput::TranslateString(const gsl::span<wchar_t> text) const noexcept
+{
+    auto it = text.begin();
+    if (!_ssTranslationTable.empty() && it != text.end())
+    {
+        *it = TranslateKey(*it);
+        ++it;
+    }
+
+    for (; it != text.end(); ++it)
+    {
+        const auto wch = *it;
+        if (wch < _translationTable.size())
+        {
+            *it = til::at(_translationTable, wch);
         }
     }
-    return wchFound;
 }
 
 bool TerminalOutput::_SetTranslationTable(const size_t gsetNumber, const std::wstring_view translationTable)
@@ -207,3 +281,35 @@ bool TerminalOutput::_SetTranslationTable(const size_t gsetNumber, const std::ws
     // We need to reapply the locking shifts in case the underlying G-sets have changed.
     return LockingShift(_glSetNumber) && LockingShiftRight(_grSetNumber);
 }
+
+// Routine Description:
+// - Combines the active GL and GR sets into the table used by TranslateKey and
+//      TranslateString, and works out which characters it actually changes.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TerminalOutput::_UpdateTranslationTable() noexcept
+{
+    for (size_t i = 0; i < _translationTable.size(); i++)
+    {
+        til::at(_translationTable, i) = gsl::narrow_cast<wchar_t>(i);
+    }
+    std::copy(_glTranslationTable.begin(), _glTranslationTable.end(), _translationTable.begin() + 0x20);
+    std::copy(_grTranslationTable.begin(), _grTranslationTable.end(), _translationTable.begin() + 0xA0);
+
+    // An empty range, unless something turns out to be translated below.
+    _firstTranslatedChar = 1;
+    _lastTranslatedChar = 0;
+    for (size_t i = 0; i < _translationTable.size(); i++)
+    {
+        if (til::at(_translationTable, i) != i)
+        {
+            if (_lastTranslatedChar < _firstTranslatedChar)
+            {
+                _firstTranslatedChar = gsl::narrow_cast<wchar_t>(i);
+            }
+            _lastTranslatedChar = gsl::narrow_cast<wchar_t>(i);
+        }
+    }
+}
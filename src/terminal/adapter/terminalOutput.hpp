@@ -26,6 +26,8 @@ namespace Microsoft::Console::VirtualTerminal
         TerminalOutput() noexcept;
 
         wchar_t TranslateKey(const wchar_t wch) const noexcept;
+        size_t FindFirstTranslatedChar(const std::wstring_view text) const noexcept;
+        void TranslateString(const gsl::span<wchar_t> text) const noexcept;
         bool Designate94Charset(const size_t gsetNumber, const std::pair<wchar_t, wchar_t> charset);
         bool Designate96Charset(const size_t gsetNumber, const std::pair<wchar_t, wchar_t> charset);
         bool LockingShift(const size_t gsetNumber);
@@ -36,6 +38,7 @@ namespace Microsoft::Console::VirtualTerminal
 
     private:
         bool _SetTranslationTable(const size_t gsetNumber, const std::wstring_view translationTable);
+        void _UpdateTranslationTable() noexcept;
 
         std::array<std::wstring_view, 4> _gsetTranslationTables;
         size_t _glSetNumber = 0;
@@ -44,5 +47,14 @@ namespace Microsoft::Console::VirtualTerminal
         std::wstring_view _grTranslationTable;
         mutable std::wstring_view _ssTranslationTable;
         boolean _grTranslationEnabled = false;
+
+        // The active GL and GR sets combined into a single table, indexed by
+        // the character to translate. Characters outside of it, and in it
+        // but outside of GL and GR, are never translated.
+        std::array<wchar_t, 256> _translationTable = {};
+        // The range of characters that the table actually changes, so that
+        // text without any of them can be skipped quickly.
+        wchar_t _firstTranslatedChar = 0;
+        wchar_t _lastTranslatedChar = 0;
     };
 }
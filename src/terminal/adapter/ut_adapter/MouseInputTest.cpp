@@ -633,4 +633,88 @@ public:
         mouseInput->EnableAlternateScroll(true);
         VERIFY_IS_FALSE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA));
     }
+
+    TEST_METHOD(CoalescingTests)
+    {
+        Log::Comment(L"Starting test...");
+        std::wstring written;
+        size_t writes = 0;
+        auto mouseInput = std::make_unique<TerminalInput>([&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+            for (const auto& event : events)
+            {
+                written.push_back(static_cast<const KeyEvent* const>(event.get())->GetCharData());
+            }
+            ++writes;
+        });
+        const short noModifierKeys = 0;
+
+        mouseInput->EnableAnyEventTracking(true);
+        mouseInput->SetSGRExtendedMode(true);
+        mouseInput->EnableMouseInputCoalescing(true);
+
+        Log::Comment(L"The first move of a frame is written right away.");
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 0, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_ARE_EQUAL(L"\x1b[<35;1;1m", std::wstring_view{ written });
+        VERIFY_IS_TRUE(mouseInput->NeedsMouseInputFlush());
+
+        Log::Comment(L"Later moves in the same frame only keep the latest position.");
+        written.clear();
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 1, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 2, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 3, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_ARE_EQUAL(0u, written.size());
+
+        mouseInput->FlushPendingMouseInput();
+        VERIFY_ARE_EQUAL(L"\x1b[<35;4;1m", std::wstring_view{ written });
+        VERIFY_IS_FALSE(mouseInput->NeedsMouseInputFlush());
+
+        Log::Comment(L"A button press writes the held move first, in the same write.");
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 4, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        written.clear();
+        writes = 0;
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 0 }, WM_LBUTTONDOWN, noModifierKeys, 0));
+        VERIFY_ARE_EQUAL(L"\x1b[<35;6;1m\x1b[<0;6;1M", std::wstring_view{ written });
+        VERIFY_ARE_EQUAL(1u, writes);
+        mouseInput->FlushPendingMouseInput();
+
+        Log::Comment(L"Wheel events in the same direction are all reported, but written together.");
+        written.clear();
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 5, 0 }, WM_MOUSEWHEEL, noModifierKeys, WHEEL_DELTA));
+        VERIFY_ARE_EQUAL(L"\x1b[<64;6;1M", std::wstring_view{ written });
+        written.clear();
+        writes = 0;
+        mouseInput->FlushPendingMouseInput();
+        VERIFY_ARE_EQUAL(L"\x1b[<64;6;1M\x1b[<64;6;1M", std::wstring_view{ written });
+        VERIFY_ARE_EQUAL(1u, writes);
+
+        Log::Comment(L"A held move is dropped if the application stops tracking the mouse.");
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 6, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 7, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        written.clear();
+        mouseInput->EnableAnyEventTracking(false);
+        mouseInput->FlushPendingMouseInput();
+        VERIFY_ARE_EQUAL(0u, written.size());
+
+        Log::Comment(L"So is a held move that the encoding the application switched to can't represent.");
+        mouseInput->EnableAnyEventTracking(true);
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 8, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        VERIFY_IS_TRUE(mouseInput->HandleMouse({ 100, 0 }, WM_MOUSEMOVE, noModifierKeys, 0));
+        written.clear();
+        mouseInput->SetSGRExtendedMode(false);
+        mouseInput->FlushPendingMouseInput();
+        VERIFY_ARE_EQUAL(0u, written.size());
+
+        const auto metrics = mouseInput->GetMouseInputMetrics();
+        Log::Comment(NoThrowString().Format(L"sent=%zu dropped=%zu merged=%zu writes=%zu",
+                                            metrics.eventsSent,
+                                            metrics.eventsDropped,
+                                            metrics.eventsMerged,
+                                            metrics.writes));
+        VERIFY_ARE_EQUAL(10u, metrics.eventsSent);
+        VERIFY_ARE_EQUAL(4u, metrics.eventsDropped);
+        VERIFY_ARE_EQUAL(1u, metrics.eventsMerged);
+    }
 };
@@ -6,6 +6,7 @@
 #include "..\..\inc\consoletaeftemplates.hpp"
 
 #include "adaptDispatch.hpp"
+#include "InteractDispatch.hpp"
 
 using namespace WEX::Common;
 using namespace WEX::Logging;
@@ -85,6 +86,59 @@ public:
         }
         return _setConsoleScreenBufferInfoExResult;
     }
+    // The narrow queries below return the same data as the matching fields of
+    // GetConsoleScreenBufferInfoEx, and fail along with it, so that tests of
+    // the failure paths don't depend on which of them the dispatcher uses.
+    bool PrivateGetCursorPosition(COORD& position) const override
+    {
+        Log::Comment(L"PrivateGetCursorPosition MOCK returning data...");
+
+        if (_getConsoleScreenBufferInfoExResult)
+        {
+            position = _cursorPos;
+        }
+
+        return _getConsoleScreenBufferInfoExResult;
+    }
+    bool PrivateGetViewport(SMALL_RECT& viewport) const override
+    {
+        Log::Comment(L"PrivateGetViewport MOCK returning data...");
+
+        if (_getConsoleScreenBufferInfoExResult)
+        {
+            viewport = _viewport;
+        }
+
+        return _getConsoleScreenBufferInfoExResult;
+    }
+    bool PrivateGetBufferSize(COORD& size) const override
+    {
+        Log::Comment(L"PrivateGetBufferSize MOCK returning data...");
+
+        if (_getConsoleScreenBufferInfoExResult)
+        {
+            size = _bufferSize;
+        }
+
+        return _getConsoleScreenBufferInfoExResult;
+    }
+    bool PrivateBeginUpdateBatch() override
+    {
+        Log::Comment(L"PrivateBeginUpdateBatch MOCK called...");
+
+        VERIFY_IS_FALSE(_inUpdateBatch);
+        _inUpdateBatch = true;
+        return true;
+    }
+    bool PrivateEndUpdateBatch() override
+    {
+        Log::Comment(L"PrivateEndUpdateBatch MOCK called...");
+
+        VERIFY_IS_TRUE(_inUpdateBatch);
+        _inUpdateBatch = false;
+        _updateBatchCount++;
+        return true;
+    }
     bool SetConsoleCursorPosition(const COORD position) override
     {
         Log::Comment(L"SetConsoleCursorPosition MOCK called...");
@@ -93,6 +147,10 @@ public:
         {
             VERIFY_ARE_EQUAL(_expectedCursorPos, position);
             _cursorPos = position;
+            if (_inUpdateBatch)
+            {
+                _cursorMovesInUpdateBatch++;
+            }
         }
 
         return _setConsoleCursorPositionResult;
@@ -249,19 +307,47 @@ public:
         return _privateSetTextAttributesResult;
     }
 
-    bool PrivateWriteConsoleInputW(std::deque<std::unique_ptr<IInputEvent>>& events,
+    bool PrivateModifyTextAttributes(const TextAttributeDelta& delta) override
+    {
+        Log::Comment(L"PrivateModifyTextAttributes MOCK called...");
+
+        // This stands in for a get and a set, so either of them can fail it.
+        TextAttribute attrs;
+        if (!PrivateGetTextAttributes(attrs))
+        {
+            return false;
+        }
+        attrs.ApplyDelta(delta);
+        return PrivateSetTextAttributes(attrs);
+    }
+
+    bool PrivateWriteConsoleInputW(const gsl::span<const INPUT_RECORD> records,
                                    size_t& eventsWritten) override
     {
         Log::Comment(L"PrivateWriteConsoleInputW MOCK called...");
 
         if (_privateWriteConsoleInputWResult)
         {
-            // move all the input events we were given into local storage so we can test against them
-            Log::Comment(NoThrowString().Format(L"Moving %zu input events into local storage...", events.size()));
+            // copy all the input records we were given into local storage so we can test against them
+            Log::Comment(NoThrowString().Format(L"Copying %zu input records into local storage...", records.size()));
 
-            _events.clear();
-            _events.swap(events);
+            _events = IInputEvent::Create(records);
             eventsWritten = _events.size();
+            _inputWriteSizes.push_back(records.size());
+        }
+
+        return _privateWriteConsoleInputWResult;
+    }
+
+    bool PrivateWriteConsoleInputText(const std::wstring_view text,
+                                      size_t& charsWritten) override
+    {
+        Log::Comment(L"PrivateWriteConsoleInputText MOCK called...");
+
+        if (_privateWriteConsoleInputWResult)
+        {
+            _textInput = text;
+            charsWritten = text.size();
         }
 
         return _privateWriteConsoleInputWResult;
@@ -616,7 +702,11 @@ public:
         _privatePrependConsoleInputResult = TRUE;
         _privateWriteConsoleControlInputResult = TRUE;
         _setConsoleWindowInfoResult = TRUE;
+        _inputWriteSizes.clear();
         _moveToBottomResult = true;
+        _inUpdateBatch = false;
+        _updateBatchCount = 0;
+        _cursorMovesInUpdateBatch = 0;
 
         _bufferSize.X = 100;
         _bufferSize.Y = 600;
@@ -726,6 +816,8 @@ public:
     static const WORD s_defaultFill = FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED; // dark gray on black.
 
     std::deque<std::unique_ptr<IInputEvent>> _events;
+    std::vector<size_t> _inputWriteSizes;
+    std::wstring _textInput;
 
     COORD _bufferSize = { 0, 0 };
     SMALL_RECT _viewport = { 0, 0, 0, 0 };
@@ -794,6 +886,9 @@ public:
     COLORREF _expectedCursorColor = 0;
     bool _getConsoleOutputCPResult = false;
     bool _moveToBottomResult = false;
+    bool _inUpdateBatch = false;
+    size_t _updateBatchCount = 0;
+    size_t _cursorMovesInUpdateBatch = 0;
 
     bool _privateGetColorTableEntryResult = false;
     bool _privateSetColorTableEntryResult = false;
@@ -1161,6 +1256,41 @@ public:
         VERIFY_IS_FALSE((_pDispatch.get()->*(moveFunc))(sVal));
     }
 
+    TEST_METHOD(DispatchBatchTest)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: All the commands of a batch are dispatched inside a single update batch.");
+        _testGetSet->PrepData(CursorX::RIGHT, CursorY::BOTTOM);
+
+        // Every move ends up at the top left of the viewport.
+        _testGetSet->_expectedCursorPos.X = 0;
+        _testGetSet->_expectedCursorPos.Y = _testGetSet->_viewport.Top;
+
+        using DispatchTypes::BatchedCommandType;
+        const std::vector<DispatchTypes::BatchedCommand> commands{
+            { BatchedCommandType::CursorPosition, 1, 1 },
+            { BatchedCommandType::SetGraphicsRendition },
+            { BatchedCommandType::PrintString, 0, 0, {}, L"text" },
+            { BatchedCommandType::CursorForward, 0 },
+            { BatchedCommandType::CursorHorizontalPositionAbsolute, 1 },
+        };
+
+        VERIFY_IS_TRUE(_pDispatch.get()->DispatchBatch(commands));
+        VERIFY_ARE_EQUAL(1u, _testGetSet->_updateBatchCount);
+        VERIFY_ARE_EQUAL(3u, _testGetSet->_cursorMovesInUpdateBatch);
+        VERIFY_IS_FALSE(_testGetSet->_inUpdateBatch);
+
+        Log::Comment(L"Test 2: A command that fails fails the batch, but the batch is still ended.");
+        _testGetSet->PrepData(CursorX::RIGHT, CursorY::BOTTOM);
+
+        _testGetSet->_setConsoleCursorPositionResult = FALSE;
+
+        VERIFY_IS_FALSE(_pDispatch.get()->DispatchBatch(commands));
+        VERIFY_ARE_EQUAL(1u, _testGetSet->_updateBatchCount);
+        VERIFY_IS_FALSE(_testGetSet->_inUpdateBatch);
+    }
+
     TEST_METHOD(CursorSaveRestoreTest)
     {
         Log::Comment(L"Starting test...");
@@ -1649,6 +1779,93 @@ public:
         VERIFY_IS_TRUE(_testGetSet->_attribute.IsBold());
     }
 
+    TEST_METHOD(GraphicsCacheTests)
+    {
+        Log::Comment(L"Starting test...");
+        _testGetSet->PrepData();
+
+        const DispatchTypes::GraphicsOptions boldRed[] = {
+            DispatchTypes::GraphicsOptions::BoldBright,
+            DispatchTypes::GraphicsOptions::ForegroundRed
+        };
+
+        Log::Comment(L"A cached rendition still applies to whatever the current attributes are.");
+        _testGetSet->_attribute = TextAttribute{ 0 };
+        _testGetSet->_attribute.SetUnderlined(true);
+        _testGetSet->_expectedAttribute = _testGetSet->_attribute;
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(boldRed));
+
+        _testGetSet->_attribute = TextAttribute{ 0 };
+        _testGetSet->_attribute.SetIndexedBackground(BACKGROUND_BLUE >> 4);
+        _testGetSet->_expectedAttribute = _testGetSet->_attribute;
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(boldRed));
+
+        Log::Comment(L"Later options still win over earlier ones.");
+        const DispatchTypes::GraphicsOptions boldThenReset[] = {
+            DispatchTypes::GraphicsOptions::BoldBright,
+            DispatchTypes::GraphicsOptions::Underline,
+            DispatchTypes::GraphicsOptions::Off,
+            DispatchTypes::GraphicsOptions::Underline
+        };
+        for (auto i = 0; i < 2; i++)
+        {
+            _testGetSet->_attribute = TextAttribute{ 0 };
+            _testGetSet->_attribute.SetItalic(true);
+            _testGetSet->_attribute.SetReverseVideo(true);
+            _testGetSet->_expectedAttribute = TextAttribute{};
+            _testGetSet->_expectedAttribute.SetUnderlined(true);
+            VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(boldThenReset));
+        }
+
+        Log::Comment(L"Renditions still work once they've been pushed out of the cache, and when they're too long to be cached.");
+        for (size_t index = 0; index < 64; index++)
+        {
+            const DispatchTypes::GraphicsOptions indexedColor[] = {
+                DispatchTypes::GraphicsOptions::ForegroundExtended,
+                DispatchTypes::GraphicsOptions::BlinkOrXterm256Index,
+                static_cast<DispatchTypes::GraphicsOptions>(index)
+            };
+            _testGetSet->_attribute = TextAttribute{ 0 };
+            _testGetSet->_expectedAttribute = TextAttribute{ 0 };
+            _testGetSet->_expectedAttribute.SetIndexedForeground256(gsl::narrow_cast<BYTE>(::Xterm256ToWindowsIndex(index)));
+            VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(indexedColor));
+        }
+
+        _testGetSet->_attribute = TextAttribute{ 0 };
+        _testGetSet->_expectedAttribute = TextAttribute{ 0 };
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(boldRed));
+
+        const DispatchTypes::GraphicsOptions longRendition[] = {
+            DispatchTypes::GraphicsOptions::BoldBright,
+            DispatchTypes::GraphicsOptions::Italics,
+            DispatchTypes::GraphicsOptions::Underline,
+            DispatchTypes::GraphicsOptions::Negative,
+            DispatchTypes::GraphicsOptions::CrossedOut,
+            DispatchTypes::GraphicsOptions::Overline,
+            DispatchTypes::GraphicsOptions::ForegroundExtended,
+            DispatchTypes::GraphicsOptions::RGBColorOrFaint,
+            static_cast<DispatchTypes::GraphicsOptions>(12),
+            static_cast<DispatchTypes::GraphicsOptions>(34),
+            static_cast<DispatchTypes::GraphicsOptions>(56)
+        };
+        _testGetSet->_attribute = TextAttribute{ 0 };
+        _testGetSet->_expectedAttribute = TextAttribute{ 0 };
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetItalic(true);
+        _testGetSet->_expectedAttribute.SetUnderlined(true);
+        _testGetSet->_expectedAttribute.SetReverseVideo(true);
+        _testGetSet->_expectedAttribute.SetCrossedOut(true);
+        _testGetSet->_expectedAttribute.SetOverlined(true);
+        _testGetSet->_expectedAttribute.SetForeground(RGB(12, 34, 56));
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition(longRendition));
+    }
+
     TEST_METHOD(DeviceStatusReportTests)
     {
         Log::Comment(L"Starting test...");
@@ -2085,6 +2302,62 @@ public:
         VERIFY_IS_FALSE(_pDispatch.get()->SetColorTableEntry(15, testColor));
     }
 
+    TEST_METHOD(BatchedInputIsCoalesced)
+    {
+        Log::Comment(L"Records written one at a time within a batch are coalesced the way the input buffer would.");
+
+        auto api = std::make_unique<TestGetSet>();
+        auto& getSet = *api;
+        getSet.PrepData();
+        InteractDispatch dispatch{ std::move(api) };
+
+        const auto mouseMove = [](const SHORT x, const SHORT y) {
+            INPUT_RECORD record{ 0 };
+            record.EventType = MOUSE_EVENT;
+            record.Event.MouseEvent.dwMousePosition = { x, y };
+            record.Event.MouseEvent.dwEventFlags = MOUSE_MOVED;
+            return record;
+        };
+        const auto key = [](const bool keyDown, const wchar_t wch) {
+            return KeyEvent{ keyDown, 1, 0x41, 0x1e, wch, 0 }.ToInputRecord();
+        };
+
+        dispatch.BeginInputBatch();
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ mouseMove(1, 1) }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ mouseMove(2, 2) }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ mouseMove(3, 3) }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ key(true, L'a'), key(false, L'a') }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ mouseMove(4, 4) }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ mouseMove(5, 5) }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ key(true, L'a') }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ key(true, L'a') }));
+        VERIFY_IS_TRUE(dispatch.WriteInput(std::array{ key(true, L'a') }));
+
+        size_t eventsWritten = 0;
+        VERIFY_IS_TRUE(dispatch.EndInputBatch(eventsWritten));
+
+        Log::Comment(L"The leading record is written on its own, so that the input buffer can still coalesce it.");
+        VERIFY_ARE_EQUAL(2u, getSet._inputWriteSizes.size());
+        VERIFY_ARE_EQUAL(1u, getSet._inputWriteSizes.at(0));
+        VERIFY_ARE_EQUAL(4u, getSet._inputWriteSizes.at(1));
+
+        Log::Comment(L"Coalesced records still count as written, like they do in the input buffer.");
+        VERIFY_ARE_EQUAL(10u, eventsWritten);
+
+        VERIFY_ARE_EQUAL(4u, getSet._events.size());
+        VERIFY_ARE_EQUAL(InputEventType::KeyEvent, getSet._events.at(0)->EventType());
+        VERIFY_ARE_EQUAL(InputEventType::KeyEvent, getSet._events.at(1)->EventType());
+
+        VERIFY_ARE_EQUAL(InputEventType::MouseEvent, getSet._events.at(2)->EventType());
+        const auto mouseEvent = static_cast<const MouseEvent*>(getSet._events.at(2).get());
+        VERIFY_ARE_EQUAL((COORD{ 5, 5 }), mouseEvent->GetPosition());
+
+        VERIFY_ARE_EQUAL(InputEventType::KeyEvent, getSet._events.at(3)->EventType());
+        const auto keyEvent = static_cast<const KeyEvent*>(getSet._events.at(3).get());
+        VERIFY_IS_TRUE(keyEvent->IsKeyDown());
+        VERIFY_ARE_EQUAL(3u, keyEvent->GetRepeatCount());
+    }
+
 private:
     TestGetSet* _testGetSet; // non-ownership pointer
     std::unique_ptr<AdaptDispatch> _pDispatch;
@@ -334,6 +334,10 @@ bool TerminalInput::HandleMouse(const COORD position,
     bool success = false;
     if (_ShouldSendAlternateScroll(button, delta))
     {
+        if (_pendingMouseEvent)
+        {
+            FlushPendingMouseInput();
+        }
         success = _SendAlternateScroll(delta);
     }
     else
@@ -368,47 +372,22 @@ bool TerminalInput::HandleMouse(const COORD position,
 
             if (success)
             {
-                std::wstring sequence;
-                switch (_mouseInputState.extendedMode)
+                success = _CanEncodeMouseEvent(position);
+                if (success)
                 {
-                case ExtendedMode::None:
-                    sequence = _GenerateDefaultSequence(position,
-                                                        realButton,
-                                                        isHover,
-                                                        modifierKeyState,
-                                                        delta);
-                    break;
-                case ExtendedMode::Utf8:
-                    sequence = _GenerateUtf8Sequence(position,
-                                                     realButton,
-                                                     isHover,
-                                                     modifierKeyState,
-                                                     delta);
-                    break;
-                case ExtendedMode::Sgr:
                     // For SGR encoding, if no physical buttons were pressed,
                     // then we want to handle hovers with WM_MOUSEMOVE.
                     // However, if we're dragging (WM_MOUSEMOVE with a button pressed),
                     //      then use that pressed button instead.
-                    sequence = _GenerateSGRSequence(position,
-                                                    physicalButtonPressed ? realButton : button,
-                                                    _isButtonDown(realButton), // Use realButton here, to properly get the up/down state
-                                                    isHover,
-                                                    modifierKeyState,
-                                                    delta);
-                    break;
-                case ExtendedMode::Urxvt:
-                default:
-                    success = false;
-                    break;
-                }
-
-                success = !sequence.empty();
-
-                if (success)
-                {
-                    _SendInputSequence(sequence);
-                    success = true;
+                    // Use realButton for the up/down state, to properly get it for drags.
+                    const MouseEvent event{ position,
+                                            realButton,
+                                            physicalButtonPressed ? realButton : button,
+                                            _isButtonDown(realButton),
+                                            isHover,
+                                            modifierKeyState,
+                                            delta };
+                    _ReportMouseEvent(event);
                 }
                 if (_mouseInputState.trackingMode == TrackingMode::ButtonEvent || _mouseInputState.trackingMode == TrackingMode::AnyEvent)
                 {
@@ -423,58 +402,264 @@ bool TerminalInput::HandleMouse(const COORD position,
 }
 
 // Routine Description:
-// - Generates a sequence encoding the mouse event according to the default scheme.
+// - Turns coalescing of mouse input on or off. While it's on, the caller is
+//   expected to call FlushPendingMouseInput once per frame whenever
+//   NeedsMouseInputFlush returns true; any-event tracking with a high-rate
+//   mouse then reports at most a couple of moves per frame.
+// - Turning it off writes whatever is pending.
+// Parameters:
+// - enable - true to coalesce mouse input.
+// Return value:
+// - <none>
+void TerminalInput::EnableMouseInputCoalescing(const bool enable)
+{
+    if (!enable)
+    {
+        FlushPendingMouseInput();
+    }
+    _coalesceMouseInput = enable;
+}
+
+// Routine Description:
+// - Relays if a frame of coalesced mouse input was started, and has to be
+//   ended with a call to FlushPendingMouseInput.
+// Parameters:
+// - <none>
+// Return value:
+// - true if FlushPendingMouseInput should be called at the end of the frame.
+bool TerminalInput::NeedsMouseInputFlush() const noexcept
+{
+    return _mouseFrameOpen;
+}
+
+// Routine Description:
+// - Ends the current frame of coalesced mouse input, writing the move or the
+//   wheel events that were held back. An event is dropped instead if the
+//   application stopped tracking the mouse in the meantime.
+// Parameters:
+// - <none>
+// Return value:
+// - <none>
+void TerminalInput::FlushPendingMouseInput()
+{
+    if (_pendingMouseEvent)
+    {
+        if (IsTrackingMouseInput())
+        {
+            _AppendMouseEvent(*_pendingMouseEvent, _pendingMouseRepeat);
+        }
+        else
+        {
+            _mouseMetrics.eventsDropped += _pendingMouseRepeat;
+        }
+        _pendingMouseEvent.reset();
+        _pendingMouseRepeat = 0;
+    }
+    _mouseFrameOpen = false;
+    _WriteMouseSequence();
+}
+
+// Routine Description:
+// - Returns how many mouse events were written, and how many were coalesced.
+// Parameters:
+// - <none>
+// Return value:
+// - the metrics, counted since this TerminalInput was created.
+TerminalInput::MouseInputMetrics TerminalInput::GetMouseInputMetrics() const noexcept
+{
+    return _mouseMetrics;
+}
+
+// Routine Description:
+// - Determines if a mouse event at the given position can be reported in the
+//   current extended mode.
+// Parameters:
+// - position - The windows coordinates (top,left = 0,0) of the mouse event
+// Return value:
+// - true if the position can be encoded.
+bool TerminalInput::_CanEncodeMouseEvent(const COORD position) const noexcept
+{
+    switch (_mouseInputState.extendedMode)
+    {
+    case ExtendedMode::None:
+        // In the default, non-extended encoding scheme, coordinates above 94 shouldn't be supported,
+        //   because (95+32+1)=128, which is not an ASCII character.
+        // There are more details in _AppendUtf8Sequence, but basically, we can't put anything above x80 into the input
+        //   stream without bash.exe trying to convert it into utf8, and generating extra bytes in the process.
+        return position.X <= s_MaxDefaultCoordinate && position.Y <= s_MaxDefaultCoordinate;
+    case ExtendedMode::Utf8:
+        return position.X <= (SHORT_MAX - 33) && position.Y <= (SHORT_MAX - 33);
+    case ExtendedMode::Sgr:
+        return true;
+    case ExtendedMode::Urxvt:
+    default:
+        return false;
+    }
+}
+
+// Routine Description:
+// - Reports a mouse event to the application. Without coalescing, it's
+//   written right away. With it, the first event of a frame is written right
+//   away, and moves and wheel events after it are held until the frame is
+//   flushed. Anything else writes the held event first, to keep the order.
+// Parameters:
+// - event - the event to report.
+// Return value:
+// - <none>
+void TerminalInput::_ReportMouseEvent(const MouseEvent& event)
+{
+    if (!_coalesceMouseInput)
+    {
+        _AppendMouseEvent(event, 1);
+        _WriteMouseSequence();
+        return;
+    }
+
+    const bool isWheel = _isWheelMsg(event.button);
+    if (_pendingMouseEvent)
+    {
+        auto& pending = *_pendingMouseEvent;
+        if (event.isHover && pending.isHover)
+        {
+            // Only the latest position matters to the application.
+            pending = event;
+            ++_mouseMetrics.eventsDropped;
+            return;
+        }
+
+        if (isWheel &&
+            pending.button == event.button &&
+            pending.modifierKeyState == event.modifierKeyState &&
+            Utils::Sign(pending.delta) == Utils::Sign(event.delta))
+        {
+            // Every notch still has to be reported, but they can all be
+            // written at once.
+            pending.position = event.position;
+            ++_pendingMouseRepeat;
+            ++_mouseMetrics.eventsMerged;
+            return;
+        }
+
+        _AppendMouseEvent(pending, _pendingMouseRepeat);
+        _pendingMouseEvent.reset();
+        _pendingMouseRepeat = 0;
+    }
+
+    if (_mouseFrameOpen && (event.isHover || isWheel))
+    {
+        _WriteMouseSequence();
+        _pendingMouseEvent = event;
+        _pendingMouseRepeat = 1;
+        return;
+    }
+
+    _mouseFrameOpen = true;
+    _AppendMouseEvent(event, 1);
+    _WriteMouseSequence();
+}
+
+// Routine Description:
+// - Encodes a mouse event according to the current extended mode, and appends
+//   it to the sequence that's going to be written next.
+// - An event that was held back by coalescing may no longer be encodable, if
+//   the application changed the extended mode in the meantime. It's dropped.
+// Parameters:
+// - event - the event to encode.
+// - count - the number of times to encode it. Used for wheel events.
+// Return value:
+// - <none>
+void TerminalInput::_AppendMouseEvent(const MouseEvent& event, const size_t count)
+{
+    if (!_CanEncodeMouseEvent(event.position))
+    {
+        _mouseMetrics.eventsDropped += count;
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        switch (_mouseInputState.extendedMode)
+        {
+        case ExtendedMode::None:
+            _AppendDefaultSequence(_mouseSequence, event.position, event.button, event.isHover, event.modifierKeyState, event.delta);
+            break;
+        case ExtendedMode::Utf8:
+            _AppendUtf8Sequence(_mouseSequence, event.position, event.button, event.isHover, event.modifierKeyState, event.delta);
+            break;
+        case ExtendedMode::Sgr:
+            _AppendSGRSequence(_mouseSequence, event.position, event.sgrButton, event.isDown, event.isHover, event.modifierKeyState, event.delta);
+            break;
+        case ExtendedMode::Urxvt:
+        default:
+            return;
+        }
+        ++_mouseMetrics.eventsSent;
+    }
+}
+
+// Routine Description:
+// - Writes the mouse sequences that were appended so far, if any. The buffer
+//   keeps its storage for the next ones.
+// Parameters:
+// - <none>
+// Return value:
+// - <none>
+void TerminalInput::_WriteMouseSequence()
+{
+    if (!_mouseSequence.empty())
+    {
+        _SendInputSequence(_mouseSequence);
+        _mouseSequence.clear();
+        ++_mouseMetrics.writes;
+    }
+}
+
+// Routine Description:
+// - Appends a sequence encoding the mouse event according to the default scheme.
 //     see http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-Mouse-Tracking
+// - The position must be encodable, see _CanEncodeMouseEvent.
 // Parameters:
+// - sequence - the sequence to append to.
 // - position - The windows coordinates (top,left = 0,0) of the mouse event
 // - button - the message to decode.
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta)
+// - <none>
+void TerminalInput::_AppendDefaultSequence(std::wstring& sequence,
+                                           const COORD position,
+                                           const unsigned int button,
+                                           const bool isHover,
+                                           const short modifierKeyState,
+                                           const short delta)
 {
-    // In the default, non-extended encoding scheme, coordinates above 94 shouldn't be supported,
-    //   because (95+32+1)=128, which is not an ASCII character.
-    // There are more details in _GenerateUtf8Sequence, but basically, we can't put anything above x80 into the input
-    //   stream without bash.exe trying to convert it into utf8, and generating extra bytes in the process.
-    if (position.X <= s_MaxDefaultCoordinate && position.Y <= s_MaxDefaultCoordinate)
-    {
-        const COORD vtCoords = _winToVTCoord(position);
-        const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
-        const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
-
-        std::wstring format{ L"\x1b[Mbxy" };
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
-    }
-
-    return {};
+    const COORD vtCoords = _winToVTCoord(position);
+    sequence.append(L"\x1b[M");
+    sequence.push_back(L' ' + gsl::narrow_cast<wchar_t>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta)));
+    sequence.push_back(gsl::narrow_cast<wchar_t>(_encodeDefaultCoordinate(vtCoords.X)));
+    sequence.push_back(gsl::narrow_cast<wchar_t>(_encodeDefaultCoordinate(vtCoords.Y)));
 }
 
 // Routine Description:
-// - Generates a sequence encoding the mouse event according to the UTF8 Extended scheme.
+// - Appends a sequence encoding the mouse event according to the UTF8 Extended scheme.
 //     see http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-Extended-coordinates
+// - The position must be encodable, see _CanEncodeMouseEvent.
 // Parameters:
+// - sequence - the sequence to append to.
 // - position - The windows coordinates (top,left = 0,0) of the mouse event
 // - button - the message to decode.
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
 // Return value:
-// - The generated sequence. Will be empty if we couldn't generate.
-std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta)
+// - <none>
+void TerminalInput::_AppendUtf8Sequence(std::wstring& sequence,
+                                        const COORD position,
+                                        const unsigned int button,
+                                        const bool isHover,
+                                        const short modifierKeyState,
+                                        const short delta)
 {
     // So we have some complications here.
     // The windows input stream is typically encoded as UTF16.
@@ -490,51 +675,40 @@ std::wstring TerminalInput::_GenerateUtf8Sequence(const COORD position,
     //   So bash would also need to change, but how could it tell the difference between them? no real good way.
     // I'm going to emit a utf16 encoded value for now. Besides, if a windows program really wants it, just use the SGR mode, which is unambiguous.
     // TODO: Followup once the UTF-8 input stack is ready, MSFT:8509613
-    if (position.X <= (SHORT_MAX - 33) && position.Y <= (SHORT_MAX - 33))
-    {
-        const COORD vtCoords = _winToVTCoord(position);
-        const short encodedX = _encodeDefaultCoordinate(vtCoords.X);
-        const short encodedY = _encodeDefaultCoordinate(vtCoords.Y);
-        std::wstring format{ L"\x1b[Mbxy" };
-        // The short cast is safe because we know s_WindowsButtonToXEncoding  never returns more than xff
-        format.at(3) = ' ' + gsl::narrow_cast<short>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta));
-        format.at(4) = encodedX;
-        format.at(5) = encodedY;
-        return format;
-    }
-
-    return {};
+    const COORD vtCoords = _winToVTCoord(position);
+    sequence.append(L"\x1b[M");
+    // The cast is safe because we know s_WindowsButtonToXEncoding never returns more than xff
+    sequence.push_back(L' ' + gsl::narrow_cast<wchar_t>(_windowsButtonToXEncoding(button, isHover, modifierKeyState, delta)));
+    sequence.push_back(gsl::narrow_cast<wchar_t>(_encodeDefaultCoordinate(vtCoords.X)));
+    sequence.push_back(gsl::narrow_cast<wchar_t>(_encodeDefaultCoordinate(vtCoords.Y)));
 }
 
 // Routine Description:
-// - Generates a sequence encoding the mouse event according to the SGR Extended scheme.
+// - Appends a sequence encoding the mouse event according to the SGR Extended scheme.
 //     see http://invisible-island.net/xterm/ctlseqs/ctlseqs.html#h2-Extended-coordinates
 // Parameters:
+// - sequence - the sequence to append to.
 // - position - The windows coordinates (top,left = 0,0) of the mouse event
 // - button - the message to decode. WM_MOUSEMOVE is used for mouse hovers with no buttons pressed.
 // - isDown - true iff a mouse button was pressed.
 // - isHover - true if the sequence is generated in response to a mouse hover
 // - modifierKeyState - the modifier keys pressed with this button
 // - delta - the amount that the scroll wheel changed (should be 0 unless button is a WM_MOUSE*WHEEL)
-// - ppwchSequence - On success, where to put the pointer to the generated sequence
-// - pcchLength - On success, where to put the length of the generated sequence
 // Return value:
-// - true if we were able to successfully generate a sequence.
-// On success, caller is responsible for delete[]ing *ppwchSequence.
-std::wstring TerminalInput::_GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta)
+// - <none>
+void TerminalInput::_AppendSGRSequence(std::wstring& sequence,
+                                       const COORD position,
+                                       const unsigned int button,
+                                       const bool isDown,
+                                       const bool isHover,
+                                       const short modifierKeyState,
+                                       const short delta)
 {
     // Format for SGR events is:
     // "\x1b[<%d;%d;%d;%c", xButton, x+1, y+1, fButtonDown? 'M' : 'm'
     const int xbutton = _windowsButtonToSGREncoding(button, isHover, modifierKeyState, delta);
 
-    auto format = wil::str_printf<std::wstring>(L"\x1b[<%d;%d;%d%c", xbutton, position.X + 1, position.Y + 1, isDown ? L'M' : L'm');
-
-    return format;
+    fmt::format_to(std::back_inserter(sequence), L"\x1b[<{};{};{}{}", xbutton, position.X + 1, position.Y + 1, isDown ? L'M' : L'm');
 }
 
 // Routine Description:
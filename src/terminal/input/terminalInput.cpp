@@ -276,6 +276,20 @@ void TerminalInput::ForceDisableWin32InputMode(const bool win32InputMode) noexce
     _forceDisableWin32InputMode = win32InputMode;
 }
 
+// Method Description:
+// - Sets a callback that's given the sequences we generate as text. Callers
+//   that only want the characters of the sequences, like a terminal writing
+//   them to its connection, can use this to skip the creation of a key event
+//   for every character.
+// Arguments:
+// - pfn: called with each sequence. The view is only valid during the call.
+// Return Value:
+// - <none>
+void TerminalInput::SetWriteSequenceCallback(std::function<void(const std::wstring_view)> pfn) noexcept
+{
+    _pfnWriteSequence.swap(pfn);
+}
+
 static const gsl::span<const TermKeyMap> _getKeyMapping(const KeyEvent& keyEvent,
                                                         const bool ansiMode,
                                                         const bool cursorApplicationMode,
@@ -527,6 +541,13 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
         return false;
     }
 
+    // Mouse input that's held back for coalescing has to be written before
+    // the key, so that the application sees them in the order they happened.
+    if (_pendingMouseEvent)
+    {
+        FlushPendingMouseInput();
+    }
+
     auto keyEvent = *static_cast<const KeyEvent* const>(pInEvent);
 
     // GH#4999 - If we're in win32-input mode, skip straight to doing that.
@@ -534,8 +555,8 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        Win32KeySequenceBuffer buffer;
+        _SendInputSequence(_GenerateWin32KeySequence(keyEvent, buffer));
         return true;
     }
 
@@ -725,6 +746,12 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     {
         try
         {
+            if (_pfnWriteSequence)
+            {
+                _pfnWriteSequence(sequence);
+                return;
+            }
+
             std::deque<std::unique_ptr<IInputEvent>> inputEvents;
             for (const auto& wch : sequence)
             {
@@ -740,12 +767,15 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
 }
 
 // Method Description:
-// - Synthesize a win32-input-mode sequence for the given keyevent.
+// - Synthesize a win32-input-mode sequence for the given keyevent. This is
+//   done for every key while win32-input-mode is on, so the sequence is
+//   written into a fixed size buffer rather than formatted into a string.
 // Arguments:
 // - key: the KeyEvent to serialize.
+// - buffer: receives the sequence.
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - the sequence, which points into buffer.
+std::wstring_view TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key, Win32KeySequenceBuffer& buffer) noexcept
 {
     // Sequences are formatted as follows:
     //
@@ -758,11 +788,48 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(L"\x1b[{};{};{};{};{};{}_",
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    size_t length = 0;
+    til::at(buffer, length++) = L'\x1b';
+    til::at(buffer, length++) = L'[';
+    _AppendDecimal(buffer, length, key.GetVirtualKeyCode());
+    til::at(buffer, length++) = L';';
+    _AppendDecimal(buffer, length, key.GetVirtualScanCode());
+    til::at(buffer, length++) = L';';
+    _AppendDecimal(buffer, length, key.GetCharData());
+    til::at(buffer, length++) = L';';
+    _AppendDecimal(buffer, length, key.IsKeyDown() ? 1 : 0);
+    til::at(buffer, length++) = L';';
+    _AppendDecimal(buffer, length, key.GetActiveModifierKeys());
+    til::at(buffer, length++) = L';';
+    _AppendDecimal(buffer, length, key.GetRepeatCount());
+    til::at(buffer, length++) = L'_';
+
+    return { buffer.data(), length };
+}
+
+// Routine Description:
+// - Appends the decimal representation of a number to a win32-input-mode
+//   sequence that's being generated.
+// Arguments:
+// - buffer: the sequence being generated.
+// - length: the length of the sequence so far. Updated to include the digits.
+// - value: the number to append.
+// Return Value:
+// - <none>
+void TerminalInput::_AppendDecimal(Win32KeySequenceBuffer& buffer, size_t& length, unsigned long value) noexcept
+{
+    // The digits come out least significant first, so collect them before
+    // writing them out in order. A DWORD has at most 10 of them.
+    std::array<wchar_t, 10> digits;
+    size_t count = 0;
+    do
+    {
+        til::at(digits, count++) = static_cast<wchar_t>(L'0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    while (count > 0)
+    {
+        til::at(buffer, length++) = til::at(digits, --count);
+    }
 }
@@ -41,7 +41,28 @@ namespace Microsoft::Console::VirtualTerminal
         void ChangeWin32InputMode(const bool win32InputMode) noexcept;
         void ForceDisableWin32InputMode(const bool win32InputMode) noexcept;
 
+        void SetWriteSequenceCallback(std::function<void(const std::wstring_view)> pfn) noexcept;
+
+        // The longest sequence win32-input-mode can produce:
+        // ESC [ Vk ; Sc ; Uc ; Kd ; Cs ; Rc _, with every parameter at its largest.
+        static constexpr size_t MaxWin32KeySequenceLength = 2 + 5 + 1 + 5 + 1 + 5 + 1 + 1 + 1 + 10 + 1 + 5 + 1;
+
 #pragma region MouseInput
+        // Counts of the mouse events that were reported to the application,
+        // of those that were folded into other events by coalescing, and of
+        // those that were held back by coalescing and then never written.
+        struct MouseInputMetrics
+        {
+            size_t eventsSent{ 0 }; // sequences written to the input
+            // Moves superseded by a later move in the same frame, and held
+            // events that couldn't be written anymore when the frame was
+            // flushed, because the application stopped tracking the mouse or
+            // switched to an encoding that can't represent them.
+            size_t eventsDropped{ 0 };
+            size_t eventsMerged{ 0 }; // wheel events written together with the previous one
+            size_t writes{ 0 }; // calls to the input callback
+        };
+
         // These methods are defined in mouseInput.cpp
         bool HandleMouse(const COORD position,
                          const unsigned int button,
@@ -49,6 +70,11 @@ namespace Microsoft::Console::VirtualTerminal
                          const short delta);
 
         bool IsTrackingMouseInput() const noexcept;
+
+        void EnableMouseInputCoalescing(const bool enable);
+        bool NeedsMouseInputFlush() const noexcept;
+        void FlushPendingMouseInput();
+        MouseInputMetrics GetMouseInputMetrics() const noexcept;
 #pragma endregion
 
 #pragma region MouseInputState Management
@@ -68,6 +94,10 @@ namespace Microsoft::Console::VirtualTerminal
     private:
         std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> _pfnWriteEvents;
 
+        // If set, sequences are written with this as text, instead of as a
+        // key event per character with _pfnWriteEvents.
+        std::function<void(const std::wstring_view)> _pfnWriteSequence;
+
         // storage location for the leading surrogate of a utf-16 surrogate pair
         std::optional<wchar_t> _leadingSurrogate;
 
@@ -81,7 +111,10 @@ namespace Microsoft::Console::VirtualTerminal
         void _SendNullInputSequence(const DWORD dwControlKeyState) const;
         void _SendInputSequence(const std::wstring_view sequence) const noexcept;
         void _SendEscapedInputSequence(const wchar_t wch) const;
-        static std::wstring _GenerateWin32KeySequence(const KeyEvent& key);
+
+        using Win32KeySequenceBuffer = std::array<wchar_t, MaxWin32KeySequenceLength>;
+        static std::wstring_view _GenerateWin32KeySequence(const KeyEvent& key, Win32KeySequenceBuffer& buffer) noexcept;
+        static void _AppendDecimal(Win32KeySequenceBuffer& buffer, size_t& length, unsigned long value) noexcept;
 
 #pragma region MouseInputState Management
         // These methods are defined in mouseInputState.cpp
@@ -116,22 +149,55 @@ namespace Microsoft::Console::VirtualTerminal
 #pragma endregion
 
 #pragma region MouseInput
-        static std::wstring _GenerateDefaultSequence(const COORD position,
-                                                     const unsigned int button,
-                                                     const bool isHover,
-                                                     const short modifierKeyState,
-                                                     const short delta);
-        static std::wstring _GenerateUtf8Sequence(const COORD position,
-                                                  const unsigned int button,
-                                                  const bool isHover,
-                                                  const short modifierKeyState,
-                                                  const short delta);
-        static std::wstring _GenerateSGRSequence(const COORD position,
-                                                 const unsigned int button,
-                                                 const bool isDown,
-                                                 const bool isHover,
-                                                 const short modifierKeyState,
-                                                 const short delta);
+        // A mouse event that's going to be reported, but hasn't been encoded yet.
+        struct MouseEvent
+        {
+            COORD position;
+            unsigned int button; // the button, with pressed buttons filled in for hovers
+            unsigned int sgrButton; // the button to encode in SGR mode
+            bool isDown;
+            bool isHover;
+            short modifierKeyState;
+            short delta;
+        };
+
+        // When coalescing is enabled, the first event of a frame is written
+        // right away. Moves and wheel events after it are held in
+        // _pendingMouseEvent until the frame is flushed: later moves replace
+        // earlier ones, and wheel events in the same direction are counted.
+        bool _coalesceMouseInput{ false };
+        bool _mouseFrameOpen{ false };
+        std::optional<MouseEvent> _pendingMouseEvent;
+        size_t _pendingMouseRepeat{ 0 };
+
+        // Reused for every mouse sequence, so that encoding doesn't allocate.
+        std::wstring _mouseSequence;
+        MouseInputMetrics _mouseMetrics;
+
+        bool _CanEncodeMouseEvent(const COORD position) const noexcept;
+        void _ReportMouseEvent(const MouseEvent& event);
+        void _AppendMouseEvent(const MouseEvent& event, const size_t count);
+        void _WriteMouseSequence();
+
+        static void _AppendDefaultSequence(std::wstring& sequence,
+                                           const COORD position,
+                                           const unsigned int button,
+                                           const bool isHover,
+                                           const short modifierKeyState,
+                                           const short delta);
+        static void _AppendUtf8Sequence(std::wstring& sequence,
+                                        const COORD position,
+                                        const unsigned int button,
+                                        const bool isHover,
+                                        const short modifierKeyState,
+                                        const short delta);
+        static void _AppendSGRSequence(std::wstring& sequence,
+                                       const COORD position,
+                                       const unsigned int button,
+                                       const bool isDown,
+                                       const bool isHover,
+                                       const short modifierKeyState,
+                                       const short delta);
 
         bool _ShouldSendAlternateScroll(const unsigned int button, const short delta) const noexcept;
         bool _SendAlternateScroll(const short delta) const noexcept;
@@ -50,6 +50,9 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool ActionSs3Dispatch(const wchar_t wch,
                                        const gsl::span<const size_t> parameters) = 0;
 
+        virtual void BeginProcessingString() = 0;
+        virtual void EndProcessingString() = 0;
+
         virtual bool ParseControlSequenceAfterSs3() const = 0;
         virtual bool FlushAtEndOfString() const = 0;
         virtual bool DispatchControlCharsFromEscape() const = 0;
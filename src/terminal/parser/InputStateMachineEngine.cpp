@@ -34,11 +34,6 @@ static constexpr std::array<CsiToVkey, 10> s_csiMap = {
     CsiToVkey{ CsiActionCodes::CSI_F4, VK_F4 }
 };
 
-static bool operator==(const CsiToVkey& pair, const CsiActionCodes code) noexcept
-{
-    return pair.action == code;
-}
-
 struct GenericToVkey
 {
     GenericKeyIdentifiers identifier;
@@ -62,11 +57,6 @@ static constexpr std::array<GenericToVkey, 14> s_genericMap = {
     GenericToVkey{ GenericKeyIdentifiers::F12, VK_F12 },
 };
 
-static bool operator==(const GenericToVkey& pair, const GenericKeyIdentifiers identifier) noexcept
-{
-    return pair.identifier == identifier;
-}
-
 struct Ss3ToVkey
 {
     Ss3ActionCodes action;
@@ -86,11 +76,47 @@ static constexpr std::array<Ss3ToVkey, 10> s_ss3Map = {
     Ss3ToVkey{ Ss3ActionCodes::SS3_F4, VK_F4 },
 };
 
-static bool operator==(const Ss3ToVkey& pair, const Ss3ActionCodes code) noexcept
+// The maps above are turned into tables at compile time, so that decoding a
+// key is a single lookup instead of a search. Every CSI and SS3 final
+// character is below 0x80, and every generic key identifier is below 32, so
+// the tables are indexed directly by those. A zero entry means that there's
+// no key for that index.
+static constexpr size_t FinalCharTableSize = 0x80;
+static constexpr size_t GenericTableSize = 32;
+
+template<typename Map>
+static constexpr std::array<short, FinalCharTableSize> s_MakeFinalCharTable(const Map& map) noexcept
 {
-    return pair.action == code;
+    std::array<short, FinalCharTableSize> table{};
+    for (const auto& pair : map)
+    {
+        til::at(table, static_cast<size_t>(pair.action)) = pair.vkey;
+    }
+    return table;
+}
+
+static constexpr std::array<short, GenericTableSize> s_MakeGenericTable() noexcept
+{
+    std::array<short, GenericTableSize> table{};
+    for (const auto& pair : s_genericMap)
+    {
+        til::at(table, static_cast<size_t>(pair.identifier)) = pair.vkey;
+    }
+    return table;
 }
 
+static constexpr auto s_csiTable = s_MakeFinalCharTable(s_csiMap);
+static constexpr auto s_ss3Table = s_MakeFinalCharTable(s_ss3Map);
+static constexpr auto s_genericTable = s_MakeGenericTable();
+
+static_assert(til::at(s_csiTable, L'A') == VK_UP);
+static_assert(til::at(s_ss3Table, L'P') == VK_F1);
+static_assert(til::at(s_genericTable, 24) == VK_F12);
+
+// VkKeyScanW doesn't return 0 for any character we've seen. If it ever does,
+// that character simply isn't cached.
+static constexpr short KeyScanNotCached = 0;
+
 InputStateMachineEngine::InputStateMachineEngine(std::unique_ptr<IInteractDispatch> pDispatch) :
     InputStateMachineEngine(std::move(pDispatch), false)
 {
@@ -277,12 +303,13 @@ bool InputStateMachineEngine::ActionPassThroughString(const std::wstring_view st
         {
             try
             {
-                std::deque<std::unique_ptr<IInputEvent>> inputEvents;
+                std::vector<INPUT_RECORD> inputRecords;
+                inputRecords.reserve(string.size());
                 for (const auto& wch : string)
                 {
-                    inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
+                    inputRecords.push_back(KeyEvent{ true, 1ui16, 0ui16, 0ui16, wch, 0 }.ToInputRecord());
                 }
-                return _pDispatch->WriteInput(inputEvents);
+                return _pDispatch->WriteInput(inputRecords);
             }
             catch (...)
             {
@@ -746,9 +773,8 @@ bool InputStateMachineEngine::_WriteSingleKey(const wchar_t wch, const short vke
     // At most 8 records - 2 for each of shift,ctrl,alt up and down, and 2 for the actual key up and down.
     std::vector<INPUT_RECORD> input;
     _GenerateWrappedSequence(wch, vkey, modifierState, input);
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(input));
 
-    return _pDispatch->WriteInput(inputEvents);
+    return _pDispatch->WriteInput(input);
 }
 
 // Method Description:
@@ -786,10 +812,9 @@ bool InputStateMachineEngine::_WriteMouseEvent(const size_t column, const size_t
     rgInput.Event.MouseEvent.dwControlKeyState = controlKeyState;
     rgInput.Event.MouseEvent.dwEventFlags = eventFlags;
 
-    // pack and write input record
+    // write input record
     // 1 record - the modifiers don't get their own events
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents = IInputEvent::Create(gsl::make_span(&rgInput, 1));
-    return _pDispatch->WriteInput(inputEvents);
+    return _pDispatch->WriteInput(gsl::make_span(&rgInput, 1));
 }
 
 // Method Description:
@@ -1024,7 +1049,7 @@ bool InputStateMachineEngine::_UpdateSGRMouseButtonState(const wchar_t wch,
 // - vkey: Receives the vkey
 // Return Value:
 // true iff we found the key
-bool InputStateMachineEngine::_GetGenericVkey(const gsl::span<const size_t> parameters, short& vkey) const
+bool InputStateMachineEngine::_GetGenericVkey(const gsl::span<const size_t> parameters, short& vkey) const noexcept
 {
     vkey = 0;
     if (parameters.empty())
@@ -1032,16 +1057,13 @@ bool InputStateMachineEngine::_GetGenericVkey(const gsl::span<const size_t> para
         return false;
     }
 
-    const auto identifier = (GenericKeyIdentifiers)til::at(parameters, 0);
-
-    const auto mapping = std::find(s_genericMap.cbegin(), s_genericMap.cend(), identifier);
-    if (mapping != s_genericMap.end())
+    const auto identifier = til::at(parameters, 0);
+    if (identifier < s_genericTable.size())
     {
-        vkey = mapping->vkey;
-        return true;
+        vkey = til::at(s_genericTable, identifier);
     }
 
-    return false;
+    return vkey != 0;
 }
 
 // Method Description:
@@ -1051,18 +1073,17 @@ bool InputStateMachineEngine::_GetGenericVkey(const gsl::span<const size_t> para
 // - vkey: Receives the vkey
 // Return Value:
 // true iff we found the key
-bool InputStateMachineEngine::_GetCursorKeysVkey(const wchar_t wch, short& vkey) const
+bool InputStateMachineEngine::_GetCursorKeysVkey(const wchar_t wch, short& vkey) const noexcept
 {
     vkey = 0;
 
-    const auto mapping = std::find(s_csiMap.cbegin(), s_csiMap.cend(), (CsiActionCodes)wch);
-    if (mapping != s_csiMap.end())
+    const auto index = static_cast<size_t>(wch);
+    if (index < s_csiTable.size())
     {
-        vkey = mapping->vkey;
-        return true;
+        vkey = til::at(s_csiTable, index);
     }
 
-    return false;
+    return vkey != 0;
 }
 
 // Method Description:
@@ -1072,18 +1093,17 @@ bool InputStateMachineEngine::_GetCursorKeysVkey(const wchar_t wch, short& vkey)
 // - pVkey: Receives the vkey
 // Return Value:
 // true iff we found the key
-bool InputStateMachineEngine::_GetSs3KeysVkey(const wchar_t wch, short& vkey) const
+bool InputStateMachineEngine::_GetSs3KeysVkey(const wchar_t wch, short& vkey) const noexcept
 {
     vkey = 0;
 
-    const auto mapping = std::find(s_ss3Map.cbegin(), s_ss3Map.cend(), (Ss3ActionCodes)wch);
-    if (mapping != s_ss3Map.end())
+    const auto index = static_cast<size_t>(wch);
+    if (index < s_ss3Table.size())
     {
-        vkey = mapping->vkey;
-        return true;
+        vkey = til::at(s_ss3Table, index);
     }
 
-    return false;
+    return vkey != 0;
 }
 
 // Method Description:
@@ -1099,7 +1119,7 @@ bool InputStateMachineEngine::_GenerateKeyFromChar(const wchar_t wch,
                                                    DWORD& modifierState) noexcept
 {
     // Low order byte is key, high order is modifiers
-    const short keyscan = VkKeyScanW(wch);
+    const short keyscan = _KeyScan(wch);
 
     short key = LOBYTE(keyscan);
 
@@ -1122,6 +1142,64 @@ bool InputStateMachineEngine::_GenerateKeyFromChar(const wchar_t wch,
     return true;
 }
 
+// Method Description:
+// - Gets the vkey and the shift state that type a character on the active
+//   keyboard layout, like VkKeyScanW. The results for ASCII characters are
+//   cached until the keyboard layout changes.
+// Arguments:
+// - wch: the wchar_t to look up.
+// Return Value:
+// - the same value VkKeyScanW returns.
+short InputStateMachineEngine::_KeyScan(const wchar_t wch) noexcept
+{
+#ifdef BUILD_ONECORE_INTERACTIVITY
+    // The keyboard layout belongs to the console IO server here, and we can't
+    // tell when it changes, so don't cache anything.
+    return VkKeyScanW(wch);
+#else
+    const auto index = static_cast<size_t>(wch);
+    if (index >= _asciiKeyScans.size())
+    {
+        return VkKeyScanW(wch);
+    }
+
+    const auto layout = GetKeyboardLayout(0);
+    if (layout != _keyScanLayout)
+    {
+        _asciiKeyScans.fill(KeyScanNotCached);
+        _keyScanLayout = layout;
+    }
+
+    auto& keyScan = til::at(_asciiKeyScans, index);
+    if (keyScan == KeyScanNotCached)
+    {
+        keyScan = VkKeyScanW(wch);
+    }
+    return keyScan;
+#endif
+}
+
+// Method Description:
+// - Called before the state machine starts processing a string. Input is
+//      always dispatched as soon as it's decoded, so there's nothing to do.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputStateMachineEngine::BeginProcessingString() noexcept
+{
+}
+
+// Method Description:
+// - Called once the state machine is done processing a string.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void InputStateMachineEngine::EndProcessingString() noexcept
+{
+}
+
 // Method Description:
 // - Returns true if the engine should attempt to parse a control sequence
 //      following an SS3 escape prefix.
@@ -1317,13 +1395,15 @@ bool InputStateMachineEngine::_GetSGRXYPosition(const gsl::span<const size_t> pa
 
 // Method Description:
 // - Attempt to parse our parameters into a win32-input-mode serialized KeyEvent.
+//   This runs for every key while win32-input-mode is on: it only reads the
+//   parameters the state machine already parsed, and must never allocate.
 // Arguments:
 // - parameters: the list of numbers to parse into values for the KeyEvent.
 // - key: receives the values of the deserialized KeyEvent.
 // Return Value:
 // - true if we successfully parsed the key event.
 bool InputStateMachineEngine::_GenerateWin32Key(const gsl::span<const size_t> parameters,
-                                                KeyEvent& key)
+                                                KeyEvent& key) noexcept
 {
     // Sequences are formatted as follows:
     //
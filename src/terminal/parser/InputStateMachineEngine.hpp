@@ -167,6 +167,9 @@ namespace Microsoft::Console::VirtualTerminal
         bool ActionSs3Dispatch(const wchar_t wch,
                                const gsl::span<const size_t> parameters) override;
 
+        void BeginProcessingString() noexcept override;
+        void EndProcessingString() noexcept override;
+
         bool ParseControlSequenceAfterSs3() const noexcept override;
         bool FlushAtEndOfString() const noexcept override;
         bool DispatchControlCharsFromEscape() const noexcept override;
@@ -180,10 +183,16 @@ namespace Microsoft::Console::VirtualTerminal
         bool _lookingForDSR;
         DWORD _mouseButtonState = 0;
 
+        // VkKeyScanW results for ASCII characters, for the keyboard layout
+        // they were looked up with. See _KeyScan.
+        std::array<short, 0x80> _asciiKeyScans{};
+        HKL _keyScanLayout{ nullptr };
+
         DWORD _GetCursorKeysModifierState(const gsl::span<const size_t> parameters, const CsiActionCodes actionCode) noexcept;
         DWORD _GetGenericKeysModifierState(const gsl::span<const size_t> parameters) noexcept;
         DWORD _GetSGRMouseModifierState(const gsl::span<const size_t> parameters) noexcept;
         bool _GenerateKeyFromChar(const wchar_t wch, short& vkey, DWORD& modifierState) noexcept;
+        short _KeyScan(const wchar_t wch) noexcept;
 
         bool _IsModified(const size_t paramCount) noexcept;
         DWORD _GetModifier(const size_t parameter) noexcept;
@@ -193,9 +202,9 @@ namespace Microsoft::Console::VirtualTerminal
                                         DWORD& buttonState,
                                         DWORD& eventFlags) noexcept;
         bool _GetGenericVkey(const gsl::span<const size_t> parameters,
-                             short& vkey) const;
-        bool _GetCursorKeysVkey(const wchar_t wch, short& vkey) const;
-        bool _GetSs3KeysVkey(const wchar_t wch, short& vkey) const;
+                             short& vkey) const noexcept;
+        bool _GetCursorKeysVkey(const wchar_t wch, short& vkey) const noexcept;
+        bool _GetSs3KeysVkey(const wchar_t wch, short& vkey) const noexcept;
 
         bool _WriteSingleKey(const short vkey, const DWORD modifierState);
         bool _WriteSingleKey(const wchar_t wch, const short vkey, const DWORD modifierState);
@@ -215,7 +224,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool _GetWindowManipulationType(const gsl::span<const size_t> parameters,
                                         unsigned int& function) const noexcept;
 
-        bool _GenerateWin32Key(const gsl::span<const size_t> parameters, KeyEvent& key);
+        bool _GenerateWin32Key(const gsl::span<const size_t> parameters, KeyEvent& key) noexcept;
 
         static constexpr size_t DefaultLine = 1;
         static constexpr size_t DefaultColumn = 1;
@@ -17,7 +17,9 @@ OutputStateMachineEngine::OutputStateMachineEngine(std::unique_ptr<ITermDispatch
     _dispatch(std::move(pDispatch)),
     _pfnFlushToTerminal(nullptr),
     _pTtyConnection(nullptr),
-    _lastPrintedChar(AsciiChars::NUL)
+    _lastPrintedChar(AsciiChars::NUL),
+    _batchDispatch(false),
+    _batching(false)
 {
     THROW_HR_IF_NULL(E_INVALIDARG, _dispatch.get());
 }
@@ -41,6 +43,8 @@ ITermDispatch& OutputStateMachineEngine::Dispatch() noexcept
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionExecute(const wchar_t wch)
 {
+    _FlushBatch();
+
     switch (wch)
     {
     case AsciiChars::NUL:
@@ -118,6 +122,7 @@ bool OutputStateMachineEngine::ActionPrint(const wchar_t wch)
         _lastPrintedChar = wch;
     }
 
+    _FlushBatch();
     _dispatch->Print(wch); // call print
 
     return true;
@@ -143,7 +148,14 @@ bool OutputStateMachineEngine::ActionPrintString(const std::wstring_view string)
         _lastPrintedChar = wch;
     }
 
-    _dispatch->PrintString(string); // call print
+    if (_batching)
+    {
+        _AddToBatch({ DispatchTypes::BatchedCommandType::PrintString, 0, 0, {}, string });
+    }
+    else
+    {
+        _dispatch->PrintString(string); // call print
+    }
 
     return true;
 }
@@ -162,6 +174,8 @@ bool OutputStateMachineEngine::ActionPrintString(const std::wstring_view string)
 // - true iff we successfully dispatched the sequence.
 bool OutputStateMachineEngine::ActionPassThroughString(const std::wstring_view string)
 {
+    _FlushBatch();
+
     bool success = true;
     if (_pTtyConnection != nullptr)
     {
@@ -186,6 +200,8 @@ bool OutputStateMachineEngine::ActionPassThroughString(const std::wstring_view s
 bool OutputStateMachineEngine::ActionEscDispatch(const wchar_t wch,
                                                  const gsl::span<const wchar_t> intermediates)
 {
+    _FlushBatch();
+
     bool success = false;
 
     // no intermediates.
@@ -320,6 +336,8 @@ bool OutputStateMachineEngine::ActionVt52EscDispatch(const wchar_t wch,
                                                      const gsl::span<const wchar_t> intermediates,
                                                      const gsl::span<const size_t> parameters)
 {
+    _FlushBatch();
+
     bool success = false;
 
     // no intermediates.
@@ -544,6 +562,16 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const wchar_t wch,
             break;
         }
 
+        // Cursor movements and renditions can be held back, so that they're
+        // dispatched together with the text around them.
+        if (success && _batching && _BatchCsiDispatch(wch, distance, line, column))
+        {
+            _ClearLastChar();
+            return true;
+        }
+
+        _FlushBatch();
+
         // if param filling successful, try to dispatch
         if (success)
         {
@@ -695,6 +723,8 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const wchar_t wch,
     }
     else if (intermediates.size() == 1)
     {
+        _FlushBatch();
+
         const auto value = til::at(intermediates, 0);
         switch (value)
         {
@@ -921,6 +951,8 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
                                                  const size_t parameter,
                                                  const std::wstring_view string)
 {
+    _FlushBatch();
+
     bool success = false;
     std::wstring title;
     std::wstring setClipboardContent;
@@ -1878,6 +1910,182 @@ void OutputStateMachineEngine::SetTerminalConnection(ITerminalOutputConnection*
     this->_pfnFlushToTerminal = pfnFlushToTerminal;
 }
 
+// Routine Description:
+// - Enables or disables batched dispatch. While it's enabled, cursor movements,
+//      renditions and runs of text are collected while a string is processed,
+//      and handed to the dispatcher together with ITermDispatch::DispatchBatch.
+//      Anything else dispatches what was collected before it, so the order
+//      in which things happen doesn't change.
+// - Nothing is batched while there's a terminal attached, since then whether a
+//      sequence is passed through depends on whether it was dispatched
+//      successfully, and that has to be known right away.
+// Arguments:
+// - enabled - true to collect commands into batches.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::SetBatchDispatch(const bool enabled) noexcept
+{
+    _batchDispatch = enabled;
+}
+
+// Routine Description:
+// - Called before the state machine starts processing a string. Decides
+//      whether commands are batched while this string is processed.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::BeginProcessingString() noexcept
+{
+    _batching = _batchDispatch && _pTtyConnection == nullptr && _pfnFlushToTerminal == nullptr;
+
+    // If the last string failed to be processed, anything left over refers to
+    // text that's gone by now.
+    _batch.clear();
+    _batchGraphicsOptions.clear();
+    _batchGraphicsRanges.clear();
+}
+
+// Routine Description:
+// - Called once the state machine is done processing a string, even if that
+//      failed. Dispatches whatever is left in the batch, since the text it
+//      refers to belongs to the string.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::EndProcessingString() noexcept
+{
+    _batching = false;
+
+    try
+    {
+        _FlushBatch();
+    }
+    CATCH_LOG();
+}
+
+// Routine Description:
+// - Adds a CSI sequence to the batch, if it's one that can be batched.
+// Arguments:
+// - wch - the final character of the sequence.
+// - distance - the distance, column or line parsed for a cursor movement.
+// - line - the line parsed for a CUP.
+// - column - the column parsed for a CUP.
+// Return Value:
+// - True if the sequence was added to the batch. False if it has to be
+//      dispatched on its own.
+bool OutputStateMachineEngine::_BatchCsiDispatch(const wchar_t wch,
+                                                 const size_t distance,
+                                                 const size_t line,
+                                                 const size_t column)
+{
+    DispatchTypes::BatchedCommand command{};
+    command.distance = distance;
+
+    switch (wch)
+    {
+    case VTActionCodes::CUU_CursorUp:
+        command.type = DispatchTypes::BatchedCommandType::CursorUp;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUU);
+        break;
+    case VTActionCodes::CUD_CursorDown:
+        command.type = DispatchTypes::BatchedCommandType::CursorDown;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUD);
+        break;
+    case VTActionCodes::CUF_CursorForward:
+        command.type = DispatchTypes::BatchedCommandType::CursorForward;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUF);
+        break;
+    case VTActionCodes::CUB_CursorBackward:
+        command.type = DispatchTypes::BatchedCommandType::CursorBackward;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUB);
+        break;
+    case VTActionCodes::CHA_CursorHorizontalAbsolute:
+    case VTActionCodes::HPA_HorizontalPositionAbsolute:
+        command.type = DispatchTypes::BatchedCommandType::CursorHorizontalPositionAbsolute;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CHA);
+        break;
+    case VTActionCodes::VPA_VerticalLinePositionAbsolute:
+        command.type = DispatchTypes::BatchedCommandType::VerticalLinePositionAbsolute;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::VPA);
+        break;
+    case VTActionCodes::CUP_CursorPosition:
+    case VTActionCodes::HVP_HorizontalVerticalPosition:
+        command.type = DispatchTypes::BatchedCommandType::CursorPosition;
+        command.distance = line;
+        command.column = column;
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::CUP);
+        break;
+    case VTActionCodes::SGR_SetGraphicsRendition:
+        // The options of every rendition in the batch are kept together, and
+        // may move as more are added. Until the batch is dispatched, only
+        // where its options start and how many there are is recorded.
+        command.type = DispatchTypes::BatchedCommandType::SetGraphicsRendition;
+        _batchGraphicsRanges.emplace_back(_batchGraphicsOptions.size(), _graphicsOptions.size());
+        _batchGraphicsOptions.insert(_batchGraphicsOptions.end(), _graphicsOptions.begin(), _graphicsOptions.end());
+        TermTelemetry::Instance().Log(TermTelemetry::Codes::SGR);
+        break;
+    default:
+        return false;
+    }
+
+    _AddToBatch(command);
+    return true;
+}
+
+// Routine Description:
+// - Adds a command to the batch, dispatching the batch if it's full.
+// Arguments:
+// - command - the command to add.
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_AddToBatch(const DispatchTypes::BatchedCommand& command)
+{
+    _batch.push_back(command);
+
+    if (_batch.size() >= MaxBatchSize)
+    {
+        _FlushBatch();
+    }
+}
+
+// Routine Description:
+// - Dispatches the commands collected so far, if there are any.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void OutputStateMachineEngine::_FlushBatch()
+{
+    if (_batch.empty())
+    {
+        return;
+    }
+
+    // The options of the renditions won't move anymore, so now they can be
+    // handed out. See _BatchCsiDispatch.
+    const auto allOptions = gsl::make_span(_batchGraphicsOptions);
+    auto range = _batchGraphicsRanges.cbegin();
+    for (auto& command : _batch)
+    {
+        if (command.type == DispatchTypes::BatchedCommandType::SetGraphicsRendition)
+        {
+            command.options = allOptions.subspan(range->first, range->second);
+            ++range;
+        }
+    }
+
+    // Whatever happens, these commands must not be dispatched again.
+    auto clearBatch = wil::scope_exit([&]() noexcept {
+        _batch.clear();
+        _batchGraphicsOptions.clear();
+        _batchGraphicsRanges.clear();
+    });
+
+    _dispatch->DispatchBatch(_batch);
+}
+
 // Routine Description:
 // - Retrieves a number of times to repeat the last graphical character
 // Arguments:
@@ -55,6 +55,9 @@ namespace Microsoft::Console::VirtualTerminal
         bool ActionSs3Dispatch(const wchar_t wch,
                                const gsl::span<const size_t> parameters) noexcept override;
 
+        void BeginProcessingString() noexcept override;
+        void EndProcessingString() noexcept override;
+
         bool ParseControlSequenceAfterSs3() const noexcept override;
         bool FlushAtEndOfString() const noexcept override;
         bool DispatchControlCharsFromEscape() const noexcept override;
@@ -63,6 +66,11 @@ namespace Microsoft::Console::VirtualTerminal
         void SetTerminalConnection(Microsoft::Console::ITerminalOutputConnection* const pTtyConnection,
                                    std::function<bool()> pfnFlushToTerminal);
 
+        void SetBatchDispatch(const bool enabled) noexcept;
+
+        // A batch is dispatched early once it holds this many commands.
+        static constexpr size_t MaxBatchSize = 1024;
+
         const ITermDispatch& Dispatch() const noexcept;
         ITermDispatch& Dispatch() noexcept;
 
@@ -73,6 +81,19 @@ namespace Microsoft::Console::VirtualTerminal
         wchar_t _lastPrintedChar;
         std::vector<DispatchTypes::GraphicsOptions> _graphicsOptions;
 
+        bool _batchDispatch;
+        bool _batching;
+        std::vector<DispatchTypes::BatchedCommand> _batch;
+        std::vector<DispatchTypes::GraphicsOptions> _batchGraphicsOptions;
+        std::vector<std::pair<size_t, size_t>> _batchGraphicsRanges; // the offset and count of each batched SGR's options
+
+        bool _BatchCsiDispatch(const wchar_t wch,
+                               const size_t distance,
+                               const size_t line,
+                               const size_t column);
+        void _AddToBatch(const DispatchTypes::BatchedCommand& command);
+        void _FlushBatch();
+
         bool _IntermediateScsDispatch(const wchar_t wch,
                                       const gsl::span<const wchar_t> intermediates);
         bool _IntermediateQuestionMarkDispatch(const wchar_t wchAction,
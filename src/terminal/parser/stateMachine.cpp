@@ -1383,6 +1383,14 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    // The engine may hold back what it dispatches while the string is being
+    // processed. It has to be done with that before the string goes away,
+    // even if processing it fails.
+    _engine->BeginProcessingString();
+    auto endProcessing = wil::scope_exit([&]() noexcept {
+        _engine->EndProcessingString();
+    });
+
     size_t start = 0;
     size_t current = start;
 
@@ -281,6 +281,13 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
 
     TEST_METHOD(TestWin32InputParsing);
     TEST_METHOD(TestWin32InputOptionals);
+    TEST_METHOD(TestWin32InputRoundtrip);
+    TEST_METHOD(Win32InputRoundtripPerformance);
+
+    TEST_METHOD(KeyLookupTablesTest);
+    TEST_METHOD(KeyScanCacheTest);
+
+    TEST_METHOD(DecodeKeyStreamPerformance);
 
     friend class TestInteractDispatch;
 };
@@ -323,7 +330,7 @@ class Microsoft::Console::VirtualTerminal::TestInteractDispatch final : public I
 public:
     TestInteractDispatch(_In_ std::function<void(std::deque<std::unique_ptr<IInputEvent>>&)> pfn,
                          _In_ TestState* testState);
-    virtual bool WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents) override;
+    virtual bool WriteInput(const gsl::span<const INPUT_RECORD> inputRecords) override;
 
     virtual bool WriteCtrlKey(const KeyEvent& event) override;
     virtual bool WindowManipulation(const DispatchTypes::WindowManipulationType function,
@@ -347,8 +354,9 @@ TestInteractDispatch::TestInteractDispatch(_In_ std::function<void(std::deque<st
 {
 }
 
-bool TestInteractDispatch::WriteInput(_In_ std::deque<std::unique_ptr<IInputEvent>>& inputEvents)
+bool TestInteractDispatch::WriteInput(const gsl::span<const INPUT_RECORD> inputRecords)
 {
+    auto inputEvents = IInputEvent::Create(inputRecords);
     _pfnWriteInputCallback(inputEvents);
     return true;
 }
@@ -356,9 +364,8 @@ bool TestInteractDispatch::WriteInput(_In_ std::deque<std::unique_ptr<IInputEven
 bool TestInteractDispatch::WriteCtrlKey(const KeyEvent& event)
 {
     VERIFY_IS_TRUE(_testState->_expectSendCtrlC);
-    std::deque<std::unique_ptr<IInputEvent>> inputEvents;
-    inputEvents.push_back(std::make_unique<KeyEvent>(event));
-    return WriteInput(inputEvents);
+    const auto record = event.ToInputRecord();
+    return WriteInput(gsl::make_span(&record, 1));
 }
 
 bool TestInteractDispatch::WindowManipulation(const DispatchTypes::WindowManipulationType function,
@@ -377,19 +384,19 @@ bool TestInteractDispatch::WindowManipulation(const DispatchTypes::WindowManipul
 
 bool TestInteractDispatch::WriteString(const std::wstring_view string)
 {
-    std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    std::vector<INPUT_RECORD> keyRecords;
 
     for (const auto& wch : string)
     {
         // We're forcing the translation to CP_USA, so that it'll be constant
         //  regardless of the CP the test is running in
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(wch, CP_USA);
-        std::move(convertedEvents.begin(),
-                  convertedEvents.end(),
-                  std::back_inserter(keyEvents));
+        for (const auto& keyEvent : CharToKeyEvents(wch, CP_USA))
+        {
+            keyRecords.push_back(keyEvent->ToInputRecord());
+        }
     }
 
-    return WriteInput(keyEvents);
+    return WriteInput(keyRecords);
 }
 
 bool TestInteractDispatch::MoveCursor(const size_t row, const size_t col)
@@ -1561,3 +1568,226 @@ void InputEngineTest::TestWin32InputOptionals()
         }
     }
 }
+
+void InputEngineTest::KeyLookupTablesTest()
+{
+    auto pfn = std::bind(&TestState::TestInputCallback, &testState, std::placeholders::_1);
+    auto dispatch = std::make_unique<TestInteractDispatch>(pfn, &testState);
+    auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch));
+
+    short vkey = 0;
+
+    Log::Comment(L"CSI final characters");
+    VERIFY_IS_TRUE(engine->_GetCursorKeysVkey(L'A', vkey));
+    VERIFY_ARE_EQUAL(VK_UP, vkey);
+    VERIFY_IS_TRUE(engine->_GetCursorKeysVkey(L'F', vkey));
+    VERIFY_ARE_EQUAL(VK_END, vkey);
+    VERIFY_IS_TRUE(engine->_GetCursorKeysVkey(L'S', vkey));
+    VERIFY_ARE_EQUAL(VK_F4, vkey);
+    VERIFY_IS_FALSE(engine->_GetCursorKeysVkey(L'Z', vkey));
+    VERIFY_IS_FALSE(engine->_GetCursorKeysVkey(L'\x7f', vkey));
+    VERIFY_IS_FALSE(engine->_GetCursorKeysVkey(L'\x3b1', vkey));
+    VERIFY_ARE_EQUAL(0, vkey);
+
+    Log::Comment(L"SS3 final characters");
+    VERIFY_IS_TRUE(engine->_GetSs3KeysVkey(L'D', vkey));
+    VERIFY_ARE_EQUAL(VK_LEFT, vkey);
+    VERIFY_IS_TRUE(engine->_GetSs3KeysVkey(L'P', vkey));
+    VERIFY_ARE_EQUAL(VK_F1, vkey);
+    VERIFY_IS_FALSE(engine->_GetSs3KeysVkey(L'~', vkey));
+    VERIFY_IS_FALSE(engine->_GetSs3KeysVkey(L'\xffff', vkey));
+
+    Log::Comment(L"Generic key identifiers");
+    const auto genericVkey = [&](const size_t identifier) {
+        const std::array<size_t, 1> params{ identifier };
+        short result = 0;
+        return engine->_GetGenericVkey(params, result) ? result : static_cast<short>(-1);
+    };
+    VERIFY_ARE_EQUAL(VK_HOME, genericVkey(1));
+    VERIFY_ARE_EQUAL(VK_NEXT, genericVkey(6));
+    VERIFY_ARE_EQUAL(VK_F5, genericVkey(15));
+    VERIFY_ARE_EQUAL(VK_F12, genericVkey(24));
+    VERIFY_ARE_EQUAL(-1, genericVkey(0));
+    VERIFY_ARE_EQUAL(-1, genericVkey(16));
+    VERIFY_ARE_EQUAL(-1, genericVkey(25));
+    VERIFY_ARE_EQUAL(-1, genericVkey(65536 + 1));
+    VERIFY_IS_FALSE(engine->_GetGenericVkey({}, vkey));
+}
+
+void InputEngineTest::KeyScanCacheTest()
+{
+    auto pfn = std::bind(&TestState::TestInputCallback, &testState, std::placeholders::_1);
+    auto dispatch = std::make_unique<TestInteractDispatch>(pfn, &testState);
+    auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch));
+
+    Log::Comment(L"The cached results must be the same as VkKeyScanW's, the first time and after.");
+    for (auto pass = 0; pass < 2; ++pass)
+    {
+        for (wchar_t wch = 0; wch < 0x80; ++wch)
+        {
+            VERIFY_ARE_EQUAL(VkKeyScanW(wch), engine->_KeyScan(wch), NoThrowString().Format(L"wch=0x%x", wch));
+        }
+    }
+
+    Log::Comment(L"Characters past ASCII aren't cached, but still looked up.");
+    for (const auto wch : { L'\xe9', L'\x3b1', L'\x20ac' })
+    {
+        VERIFY_ARE_EQUAL(VkKeyScanW(wch), engine->_KeyScan(wch), NoThrowString().Format(L"wch=0x%x", wch));
+    }
+}
+
+void InputEngineTest::DecodeKeyStreamPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    // A recording of someone typing in a shell and moving around in an
+    // editor: text, arrow and navigation keys, function keys, and modified
+    // keys, in the shapes a terminal sends them.
+    static constexpr std::wstring_view recording{
+        L"git status\r"
+        L"\x1b[A\x1b[A\x1b[B\r"
+        L"vim src/terminal/parser/InputStateMachineEngine.cpp\r"
+        L"\x1bOB\x1bOB\x1bOB\x1bOC\x1bOC\x1b[1;5C\x1b[1;5D\x1b[1;2A"
+        L"\x1b[5~\x1b[6~\x1b[H\x1b[F\x1b[3~\x1b[2~"
+        L"ihello, world\x1b"
+        L"\x1bOP\x1b[15~\x1b[24~\x1b[1;3S"
+        L":wq\r"
+        L"\x1b" L"b\x1b" L"f\x7f\x7f\x08\t\x1b[Z"
+        L"ls -la | grep .cpp\r"
+    };
+    static constexpr size_t repetitions = 20000;
+
+    size_t eventsWritten = 0;
+    auto dispatch = std::make_unique<TestInteractDispatch>([&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+        eventsWritten += events.size();
+    },
+                                                           &testState);
+    auto engine = std::make_unique<InputStateMachineEngine>(std::move(dispatch));
+    StateMachine stateMachine{ std::move(engine) };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+        stateMachine.ProcessString(recording);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    VERIFY_IS_GREATER_THAN(eventsWritten, repetitions);
+    Log::Comment(NoThrowString().Format(L"Decoded %zu characters into %zu events in %lld us",
+                                        recording.size() * repetitions,
+                                        eventsWritten,
+                                        elapsed));
+}
+
+void InputEngineTest::TestWin32InputRoundtrip()
+{
+    // Keys are encoded by a TerminalInput in win32-input-mode, and the
+    // sequences it writes are decoded by an InputStateMachineEngine. What
+    // comes out must be exactly the key that went in.
+    std::vector<KeyEvent> decoded;
+    auto dispatch = std::make_unique<TestInteractDispatch>([&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+        for (const auto& ev : events)
+        {
+            VERIFY_IS_TRUE(ev->EventType() == InputEventType::KeyEvent);
+            decoded.push_back(static_cast<const KeyEvent&>(*ev));
+        }
+    },
+                                                           &testState);
+    StateMachine stateMachine{ std::make_unique<InputStateMachineEngine>(std::move(dispatch)) };
+
+    std::wstring written;
+    TerminalInput terminalInput{ [](auto&) { VERIFY_FAIL(L"Sequences should be written as text"); } };
+    terminalInput.SetWriteSequenceCallback([&](const std::wstring_view sequence) {
+        VERIFY_IS_LESS_THAN_OR_EQUAL(sequence.size(), TerminalInput::MaxWin32KeySequenceLength);
+        written = sequence;
+        stateMachine.ProcessString(sequence);
+    });
+    terminalInput.ChangeWin32InputMode(true);
+
+    // Every key is written with WriteCtrlKey, so that Ctrl+C is handled.
+    testState._expectSendCtrlC = true;
+    auto resetExpectations = wil::scope_exit([&]() { testState._expectSendCtrlC = false; });
+
+    // Note that the state machine caps parameters at MAX_PARAMETER_VALUE, so
+    // none of these go past it.
+    const std::vector<KeyEvent> keys{
+        KeyEvent{ true, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ false, 1, 'A', 0x1e, L'a', 0 },
+        KeyEvent{ true, 1, 'A', 0x1e, L'A', SHIFT_PRESSED },
+        KeyEvent{ true, 1, 'C', 0x2e, L'\x03', LEFT_CTRL_PRESSED },
+        KeyEvent{ true, 3, VK_UP, 0x48, L'\0', ENHANCED_KEY | NUMLOCK_ON },
+        KeyEvent{ true, 1, VK_F12, 0x58, L'\0', RIGHT_ALT_PRESSED | LEFT_CTRL_PRESSED | SHIFT_PRESSED },
+        KeyEvent{ true, 1, VK_PACKET, 0, L'\x4e2d', 0 },
+        KeyEvent{ true, 1, 0, 0, L'\0', 0 },
+        KeyEvent{ true, 32767, 0xff, 0x7f, L'\x7fff', 0x1ff },
+    };
+
+    for (const auto& key : keys)
+    {
+        decoded.clear();
+        VERIFY_IS_TRUE(terminalInput.HandleKey(&key));
+        Log::Comment(NoThrowString().Format(L"Round tripped \"\\x1b%s\"", written.substr(1).c_str()));
+
+        VERIFY_ARE_EQUAL(1u, decoded.size());
+        const auto& actual = decoded.at(0);
+        VERIFY_ARE_EQUAL(key.IsKeyDown(), actual.IsKeyDown());
+        VERIFY_ARE_EQUAL(key.GetRepeatCount(), actual.GetRepeatCount());
+        VERIFY_ARE_EQUAL(key.GetVirtualKeyCode(), actual.GetVirtualKeyCode());
+        VERIFY_ARE_EQUAL(key.GetVirtualScanCode(), actual.GetVirtualScanCode());
+        VERIFY_ARE_EQUAL(key.GetCharData(), actual.GetCharData());
+        VERIFY_ARE_EQUAL(key.GetActiveModifierKeys(), actual.GetActiveModifierKeys());
+    }
+}
+
+void InputEngineTest::Win32InputRoundtripPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    static constexpr size_t repetitions = 100000;
+
+    size_t keysDecoded = 0;
+    auto dispatch = std::make_unique<TestInteractDispatch>([&](std::deque<std::unique_ptr<IInputEvent>>& events) {
+        keysDecoded += events.size();
+    },
+                                                           &testState);
+    StateMachine stateMachine{ std::make_unique<InputStateMachineEngine>(std::move(dispatch)) };
+
+    TerminalInput terminalInput{ [](auto&) {} };
+    terminalInput.SetWriteSequenceCallback([&](const std::wstring_view sequence) {
+        stateMachine.ProcessString(sequence);
+    });
+    terminalInput.ChangeWin32InputMode(true);
+
+    testState._expectSendCtrlC = true;
+    auto resetExpectations = wil::scope_exit([&]() { testState._expectSendCtrlC = false; });
+
+    // Typing "ls", then Enter, with each key pressed and released.
+    const std::array<KeyEvent, 6> keys{
+        KeyEvent{ true, 1, 'L', 0x26, L'l', NUMLOCK_ON },
+        KeyEvent{ false, 1, 'L', 0x26, L'l', NUMLOCK_ON },
+        KeyEvent{ true, 1, 'S', 0x1f, L's', NUMLOCK_ON },
+        KeyEvent{ false, 1, 'S', 0x1f, L's', NUMLOCK_ON },
+        KeyEvent{ true, 1, VK_RETURN, 0x1c, L'\r', NUMLOCK_ON },
+        KeyEvent{ false, 1, VK_RETURN, 0x1c, L'\r', NUMLOCK_ON },
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; ++i)
+    {
+        for (const auto& key : keys)
+        {
+            terminalInput.HandleKey(&key);
+        }
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    VERIFY_ARE_EQUAL(repetitions * keys.size(), keysDecoded);
+    Log::Comment(NoThrowString().Format(L"Encoded and decoded %zu keys in %.3f s (%.0f keys/s)",
+                                        keysDecoded,
+                                        elapsed,
+                                        keysDecoded / elapsed));
+}
@@ -563,8 +563,16 @@ public:
     {
     }
 
-    virtual void PrintString(const std::wstring_view /*string*/) override
+    virtual void PrintString(const std::wstring_view string) override
+    {
+        _printed.append(string);
+    }
+
+    bool DispatchBatch(const gsl::span<const DispatchTypes::BatchedCommand> commands) override
     {
+        ++_batches;
+        _batchedCommands += commands.size();
+        return _ReplayBatch(commands);
     }
 
     StatefulDispatch() :
@@ -614,6 +622,8 @@ public:
         _isDECCOLMAllowed{ false },
         _windowWidth{ 80 },
         _win32InputMode{ false },
+        _batches{ 0 },
+        _batchedCommands{ 0 },
         _options{ s_cMaxOptions, static_cast<DispatchTypes::GraphicsOptions>(s_uiGraphicsCleared) } // fill with cleared option
     {
     }
@@ -1013,6 +1023,9 @@ public:
     size_t _windowWidth;
     bool _win32InputMode;
     std::wstring _copyContent;
+    std::wstring _printed;
+    size_t _batches;
+    size_t _batchedCommands;
 
     static const size_t s_cMaxOptions = 16;
     static const size_t s_uiGraphicsCleared = UINT_MAX;
@@ -2191,6 +2204,60 @@ class StateMachineExternalTest final
         VERIFY_IS_TRUE(pDispatch->_vt52DeviceAttributes);
     }
 
+    TEST_METHOD(TestBatchDispatch)
+    {
+        auto dispatch = std::make_unique<StatefulDispatch>();
+        auto pDispatch = dispatch.get();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        auto pEngine = engine.get();
+        StateMachine mach(std::move(engine));
+
+        Log::Comment(L"Without batching, nothing goes through DispatchBatch.");
+        mach.ProcessString(L"\x1b[2;3H\x1b[1mHello");
+        VERIFY_ARE_EQUAL(0u, pDispatch->_batches);
+        VERIFY_ARE_EQUAL(L"Hello", pDispatch->_printed);
+
+        pDispatch->ClearState();
+        pEngine->SetBatchDispatch(true);
+
+        Log::Comment(L"Movements, renditions and text are dispatched together, before the erase that follows them.");
+        mach.ProcessString(L"\x1b[2;3H\x1b[1;30mHello\x1b[5C World\x1b[2J");
+        VERIFY_ARE_EQUAL(1u, pDispatch->_batches);
+        VERIFY_ARE_EQUAL(5u, pDispatch->_batchedCommands);
+        VERIFY_IS_TRUE(pDispatch->_cursorPosition);
+        VERIFY_ARE_EQUAL(2u, pDispatch->_line);
+        VERIFY_ARE_EQUAL(3u, pDispatch->_column);
+        VERIFY_IS_TRUE(pDispatch->_cursorForward);
+        VERIFY_ARE_EQUAL(5u, pDispatch->_cursorDistance);
+        VERIFY_IS_TRUE(pDispatch->_setGraphics);
+        VERIFY_ARE_EQUAL(2u, pDispatch->_options.size());
+        VERIFY_ARE_EQUAL(DispatchTypes::GraphicsOptions::BoldBright, pDispatch->_options.at(0));
+        VERIFY_ARE_EQUAL(DispatchTypes::GraphicsOptions::ForegroundBlack, pDispatch->_options.at(1));
+        VERIFY_ARE_EQUAL(L"Hello World", pDispatch->_printed);
+        VERIFY_IS_TRUE(pDispatch->_eraseDisplay);
+
+        pDispatch->ClearState();
+
+        Log::Comment(L"Whatever is left at the end of the string is dispatched too.");
+        mach.ProcessString(L"\x1b[1m\x1b[0mA\x1b[4mB");
+        VERIFY_ARE_EQUAL(1u, pDispatch->_batches);
+        VERIFY_ARE_EQUAL(5u, pDispatch->_batchedCommands);
+        VERIFY_ARE_EQUAL(L"AB", pDispatch->_printed);
+        VERIFY_ARE_EQUAL(1u, pDispatch->_options.size());
+        VERIFY_ARE_EQUAL(DispatchTypes::GraphicsOptions::Underline, pDispatch->_options.at(0));
+
+        pDispatch->ClearState();
+
+        Log::Comment(L"Characters processed one at a time aren't batched.");
+        mach.ProcessCharacter(AsciiChars::ESC);
+        mach.ProcessCharacter(L'[');
+        mach.ProcessCharacter(L'A');
+        VERIFY_ARE_EQUAL(0u, pDispatch->_batches);
+        VERIFY_IS_TRUE(pDispatch->_cursorUp);
+
+        pDispatch->ClearState();
+    }
+
     TEST_METHOD(TestSetClipboard)
     {
         auto dispatch = std::make_unique<StatefulDispatch>();
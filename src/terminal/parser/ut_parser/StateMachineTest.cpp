@@ -76,6 +76,9 @@ public:
     bool ActionSs3Dispatch(const wchar_t /* wch */,
                            const gsl::span<const size_t> /* parameters */) override { return true; };
 
+    void BeginProcessingString() override {};
+    void EndProcessingString() override {};
+
     bool ParseControlSequenceAfterSs3() const override { return false; }
     bool FlushAtEndOfString() const override { return false; };
     bool DispatchControlCharsFromEscape() const override { return false; };
@@ -7,6 +7,7 @@
 using namespace WEX::Common;
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
+using namespace std::string_view_literals;
 
 class Utf8Utf16ConvertTests
 {
@@ -17,6 +18,12 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestU8ToU16AsciiPrefix);
+    TEST_METHOD(TestU16ToU8AsciiPrefix);
+    TEST_METHOD(TestU8ToU16IntoSpan);
+    TEST_METHOD(TestU16ToU8IntoSpan);
+    TEST_METHOD(TestU8ToU16IntoSpanPartials);
+    TEST_METHOD(TestU16ToU8IntoSpanPartials);
 };
 
 void Utf8Utf16ConvertTests::TestU8ToU16()
@@ -191,3 +198,186 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestU8ToU16AsciiPrefix()
+{
+    // The ASCII at the start of a string is converted without the platform functions.
+    // Wherever it ends, the result has to be the same, invalid sequences included.
+    for (size_t asciiLength{}; asciiLength <= 20u; ++asciiLength)
+    {
+        const std::string ascii(asciiLength, 'a');
+        const std::wstring asciiComp(asciiLength, L'a');
+
+        std::wstring u16Out{};
+        VERIFY_SUCCEEDED(til::u8u16(ascii, u16Out));
+        VERIFY_ARE_EQUAL(asciiComp, u16Out);
+
+        VERIFY_SUCCEEDED(til::u8u16(ascii + "\xE2\x82\xAC" + ascii, u16Out)); // EURO SIGN (3 bytes)
+        VERIFY_ARE_EQUAL(asciiComp + L"\x20AC" + asciiComp, u16Out);
+
+        VERIFY_SUCCEEDED(til::u8u16(ascii + "\xFF" + ascii, u16Out)); // never valid in UTF-8
+        VERIFY_ARE_EQUAL(asciiComp + L"\xFFFD" + asciiComp, u16Out);
+    }
+}
+
+void Utf8Utf16ConvertTests::TestU16ToU8AsciiPrefix()
+{
+    for (size_t asciiLength{}; asciiLength <= 20u; ++asciiLength)
+    {
+        const std::wstring ascii(asciiLength, L'a');
+        const std::string asciiComp(asciiLength, 'a');
+
+        std::string u8Out{};
+        VERIFY_SUCCEEDED(til::u16u8(ascii, u8Out));
+        VERIFY_ARE_EQUAL(asciiComp, u8Out);
+
+        // U+0080 is the first code point that isn't ASCII.
+        VERIFY_SUCCEEDED(til::u16u8(ascii + L"\x80" + ascii, u8Out));
+        VERIFY_ARE_EQUAL(asciiComp + "\xC2\x80" + asciiComp, u8Out);
+
+        VERIFY_SUCCEEDED(til::u16u8(ascii + L"\xDC00" + ascii, u8Out)); // unpaired trailing surrogate
+        VERIFY_ARE_EQUAL(asciiComp + "\xEF\xBF\xBD" + asciiComp, u8Out);
+    }
+}
+
+void Utf8Utf16ConvertTests::TestU8ToU16IntoSpan()
+{
+    const std::string u8String{ "ab\xE2\x82\xAC" "cd\xF0\x9F\x98\x80" "ef\xC3\xA9\xE6\x97\xA5 ghijklmnop" };
+    const std::wstring u16Comp{ til::u8u16(u8String) };
+
+    // However small the buffer, converting into it over and over has to end up with the same as converting the whole string.
+    for (size_t room{ 4u }; room <= 16u; ++room)
+    {
+        std::vector<wchar_t> buffer(room);
+        til::u8state state{};
+        std::wstring u16Out{};
+        std::string_view in{ u8String };
+        while (!in.empty())
+        {
+            size_t consumed{};
+            size_t produced{};
+            VERIFY_SUCCEEDED(til::u8u16(in, buffer, state, consumed, produced));
+            VERIFY_IS_TRUE(consumed != 0u);
+            VERIFY_IS_TRUE(produced <= room);
+            u16Out.append(buffer.data(), produced);
+            in.remove_prefix(consumed);
+        }
+
+        VERIFY_ARE_EQUAL(u16Comp, u16Out);
+    }
+
+    Log::Comment(L"A buffer that is too small for the next code point is reported without consuming anything.");
+    std::array<wchar_t, 1> tooSmall{};
+    til::u8state state{};
+    size_t consumed{};
+    size_t produced{};
+    VERIFY_ARE_EQUAL(E_NOT_SUFFICIENT_BUFFER, til::u8u16("\xF0\x9F\x98\x80"sv, tooSmall, state, consumed, produced));
+    VERIFY_ARE_EQUAL(0u, consumed);
+    VERIFY_ARE_EQUAL(0u, produced);
+}
+
+void Utf8Utf16ConvertTests::TestU16ToU8IntoSpan()
+{
+    const std::wstring u16String{ L"ab\x20AC" L"cd\xD83D\xDE00" L"ef\xE9\x65E5 ghijklmnop" };
+    const std::string u8Comp{ til::u16u8(u16String) };
+
+    for (size_t room{ 6u }; room <= 24u; ++room)
+    {
+        std::vector<char> buffer(room);
+        til::u16state state{};
+        std::string u8Out{};
+        std::wstring_view in{ u16String };
+        while (!in.empty())
+        {
+            size_t consumed{};
+            size_t produced{};
+            VERIFY_SUCCEEDED(til::u16u8(in, buffer, state, consumed, produced));
+            VERIFY_IS_TRUE(consumed != 0u);
+            VERIFY_IS_TRUE(produced <= room);
+            u8Out.append(buffer.data(), produced);
+            in.remove_prefix(consumed);
+        }
+
+        VERIFY_ARE_EQUAL(u8Comp, u8Out);
+    }
+
+    Log::Comment(L"A buffer that is too small for the next code point is reported without consuming anything.");
+    std::array<char, 2> tooSmall{};
+    til::u16state state{};
+    size_t consumed{};
+    size_t produced{};
+    VERIFY_ARE_EQUAL(E_NOT_SUFFICIENT_BUFFER, til::u16u8(L"\x65E5"sv, tooSmall, state, consumed, produced));
+    VERIFY_ARE_EQUAL(0u, consumed);
+    VERIFY_ARE_EQUAL(0u, produced);
+}
+
+void Utf8Utf16ConvertTests::TestU8ToU16IntoSpanPartials()
+{
+    std::array<wchar_t, 8> buffer{};
+    til::u8state state{};
+    size_t consumed{};
+    size_t produced{};
+
+    // GRINNING FACE split into three reads
+    VERIFY_SUCCEEDED(til::u8u16("a\xF0"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(2u, consumed);
+    VERIFY_ARE_EQUAL(std::wstring{ L"a" }, std::wstring(buffer.data(), produced));
+
+    VERIFY_SUCCEEDED(til::u8u16("\x9F\x98"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(2u, consumed);
+    VERIFY_ARE_EQUAL(0u, produced);
+
+    VERIFY_SUCCEEDED(til::u8u16("\x80z"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(2u, consumed);
+    VERIFY_ARE_EQUAL(std::wstring{ L"\xD83D\xDE00z" }, std::wstring(buffer.data(), produced));
+
+    Log::Comment(L"A partial that isn't continued becomes U+FFFD.");
+    VERIFY_SUCCEEDED(til::u8u16("\xE2\x82"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(0u, produced);
+    VERIFY_SUCCEEDED(til::u8u16("z"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(1u, consumed);
+    VERIFY_ARE_EQUAL(std::wstring{ L"\xFFFDz" }, std::wstring(buffer.data(), produced));
+
+    Log::Comment(L"An empty string flushes the cached partial.");
+    VERIFY_SUCCEEDED(til::u8u16("\xC3"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(0u, produced);
+    VERIFY_SUCCEEDED(til::u8u16(std::string_view{}, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(std::wstring{ L"\xFFFD" }, std::wstring(buffer.data(), produced));
+
+    Log::Comment(L"A partial that only doesn't fit into the buffer is left for the next call instead of being cached.");
+    std::array<wchar_t, 4> small{};
+    VERIFY_SUCCEEDED(til::u8u16("abc\xE2\x82\xAC"sv, small, state, consumed, produced));
+    VERIFY_ARE_EQUAL(3u, consumed);
+    VERIFY_ARE_EQUAL(std::wstring{ L"abc" }, std::wstring(small.data(), produced));
+    VERIFY_SUCCEEDED(til::u8u16("\xE2\x82\xAC"sv, small, state, consumed, produced));
+    VERIFY_ARE_EQUAL(3u, consumed);
+    VERIFY_ARE_EQUAL(std::wstring{ L"\x20AC" }, std::wstring(small.data(), produced));
+}
+
+void Utf8Utf16ConvertTests::TestU16ToU8IntoSpanPartials()
+{
+    std::array<char, 8> buffer{};
+    til::u16state state{};
+    size_t consumed{};
+    size_t produced{};
+
+    VERIFY_SUCCEEDED(til::u16u8(L"a\xD83D"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(2u, consumed);
+    VERIFY_ARE_EQUAL(std::string{ "a" }, std::string(buffer.data(), produced));
+
+    VERIFY_SUCCEEDED(til::u16u8(L"\xDE00z"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(2u, consumed);
+    VERIFY_ARE_EQUAL(std::string{ "\xF0\x9F\x98\x80z" }, std::string(buffer.data(), produced));
+
+    Log::Comment(L"A high surrogate that isn't continued becomes U+FFFD.");
+    VERIFY_SUCCEEDED(til::u16u8(L"\xD83D"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(0u, produced);
+    VERIFY_SUCCEEDED(til::u16u8(L"z"sv, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(1u, consumed);
+    VERIFY_ARE_EQUAL(std::string{ "\xEF\xBF\xBDz" }, std::string(buffer.data(), produced));
+
+    Log::Comment(L"An empty string flushes the cached high surrogate.");
+    VERIFY_SUCCEEDED(til::u16u8(L"\xD83D"sv, buffer, state, consumed, produced));
+    VERIFY_SUCCEEDED(til::u16u8(std::wstring_view{}, buffer, state, consumed, produced));
+    VERIFY_ARE_EQUAL(std::string{ "\xEF\xBF\xBD" }, std::string(buffer.data(), produced));
+}
@@ -3,6 +3,7 @@
 // NOTE The functions u8u16 and u16u8 contain own algorithms. Tests have shown that they perform
 // worse than the platform API functions.
 // Thus, these functions are *unrelated* to the til::u8u16 and til::u16u8 implementation.
+// The throughput of til::u8u16 and til::u16u8 themselves is measured by CompTil.
 
 #include <iostream>
 #include <memory>
@@ -13,6 +14,11 @@
 
 #include "U8U16Test.hpp"
 
+#include <wil/result.h>
+#include <gsl/gsl>
+#include <base/numerics/safe_math.h>
+#include "til/u8u16convert.h"
+
 typedef NTSTATUS(WINAPI* t_RtlUTF8ToUnicodeN)(PWSTR, ULONG, PULONG, PCCH, ULONG);
 typedef NTSTATUS(WINAPI* t_RtlUnicodeToUTF8N)(PCHAR, ULONG, PULONG, PCWSTR, ULONG);
 NTSTATUS(WINAPI* p_RtlUTF8ToUnicodeN)
@@ -34,6 +40,7 @@ NTSTATUS(WINAPI* p_RtlUnicodeToUTF8N)
 double GetDuration();
 ptrdiff_t RandomIndex(ptrdiff_t length);
 void PrintHeader(const char* const funcName);
+std::string ReadCorpus(const std::string& fileName);
 
 // test functions
 void WideCharToMultiByte_WholeString(std::wstring_view testU16)
@@ -442,6 +449,92 @@ void CompNaturalLang_Chunks(const std::string& fileName)
     std::cout << " u16u8_ptr           length " << lenTotalU16U8 << " elapsed " << durTotalU16U8 << std::endl;
 }
 
+// Compares the throughput of til::u8u16 and til::u16u8 with the platform functions they
+// fall back to. The text is converted all at once, and in chunks of the 4096 bytes that
+// ConptyConnection reads the output of the client in.
+void CompTil(const std::string& name, const std::string& text)
+{
+    std::string head{ __func__ };
+    head += " - " + name;
+    PrintHeader(head.c_str());
+    std::ostringstream u8Ss{};
+    std::fill_n(std::ostream_iterator<const char*>{ u8Ss }, 30000u, text.c_str());
+    const std::string u8Str = u8Ss.str();
+    const std::wstring u16Str = til::u8u16(u8Str);
+    const double megabytes{ static_cast<double>(u8Str.length()) / 1000000.0 };
+    HRESULT hRes{ S_OK };
+
+    const auto print = [&](const char* const funcName, const size_t length, const double duration) {
+        std::cout << " " << funcName << " length " << length << " elapsed " << duration << " MB/s " << megabytes / duration << std::endl;
+    };
+
+    // whole string
+    std::unique_ptr<wchar_t[]> u16Buffer{ std::make_unique<wchar_t[]>(u8Str.length()) };
+    GetDuration();
+    const int lengthMB2WC = MultiByteToWideChar(65001, 0, u8Str.data(), static_cast<int>(u8Str.length()), u16Buffer.get(), static_cast<int>(u8Str.length()));
+    print("MultiByteToWideChar          ", static_cast<size_t>(lengthMB2WC), GetDuration());
+
+    std::wstring u16StrOut{};
+    GetDuration();
+    hRes |= til::u8u16(u8Str, u16StrOut);
+    print("til::u8u16                   ", u16StrOut.length(), GetDuration());
+
+    std::unique_ptr<char[]> u8Buffer{ std::make_unique<char[]>(u16Str.length() * 3) };
+    GetDuration();
+    const int lengthWC2MB = WideCharToMultiByte(65001, 0, u16Str.data(), static_cast<int>(u16Str.length()), u8Buffer.get(), static_cast<int>(u16Str.length()) * 3, nullptr, nullptr);
+    print("WideCharToMultiByte          ", static_cast<size_t>(lengthWC2MB), GetDuration());
+
+    std::string u8StrOut{};
+    GetDuration();
+    hRes |= til::u16u8(u16Str, u8StrOut);
+    print("til::u16u8                   ", u8StrOut.length(), GetDuration());
+
+    // chunks, which may end in the middle of a code point, so til is given a state to keep partials in
+    constexpr size_t chunkSize{ 4096u };
+    size_t lenTotal{};
+    GetDuration();
+    for (size_t idx = 0u; idx < u8Str.length(); idx += chunkSize)
+    {
+        const std::string_view chunk{ std::string_view{ u8Str }.substr(idx, chunkSize) };
+        lenTotal += static_cast<size_t>(MultiByteToWideChar(65001, 0, chunk.data(), static_cast<int>(chunk.length()), u16Buffer.get(), static_cast<int>(chunk.length())));
+    }
+    print("MultiByteToWideChar (chunks) ", lenTotal, GetDuration());
+
+    til::u8state u8State{};
+    lenTotal = 0u;
+    GetDuration();
+    for (size_t idx = 0u; idx < u8Str.length(); idx += chunkSize)
+    {
+        hRes |= til::u8u16(std::string_view{ u8Str }.substr(idx, chunkSize), u16StrOut, u8State);
+        lenTotal += u16StrOut.length();
+    }
+    print("til::u8u16 (chunks)          ", lenTotal, GetDuration());
+
+    lenTotal = 0u;
+    GetDuration();
+    for (size_t idx = 0u; idx < u16Str.length(); idx += chunkSize)
+    {
+        const std::wstring_view chunk{ std::wstring_view{ u16Str }.substr(idx, chunkSize) };
+        lenTotal += static_cast<size_t>(WideCharToMultiByte(65001, 0, chunk.data(), static_cast<int>(chunk.length()), u8Buffer.get(), static_cast<int>(chunk.length()) * 3, nullptr, nullptr));
+    }
+    print("WideCharToMultiByte (chunks) ", lenTotal, GetDuration());
+
+    til::u16state u16State{};
+    lenTotal = 0u;
+    GetDuration();
+    for (size_t idx = 0u; idx < u16Str.length(); idx += chunkSize)
+    {
+        hRes |= til::u16u8(std::wstring_view{ u16Str }.substr(idx, chunkSize), u8StrOut, u16State);
+        lenTotal += u8StrOut.length();
+    }
+    print("til::u16u8 (chunks)          ", lenTotal, GetDuration());
+
+    if (FAILED(hRes))
+    {
+        std::cerr << "A til conversion failed with HRESULT " << hRes << std::endl;
+    }
+}
+
 int main()
 {
     // UTF-16 string length
@@ -519,6 +612,14 @@ int main()
     CompNaturalLang_Chunks("ru.txt");
     CompNaturalLang_Chunks("zh.txt");
 
+    std::cout << "\n\n### til Throughput ###" << std::endl;
+
+    CompTil("ASCII", "[  42%] Building CXX object src/CMakeFiles/core.dir/parser.cpp.o\r\n");
+    CompTil("en.txt", ReadCorpus("en.txt"));
+    CompTil("fr.txt", ReadCorpus("fr.txt"));
+    CompTil("ru.txt", ReadCorpus("ru.txt"));
+    CompTil("zh.txt", ReadCorpus("zh.txt"));
+
     FreeLibrary(ntdll);
     return 0;
 }
@@ -556,3 +657,11 @@ void PrintHeader(const char* const funcName)
 {
     std::cout << "\n~~~\ntest \"" << funcName << "\"" << std::endl;
 }
+
+// returns the content of a text file
+std::string ReadCorpus(const std::string& fileName)
+{
+    std::ostringstream buf{};
+    buf << std::ifstream{ fileName }.rdbuf();
+    return buf.str();
+}
@@ -3,6 +3,7 @@
 
 #include "precomp.h"
 #include "inc/IInputEvent.hpp"
+#include "inc/GlyphWidth.hpp"
 
 KeyEvent::~KeyEvent()
 {
@@ -181,3 +182,58 @@ bool KeyEvent::IsPopupKey() const noexcept
 
     return false;
 }
+
+// Routine Description:
+// - checks two KeyEvents to see if they're similar enough to be coalesced
+// Arguments:
+// - a - the first KeyEvent
+// - b - the other KeyEvent
+// Return Value:
+// - true if the events could be coalesced, false otherwise
+static bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) noexcept
+{
+    if (WI_IsFlagSet(a.GetActiveModifierKeys(), NLS_IME_CONVERSION) &&
+        a.GetCharData() == b.GetCharData() &&
+        a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    {
+        return true;
+    }
+    // other key events check
+    else if (a.GetVirtualScanCode() == b.GetVirtualScanCode() &&
+             a.GetCharData() == b.GetCharData() &&
+             a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    {
+        return true;
+    }
+    return false;
+}
+
+// Routine Description:
+// - If lastRecord and inRecord are both a keypress down event for the same
+//   key, the repeat count of lastRecord is increased by the one of inRecord,
+//   and inRecord doesn't need to be stored.
+// Arguments:
+// - lastRecord - The record that was stored last.
+// - inRecord - The incoming record.
+// Return Value:
+// - true if the records were coalesced, false if they were not.
+bool CoalesceRepeatedKeyPress(INPUT_RECORD& lastRecord, const INPUT_RECORD& inRecord)
+{
+    if (inRecord.EventType == KEY_EVENT &&
+        lastRecord.EventType == KEY_EVENT)
+    {
+        const KeyEvent inKeyEvent{ inRecord.Event.KeyEvent };
+        const KeyEvent lastKeyEvent{ lastRecord.Event.KeyEvent };
+
+        if (inKeyEvent.IsKeyDown() &&
+            lastKeyEvent.IsKeyDown() &&
+            !IsGlyphFullWidth(inKeyEvent.GetCharData()) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
+        {
+            // increment repeat count
+            lastRecord.Event.KeyEvent.wRepeatCount = gsl::narrow_cast<WORD>(lastKeyEvent.GetRepeatCount() + inKeyEvent.GetRepeatCount());
+            return true;
+        }
+    }
+    return false;
+}
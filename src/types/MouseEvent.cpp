@@ -42,3 +42,26 @@ void MouseEvent::SetEventFlags(const DWORD eventFlags) noexcept
 {
     _eventFlags = eventFlags;
 }
+
+// Routine Description:
+// - Checks if lastRecord and inRecord are both MOUSE_MOVED events. If they
+//   are, lastRecord is updated with the new mouse position, and inRecord
+//   doesn't need to be stored.
+// Arguments:
+// - lastRecord - The record that was stored last.
+// - inRecord - The incoming record.
+// Return Value:
+// - true if the records were coalesced, false if they were not.
+bool CoalesceMouseMoved(INPUT_RECORD& lastRecord, const INPUT_RECORD& inRecord) noexcept
+{
+    if (inRecord.EventType == MOUSE_EVENT &&
+        lastRecord.EventType == MOUSE_EVENT &&
+        inRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED &&
+        lastRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED)
+    {
+        // update mouse moved position
+        lastRecord.Event.MouseEvent.dwMousePosition = inRecord.Event.MouseEvent.dwMousePosition;
+        return true;
+    }
+    return false;
+}
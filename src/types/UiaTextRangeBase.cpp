@@ -528,16 +528,13 @@ try
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
         const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange);
-        const auto bufferData = buffer.GetText(true,
-                                               false,
-                                               textRects);
 
-        const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
-        textData.reserve(textDataSize);
-        for (const auto& text : bufferData.text)
-        {
-            textData += text;
-        }
+        const size_t textDataSize = base::ClampMul(textRects.size(), bufferSize.Width());
+        textData.reserve(maxLength.has_value() ? std::min<size_t>(textDataSize, *maxLength) : textDataSize);
+        buffer.GetPlainText(textRects,
+                            true,
+                            textData,
+                            maxLength.has_value() ? *maxLength : std::wstring::npos);
     }
 
     if (maxLength.has_value())
@@ -915,33 +912,9 @@ void UiaTextRangeBase::_moveEndpointByUnitCharacter(_In_ const int moveCount,
     }
 
     const bool allowBottomExclusive = !preventBufferEnd;
-    const MovementDirection moveDirection = (moveCount > 0) ? MovementDirection::Forward : MovementDirection::Backward;
-    const auto& buffer = _pData->GetTextBuffer();
 
-    bool success = true;
     til::point target = GetEndpoint(endpoint);
-    while (std::abs(*pAmountMoved) < std::abs(moveCount) && success)
-    {
-        switch (moveDirection)
-        {
-        case MovementDirection::Forward:
-            success = buffer.MoveToNextGlyph(target, allowBottomExclusive);
-            if (success)
-            {
-                (*pAmountMoved)++;
-            }
-            break;
-        case MovementDirection::Backward:
-            success = buffer.MoveToPreviousGlyph(target, allowBottomExclusive);
-            if (success)
-            {
-                (*pAmountMoved)--;
-            }
-            break;
-        default:
-            break;
-        }
-    }
+    *pAmountMoved = _pData->GetTextBuffer().MoveByGlyphs(target, moveCount, allowBottomExclusive);
 
     SetEndpoint(endpoint, target);
 }
@@ -971,65 +944,12 @@ void UiaTextRangeBase::_moveEndpointByUnitWord(_In_ const int moveCount,
     }
 
     const bool allowBottomExclusive = !preventBufferEnd;
-    const MovementDirection moveDirection = (moveCount > 0) ? MovementDirection::Forward : MovementDirection::Backward;
     const auto& buffer = _pData->GetTextBuffer();
     const auto bufferSize = _getBufferSize();
-    const auto bufferOrigin = bufferSize.Origin();
-    const auto bufferEnd = bufferSize.EndExclusive();
     const auto lastCharPos = buffer.GetLastNonSpaceCharacter(bufferSize);
 
     auto resultPos = GetEndpoint(endpoint);
-    auto nextPos = resultPos;
-
-    bool success = true;
-    while (std::abs(*pAmountMoved) < std::abs(moveCount) && success)
-    {
-        nextPos = resultPos;
-        switch (moveDirection)
-        {
-        case MovementDirection::Forward:
-        {
-            if (nextPos == bufferEnd)
-            {
-                success = false;
-            }
-            else if (buffer.MoveToNextWord(nextPos, _wordDelimiters, lastCharPos))
-            {
-                resultPos = nextPos;
-                (*pAmountMoved)++;
-            }
-            else if (allowBottomExclusive)
-            {
-                resultPos = bufferEnd;
-                (*pAmountMoved)++;
-            }
-            else
-            {
-                success = false;
-            }
-            break;
-        }
-        case MovementDirection::Backward:
-        {
-            if (nextPos == bufferOrigin)
-            {
-                success = false;
-            }
-            else if (buffer.MoveToPreviousWord(nextPos, _wordDelimiters))
-            {
-                resultPos = nextPos;
-                (*pAmountMoved)--;
-            }
-            else
-            {
-                resultPos = bufferOrigin;
-            }
-            break;
-        }
-        default:
-            return;
-        }
-    }
+    *pAmountMoved = buffer.MoveByWords(resultPos, moveCount, _wordDelimiters, bufferSize.Origin(), bufferSize.EndExclusive(), lastCharPos, allowBottomExclusive);
 
     SetEndpoint(endpoint, resultPos);
 }
@@ -17,7 +17,7 @@ Author:
 #include <functional>
 
 static_assert(sizeof(unsigned int) == sizeof(wchar_t) * 2,
-              "UnicodeRange expects to be able to store a unicode codepoint in an unsigned int");
+              "CodepointWidthDetector expects to be able to store a unicode codepoint in an unsigned int");
 
 // use to measure the width of a codepoint
 class CodepointWidthDetector final
@@ -36,6 +36,15 @@ public:
     void SetFallbackMethod(std::function<bool(const std::wstring_view)> pfnFallback);
     void NotifyFontChanged() const noexcept;
 
+    struct FallbackCacheStatistics
+    {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+    };
+
+    FallbackCacheStatistics GetFallbackCacheStatistics() const noexcept;
+
 #ifdef UNIT_TESTING
     friend class CodepointWidthDetectorTests;
 #endif
@@ -44,8 +53,25 @@ private:
     CodepointWidth _lookupGlyphWidth(const std::wstring_view glyph) const;
     CodepointWidth _lookupGlyphWidthWithCache(const std::wstring_view glyph) const noexcept;
     bool _checkFallbackViaCache(const std::wstring_view glyph) const;
+    std::optional<bool> _findCodepointInFallbackCache(const unsigned int codepoint) const noexcept;
+    void _addCodepointToFallbackCache(const unsigned int codepoint, const bool isWide) const noexcept;
+    static bool _isSingleCodepoint(const std::wstring_view glyph) noexcept;
     static unsigned int _extractCodepoint(const std::wstring_view glyph) noexcept;
 
-    mutable std::unordered_map<std::wstring, bool> _fallbackCache;
+    // The answers of the fallback method for single codepoints are kept in an open
+    // addressed table. An entry holds the codepoint, a bit to mark it as in use and a
+    // bit for the answer, so the table never allocates. A codepoint is only ever
+    // stored within FallbackCacheProbeLength slots of where it hashes to, and when
+    // they're all in use one of them is evicted.
+    static constexpr size_t FallbackCacheSizeBits = 12;
+    static constexpr size_t FallbackCacheProbeLength = 8;
+    mutable std::array<uint32_t, size_t{ 1 } << FallbackCacheSizeBits> _fallbackCache;
+    mutable size_t _fallbackCacheNextEviction;
+
+    // Glyphs made up of more than one codepoint are rare enough to be kept in a map.
+    static constexpr size_t MaxFallbackClusterCacheSize = 256;
+    mutable std::unordered_map<std::wstring, bool> _fallbackClusterCache;
+
+    mutable FallbackCacheStatistics _fallbackCacheStatistics;
     std::function<bool(std::wstring_view)> _pfnFallbackMethod;
 };
@@ -352,6 +352,8 @@ constexpr bool operator==(const KeyEvent& a, const KeyEvent& b) noexcept
 std::wostream& operator<<(std::wostream& stream, const KeyEvent* const pKeyEvent);
 #endif
 
+bool CoalesceRepeatedKeyPress(INPUT_RECORD& lastRecord, const INPUT_RECORD& inRecord);
+
 class MouseEvent : public IInputEvent
 {
 public:
@@ -428,6 +430,8 @@ private:
 std::wostream& operator<<(std::wostream& stream, const MouseEvent* const pMouseEvent);
 #endif
 
+bool CoalesceMouseMoved(INPUT_RECORD& lastRecord, const INPUT_RECORD& inRecord) noexcept;
+
 class WindowBufferSizeEvent : public IInputEvent
 {
 public:
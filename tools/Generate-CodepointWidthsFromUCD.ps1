@@ -5,9 +5,13 @@
 # (we use the null coalescing operator)
 
 ################################################################################
-# This script generates the an array suitable for replacing the body of
-# src/types/CodepointWidthDetector.cpp from a Unicode UCD XML document[1]
-# compliant with UAX#42[2].
+# This script generates the two stage width tables suitable for replacing the
+# body of src/types/CodepointWidthDetector.cpp from a Unicode UCD XML
+# document[1] compliant with UAX#42[2].
+#
+# Every page of 256 codepoints maps to a leaf holding the widths of its
+# codepoints, and pages with the same widths share a leaf, so that looking up
+# the width of any codepoint takes two array loads.
 #
 # This script supports a quasi-mandatory "overrides" file, overrides.xml.
 # If you do not have overrides, supply the -NoOverrides parameter. This was
@@ -255,6 +259,44 @@ If (-not $NoOverrides) {
     }
 }
 
+# Build the two stage table
+$PageBits = 8
+$PageSize = 1 -shl $PageBits
+
+$widths = [byte[]]::new(0x110000)
+ForEach($_ in $ranges) {
+    If ($_.Width -ne [CodepointWidth]::Wide -and $_.Width -ne [CodepointWidth]::Ambiguous) {
+        # Everything else is presumed to be Narrow, which is what the table starts out as.
+        Continue
+    }
+    For($cp = $_.Start; $cp -le $_.End; $cp++) {
+        $widths[$cp] = [byte]$_.Width
+    }
+}
+
+$leafIndices = [System.Collections.Generic.Dictionary[string, int]]::New()
+$leaves = [System.Collections.Generic.List[byte[]]]::New()
+$leafFirstPages = [System.Collections.Generic.List[int]]::New()
+$pages = [System.Collections.Generic.List[int]]::New(0x110000 -shr $PageBits)
+For($page = 0; $page -lt (0x110000 -shr $PageBits); $page++) {
+    $leaf = [byte[]]::new($PageSize)
+    [Array]::Copy($widths, $page * $PageSize, $leaf, 0, $PageSize)
+
+    $key = [Convert]::ToBase64String($leaf)
+    $index = 0
+    If (-not $leafIndices.TryGetValue($key, [ref]$index)) {
+        $index = $leaves.Count
+        $leafIndices.Add($key, $index)
+        $leaves.Add($leaf)
+        $leafFirstPages.Add($page)
+    }
+    $pages.Add($index)
+}
+
+If ($leaves.Count -gt 256) {
+    Throw "There are too many distinct pages for their indices to fit in a byte"
+}
+
 # Emit Code
 "    // Generated by {0} -Pack:{1} -Full:{2} -NoOverrides:{3}" -f $MyInvocation.MyCommand.Name, $Pack, $Full, $NoOverrides
 "    // on {0} (UTC) from {1}." -f (Get-Date -AsUTC), $InputObject.ucd.description
@@ -262,13 +304,22 @@ If (-not $NoOverrides) {
 If (-not $NoOverrides) {
 "    // {0} (0x{0:X}) codepoints overridden." -f $overrideCount
 }
-"    static constexpr std::array<UnicodeRange, {0}> s_wideAndAmbiguousTable{{" -f $ranges.Count
-ForEach($_ in $ranges) {
-    $comment = ""
-    if ($null -ne $_.Comment) {
-        # We only vend comments when we aren't packing tightly
-        $comment = " // {0}" -f $_.Comment
+"    static constexpr size_t s_widthPageBits = {0};" -f $PageBits
+""
+"    // The leaf of each page of codepoints."
+"    static constexpr std::array<uint8_t, {0}> s_widthPages{{" -f $pages.Count
+For($i = 0; $i -lt $pages.Count; $i += 16) {
+    $line = ($pages.GetRange($i, 16) | ForEach-Object { "0x{0:x2}" -f $_ }) -join ", "
+"        {0}, // U+{1:X4}" -f $line, ($i -shl $PageBits)
+}
+"    };"
+""
+"    // The widths of the codepoints in each distinct page. 0 is Narrow, 1 is Wide and 2 is Ambiguous."
+"    static constexpr std::array<uint8_t, {0}> s_widthLeaves{{" -f ($leaves.Count * $PageSize)
+For($leaf = 0; $leaf -lt $leaves.Count; $leaf++) {
+"        // leaf 0x{0:x2}, first used by U+{1:X4}" -f $leaf, ($leafFirstPages[$leaf] -shl $PageBits)
+    For($i = 0; $i -lt $PageSize; $i += 32) {
+"        {0}," -f ($leaves[$leaf][$i..($i + 31)] -join ", ")
     }
-"        UnicodeRange{{ 0x{0:x}, 0x{1:x}, CodepointWidth::{2} }},{3}" -f $_.Start, $_.End, $_.Width, $comment
 }
 "    };"